@@ -25,6 +25,8 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/time.h>
+#include <sched.h>
+#include <atomic>
 
 #include <rkisp_control_loop.h>
 #include <rkisp_dev_manager.h>
@@ -63,6 +65,29 @@ struct rkisp_buf_priv {
 };
 
 
+/*
+ * The 3A results rkisp_get_frame() reports, refreshed from every result
+ * metadata. @valid holds the RKISP_SNAPSHOT_* of the fields present.
+ */
+#define RKISP_SNAPSHOT_EXPO_TIME        (1 << 0)
+#define RKISP_SNAPSHOT_GAIN             (1 << 1)
+#define RKISP_SNAPSHOT_FRAME_ID         (1 << 2)
+#define RKISP_SNAPSHOT_MAX_EXPO_TIME    (1 << 3)
+#define RKISP_SNAPSHOT_MAX_GAIN         (1 << 4)
+
+struct rkisp_3a_snapshot {
+    uint32_t valid;
+    int64_t expo_time;
+    int gain;
+    int64_t frame_id;
+    int64_t max_expo_time;
+    int max_gain;
+    unsigned char luminance_grid[RKISP_MAX_LUMINANCE_GRID];
+    int luminance_grid_count;   /* -1 if not reported */
+    int hist_bins[RKISP_MAX_HISTOGRAM_BIN];
+    int hist_bins_count;        /* -1 if not reported */
+};
+
 struct control_params_3A
 {
     /* used to receive current 3A settings and 3A states
@@ -73,9 +98,25 @@ struct control_params_3A
     rkisp_cl_frame_metadata_s _frame_metas;
     /* to manage the 3A settings, used by _frame_metas */
     CameraMetadata _settings_metadata;
-    /* to manage the 3A result settings, used by metadata_result_callback */
+    /* full 3A result, only kept once rkisp_get_result_metadata() asked */
     CameraMetadata _result_metadata;
     XCam::Mutex _meta_mutex;
+    std::atomic<bool> _keep_result_metadata;
+    /*
+     * seqlock around _snapshot: written by the result callback only, odd
+     * while a write is in progress, readers retry instead of locking
+     */
+    std::atomic<uint32_t> _snapshot_seq;
+    struct rkisp_3a_snapshot _snapshot;
+
+    control_params_3A()
+        : _keep_result_metadata(false)
+        , _snapshot_seq(0)
+    {
+        memset(&_snapshot, 0, sizeof(_snapshot));
+        _snapshot.luminance_grid_count = -1;
+        _snapshot.hist_bins_count = -1;
+    }
 };
 
 enum {
@@ -116,11 +157,7 @@ static int rkisp_init_engine(struct rkisp_priv *priv);
 static void rkisp_deinit_engine(struct rkisp_priv *priv);
 static void rkisp_stop_engine(struct rkisp_priv *priv);
 static int rkisp_start_engine(struct rkisp_priv *priv);
-static int rkisp_get_ae_time(struct rkisp_priv *priv, int64_t &time);
-static int rkisp_get_ae_gain(struct rkisp_priv *priv, int &gain);
-static int rkisp_get_meta_frame_id(struct rkisp_priv *priv, int64_t& frame_id);
-static int rkisp_get_luminance_grid(struct rkisp_priv *, unsigned char *, int);
-static int rkisp_get_histogram(struct rkisp_priv *, int *, int);
+static void rkisp_read_3a_snapshot(struct rkisp_priv *priv, struct rkisp_3a_snapshot &snapshot);
 
 static int rkisp_get_fmt(const struct rkisp_api_ctx *ctx);
 
@@ -994,13 +1031,23 @@ rkisp_get_frame(const struct rkisp_api_ctx *ctx, int timeout_ms)
     buffer->pul.sequence = buf.sequence;
 
     if (priv->ctx.uselocal3A && priv->rkisp_engine) {
-        rkisp_get_ae_time(priv, buffer->pul.metadata.expo_time);
-        rkisp_get_ae_gain(priv, buffer->pul.metadata.gain);
-        rkisp_get_meta_frame_id(priv, buffer->pul.metadata.frame_id);
-        buffer->pul.metadata.luminance_grid_count = rkisp_get_luminance_grid(priv,
-           buffer->pul.metadata.luminance_grid, RKISP_MAX_LUMINANCE_GRID);
-        buffer->pul.metadata.hist_bins_count = rkisp_get_histogram(priv,
-           buffer->pul.metadata.hist_bins, RKISP_MAX_HISTOGRAM_BIN);
+        struct rkisp_3a_snapshot snapshot;
+
+        rkisp_read_3a_snapshot(priv, snapshot);
+        if (snapshot.valid & RKISP_SNAPSHOT_EXPO_TIME)
+            buffer->pul.metadata.expo_time = snapshot.expo_time;
+        if (snapshot.valid & RKISP_SNAPSHOT_GAIN)
+            buffer->pul.metadata.gain = snapshot.gain;
+        buffer->pul.metadata.frame_id =
+            (snapshot.valid & RKISP_SNAPSHOT_FRAME_ID) ? snapshot.frame_id : -1;
+        buffer->pul.metadata.luminance_grid_count = snapshot.luminance_grid_count;
+        if (snapshot.luminance_grid_count > 0)
+            memcpy(buffer->pul.metadata.luminance_grid, snapshot.luminance_grid,
+                   snapshot.luminance_grid_count);
+        buffer->pul.metadata.hist_bins_count = snapshot.hist_bins_count;
+        if (snapshot.hist_bins_count > 0)
+            memcpy(buffer->pul.metadata.hist_bins, snapshot.hist_bins,
+                   sizeof(int) * snapshot.hist_bins_count);
     }
 
     return (struct rkisp_api_buf*)buffer;
@@ -1097,144 +1144,109 @@ static void construct_default_metas(CameraMetadata* metas)
 }
 
 static void
-rkisp_metadata_result_cb(const struct cl_result_callback_ops *ops,
-                         struct rkisp_cl_frame_metadata_s *result)
+rkisp_fill_3a_snapshot(const camera_metadata_t *metas, struct rkisp_3a_snapshot &snapshot)
 {
-    struct control_params_3A* ctl_params = (struct control_params_3A*)ops;
-
-    SmartLock lock(ctl_params->_meta_mutex);
-    /* this will clone results to _result_metadata */
-    ctl_params->_result_metadata = result->metas;
-}
-
-static int rkisp_get_meta_frame_id(struct rkisp_priv *priv, int64_t& frame_id) {
-    struct control_params_3A* ctl_params = priv->g_3A_control_params;
-    camera_metadata_entry entry;
+    camera_metadata_ro_entry entry, count;
 
-    SmartLock lock(ctl_params->_meta_mutex);
+    snapshot.valid = 0;
+    snapshot.luminance_grid_count = -1;
+    snapshot.hist_bins_count = -1;
 
-    entry = ctl_params->_result_metadata.find(RKCAMERA3_PRIVATEDATA_EFFECTIVE_DRIVER_FRAME_ID);
-    if (!entry.count) {
-        DBG("no RKCAMERA3_PRIVATEDATA_EFFECTIVE_DRIVER_FRAME_ID, %lu\n", entry.count);
-        frame_id = -1;
-        return -1;
+    if (!find_camera_metadata_ro_entry(metas, ANDROID_SENSOR_EXPOSURE_TIME, &entry) &&
+        entry.count) {
+        snapshot.expo_time = entry.data.i64[0];
+        snapshot.valid |= RKISP_SNAPSHOT_EXPO_TIME;
     }
-    frame_id = entry.data.i64[0];
-
-    return 0;
-}
-
-/* time in ns */
-static int rkisp_get_ae_time(struct rkisp_priv *priv, int64_t &time)
-{
-    struct control_params_3A* ctl_params = priv->g_3A_control_params;
-    camera_metadata_entry entry;
-
-    SmartLock lock(ctl_params->_meta_mutex);
-
-    entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_EXPOSURE_TIME);
-    if (!entry.count)
-        return -1;
-
-    time = entry.data.i64[0];
-
-    return 0;
-}
-
-static int rkisp_getAeMaxExposureTime(struct rkisp_priv *priv, int64_t &time)
-{
-    struct control_params_3A* ctl_params = priv->g_3A_control_params;
-    camera_metadata_entry entry;
-
-    SmartLock lock(ctl_params->_meta_mutex);
-
-    entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_INFO_EXPOSURE_TIME_RANGE);
-    if (entry.count != 2)
-        return -1;
-
-    time = entry.data.i64[1];
-
-    return 0;
-}
-
-static int rkisp_get_ae_gain(struct rkisp_priv *priv, int &gain)
-{
-    struct control_params_3A* ctl_params = priv->g_3A_control_params;
-    camera_metadata_entry entry;
-
-    SmartLock lock(ctl_params->_meta_mutex);
-
-    entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_SENSITIVITY);
-    if (!entry.count)
-        return -1;
-
-    gain = entry.data.i32[0];
 
-    return 0;
-}
+    if (!find_camera_metadata_ro_entry(metas, ANDROID_SENSOR_SENSITIVITY, &entry) &&
+        entry.count) {
+        snapshot.gain = entry.data.i32[0];
+        snapshot.valid |= RKISP_SNAPSHOT_GAIN;
+    }
 
-static int rkisp_getAeMaxExposureGain(struct rkisp_priv *priv, int &gain)
-{
-    struct control_params_3A* ctl_params = priv->g_3A_control_params;
-    camera_metadata_entry entry;
+    if (!find_camera_metadata_ro_entry(metas, RKCAMERA3_PRIVATEDATA_EFFECTIVE_DRIVER_FRAME_ID, &entry) &&
+        entry.count) {
+        snapshot.frame_id = entry.data.i64[0];
+        snapshot.valid |= RKISP_SNAPSHOT_FRAME_ID;
+    }
 
-    SmartLock lock(ctl_params->_meta_mutex);
+    if (!find_camera_metadata_ro_entry(metas, ANDROID_SENSOR_INFO_EXPOSURE_TIME_RANGE, &entry) &&
+        entry.count == 2) {
+        snapshot.max_expo_time = entry.data.i64[1];
+        snapshot.valid |= RKISP_SNAPSHOT_MAX_EXPO_TIME;
+    }
 
-    entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_INFO_SENSITIVITY_RANGE);
-    if (!entry.count)
-        return -1;
+    if (!find_camera_metadata_ro_entry(metas, ANDROID_SENSOR_INFO_SENSITIVITY_RANGE, &entry) &&
+        entry.count == 2) {
+        snapshot.max_gain = entry.data.i32[1];
+        snapshot.valid |= RKISP_SNAPSHOT_MAX_GAIN;
+    }
 
-    gain = entry.data.i32[1];
+    if (!find_camera_metadata_ro_entry(metas, RKCAMERA3_PRIVATEDATA_EXP_MEANS_COUNT, &count) &&
+        !find_camera_metadata_ro_entry(metas, RKCAMERA3_PRIVATEDATA_EXP_MEANS, &entry) &&
+        count.count && entry.count) {
+        if (count.data.i32[0] > RKISP_MAX_LUMINANCE_GRID || (size_t)count.data.i32[0] > entry.count) {
+            ERR("size of array [%d] < target size [%d]\n",
+                RKISP_MAX_LUMINANCE_GRID, count.data.i32[0]);
+        } else {
+            memcpy(snapshot.luminance_grid, entry.data.u8, count.data.i32[0]);
+            snapshot.luminance_grid_count = count.data.i32[0];
+        }
+    }
 
-    return 0;
+    if (!find_camera_metadata_ro_entry(metas, ANDROID_STATISTICS_INFO_MAX_HISTOGRAM_COUNT, &count) &&
+        !find_camera_metadata_ro_entry(metas, ANDROID_STATISTICS_HISTOGRAM, &entry) &&
+        count.count && entry.count) {
+        if (count.data.i32[0] > RKISP_MAX_HISTOGRAM_BIN || (size_t)count.data.i32[0] > entry.count) {
+            ERR("size of array [%d] < target size [%d]\n",
+                RKISP_MAX_HISTOGRAM_BIN, count.data.i32[0]);
+        } else {
+            memcpy(snapshot.hist_bins, entry.data.i32, sizeof(int) * count.data.i32[0]);
+            snapshot.hist_bins_count = count.data.i32[0];
+        }
+    }
 }
 
-static int rkisp_get_histogram(struct rkisp_priv *priv, int *hist, int size)
+static void
+rkisp_metadata_result_cb(const struct cl_result_callback_ops *ops,
+                         struct rkisp_cl_frame_metadata_s *result)
 {
-    struct control_params_3A* ctl_params = priv->g_3A_control_params;
-    camera_metadata_entry entry, count;
-
-    SmartLock lock(ctl_params->_meta_mutex);
+    struct control_params_3A* ctl_params = (struct control_params_3A*)ops;
+    uint32_t seq = ctl_params->_snapshot_seq.load(std::memory_order_relaxed);
 
-    count = ctl_params->_result_metadata.find(ANDROID_STATISTICS_INFO_MAX_HISTOGRAM_COUNT);
-    entry = ctl_params->_result_metadata.find(ANDROID_STATISTICS_HISTOGRAM);
-    if (!entry.count || !count.count)
-        return -1;
+    /* the only writer, readers see an odd sequence while this runs */
+    ctl_params->_snapshot_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    rkisp_fill_3a_snapshot(result->metas, ctl_params->_snapshot);
+    ctl_params->_snapshot_seq.store(seq + 2, std::memory_order_release);
 
-    if (count.data.i32[0] > size) {
-        ERR("size of array [%d] < target size [%d]\n", size, count.data.i32[0]);
-        return -1;
+    if (ctl_params->_keep_result_metadata.load(std::memory_order_relaxed)) {
+        SmartLock lock(ctl_params->_meta_mutex);
+        /* this will clone results to _result_metadata */
+        ctl_params->_result_metadata = result->metas;
     }
-
-    memcpy(hist, entry.data.i32, sizeof(int) * count.data.i32[0]);
-
-    return count.data.i32[0];
 }
 
-static int
-rkisp_get_luminance_grid(struct rkisp_priv *priv, unsigned char *luma, int size)
+static void
+rkisp_read_3a_snapshot(struct rkisp_priv *priv, struct rkisp_3a_snapshot &snapshot)
 {
     struct control_params_3A* ctl_params = priv->g_3A_control_params;
-    camera_metadata_entry entry, count;
-
-    SmartLock lock(ctl_params->_meta_mutex);
-
-    count = ctl_params->_result_metadata.find(RKCAMERA3_PRIVATEDATA_EXP_MEANS_COUNT);
-    entry = ctl_params->_result_metadata.find(RKCAMERA3_PRIVATEDATA_EXP_MEANS);
-    if (!entry.count || !count.count)
-        return -1;
-
-    if (count.data.i32[0] > size) {
-        ERR("size of array [%d] < target size [%d]\n", size, count.data.i32[0]);
-        return -1;
-    }
-
-    memcpy(luma, entry.data.u8, sizeof(entry.data.u8[0]) * count.data.i32[0]);
+    uint32_t begin, end;
 
-    return count.data.i32[0];
+    do {
+        begin = ctl_params->_snapshot_seq.load(std::memory_order_acquire);
+        if (begin & 1) {
+            sched_yield();
+            continue;
+        }
+        memcpy(&snapshot, &ctl_params->_snapshot, sizeof(snapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        end = ctl_params->_snapshot_seq.load(std::memory_order_relaxed);
+        if (begin == end)
+            break;
+    } while (1);
 }
 
-
 static int init_3A_control_params(struct rkisp_priv *priv)
 {
     priv->meta = allocate_camera_metadata(DEFAULT_ENTRY_CAP, DEFAULT_DATA_CAP);
@@ -1426,20 +1438,20 @@ rkisp_set_manual_expo(const struct rkisp_api_ctx *ctx, int on)
 
     ctl_params = priv->g_3A_control_params;
     if (on) {
-        camera_metadata_entry entry;
+        struct rkisp_3a_snapshot snapshot;
+        int32_t sensitivity;
 
         ae_mode = ANDROID_CONTROL_AE_MODE_OFF;
-        SmartLock lock(ctl_params->_meta_mutex);
+        rkisp_read_3a_snapshot(priv, snapshot);
 
-        entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_EXPOSURE_TIME);
-        if (!entry.count)
+        if (!(snapshot.valid & RKISP_SNAPSHOT_EXPO_TIME))
             return -1;
-        ctl_params->_settings_metadata.update(ANDROID_SENSOR_EXPOSURE_TIME, entry.data.i64, 1);
+        ctl_params->_settings_metadata.update(ANDROID_SENSOR_EXPOSURE_TIME, &snapshot.expo_time, 1);
 
-        entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_SENSITIVITY);
-        if (!entry.count)
+        if (!(snapshot.valid & RKISP_SNAPSHOT_GAIN))
             return -1;
-        ctl_params->_settings_metadata.update(ANDROID_SENSOR_SENSITIVITY, entry.data.i32, 1);
+        sensitivity = snapshot.gain;
+        ctl_params->_settings_metadata.update(ANDROID_SENSOR_SENSITIVITY, &sensitivity, 1);
 
         ctl_params->_settings_metadata.update(ANDROID_CONTROL_AE_MODE, &ae_mode, 1);
     } else {
@@ -1519,8 +1531,7 @@ int
 rkisp_get_max_expotime(const struct rkisp_api_ctx *ctx, int64_t *max_expo_time)
 {
     struct rkisp_priv *priv = (struct rkisp_priv *) ctx;
-    struct control_params_3A* ctl_params;
-    camera_metadata_entry entry;
+    struct rkisp_3a_snapshot snapshot;
 
     if (NULL == ctx) {
         ERR("ctx is %p, abort\n", ctx);
@@ -1530,13 +1541,11 @@ rkisp_get_max_expotime(const struct rkisp_api_ctx *ctx, int64_t *max_expo_time)
     if (!priv->ctx.uselocal3A || !priv->rkisp_engine)
         return -EINVAL;
 
-    SmartLock lock(ctl_params->_meta_mutex);
-
-    entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_INFO_EXPOSURE_TIME_RANGE);
-    if (entry.count != 2)
+    rkisp_read_3a_snapshot(priv, snapshot);
+    if (!(snapshot.valid & RKISP_SNAPSHOT_MAX_EXPO_TIME))
         return -1;
 
-    *max_expo_time = entry.data.i64[1];
+    *max_expo_time = snapshot.max_expo_time;
 
     return 0;
 }
@@ -1576,8 +1585,7 @@ int
 rkisp_get_max_gain(const struct rkisp_api_ctx *ctx, int *max_gain)
 {
     struct rkisp_priv *priv = (struct rkisp_priv *) ctx;
-    struct control_params_3A* ctl_params;
-    camera_metadata_entry entry;
+    struct rkisp_3a_snapshot snapshot;
 
     if (NULL == ctx) {
         ERR("ctx is %p, abort\n", ctx);
@@ -1587,17 +1595,43 @@ rkisp_get_max_gain(const struct rkisp_api_ctx *ctx, int *max_gain)
     if (!priv->ctx.uselocal3A || !priv->rkisp_engine)
         return -EINVAL;
 
-    SmartLock lock(ctl_params->_meta_mutex);
-
-    entry = ctl_params->_result_metadata.find(ANDROID_SENSOR_INFO_SENSITIVITY_RANGE);
-    if (!entry.count)
+    rkisp_read_3a_snapshot(priv, snapshot);
+    if (!(snapshot.valid & RKISP_SNAPSHOT_MAX_GAIN))
         return -1;
 
-    *max_gain = entry.data.i32[1];
+    *max_gain = snapshot.max_gain;
 
     return 0;
 }
 
+int
+rkisp_get_result_metadata(const struct rkisp_api_ctx *ctx, struct camera_metadata **metas)
+{
+    struct rkisp_priv *priv = (struct rkisp_priv *) ctx;
+    struct control_params_3A* ctl_params;
+
+    if (NULL == ctx || NULL == metas) {
+        ERR("ctx is %p, metas is %p, abort\n", ctx, metas);
+        return -EINVAL;
+    }
+
+    if (!priv->ctx.uselocal3A || !priv->rkisp_engine)
+        return -EINVAL;
+
+    ctl_params = priv->g_3A_control_params;
+    ctl_params->_keep_result_metadata.store(true, std::memory_order_relaxed);
+
+    SmartLock lock(ctl_params->_meta_mutex);
+    if (ctl_params->_result_metadata.isEmpty())
+        return -EAGAIN;
+
+    const camera_metadata_t *result = ctl_params->_result_metadata.getAndLock();
+    *metas = clone_camera_metadata(result);
+    ctl_params->_result_metadata.unlock(result);
+
+    return *metas ? 0 : -ENOMEM;
+}
+
 int
 rkisp_get_expo_weights(const struct rkisp_api_ctx *ctx,
                        unsigned char* weights, unsigned int size)
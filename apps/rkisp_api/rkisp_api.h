@@ -265,6 +265,21 @@ rkisp_set_max_gain(const struct rkisp_api_ctx *ctx, int max_gain);
 int
 rkisp_get_max_gain(const struct rkisp_api_ctx *ctx, int *max_gain);
 
+struct camera_metadata;
+
+/*
+ * Get a copy of the full 3A result metadata of the latest frame. The
+ * results rkisp_get_frame() reports come from a compact per-frame copy,
+ * the full metadata is only kept after the first call of this, which
+ * returns -EAGAIN until a frame arrived.
+ *
+ * @metas:          The copy, release it with free_camera_metadata().
+ *
+ * Return 0 if success, or < 0 if error.
+ */
+int
+rkisp_get_result_metadata(const struct rkisp_api_ctx *ctx, struct camera_metadata **metas);
+
 
 /*
  * The get/set_expo_weights() will get or set exposure weights
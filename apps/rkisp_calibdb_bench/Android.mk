@@ -0,0 +1,39 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES = rkisp_calibdb_bench.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../xcore \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/calib_xml/include \
+
+ifeq ($(IS_NEED_COMPILE_TINYXML2), true)
+LOCAL_C_INCLUDES += \
+	$(LOCAL_PATH)/../../ext/tinyxml2
+else
+LOCAL_C_INCLUDES += \
+	external/tinyxml2
+endif
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+ifeq (1,$(strip $(shell expr $(PLATFORM_SDK_VERSION) \>= 26)))
+LOCAL_PROPRIETARY_MODULE := true
+endif
+endif
+
+# the dom baseline loads the files with tinyxml2 directly
+LOCAL_STATIC_LIBRARIES += libtinyxml2
+LOCAL_SHARED_LIBRARIES += librkisp
+
+LOCAL_MODULE:= rkisp_calibdb_bench
+
+include $(BUILD_EXECUTABLE)
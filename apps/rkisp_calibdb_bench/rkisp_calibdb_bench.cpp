@@ -0,0 +1,166 @@
+/*
+ * Times parsing the IQ xml files into the calibration database and the
+ * peak memory it takes, next to loading the same files as a tinyxml2 dom.
+ *
+ *   rkisp_calibdb_bench [-n loops] iqfiles/*.xml
+ *
+ * Every measurement runs in a child of its own, so the peak resident set
+ * of one does not hide the next. The time is the best of the loops, the
+ * peak is the growth of the resident set over the first one.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <calib_xml/calibdb.h>
+#include <tinyxml2.h>
+
+#define ERR(...) do { fprintf(stderr, "ERR: " __VA_ARGS__); } while (0)
+
+struct bench_result {
+    int ok;
+    double ms;
+    long peak_kb;
+};
+
+static double now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static long max_rss_kb()
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [options] xml...\n"
+           "  -n, --loops n      parses timed per file, default 10\n",
+           name);
+}
+
+/* what the engine does at start up, a single streaming pass */
+static bool parse_stream(const char *xml)
+{
+    CalibDb db;
+    return db.CreateCalibDb(xml);
+}
+
+/* the tree the parse used to be walked on, without walking it */
+static bool load_dom(const char *xml)
+{
+    tinyxml2::XMLDocument doc;
+    return doc.LoadFile(xml) == tinyxml2::XML_SUCCESS;
+}
+
+static bool measure(bool (*run)(const char *), const char *xml, int loops, bench_result *res)
+{
+    int fds[2];
+    pid_t pid;
+    ssize_t len;
+
+    if (pipe(fds) < 0)
+        return false;
+
+    pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        bench_result r;
+        long base = max_rss_kb();
+
+        close(fds[0]);
+        r.ok = run(xml);
+        r.peak_kb = max_rss_kb() - base;
+        r.ms = 0;
+        for (int i = 0; i < loops && r.ok; i++) {
+            double start = now_ms();
+            r.ok = run(xml);
+            double ms = now_ms() - start;
+            if (i == 0 || ms < r.ms)
+                r.ms = ms;
+        }
+        len = write(fds[1], &r, sizeof(r));
+        _exit(len == sizeof(r) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    len = read(fds[0], res, sizeof(*res));
+    close(fds[0]);
+    waitpid(pid, NULL, 0);
+    return len == sizeof(*res) && res->ok;
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"loops", required_argument, 0, 'n'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    double stream_total = 0, dom_total = 0;
+    long stream_peak = 0, dom_peak = 0;
+    int loops = 10, failed = 0, c;
+
+    while ((c = getopt_long(argc, argv, "n:h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'n':
+            loops = atoi(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return c == 'h' ? 0 : 1;
+        }
+    }
+
+    if (optind == argc || loops < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* parse the xml itself, not a map or dump of an earlier run */
+    unsetenv("CAMERA_ENGINE_RKISP_XML_DB");
+
+    for (int i = optind; i < argc; i++) {
+        const char *xml = argv[i];
+        bench_result stream, dom;
+
+        if (!measure(parse_stream, xml, loops, &stream)) {
+            ERR("%s: parsing failed\n", xml);
+            failed++;
+            continue;
+        }
+        if (!measure(load_dom, xml, loops, &dom)) {
+            ERR("%s: loading the dom failed\n", xml);
+            failed++;
+            continue;
+        }
+
+        printf("%-48s parse %8.3f ms %6ld KB  dom load %8.3f ms %6ld KB\n",
+               strrchr(xml, '/') ? strrchr(xml, '/') + 1 : xml,
+               stream.ms, stream.peak_kb, dom.ms, dom.peak_kb);
+        stream_total += stream.ms;
+        dom_total += dom.ms;
+        stream_peak = stream.peak_kb > stream_peak ? stream.peak_kb : stream_peak;
+        dom_peak = dom.peak_kb > dom_peak ? dom.peak_kb : dom_peak;
+    }
+
+    printf("%d files  parse %.3f ms max %ld KB  dom load %.3f ms max %ld KB\n",
+           argc - optind - failed, stream_total, stream_peak, dom_total, dom_peak);
+
+    return failed ? 1 : 0;
+}
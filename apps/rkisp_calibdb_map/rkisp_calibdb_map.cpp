@@ -0,0 +1,185 @@
+/*
+ * Generates the memory mappable calibration database of IQ xml files and
+ * compares the time to open it with parsing the xml.
+ *
+ *   rkisp_calibdb_map -o /data/iqdb [-n loops] [-b] iqfiles/*.xml
+ *
+ * The files are written to the output directory, the one the engine reads
+ * them from through CAMERA_ENGINE_RKISP_XML_DB. Run it on the target, the
+ * files are specific to its ABI. With -b the summary gives the startup
+ * time of all the files and the range of the per file speedup.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <vector>
+
+#include <calib_xml/calibdb.h>
+
+#define ERR(...) do { fprintf(stderr, "ERR: " __VA_ARGS__); } while (0)
+
+static const char *db_dir;
+
+static double now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s -o dir [options] xml...\n"
+           "  -o, --output dir   where to write the map files\n"
+           "  -n, --loops n      opens timed per file, default 10\n"
+           "  -b, --bench        also time xml parsing and mapping\n",
+           name);
+}
+
+static bool read_file(const char *path, std::vector<char> &data)
+{
+    FILE *fp = fopen(path, "rb");
+    long size;
+
+    if (!fp)
+        return false;
+    fseek(fp, 0L, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0L, SEEK_SET);
+    data.resize(size);
+    size = fread(data.data(), 1, size, fp);
+    fclose(fp);
+    return size == (long)data.size();
+}
+
+/*
+ * a map generated from the mapped database has to come out identical,
+ * that covers every list and array the dump format knows
+ */
+static bool check_round_trip(CamCalibDbHandle_t mapped, const char *xml, uint32_t magic,
+                             const char *map_file)
+{
+    std::vector<char> generated, regenerated;
+
+    return read_file(map_file, generated) &&
+           CamCalibDbGenerateMapFile(mapped, xml, magic) == RET_SUCCESS &&
+           read_file(map_file, regenerated) && generated == regenerated;
+}
+
+static int process(const char *xml, int loops, bool bench, double *xml_total, double *map_total,
+                   double *min_ratio, double *max_ratio)
+{
+    CamCalibDbHandle_t handle = NULL;
+    double start, xml_ms = 0, map_ms = 0;
+    char map_file[256];
+    struct stat st;
+    double ratio;
+
+    /* parse without the map directory, the db would map a previous file */
+    unsetenv("CAMERA_ENGINE_RKISP_XML_DB");
+    start = now_ms();
+    for (int i = 0; i < (bench ? loops : 1); i++) {
+        CalibDb db;
+        if (!db.CreateCalibDb(xml)) {
+            ERR("%s: parsing failed\n", xml);
+            return -1;
+        }
+    }
+    xml_ms = (now_ms() - start) / (bench ? loops : 1);
+
+    CalibDb db;
+    uint32_t magic = db.GetCalibDbInfo()->IQMagicVerCode;
+    db.CreateCalibDb(xml);
+    setenv("CAMERA_ENGINE_RKISP_XML_DB", db_dir, 1);
+    if (CamCalibDbGenerateMapFile(db.GetCalibDbHandle(), xml, magic) != RET_SUCCESS) {
+        ERR("%s: generating the map failed\n", xml);
+        return -1;
+    }
+
+    start = now_ms();
+    for (int i = 0; i < loops; i++) {
+        if (CamCalibDbMapFile(&handle, xml, magic) != RET_SUCCESS) {
+            ERR("%s: mapping failed\n", xml);
+            return -1;
+        }
+        if (i < loops - 1)
+            CamCalibDbRelease(&handle);
+    }
+    map_ms = (now_ms() - start) / loops;
+
+    snprintf(map_file, sizeof(map_file), "%s/%s.map", db_dir,
+             strrchr(xml, '/') ? strrchr(xml, '/') + 1 : xml);
+    if (!check_round_trip(handle, xml, magic, map_file)) {
+        ERR("%s: mapped database differs\n", xml);
+        CamCalibDbRelease(&handle);
+        return -1;
+    }
+    CamCalibDbRelease(&handle);
+    stat(map_file, &st);
+    if (bench)
+        printf("%-48s %8ld bytes  xml %8.3f ms  map %8.3f ms  x%.0f\n",
+               map_file, (long)st.st_size, xml_ms, map_ms, xml_ms / map_ms);
+    else
+        printf("%-48s %8ld bytes\n", map_file, (long)st.st_size);
+
+    ratio = map_ms > 0 ? xml_ms / map_ms : 0;
+    if (!*min_ratio || ratio < *min_ratio)
+        *min_ratio = ratio;
+    if (ratio > *max_ratio)
+        *max_ratio = ratio;
+    *xml_total += xml_ms;
+    *map_total += map_ms;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"output", required_argument, 0, 'o'},
+        {"loops", required_argument, 0, 'n'},
+        {"bench", no_argument, 0, 'b'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    double xml_total = 0, map_total = 0, min_ratio = 0, max_ratio = 0;
+    int loops = 10, failed = 0, c;
+    bool bench = false;
+
+    while ((c = getopt_long(argc, argv, "o:n:bh", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'o':
+            db_dir = optarg;
+            break;
+        case 'n':
+            loops = atoi(optarg);
+            break;
+        case 'b':
+            bench = true;
+            break;
+        default:
+            usage(argv[0]);
+            return c == 'h' ? 0 : 1;
+        }
+    }
+
+    if (!db_dir || optind == argc || loops < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    for (int i = optind; i < argc; i++)
+        failed += process(argv[i], loops, bench, &xml_total, &map_total,
+                          &min_ratio, &max_ratio) ? 1 : 0;
+
+    if (bench && map_total > 0)
+        printf("%d files  xml %.3f ms  map %.3f ms  x%.0f, x%.0f-x%.0f per file\n",
+               argc - optind - failed, xml_total, map_total, xml_total / map_total,
+               min_ratio, max_ratio);
+    if (failed)
+        printf("%d of %d files failed\n", failed, argc - optind);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,28 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES = rkisp_smartptr_bench.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -O2 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX -DXCAM_REFCOUNT_STATS
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../xcore \
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+ifeq (1,$(strip $(shell expr $(PLATFORM_SDK_VERSION) \>= 26)))
+LOCAL_PROPRIETARY_MODULE := true
+endif
+endif
+
+# SafeList and SafeRing log through xcam_log
+LOCAL_SHARED_LIBRARIES += librkisp
+
+LOCAL_MODULE:= rkisp_smartptr_bench
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,393 @@
+/*
+ * Counts and times the SmartPtr reference handling of the per-frame paths,
+ * copying against moving or borrowing, in one build:
+ *
+ *   rkisp_smartptr_bench [-n iterations] [-r runs] [-t threads]
+ *
+ *   pipeline  one frame from the poll thread through the analyzer to the
+ *             isp params, the hand-offs as they were before SmartPtr could
+ *             move or borrow against the ones in the tree now
+ *   queue     stats handed through a SafeRing, the producer keeping its
+ *             reference and pushing a copy, or moving it in and out
+ *   callback  stats passed down a chain of callbacks by value, or by
+ *             const reference and BorrowedPtr
+ *   downcast  dynamic_cast_ptr against dynamic_cast_borrow
+ *
+ * It is built with XCAM_REFCOUNT_STATS and reports the atomic refcount
+ * operations per iteration, a frame for the pipeline. The counter adds an
+ * atomic of its own to every operation, so the times exaggerate the gap.
+ * The pipeline time is mostly the timed wait of the results thread's last,
+ * empty pop, its count is what to compare.
+ *
+ * With more than one thread all of them work on the same object, so its
+ * refcount is contended the way it is between the poll, analyzer and
+ * result threads. The time is the best of the runs per iteration.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <list>
+
+#include <base/xcam_common.h>
+#include <smartptr.h>
+#include <safe_list.h>
+#include <safe_ring.h>
+
+#ifndef XCAM_REFCOUNT_STATS
+#error "rkisp_smartptr_bench counts refcount operations, build it with -DXCAM_REFCOUNT_STATS"
+#endif
+
+using namespace XCam;
+
+#define CALLBACK_DEPTH 4
+// exposure, focus and isp params, what rkiq hands over every frame
+#define PIPELINE_RESULTS 3
+// X3aResultsProcessThread drains its queue with no wait
+#define PIPELINE_TIMEOUT 0
+
+class BenchBuffer {
+public:
+    BenchBuffer () : sequence (0) {}
+    virtual ~BenchBuffer () {}
+    uint32_t sequence;
+};
+
+class BenchStats : public BenchBuffer {
+public:
+    BenchStats () : exposure (0) {}
+    uint32_t exposure;
+};
+
+class BenchResult {
+public:
+    explicit BenchResult (uint32_t type) : type (type) {}
+    virtual ~BenchResult () {}
+    uint32_t type;
+};
+
+class BenchIspResult : public BenchResult {
+public:
+    explicit BenchIspResult (uint32_t type) : BenchResult (type), value (type + 1) {}
+    uint32_t value;
+};
+
+typedef std::list<SmartPtr<BenchResult>> BenchResultList;
+
+enum BenchMode {
+    BENCH_COPY = 0,
+    BENCH_MOVE,
+};
+
+struct bench_case {
+    const char *name;
+    uint32_t (*run) (const SmartPtr<BenchBuffer> &, uint32_t, BenchMode);
+};
+
+struct bench_thread {
+    const bench_case *test;
+    SmartPtr<BenchBuffer> *shared;
+    uint32_t iterations;
+    BenchMode mode;
+    pthread_barrier_t *barrier;
+    double ns;
+    uint32_t sum;
+};
+
+struct bench_result {
+    double ns;
+    double ops;
+};
+
+static double now_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * SafeList::pop before it moved: the front copied out, then erased from the
+ * list, waiting as pop does when it is empty. Bind the result to a const
+ * reference to get the copy assignment SmartPtr had before it could move.
+ */
+template<class Obj>
+static SmartPtr<Obj>
+baseline_pop (SafeList<Obj> &list, int32_t timeout)
+{
+    SmartPtr<Obj> obj = list.front ();
+    if (!obj.ptr ())
+        return list.pop (timeout);
+    list.erase (obj);
+    return obj;
+}
+
+/*
+ * One frame through the same steps as PollThread, AnalyzerThread,
+ * X3aResultsProcessThread and IspImageProcessor, the threads run one
+ * after another. BENCH_COPY is the code before SmartPtr could move or
+ * borrow, BENCH_MOVE the code in the tree. The steps which are the same
+ * in both, the const reference callback chains, the result debug loop of
+ * AnalyzerCallback, are kept so the count is the whole frame.
+ */
+static uint32_t
+run_pipeline (const SmartPtr<BenchBuffer> &shared, uint32_t iterations, BenchMode mode)
+{
+    SafeList<BenchBuffer> stats_queue;
+    SafeList<BenchResult> result_queue;
+    uint32_t sum = shared->sequence;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        // poll thread: a stats buffer from the pool, down the StatsCallback
+        // chain by const reference, AnalyzerThread::push_stats copies it in
+        {
+            SmartPtr<BenchBuffer> buf = new BenchStats;
+            stats_queue.push (buf);
+        }
+
+        // analyzer thread: pop, X3aStats::get_stats downcasts the data
+        SmartPtr<BenchBuffer> stats;
+        if (mode == BENCH_COPY) {
+            stats = static_cast<const SmartPtr<BenchBuffer> &> (baseline_pop (stats_queue, -1));
+            SmartPtr<BenchBuffer> data = stats;
+            SmartPtr<BenchStats> isp_stats = data.dynamic_cast_ptr<BenchStats> ();
+            sum += isp_stats->exposure;
+        } else {
+            stats = stats_queue.pop (-1);
+            BorrowedPtr<BenchStats> isp_stats = stats.dynamic_cast_borrow<BenchStats> ();
+            sum += isp_stats->exposure;
+        }
+
+        // the analyzer's results, AnalyzerCallback::x3a_calculation_done
+        // copies each for its debug log, push_3a_results queues a copy
+        {
+            BenchResultList calculated;
+            for (uint32_t r = 0; r < PIPELINE_RESULTS; r++)
+                calculated.push_back (new BenchIspResult (r));
+            for (BenchResultList::iterator it = calculated.begin (); it != calculated.end (); ++it) {
+                SmartPtr<BenchResult> res = *it;
+                sum += res->type;
+            }
+            for (BenchResultList::iterator it = calculated.begin (); it != calculated.end (); ++it)
+                result_queue.push (*it);
+        }
+        stats.release ();
+
+        // results thread: drain the queue, filter_valid_results, apply
+        BenchResultList result_list, valid_results;
+        SmartPtr<BenchResult> result;
+        if (mode == BENCH_COPY) {
+            result = static_cast<const SmartPtr<BenchResult> &> (baseline_pop (result_queue, PIPELINE_TIMEOUT));
+            result_list.push_back (result);
+            while ((result = static_cast<const SmartPtr<BenchResult> &> (baseline_pop (result_queue, PIPELINE_TIMEOUT))).ptr ())
+                result_list.push_back (result);
+
+            for (BenchResultList::iterator it = result_list.begin (); it != result_list.end (); ) {
+                valid_results.push_back (*it);
+                result_list.erase (it++);
+            }
+            for (BenchResultList::iterator it = valid_results.begin (); it != valid_results.end (); ) {
+                SmartPtr<BenchIspResult> res = (*it).dynamic_cast_ptr<BenchIspResult> ();
+                sum += res->value;
+                valid_results.erase (it++);
+            }
+        } else {
+            result = result_queue.pop (PIPELINE_TIMEOUT);
+            result_list.push_back (std::move (result));
+            while ((result = result_queue.pop (PIPELINE_TIMEOUT)).ptr ())
+                result_list.push_back (std::move (result));
+
+            for (BenchResultList::iterator it = result_list.begin (); it != result_list.end (); )
+                valid_results.splice (valid_results.end (), result_list, it++);
+            for (BenchResultList::iterator it = valid_results.begin (); it != valid_results.end (); ) {
+                BorrowedPtr<BenchIspResult> res = (*it).dynamic_cast_borrow<BenchIspResult> ();
+                sum += res->value;
+                valid_results.erase (it++);
+            }
+        }
+    }
+    return sum;
+}
+
+static uint32_t
+run_queue (const SmartPtr<BenchBuffer> &shared, uint32_t iterations, BenchMode mode)
+{
+    SafeRing<BenchBuffer> ring (4);
+    SmartPtr<BenchBuffer> held = shared;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (mode == BENCH_COPY) {
+            ring.push (held);
+            SmartPtr<BenchBuffer> out = ring.pop (0);
+            sum += out->sequence;
+        } else {
+            ring.push (std::move (held));
+            held = ring.pop (0);
+            sum += held->sequence;
+        }
+    }
+    return sum;
+}
+
+__attribute__ ((noinline)) static uint32_t
+callback_by_value (SmartPtr<BenchBuffer> buf, int depth)
+{
+    if (!depth)
+        return buf->sequence;
+    return callback_by_value (buf, depth - 1) + 1;
+}
+
+__attribute__ ((noinline)) static uint32_t
+callback_by_borrow (BorrowedPtr<BenchBuffer> buf, int depth)
+{
+    if (!depth)
+        return buf->sequence;
+    return callback_by_borrow (buf, depth - 1) + 1;
+}
+
+static uint32_t
+run_callback (const SmartPtr<BenchBuffer> &shared, uint32_t iterations, BenchMode mode)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (mode == BENCH_COPY)
+            sum += callback_by_value (shared, CALLBACK_DEPTH);
+        else
+            sum += callback_by_borrow (shared, CALLBACK_DEPTH);
+    }
+    return sum;
+}
+
+static uint32_t
+run_downcast (const SmartPtr<BenchBuffer> &shared, uint32_t iterations, BenchMode mode)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (mode == BENCH_COPY) {
+            SmartPtr<BenchStats> stats = shared.dynamic_cast_ptr<BenchStats> ();
+            sum += stats->exposure;
+        } else {
+            BorrowedPtr<BenchStats> stats = shared.dynamic_cast_borrow<BenchStats> ();
+            sum += stats->exposure;
+        }
+    }
+    return sum;
+}
+
+static const bench_case bench_cases[] = {
+    {"pipeline", run_pipeline},
+    {"queue", run_queue},
+    {"callback", run_callback},
+    {"downcast", run_downcast},
+};
+
+static void *bench_thread_loop (void *arg)
+{
+    bench_thread *t = (bench_thread *)arg;
+
+    pthread_barrier_wait (t->barrier);
+    double start = now_ns ();
+    t->sum = t->test->run (*t->shared, t->iterations, t->mode);
+    t->ns = now_ns () - start;
+    return NULL;
+}
+
+// slowest thread of one run and the refcount operations, per iteration
+static bench_result
+measure (const bench_case *test, SmartPtr<BenchBuffer> &shared,
+         uint32_t iterations, BenchMode mode, int threads)
+{
+    pthread_t ids[threads];
+    bench_thread args[threads];
+    pthread_barrier_t barrier;
+    double worst = 0;
+    uint64_t ops = xcam_refcount_ops ().load ();
+
+    pthread_barrier_init (&barrier, NULL, threads);
+    for (int i = 0; i < threads; i++) {
+        args[i].test = test;
+        args[i].shared = &shared;
+        args[i].iterations = iterations;
+        args[i].mode = mode;
+        args[i].barrier = &barrier;
+        pthread_create (&ids[i], NULL, bench_thread_loop, &args[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join (ids[i], NULL);
+        if (args[i].ns > worst)
+            worst = args[i].ns;
+    }
+    pthread_barrier_destroy (&barrier);
+    ops = xcam_refcount_ops ().load () - ops;
+
+    bench_result result = {worst / iterations, (double)ops / iterations / threads};
+    return result;
+}
+
+static void usage (const char *name)
+{
+    printf ("Usage: %s [options]\n"
+            "  -n, --iterations n  iterations per run, default 1000000\n"
+            "  -r, --runs n        runs per case, best one counts, default 5\n"
+            "  -t, --threads n     threads sharing the object, default 1\n",
+            name);
+}
+
+int main (int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"iterations", required_argument, 0, 'n'},
+        {"runs", required_argument, 0, 'r'},
+        {"threads", required_argument, 0, 't'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    int iterations = 1000000, runs = 5, threads = 1, c;
+
+    while ((c = getopt_long (argc, argv, "n:r:t:h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'n':
+            iterations = atoi (optarg);
+            break;
+        case 'r':
+            runs = atoi (optarg);
+            break;
+        case 't':
+            threads = atoi (optarg);
+            break;
+        default:
+            usage (argv[0]);
+            return c == 'h' ? 0 : 1;
+        }
+    }
+
+    if (iterations < 1 || runs < 1 || threads < 1) {
+        usage (argv[0]);
+        return 1;
+    }
+
+    SmartPtr<BenchBuffer> shared = new BenchStats;
+
+    printf ("%d iterations, best of %d runs, %d thread(s)\n", iterations, runs, threads);
+    for (size_t i = 0; i < sizeof (bench_cases) / sizeof (bench_cases[0]); i++) {
+        const bench_case *test = &bench_cases[i];
+        bench_result copy = {0, 0}, move = {0, 0};
+
+        for (int r = 0; r < runs; r++) {
+            bench_result res = measure (test, shared, iterations, BENCH_COPY, threads);
+            copy = (r == 0 || res.ns < copy.ns) ? res : copy;
+            res = measure (test, shared, iterations, BENCH_MOVE, threads);
+            move = (r == 0 || res.ns < move.ns) ? res : move;
+        }
+        printf ("%-10s copy %5.1f ops %8.2f ns  move/borrow %5.1f ops %8.2f ns  %6.2fx\n",
+                test->name, copy.ops, copy.ns, move.ops, move.ns,
+                move.ns > 0 ? copy.ns / move.ns : 0.0);
+    }
+
+    return 0;
+}
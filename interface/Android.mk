@@ -45,6 +45,7 @@ LOCAL_STATIC_LIBRARIES += \
 	libisp_cam_calibdb \
 	libisp_calibdb \
 	libtinyxml2 \
+	libexpat \
 	libisp_oslayer \
 	libisp_ebase
 
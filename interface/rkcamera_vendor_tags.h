@@ -73,6 +73,7 @@ enum rkcamera3_ext_tags {
     //RKCAMERA3_PRIVATEDATA_HIST_BINS,
     RKCAMERA3_PRIVATEDATA_EXP_MEANS,
     RKCAMERA3_PRIVATEDATA_EXP_MEANS_COUNT,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUPS,
     RKCAMERA3_PRIVATEDATA_END,
 };
 
@@ -83,6 +84,28 @@ typedef enum rkcamera3_privatemeta_enum_stillcap_sync_cmd {
     RKCAMERA3_PRIVATEDATA_STILLCAP_SYNC_CMD_SYNCEND,
 } rkcamera3_privatemeta_enum_stillcap_sync_cmd_t;
 
+// RKCAMERA3_PRIVATEDATA_TUNING_GROUPS, mask of the tuning tool result
+// groups a client subscribes to. A group is only reported on frames its
+// values changed, clients keep the last ones received.
+typedef enum rkcamera3_privatemeta_enum_tuning_group {
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_MODULE_INFO      = 1 << 0,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_SENSOR_INFO      = 1 << 1,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_PROTOCOL_INFO    = 1 << 2,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_BLS              = 1 << 3,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_LSC              = 1 << 4,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_CCM              = 1 << 5,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB              = 1 << 6,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB_WP           = 1 << 7,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB_CURV         = 1 << 8,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB_REFGAIN      = 1 << 9,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_GOC              = 1 << 10,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_CPROC            = 1 << 11,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_DPF              = 1 << 12,
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_FLT              = 1 << 13,
+    // all groups, what a bare RKCAMERA3_PRIVATEDATA_TUNING_FLAG asks for
+    RKCAMERA3_PRIVATEDATA_TUNING_GROUP_ALL              = (1 << 14) - 1,
+} rkcamera3_privatemeta_enum_tuning_group_t;
+
 class RkCamera3VendorTags {
     public:
         static void get_vendor_tag_ops(vendor_tag_ops_t* ops);
@@ -196,6 +196,19 @@ void rkisp_cl_deinit(void* cl_ctx);
 void rkisp_set_aec_weights(const unsigned char* pWeight, unsigned int cnt);
 void rkisp_get_aec_weights(unsigned char* pWeight, unsigned int *cnt);
 
+/*
+ * Dump the per-frame latency trace of the control loop, tracing has to be
+ * enabled by env persist_camera_engine_frame_trace or property
+ * persist.vendor.rkisp.frametrace.
+ * Args:
+ *    |path_prefix|: writes <path_prefix>.json in chrome trace-event format
+ *                   and <path_prefix>_hist.txt with stage latency histograms
+ * Returns:
+ *    -EINVAL: failed
+ *    0      : success
+ */
+int rkisp_cl_dump_frame_trace(const char* path_prefix);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
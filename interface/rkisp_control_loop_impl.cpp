@@ -6,6 +6,8 @@
 #include "iq/x3a_analyze_tuner.h"
 #include "x3a_analyzer_rkiq.h"
 #include "dynamic_analyzer_loader.h"
+#include "frame_tracer.h"
+#include "object_pool.h"
 
 #include "mediactl-priv.h"
 #include "mediactl.h"
@@ -267,7 +269,9 @@ int rkisp_cl_prepare(void* cl_ctx,
     stats_dev->set_capture_mode (V4L2_CAPTURE_MODE_VIDEO);
     stats_dev->set_buf_type(V4L2_BUF_TYPE_META_CAPTURE);
     stats_dev->set_mem_type (V4L2_MEMORY_MMAP);
-    stats_dev->set_buffer_count (4);
+    // zero-copy stats hold dequeued buffers during the analysis
+    stats_dev->set_buffer_count (XCam::IspController::zero_copy_stats_enabled () ?
+                                 XCAM_ZERO_COPY_STATS_BUF_COUNT : 4);
     ret = stats_dev->open ();
     if (ret == XCAM_RETURN_NO_ERROR) {
         device_manager->set_isp_stats_device (stats_dev);
@@ -372,6 +376,9 @@ int rkisp_cl_prepare(void* cl_ctx,
     cam_otp.awb.golden_b_value = camera_mod_info.awb.b_value;
     cam_otp.lsc.enable = camera_mod_info.lsc.flag;
     aiq_analyzer->setOtpInfo(cam_otp);
+    // zero-copy stats hold their buffer while queued, keep 2 for the driver
+    if (XCam::IspController::zero_copy_stats_enabled ())
+        aiq_analyzer->set_max_queued_stats (XCAM_ZERO_COPY_STATS_MAX_QUEUED);
     device_manager->set_3a_analyzer (aiq_analyzer);
 
     device_manager->set_static_metadata (prepare_params->staticMeta);
@@ -443,9 +450,19 @@ void rkisp_cl_deinit(void* cl_ctx) {
     device_manager->_cl_state = RKISP_CL_STATE_INVALID;
     delete device_manager;
     device_manager = NULL;
+    XCam::ObjectSlab::dump_all_stats ();
     LOGD("--------------------------rkisp_cl_deinit done");
 }
 
+int rkisp_cl_dump_frame_trace(const char* path_prefix)
+{
+    XCam::FrameTracer *tracer = XCam::FrameTracer::instance ();
+
+    if (!tracer->is_enabled () || !tracer->dump (path_prefix))
+        return -EINVAL;
+    return 0;
+}
+
 void rkisp_set_aec_weights(const unsigned char* pWeight, unsigned int cnt)
 {
     return CamIa10_set_aec_weights(pWeight, cnt);
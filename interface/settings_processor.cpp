@@ -1148,6 +1148,14 @@ SettingsProcessor::tuningFlagInputParams(const CameraMetadata *settings, AiqInpu
     }else{
          aiqInputParams->tuningFlag = entry.data.u8[0];
     }
+
+    entry = settings->find(RKCAMERA3_PRIVATEDATA_TUNING_GROUPS);
+    if (entry.count)
+        aiqInputParams->tuningGroups = entry.data.i32[0] & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_ALL;
+    else if (aiqInputParams->tuningFlag)
+        aiqInputParams->tuningGroups = RKCAMERA3_PRIVATEDATA_TUNING_GROUP_ALL;
+    else
+        aiqInputParams->tuningGroups = 0;
     return ret;
 }
 
@@ -6,6 +6,8 @@ LOCAL_SRC_FILES +=\
 	aiq3a_utils.cpp \
 	rkiq_handler.cpp \
 	rkisp_device.cpp \
+	converge_scheduler.cpp \
+	exposure_scheduler.cpp \
 	hybrid_analyzer.cpp \
 	hybrid_analyzer_loader.cpp \
 	isp_config_translator.cpp \
@@ -15,6 +17,7 @@ LOCAL_SRC_FILES +=\
 	sensor_descriptor.cpp \
 	x3a_analyzer_rkiq.cpp \
 	x3a_isp_config.cpp \
+	x3a_meta_result.cpp \
 	x3a_statistics_queue.cpp \
 	ae_state_machine.cpp \
 	awb_state_machine.cpp \
@@ -0,0 +1,186 @@
+/*
+ * converge_scheduler.cpp - skip 3a algorithms on static converged scenes
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "converge_scheduler.h"
+#include <stdlib.h>
+#include <limits.h>
+
+#define CONVERGE_SIGNATURE_MEAS (CIFISP_STAT_AUTOEXP | CIFISP_STAT_HIST | CIFISP_STAT_AWB)
+
+namespace XCam {
+
+ConvergeScheduler::ConvergeScheduler ()
+    : _enabled (false)
+{
+    _config.cadence = XCAM_CONVERGE_DEFAULT_CADENCE;
+    _config.max_skip = XCAM_CONVERGE_DEFAULT_MAX_SKIP;
+    _config.tolerance = XCAM_CONVERGE_DEFAULT_TOLERANCE;
+    xcam_mem_clear (_stats);
+    reset ();
+}
+
+void
+ConvergeScheduler::set_config (const ConvergeScheduleConfig &config)
+{
+    XCAM_ASSERT (config.cadence > 0 && config.max_skip >= 0 && config.tolerance >= 0);
+    _config = config;
+    reset ();
+}
+
+void
+ConvergeScheduler::set_enabled (bool enable)
+{
+    _enabled = enable;
+    reset ();
+}
+
+bool
+ConvergeScheduler::parse_config (const char *str, ConvergeScheduleConfig &config)
+{
+    ConvergeScheduleConfig parsed = config;
+    int32_t *fields[] = {&parsed.cadence, &parsed.max_skip, &parsed.tolerance};
+    const char *pos = str;
+
+    if (!str || !str[0])
+        return false;
+
+    for (uint32_t i = 0; i < sizeof (fields) / sizeof (fields[0]) && *pos; i++) {
+        char *end = NULL;
+        long value = strtol (pos, &end, 10);
+        if (end == pos || value < 0 || value > 255)
+            return false;
+        *fields[i] = value;
+        pos = end;
+        if (*pos == ',')
+            pos++;
+        else if (*pos)
+            return false;
+    }
+
+    if (parsed.cadence < 1)
+        return false;
+    config = parsed;
+    return true;
+}
+
+void
+ConvergeScheduler::compute_signature (const struct cifisp_stat_buffer *stats, StatsSignature &sig)
+{
+    xcam_mem_clear (sig);
+    if (!stats || (stats->meas_type & CONVERGE_SIGNATURE_MEAS) != CONVERGE_SIGNATURE_MEAS)
+        return;
+
+    for (uint32_t i = 0; i < CIFISP_AE_MEAN_MAX; i++)
+        sig.ae_mean[i] = stats->params.ae.exp_mean[i];
+
+    // bin shares, independent of the window size
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < CIFISP_HIST_BIN_N_MAX; i++)
+        total += stats->params.hist.hist_bins[i];
+    if (total) {
+        for (uint32_t i = 0; i < CIFISP_HIST_BIN_N_MAX; i++)
+            sig.hist[i] = XCAM_MIN ((uint64_t)stats->params.hist.hist_bins[i] * 256 / total, (uint64_t)255);
+    }
+
+#if RKISP
+    sig.awb_mean[0] = stats->params.awb.awb_mean[0].mean_y_or_g;
+    sig.awb_mean[1] = stats->params.awb.awb_mean[0].mean_cb_or_b;
+    sig.awb_mean[2] = stats->params.awb.awb_mean[0].mean_cr_or_r;
+#else
+    if (stats->params.awb.awb_mean[0].mean_y != 0) {
+        sig.awb_mean[0] = stats->params.awb.awb_mean[0].mean_y;
+        sig.awb_mean[1] = stats->params.awb.awb_mean[0].mean_cb;
+        sig.awb_mean[2] = stats->params.awb.awb_mean[0].mean_cr;
+    } else {
+        sig.awb_mean[0] = XCAM_MIN (stats->params.awb.awb_mean[0].mean_g, 255);
+        sig.awb_mean[1] = XCAM_MIN (stats->params.awb.awb_mean[0].mean_b, 255);
+        sig.awb_mean[2] = XCAM_MIN (stats->params.awb.awb_mean[0].mean_r, 255);
+    }
+#endif
+    sig.valid = true;
+}
+
+int32_t
+ConvergeScheduler::signature_distance (const StatsSignature &a, const StatsSignature &b)
+{
+    int32_t sum = 0;
+    int32_t distance = 0;
+
+    if (!a.valid || !b.valid)
+        return INT32_MAX;
+
+    for (uint32_t i = 0; i < CIFISP_AE_MEAN_MAX; i++)
+        sum += abs ((int32_t)a.ae_mean[i] - b.ae_mean[i]);
+    distance = XCAM_MAX (distance, sum / CIFISP_AE_MEAN_MAX);
+
+    // half the L1 distance is the share of pixels that moved bin
+    sum = 0;
+    for (uint32_t i = 0; i < CIFISP_HIST_BIN_N_MAX; i++)
+        sum += abs ((int32_t)a.hist[i] - b.hist[i]);
+    distance = XCAM_MAX (distance, sum / 2);
+
+    for (uint32_t i = 0; i < 3; i++)
+        distance = XCAM_MAX (distance, abs ((int32_t)a.awb_mean[i] - b.awb_mean[i]));
+
+    return distance;
+}
+
+uint32_t
+ConvergeScheduler::plan (const StatsSignature &sig, uint32_t converged, uint32_t force)
+{
+    _run_mask = 0;
+    ++_stats.frames;
+
+    for (int i = 0; i < ConvergeAlgoCount; i++) {
+        uint32_t bit = XCAM_CONVERGE_ALGO_MASK (i);
+        bool run = true;
+
+        if (_enabled && !(force & bit) && (converged & bit) && _skipped[i] < _config.max_skip) {
+            if (signature_distance (sig, _ref[i]) <= _config.tolerance)
+                run = false;
+            else if (i != ConvergeAlgoAe && (converged & XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAe)) &&
+                     _skipped[i] + 1 < _config.cadence)
+                run = false;
+        }
+
+        if (run) {
+            _run_mask |= bit;
+            _ref[i] = sig;
+            _skipped[i] = 0;
+            ++_stats.run[i];
+        } else {
+            ++_skipped[i];
+            ++_stats.skipped[i];
+        }
+    }
+
+    return _run_mask;
+}
+
+void
+ConvergeScheduler::reset ()
+{
+    _run_mask = XCAM_CONVERGE_ALGO_ALL;
+    for (int i = 0; i < ConvergeAlgoCount; i++) {
+        _skipped[i] = 0;
+        xcam_mem_clear (_ref[i]);
+    }
+}
+
+};
@@ -0,0 +1,121 @@
+/*
+ * converge_scheduler.h - skip 3a algorithms on static converged scenes
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_CONVERGE_SCHEDULER_H
+#define XCAM_CONVERGE_SCHEDULER_H
+
+#include <xcam_std.h>
+#include <linux/rkisp.h>
+#include <rk-isp-config.h>
+
+#define XCAM_CONVERGE_DEFAULT_CADENCE   4
+#define XCAM_CONVERGE_DEFAULT_MAX_SKIP  15
+#define XCAM_CONVERGE_DEFAULT_TOLERANCE 3
+
+namespace XCam {
+
+enum ConvergeAlgo {
+    ConvergeAlgoAe = 0,
+    ConvergeAlgoAwb,
+    ConvergeAlgoAf,
+    ConvergeAlgoCount,
+};
+
+#define XCAM_CONVERGE_ALGO_MASK(algo) (1 << (algo))
+#define XCAM_CONVERGE_ALGO_ALL ((1 << ConvergeAlgoCount) - 1)
+
+/*
+ * scene summary of one stats buffer, every field on a 0..255 scale so a
+ * single tolerance fits all of them
+ */
+struct StatsSignature {
+    bool        valid;                           // AE means, histogram and AWB means all measured
+    uint8_t     ae_mean[CIFISP_AE_MEAN_MAX];
+    uint8_t     hist[CIFISP_HIST_BIN_N_MAX];     // share of each bin, 1/256 units
+    uint8_t     awb_mean[3];                     // y/g, cb/b, cr/r
+};
+
+struct ConvergeScheduleConfig {
+    int32_t     cadence;     // converged AWB/AF run every @cadence frames while AE is converged too
+    int32_t     max_skip;    // hard bound of consecutive skipped frames per algorithm
+    int32_t     tolerance;   // max mean abs difference of a signature field, 0..255
+};
+
+struct ConvergeScheduleStats {
+    uint64_t    frames;
+    uint64_t    run[ConvergeAlgoCount];
+    uint64_t    skipped[ConvergeAlgoCount];
+};
+
+/*
+ * Decides per frame which 3a algorithms have to run. A converged
+ * algorithm is skipped, and its previous result reused, while the stats
+ * signature stays within tolerance of the one it last ran on. Once AE is
+ * converged, converged AWB and AF also drop to a reduced cadence. No
+ * algorithm is skipped more than max_skip frames in a row. Not thread
+ * safe, plan on the analyzer thread before the handlers run.
+ */
+class ConvergeScheduler {
+public:
+    explicit ConvergeScheduler ();
+
+    void set_config (const ConvergeScheduleConfig &config);
+    const ConvergeScheduleConfig &get_config () const {
+        return _config;
+    }
+    bool is_enabled () const {
+        return _enabled;
+    }
+    void set_enabled (bool enable);
+
+    // @str as "cadence,max_skip,tolerance", missing fields keep their value
+    static bool parse_config (const char *str, ConvergeScheduleConfig &config);
+    static void compute_signature (const struct cifisp_stat_buffer *stats, StatsSignature &sig);
+    static int32_t signature_distance (const StatsSignature &a, const StatsSignature &b);
+
+    /*
+     * plan the frame of @sig, @converged holds XCAM_CONVERGE_ALGO_MASK of
+     * the converged algorithms and the algorithms in @force always run.
+     * Returns the mask of algorithms to run.
+     */
+    uint32_t plan (const StatsSignature &sig, uint32_t converged, uint32_t force);
+    bool need_run (ConvergeAlgo algo) const {
+        return (_run_mask & XCAM_CONVERGE_ALGO_MASK (algo)) != 0;
+    }
+
+    void reset ();
+    void get_stats (ConvergeScheduleStats &stats) const {
+        stats = _stats;
+    }
+
+private:
+    XCAM_DEAD_COPY (ConvergeScheduler);
+
+private:
+    bool                        _enabled;
+    ConvergeScheduleConfig      _config;
+    uint32_t                    _run_mask;
+    int32_t                     _skipped[ConvergeAlgoCount];
+    StatsSignature              _ref[ConvergeAlgoCount];     // signature of the last run
+    ConvergeScheduleStats       _stats;
+};
+
+};
+
+#endif //XCAM_CONVERGE_SCHEDULER_H
@@ -0,0 +1,239 @@
+/*
+ * exposure_scheduler.cpp - schedule sensor exposure writes per latency
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "exposure_scheduler.h"
+
+namespace XCam {
+
+ExposureScheduler::ExposureScheduler ()
+{
+    for (int i = 0; i < ExposureComponentCount; i++)
+        _delay.delay[i] = 0;
+    xcam_mem_clear (_stats);
+    reset ();
+}
+
+void
+ExposureScheduler::set_delay (const SensorExposureDelay &delay)
+{
+    for (int i = 0; i < ExposureComponentCount; i++) {
+        XCAM_ASSERT (delay.delay[i] >= 0 && delay.delay[i] < XCAM_EXPOSURE_SCHEDULE_DEPTH / 2);
+        _delay.delay[i] = XCAM_MAX (0, XCAM_MIN (delay.delay[i], XCAM_EXPOSURE_SCHEDULE_DEPTH / 2 - 1));
+    }
+    reset ();
+}
+
+int32_t
+ExposureScheduler::get_max_delay () const
+{
+    int32_t max_delay = 0;
+    for (int i = 0; i < ExposureComponentCount; i++)
+        max_delay = XCAM_MAX (max_delay, _delay.delay[i]);
+    return max_delay;
+}
+
+bool
+ExposureScheduler::parse_delay (const char *str, SensorExposureDelay &delay)
+{
+    SensorExposureDelay parsed = delay;
+    const char *pos = str;
+
+    if (!str || !str[0])
+        return false;
+
+    for (int i = 0; i < ExposureComponentCount && *pos; i++) {
+        char *end = NULL;
+        long value = strtol (pos, &end, 10);
+        if (end == pos || value < 0 || value >= XCAM_EXPOSURE_SCHEDULE_DEPTH / 2)
+            return false;
+        parsed.delay[i] = value;
+        pos = end;
+        if (*pos == ',')
+            pos++;
+        else if (*pos)
+            return false;
+    }
+
+    delay = parsed;
+    return true;
+}
+
+ExposureWrite *
+ExposureScheduler::get_slot (int32_t sof_frame, bool claim)
+{
+    ExposureWrite *slot = &_slots[sof_frame & (XCAM_EXPOSURE_SCHEDULE_DEPTH - 1)];
+
+    if (slot->sof_frame == sof_frame)
+        return slot;
+    if (!claim)
+        return NULL;
+
+    if (slot->mask) {
+        XCAM_LOG_DEBUG ("exposure writes of sof %d never issued, mask 0x%x",
+                        slot->sof_frame, slot->mask);
+        for (int i = 0; i < ExposureComponentCount; i++)
+            if (slot->mask & XCAM_EXPOSURE_COMPONENT_MASK (i))
+                _stats.dropped++;
+    }
+    xcam_mem_clear (*slot);
+    slot->sof_frame = sof_frame;
+    slot->vts = -1;
+    return slot;
+}
+
+void
+ExposureScheduler::cancel_from (uint32_t mask, int32_t target, bool vts)
+{
+    for (int s = 0; s < XCAM_EXPOSURE_SCHEDULE_DEPTH; s++) {
+        ExposureWrite *slot = &_slots[s];
+        for (int i = 0; i < ExposureComponentCount; i++) {
+            uint32_t bit = XCAM_EXPOSURE_COMPONENT_MASK (i);
+            if ((mask & bit) && (slot->mask & bit) && slot->target[i] >= target) {
+                slot->mask &= ~bit;
+                _stats.dropped++;
+            }
+        }
+        if (vts && slot->vts >= 0 && slot->target[ExposureComponentTime] >= target)
+            slot->vts = -1;
+    }
+}
+
+void
+ExposureScheduler::schedule (
+    int32_t next_sof, int32_t target, uint32_t mask,
+    const int32_t value[ExposureComponentCount], int32_t vts)
+{
+    cancel_from (mask, target, vts >= 0);
+
+    for (int i = 0; i < ExposureComponentCount; i++) {
+        if (!(mask & XCAM_EXPOSURE_COMPONENT_MASK (i)))
+            continue;
+
+        int32_t sof = target - _delay.delay[i];
+        if (sof < next_sof) {
+            XCAM_LOG_DEBUG ("exposure component %d for frame %d is late, lands on %d",
+                            i, target, next_sof + _delay.delay[i]);
+            sof = next_sof;
+            _stats.late++;
+        }
+
+        ExposureWrite *slot = get_slot (sof, true);
+        slot->mask |= XCAM_EXPOSURE_COMPONENT_MASK (i);
+        slot->value[i] = value[i];
+        slot->target[i] = target;
+        _stats.scheduled++;
+    }
+
+    // vts is written on every plan, in the SOF of the integration time
+    if (vts >= 0) {
+        ExposureWrite *slot = get_slot (
+            XCAM_MAX (target - _delay.delay[ExposureComponentTime], next_sof), true);
+        slot->vts = vts;
+        slot->target[ExposureComponentTime] = target;
+    }
+}
+
+bool
+ExposureScheduler::take_writes (int32_t sof_frame, ExposureWrite &write)
+{
+    ExposureWrite *slot = get_slot (sof_frame, false);
+
+    if (!slot || (!slot->mask && slot->vts < 0))
+        return false;
+
+    write = *slot;
+    for (int i = 0; i < ExposureComponentCount; i++)
+        if (slot->mask & XCAM_EXPOSURE_COMPONENT_MASK (i))
+            _stats.written++;
+    slot->mask = 0;
+    slot->vts = -1;
+    return true;
+}
+
+void
+ExposureScheduler::reset ()
+{
+    for (int i = 0; i < XCAM_EXPOSURE_SCHEDULE_DEPTH; i++) {
+        xcam_mem_clear (_slots[i]);
+        _slots[i].sof_frame = -1;
+    }
+}
+
+FakeExposureSensor::FakeExposureSensor (const SensorExposureDelay &delay)
+    : _delay (delay)
+{
+    xcam_mem_clear (_history);
+    xcam_mem_clear (_count);
+}
+
+void
+FakeExposureSensor::latch (int reg, int32_t frame, int32_t value, int32_t target)
+{
+    Latched &latched = _history[reg][_count[reg] % XCAM_EXPOSURE_SCHEDULE_DEPTH];
+    latched.frame = frame;
+    latched.value = value;
+    latched.target = target;
+    _count[reg]++;
+}
+
+void
+FakeExposureSensor::write (const ExposureWrite &write)
+{
+    for (int i = 0; i < ExposureComponentCount; i++) {
+        if (write.mask & XCAM_EXPOSURE_COMPONENT_MASK (i))
+            latch (i, write.sof_frame + _delay.delay[i], write.value[i], write.target[i]);
+    }
+    // frame length latches along with the integration time
+    if (write.vts >= 0)
+        latch (ExposureComponentCount, write.sof_frame + _delay.delay[ExposureComponentTime],
+               write.vts, write.target[ExposureComponentTime]);
+}
+
+bool
+FakeExposureSensor::find (int reg, int32_t frame, int32_t &value, int32_t &target) const
+{
+    uint32_t count = XCAM_MIN (_count[reg], (uint32_t)XCAM_EXPOSURE_SCHEDULE_DEPTH);
+
+    // newest write already latched for @frame wins
+    for (uint32_t i = 1; i <= count; i++) {
+        const Latched &latched = _history[reg][(_count[reg] - i) % XCAM_EXPOSURE_SCHEDULE_DEPTH];
+        if (latched.frame <= frame) {
+            value = latched.value;
+            target = latched.target;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+FakeExposureSensor::get_effective (
+    ExposureComponent comp, int32_t frame, int32_t &value, int32_t &target) const
+{
+    XCAM_ASSERT (comp >= ExposureComponentTime && comp < ExposureComponentCount);
+    return find (comp, frame, value, target);
+}
+
+bool
+FakeExposureSensor::get_effective_vts (int32_t frame, int32_t &vts, int32_t &target) const
+{
+    return find (ExposureComponentCount, frame, vts, target);
+}
+
+};
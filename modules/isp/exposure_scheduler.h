@@ -0,0 +1,146 @@
+/*
+ * exposure_scheduler.h - schedule sensor exposure writes per latency
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_EXPOSURE_SCHEDULER_H
+#define XCAM_EXPOSURE_SCHEDULER_H
+
+#include <xcam_std.h>
+
+// pending SOFs tracked at once, must be power of 2
+#define XCAM_EXPOSURE_SCHEDULE_DEPTH 16
+
+namespace XCam {
+
+enum ExposureComponent {
+    ExposureComponentTime = 0,  // integration time
+    ExposureComponentAgain,
+    ExposureComponentDgain,
+    ExposureComponentCount,
+};
+
+#define XCAM_EXPOSURE_COMPONENT_MASK(comp) (1 << (comp))
+
+/*
+ * frames between the SOF a register is written in and the first frame
+ * exposed with it, per component
+ */
+struct SensorExposureDelay {
+    int32_t delay[ExposureComponentCount];
+};
+
+// register writes to issue in the SOF of @sof_frame
+struct ExposureWrite {
+    int32_t     sof_frame;
+    uint32_t    mask;                            // XCAM_EXPOSURE_COMPONENT_MASK
+    int32_t     value[ExposureComponentCount];
+    int32_t     target[ExposureComponentCount];  // frame the value is meant for
+    int32_t     vts;                             // frame length lines, -1 keeps it,
+                                                 // meant for target[ExposureComponentTime]
+};
+
+struct ExposureScheduleStats {
+    uint64_t    scheduled;   // component writes planned
+    uint64_t    written;     // component writes handed out at SOF
+    uint64_t    late;        // planned too late to land on their target
+    uint64_t    dropped;     // replaced by a newer plan or never picked up
+};
+
+/*
+ * Plans every exposure component so they all land on the same target
+ * frame: a component with delay d is written in the SOF of target - d.
+ * Writes are precomputed when the AE result arrives and handed out by
+ * take_writes in the SOF handler. Not thread safe, callers lock.
+ */
+class ExposureScheduler {
+public:
+    explicit ExposureScheduler ();
+
+    void set_delay (const SensorExposureDelay &delay);
+    const SensorExposureDelay &get_delay () const {
+        return _delay;
+    }
+    int32_t get_max_delay () const;
+
+    // @str as "time,again,dgain" in frames, missing fields keep their value
+    static bool parse_delay (const char *str, SensorExposureDelay &delay);
+
+    /*
+     * plan the components in @mask to be in effect from frame @target on,
+     * the earliest SOF that can still be written is @next_sof. Writes of
+     * those components planned for @target or later frames are replaced.
+     * @vts, unless negative, is written with the latency of the integration
+     * time whether or not the integration time itself is in @mask.
+     */
+    void schedule (
+        int32_t next_sof, int32_t target, uint32_t mask,
+        const int32_t value[ExposureComponentCount], int32_t vts);
+    // writes due in the SOF of @sof_frame, false if none
+    bool take_writes (int32_t sof_frame, ExposureWrite &write);
+
+    void reset ();
+    void get_stats (ExposureScheduleStats &stats) const {
+        stats = _stats;
+    }
+
+private:
+    ExposureWrite *get_slot (int32_t sof_frame, bool claim);
+    void cancel_from (uint32_t mask, int32_t target, bool vts);
+
+    XCAM_DEAD_COPY (ExposureScheduler);
+
+private:
+    SensorExposureDelay         _delay;
+    ExposureWrite               _slots[XCAM_EXPOSURE_SCHEDULE_DEPTH];
+    ExposureScheduleStats       _stats;
+};
+
+/*
+ * Simulated sensor with per-component latencies, feed it the writes of
+ * every SOF and ask which values a frame was exposed with. Used by
+ * testApp/exposure_scheduler_test to check schedules without a sensor.
+ */
+class FakeExposureSensor {
+public:
+    explicit FakeExposureSensor (const SensorExposureDelay &delay);
+
+    void write (const ExposureWrite &write);
+    // value of @comp in effect for @frame, false if never written
+    bool get_effective (ExposureComponent comp, int32_t frame, int32_t &value, int32_t &target) const;
+    bool get_effective_vts (int32_t frame, int32_t &vts, int32_t &target) const;
+
+private:
+    struct Latched {
+        int32_t frame;   // first frame exposed with the value
+        int32_t value;
+        int32_t target;
+    };
+
+    // registers are the components, then the frame length
+    void latch (int reg, int32_t frame, int32_t value, int32_t target);
+    bool find (int reg, int32_t frame, int32_t &value, int32_t &target) const;
+
+private:
+    SensorExposureDelay         _delay;
+    Latched                     _history[ExposureComponentCount + 1][XCAM_EXPOSURE_SCHEDULE_DEPTH];
+    uint32_t                    _count[ExposureComponentCount + 1];
+};
+
+};
+
+#endif //XCAM_EXPOSURE_SCHEDULER_H
@@ -22,13 +22,37 @@
 #include "v4l2_device.h"
 #include "x3a_statistics_queue.h"
 #include "x3a_isp_config.h"
+#include "frame_tracer.h"
 
 #include <linux/rkisp.h>
 #include <rkiq_params.h>
+#ifdef ANDROID_OS
+#include <cutils/properties.h>
+#endif
 namespace XCam {
 
+bool
+IspController::zero_copy_stats_enabled ()
+{
+    static int enabled = -1;
+
+    if (enabled < 0) {
+        char value[16] = {0};
+#ifdef ANDROID_OS
+        property_get ("persist.vendor.rkisp.zerocopystats", value, "0");
+#else
+        const char *env = getenv ("persist_camera_engine_zero_copy_stats");
+        if (env)
+            strncpy (value, env, sizeof (value) - 1);
+#endif
+        enabled = (atoi (value) != 0);
+    }
+    return enabled != 0;
+}
+
 IspController::IspController ():
     _is_exit(false),
+    _zero_copy_stats(zero_copy_stats_enabled ()),
     _device(NULL),
     _isp_device(NULL),
     _sensor_subdev(NULL),
@@ -37,9 +61,15 @@ IspController::IspController ():
     _isp_ioctl(NULL),
     _frame_sequence(-(EXPOSURE_TIME_DELAY - 1)),
     _frame_sof_time(0),
+    _pending_params_frame_id(-1),
     _isp_acq_out_width(-1),
-    _isp_acq_out_height(-1)
+    _isp_acq_out_height(-1),
+    _submitted_modules(0),
+    _module_submitted_count(0),
+    _module_skipped_count(0)
 {
+    reset_effect_params ();
+    xcam_mem_clear(_submitted_isp_params);
     xcam_mem_clear(_last_aiq_results);
     xcam_mem_clear(_full_active_isp_params);
     xcam_mem_clear(_flash_settings);
@@ -50,6 +80,7 @@ IspController::IspController ():
 
     _exposure_queue =
         (struct rkisp_exposure *)xcam_malloc0(sizeof(struct rkisp_exposure) * _max_delay);
+    load_exposure_delay ();
 
     XCAM_LOG_DEBUG ("IspController construction");
 }
@@ -57,6 +88,18 @@ IspController::IspController ():
 IspController::~IspController ()
 {
     XCAM_LOG_DEBUG ("~IspController destruction");
+    XCAM_LOG_INFO ("isp params modules submitted:%lld skipped as unchanged:%lld",
+                   (long long)_module_submitted_count, (long long)_module_skipped_count);
+    FrameSequencerStats seq_stats;
+    _frame_sequencer.get_stats (seq_stats);
+    XCAM_LOG_INFO ("frame sequencer matched:%lld mismatches:%lld late:%lld timeouts:%lld",
+                   (long long)seq_stats.matched, (long long)seq_stats.mismatches,
+                   (long long)seq_stats.late, (long long)seq_stats.timeouts);
+    ExposureScheduleStats exp_stats;
+    _exp_scheduler.get_stats (exp_stats);
+    XCAM_LOG_INFO ("exposure writes scheduled:%lld written:%lld late:%lld dropped:%lld",
+                   (long long)exp_stats.scheduled, (long long)exp_stats.written,
+                   (long long)exp_stats.late, (long long)exp_stats.dropped);
     free(_exposure_queue);
     float power[2] = {0.0f, 0.0f};
     set_3a_fl (RKISP_FLASH_MODE_OFF, power, 0, 0);
@@ -66,10 +109,17 @@ void IspController::exit(bool pause) {
     SmartLock locker (_mutex);
     XCAM_LOG_DEBUG("ISP controller has exit %d", pause);
     _is_exit = pause;
+    if (pause)
+        _frame_sequencer.stop ();
+    else
+        _frame_sequencer.reset ();
     _frame_sequence = -(EXPOSURE_TIME_DELAY - 1);
     _effecting_exposure_map.clear();
+    _exp_scheduler.reset ();
     _pending_ispparams_queue.clear();
-    _effecting_ispparm_map.clear();
+    _pending_params_frame_id = -1;
+    reset_effect_params ();
+    reset_submitted_modules ();
     _isp_acq_out_width = -1;
     _isp_acq_out_height = -1;
 }
@@ -125,7 +175,8 @@ IspController::handle_sof(int64_t time, int frameid)
     if (_is_exit)
         return XCAM_RETURN_BYPASS;
 
-    _frame_sequence_cond.signal();
+    XCAM_FRAME_TRACE (FrameTraceSof, frameid);
+    _frame_sequencer.notify (FrameSourceSof, frameid, time);
 
     _frame_sof_time = time;
     _frame_sequence = frameid;
@@ -152,22 +203,26 @@ IspController::handle_sof(int64_t time, int frameid)
 
     XCAM_LOG_DEBUG(" --SOF[%d]------------------expsync-statsync\n%s", frameid, log_str);
 
-    struct rkisp_exposure exposure;
-
-    //exposure.coarse_integration_time = _exposure_queue[EXPOSURE_TIME_DELAY - 1].coarse_integration_time;
-    //exposure.analog_gain = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].analog_gain;
-    //exposure.digital_gain = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].digital_gain;
-    //exposure.frame_line_length = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].frame_line_length;
-    exposure = _exposure_queue[EXPOSURE_GAIN_DELAY - 1];
-    exposure = _exposure_queue[_cur_apply_index++];
-    if (_cur_apply_index == _used_exp_que_len) {
-        _cur_apply_index = _used_exp_que_len-1;
-        LOGD("no new expoure, use the latest !");
-    }
+    if (use_exposure_scheduler (_exposure_queue[0])) {
+        apply_scheduled_exposure (frameid);
+    } else {
+        struct rkisp_exposure exposure;
+
+        //exposure.coarse_integration_time = _exposure_queue[EXPOSURE_TIME_DELAY - 1].coarse_integration_time;
+        //exposure.analog_gain = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].analog_gain;
+        //exposure.digital_gain = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].digital_gain;
+        //exposure.frame_line_length = _exposure_queue[EXPOSURE_GAIN_DELAY - 1].frame_line_length;
+        exposure = _exposure_queue[EXPOSURE_GAIN_DELAY - 1];
+        exposure = _exposure_queue[_cur_apply_index++];
+        if (_cur_apply_index == _used_exp_que_len) {
+            _cur_apply_index = _used_exp_que_len-1;
+            LOGD("no new expoure, use the latest !");
+        }
 
-    set_3a_exposure(exposure);
+        set_3a_exposure(exposure);
+    }
 
-    _effecting_ispparm_map[frameid].frame_sof_ts = _frame_sof_time;
+    get_effect_params (frameid)->frame_sof_ts = _frame_sof_time;
     set_3a_config_sync();
 
     return XCAM_RETURN_NO_ERROR;
@@ -326,22 +381,13 @@ IspController::get_flash_status (rkisp_flash_setting_t& flash_settings, int fram
     if (_is_exit)
         return XCAM_RETURN_BYPASS;
 
-    std::map<int, struct rkisp_effect_params>::iterator it;
-    int num = _effecting_ispparm_map.size();
-    int search_id = frame_id < 0 ? 0 : frame_id;
-
-    do {
-        it = _effecting_ispparm_map.find(search_id);
-        if (it != _effecting_ispparm_map.end()) {
-            flash_settings =
-              _effecting_ispparm_map[search_id].flash_settings;
-            break;
-        }
-    } while (--num > 0 && --search_id >=0);
+    struct rkisp_effect_params* isp_effect_params =
+        find_effect_params (frame_id < 0 ? 0 : frame_id);
 
-    if (it == _effecting_ispparm_map.end()) {
+    if (isp_effect_params)
+        flash_settings = isp_effect_params->flash_settings;
+    else
         LOGW("can't find %d flash settings in effecting map.", frame_id);
-    }
 
     if (_fl_device[0].ptr()) {
         struct timeval flash_time;
@@ -479,8 +525,11 @@ IspController::get_sensor_mode_data (struct isp_supplemental_sensor_mode_data &s
         sensor_mode_data.isp_output_height                  =
             sensor_desc.isp_output_height;
 
+        // valid frame counts the frame of the write, as EXPOSURE_TIME_DELAY
         sensor_mode_data.exposure_valid_frame[0]            =
-            EXPOSURE_TIME_DELAY;
+            _exp_scheduler.get_delay ().delay[ExposureComponentTime] + 1;
+        sensor_mode_data.exposure_valid_frame[1]            =
+            _exp_scheduler.get_delay ().delay[ExposureComponentAgain] + 1;
 
         _isp_acq_out_width =
             sensor_mode_data.sensor_output_width;
@@ -535,47 +584,33 @@ XCamReturn
 IspController::get_isp_parameter (struct rkisp_parameters& parameters, int frame_id)
 {
     SmartLock locker (_mutex);
-    std::map<int, struct rkisp_effect_params>::iterator it;
     struct rkisp_effect_params* isp_effect_params;
-    int num = _effecting_ispparm_map.size();
-    int search_id = frame_id;
 
-    if (_effecting_ispparm_map.empty()) {
+    if (_effecting_ispparm_latest < 0) {
         XCAM_LOG_WARNING ("no effecting isp params !");
         return XCAM_RETURN_ERROR_PARAM;
     }
 
-    do {
-        it = _effecting_ispparm_map.find(search_id);
-        if (it != _effecting_ispparm_map.end()) {
-            isp_effect_params = &it->second;
-            LOGD("use isp param %d for %d",search_id, frame_id);
-            break;
-        }
-    } while (--num > 0 && --search_id >= 0);
-
+    isp_effect_params = find_effect_params (frame_id);
     // havn't found
-    if (it == _effecting_ispparm_map.end()) {
+    if (!isp_effect_params) {
         /* use the latest */
-        std::map<int, struct rkisp_effect_params>::reverse_iterator rit;
-
-        rit = _effecting_ispparm_map.rbegin();
-        isp_effect_params = &rit->second;
+        isp_effect_params = get_effect_params (_effecting_ispparm_latest);
         LOGW("FIXME! unpossible case. frame_id %d",frame_id);
     }
 
     parameters.awb_gain_config =
-        isp_effect_params->isp_params.others.awb_gain_config;
+        isp_effect_params->awb_gain_config;
     parameters.ctk_config =
-        isp_effect_params->isp_params.others.ctk_config;
+        isp_effect_params->ctk_config;
     parameters.awb_algo_results =
         isp_effect_params->awb_algo_results;
     parameters.frame_sof_ts =
         isp_effect_params->frame_sof_ts;
     parameters.bls_config =
-        isp_effect_params->isp_params.others.bls_config;
+        isp_effect_params->bls_config;
     parameters.awb_meas_config =
-        isp_effect_params->isp_params.meas.awb_meas_config;
+        isp_effect_params->awb_meas_config;
 
     return XCAM_RETURN_NO_ERROR;
 }
@@ -619,7 +654,6 @@ IspController::get_3a_statistics (SmartPtr<X3aIspStatistics> &stats)
         SmartPtr<V4l2Buffer> v4l2buf;
         struct cifisp_stat_buffer* isp_stats = NULL;
 
-        isp_stats =  (struct cifisp_stat_buffer*)stats->get_isp_stats ();
         ret = _isp_stats_device->dequeue_buffer (v4l2buf);
         if (ret != XCAM_RETURN_NO_ERROR) {
             XCAM_LOG_WARNING ("dequeue stats buffer failed");
@@ -628,8 +662,10 @@ IspController::get_3a_statistics (SmartPtr<X3aIspStatistics> &stats)
         XCAM_ASSERT (v4l2buf.ptr());
 
         int cur_frame_id = v4l2buf->get_buf().sequence;
+        XCAM_FRAME_TRACE (FrameTraceStatsDequeued, cur_frame_id);
         int64_t cur_time = v4l2buf->get_buf().timestamp.tv_sec * 1000 * 1000 * 1000 +
                             v4l2buf->get_buf().timestamp.tv_usec * 1000;
+        _frame_sequencer.notify (FrameSourceStats, cur_frame_id, cur_time);
 
         //translate stats to struct cifisp_stat_buffer
         struct cifisp_stat_buffer *aiq_stats = (struct cifisp_stat_buffer*)v4l2buf->map();
@@ -638,19 +674,31 @@ IspController::get_3a_statistics (SmartPtr<X3aIspStatistics> &stats)
         /* isp_stats->params.hist= aiq_stats->params.hist; */
         /* isp_stats->params.awb = aiq_stats->params.awb; */
         /* isp_stats->params.af = aiq_stats->params.af; */
-        /* compatible with no emd info, so we could use new camera engine with
-         * old rkisp driver that has no emd field in stats
-         */
-        if (aiq_stats->meas_type & CIFISP_STAT_EMB_DATA)
-            *isp_stats = *aiq_stats;
-        else
-            memcpy(isp_stats, aiq_stats,
-                   sizeof(*isp_stats) - sizeof(struct cifisp_embedded_data));
-        isp_stats->frame_id = cur_frame_id;
-        ret = _isp_stats_device->queue_buffer (v4l2buf);
-        if (ret != XCAM_RETURN_NO_ERROR) {
-            XCAM_LOG_WARNING ("queue stats buffer failed");
-            return ret;
+        // old drivers without emd field have smaller buffers, copy those
+        if (_zero_copy_stats &&
+                v4l2buf->get_buf().length >= sizeof(struct cifisp_stat_buffer)) {
+            if (!stats->attach_v4l2_buffer (v4l2buf, _isp_stats_device)) {
+                _isp_stats_device->queue_buffer (v4l2buf);
+                return XCAM_RETURN_ERROR_MEM;
+            }
+            isp_stats = aiq_stats;
+            isp_stats->frame_id = cur_frame_id;
+        } else {
+            isp_stats = (struct cifisp_stat_buffer*)stats->get_isp_stats ();
+            /* compatible with no emd info, so we could use new camera engine with
+             * old rkisp driver that has no emd field in stats
+             */
+            if (aiq_stats->meas_type & CIFISP_STAT_EMB_DATA)
+                *isp_stats = *aiq_stats;
+            else
+                memcpy(isp_stats, aiq_stats,
+                       sizeof(*isp_stats) - sizeof(struct cifisp_embedded_data));
+            isp_stats->frame_id = cur_frame_id;
+            ret = _isp_stats_device->queue_buffer (v4l2buf);
+            if (ret != XCAM_RETURN_NO_ERROR) {
+                XCAM_LOG_WARNING ("queue stats buffer failed");
+                return ret;
+            }
         }
 
         XCAM_LOG_DEBUG("|||get_3a_statistics[%d-%d] MEAS AE: %d MEAS AWB[%d] [%d-%d-%d] expsync, meastype 0x%x",
@@ -731,19 +779,19 @@ IspController::get_3a_statistics (SmartPtr<X3aIspStatistics> &stats)
             _frame_sequence, cur_frame_id,
             _frame_sof_time, cur_time,
             cur_time - _frame_sof_time);
-resync:
-        if (_frame_sequence < cur_frame_id) {
-            // impossible case
-            XCAM_LOG_DEBUG("[%d-%d] wait for next SOF signal[exit: %d] - statsync",
-                _frame_sequence, cur_frame_id, _is_exit);
-            if (!_is_exit) {
-                SmartLock locker (_mutex);
-                _frame_sequence_cond.timedwait(_mutex, 3000); //3ms
-                goto resync;
-            } else {
-                return XCAM_RETURN_BYPASS;
-            }
-        } else if (_frame_sequence > cur_frame_id) {
+        // wakes up as soon as the SOF of this frame, or a newer one, arrived
+        FrameTuple tuple;
+        while ((ret = _frame_sequencer.wait_complete (
+                          cur_frame_id, XCAM_STATS_SOF_TIMEOUT_US, tuple)) == XCAM_RETURN_ERROR_TIMEOUT) {
+            XCAM_LOG_WARNING("[%d-%d] no SOF for stats after %dms[exit: %d] - statsync",
+                _frame_sequence, cur_frame_id, XCAM_STATS_SOF_TIMEOUT_US / 1000, _is_exit);
+            if (_is_exit)
+                break;
+        }
+        if (ret != XCAM_RETURN_NO_ERROR)
+            return XCAM_RETURN_BYPASS;
+
+        if (_frame_sequence > cur_frame_id) {
             if ( cur_time - _frame_sof_time < 10 * 1000 * 1000) {
                 XCAM_LOG_DEBUG("measurement late %lld for frame %d - statsync",
                     _frame_sof_time - cur_time, cur_frame_id);
@@ -879,6 +927,177 @@ IspController::gen_full_isp_params(const struct rkisp1_isp_params_cfg *update_pa
     }
 }
 
+void
+IspController::reset_effect_params ()
+{
+    for (int i = 0; i < ISP_EFFECT_PARAMS_RING_DEPTH; i++) {
+        xcam_mem_clear (_effecting_ispparm_ring[i]);
+        _effecting_ispparm_ring[i].frame_id = -1;
+    }
+    _effecting_ispparm_latest = -1;
+}
+
+struct IspController::rkisp_effect_params*
+IspController::get_effect_params (int frame_id)
+{
+    int idx = ((frame_id % ISP_EFFECT_PARAMS_RING_DEPTH) + ISP_EFFECT_PARAMS_RING_DEPTH) %
+              ISP_EFFECT_PARAMS_RING_DEPTH;
+    struct rkisp_effect_params* effect = &_effecting_ispparm_ring[idx];
+
+    if (effect->frame_id != frame_id) {
+        xcam_mem_clear (*effect);
+        effect->frame_id = frame_id;
+    }
+    if (frame_id > _effecting_ispparm_latest)
+        _effecting_ispparm_latest = frame_id;
+
+    return effect;
+}
+
+struct IspController::rkisp_effect_params*
+IspController::find_effect_params (int frame_id)
+{
+    int search_id = XCAM_MIN (frame_id, _effecting_ispparm_latest);
+
+    for (int i = 0; i < ISP_EFFECT_PARAMS_RING_DEPTH && search_id >= 0; i++, search_id--) {
+        struct rkisp_effect_params* effect =
+            &_effecting_ispparm_ring[search_id % ISP_EFFECT_PARAMS_RING_DEPTH];
+        if (effect->frame_id == search_id) {
+            if (search_id != frame_id)
+                LOGD("use isp param %d for %d", search_id, frame_id);
+            return effect;
+        }
+    }
+
+    return NULL;
+}
+
+void
+IspController::set_effect_isp_params (struct rkisp_effect_params *effect,
+                                      const struct rkisp1_isp_params_cfg *isp_params)
+{
+    effect->awb_gain_config = isp_params->others.awb_gain_config;
+    effect->ctk_config = isp_params->others.ctk_config;
+    effect->bls_config = isp_params->others.bls_config;
+    effect->awb_meas_config = isp_params->meas.awb_meas_config;
+}
+
+static const void*
+isp_module_config (const struct rkisp1_isp_params_cfg *params, int id, size_t &size)
+{
+#define MODULE_CONFIG(cfg) size = sizeof (params->cfg); return &params->cfg;
+    switch (id) {
+    case CIFISP_DPCC_ID:
+        MODULE_CONFIG (others.dpcc_config);
+    case CIFISP_BLS_ID:
+        MODULE_CONFIG (others.bls_config);
+    case CIFISP_SDG_ID:
+        MODULE_CONFIG (others.sdg_config);
+    case CIFISP_HST_ID:
+        MODULE_CONFIG (meas.hst_config);
+    case CIFISP_LSC_ID:
+        MODULE_CONFIG (others.lsc_config);
+    case CIFISP_AWB_GAIN_ID:
+        MODULE_CONFIG (others.awb_gain_config);
+    case CIFISP_FLT_ID:
+        MODULE_CONFIG (others.flt_config);
+    case CIFISP_BDM_ID:
+        MODULE_CONFIG (others.bdm_config);
+    case CIFISP_CTK_ID:
+        MODULE_CONFIG (others.ctk_config);
+    case CIFISP_GOC_ID:
+        MODULE_CONFIG (others.goc_config);
+    case CIFISP_CPROC_ID:
+        MODULE_CONFIG (others.cproc_config);
+    case CIFISP_AFC_ID:
+        MODULE_CONFIG (meas.afc_config);
+    case CIFISP_AWB_ID:
+        MODULE_CONFIG (meas.awb_meas_config);
+    case CIFISP_IE_ID:
+        MODULE_CONFIG (others.ie_config);
+    case CIFISP_AEC_ID:
+        MODULE_CONFIG (meas.aec_config);
+    case CIFISP_WDR_ID:
+        MODULE_CONFIG (others.wdr_config);
+    case CIFISP_DPF_ID:
+        MODULE_CONFIG (others.dpf_config);
+    case CIFISP_DPF_STRENGTH_ID:
+        MODULE_CONFIG (others.dpf_strength_config);
+    case CIFISP_DEMOSAICLP_ID:
+        MODULE_CONFIG (others.demosaiclp_config);
+    case CIFISP_RK_IESHARP_ID:
+        MODULE_CONFIG (others.rkiesharp_config);
+    default:
+        size = 0;
+        return NULL;
+    }
+#undef MODULE_CONFIG
+}
+
+// the same module config as @cfg of @params, in @submitted
+static const void*
+isp_submitted_config (const struct rkisp1_isp_params_cfg *submitted,
+                      const struct rkisp1_isp_params_cfg *params, const void *cfg)
+{
+    return (const uint8_t *)submitted + ((const uint8_t *)cfg - (const uint8_t *)params);
+}
+
+// clears the update flag of the modules whose config is the one the driver last received
+void
+IspController::filter_unchanged_modules (struct rkisp1_isp_params_cfg *params)
+{
+    for (int i = 0; i < ISP_PARAMS_MODULE_NUM; i++) {
+        if (!(params->module_cfg_update & (1 << i)))
+            continue;
+
+        size_t size = 0;
+        const void *cfg = isp_module_config (params, i, size);
+        if (!cfg)
+            continue;
+
+        if ((_submitted_modules & (1 << i)) &&
+                !memcmp (cfg, isp_submitted_config (&_submitted_isp_params, params, cfg), size)) {
+            params->module_cfg_update &= ~(1 << i);
+            _module_skipped_count++;
+        }
+    }
+}
+
+// the params buffer is queued, the driver now holds the flagged configs
+void
+IspController::commit_submitted_modules (const struct rkisp1_isp_params_cfg *params)
+{
+    for (int i = 0; i < ISP_PARAMS_MODULE_NUM; i++) {
+        if (!(params->module_cfg_update & (1 << i)))
+            continue;
+
+        size_t size = 0;
+        const void *cfg = isp_module_config (params, i, size);
+        if (!cfg)
+            continue;
+
+        memcpy ((void *)isp_submitted_config (&_submitted_isp_params, params, cfg), cfg, size);
+        _submitted_modules |= 1 << i;
+        _module_submitted_count++;
+    }
+}
+
+void
+IspController::reset_submitted_modules ()
+{
+    // the driver may have lost its state, send every known module again
+    _full_active_isp_params.module_cfg_update |= _submitted_modules;
+    _submitted_modules = 0;
+}
+
+void
+IspController::get_module_update_counts (uint64_t &submitted, uint64_t &skipped)
+{
+    SmartLock locker (_mutex);
+    submitted = _module_submitted_count;
+    skipped = _module_skipped_count;
+}
+
 XCamReturn
 IspController::set_3a_config_sync ()
 {
@@ -888,15 +1107,13 @@ IspController::set_3a_config_sync ()
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     static bool delay_flash_strobe = false;
 
-    while (_effecting_ispparm_map.size() > 10)
-        _effecting_ispparm_map.erase(_effecting_ispparm_map.begin());
-
     if (_pending_ispparams_queue.empty()) {
         LOGD("no new isp params !");
         // reuse last params
         if (_frame_sequence >= 0) {
-            _effecting_ispparm_map[_frame_sequence + 1] =
-                _effecting_ispparm_map[_frame_sequence];
+            struct rkisp_effect_params* next = get_effect_params (_frame_sequence + 1);
+            *next = *get_effect_params (_frame_sequence);
+            next->frame_id = _frame_sequence + 1;
 
             if (delay_flash_strobe) {
                 rkisp_flash_setting_t* flash_settings = &_flash_settings;
@@ -907,8 +1124,8 @@ IspController::set_3a_config_sync ()
             }
 
             if (_frame_sequence > 0)
-                _effecting_ispparm_map[_frame_sequence].flash_settings =
-                    _effecting_ispparm_map[_frame_sequence - 1].flash_settings;
+                get_effect_params (_frame_sequence)->flash_settings =
+                    get_effect_params (_frame_sequence - 1)->flash_settings;
         } else
             LOGE("FIXME! no initial isp params !");
 
@@ -985,13 +1202,15 @@ IspController::set_3a_config_sync ()
     _flash_settings = *flash_settings;
 
     if (_frame_sequence < 0) {
-        _effecting_ispparm_map[0].isp_params = _full_active_isp_params;
-        _effecting_ispparm_map[0].awb_algo_results = isp_cfg->awb_algo_results;
-        _effecting_ispparm_map[0].flash_settings = *flash_settings;
+        struct rkisp_effect_params* effect = get_effect_params (0);
+        set_effect_isp_params (effect, &_full_active_isp_params);
+        effect->awb_algo_results = isp_cfg->awb_algo_results;
+        effect->flash_settings = *flash_settings;
     } else {
-        _effecting_ispparm_map[_frame_sequence + 1].isp_params = _full_active_isp_params;
-        _effecting_ispparm_map[_frame_sequence + 1].awb_algo_results = isp_cfg->awb_algo_results;
-        _effecting_ispparm_map[_frame_sequence].flash_settings = *flash_settings;
+        struct rkisp_effect_params* effect = get_effect_params (_frame_sequence + 1);
+        set_effect_isp_params (effect, &_full_active_isp_params);
+        effect->awb_algo_results = isp_cfg->awb_algo_results;
+        get_effect_params (_frame_sequence)->flash_settings = *flash_settings;
     }
 
 #if RKISP
@@ -1019,6 +1238,7 @@ IspController::set_3a_config_sync ()
             v4l2buf = _isp_params_device->get_buffer_by_index(buf_index);
         }
 
+        filter_unchanged_modules (&_full_active_isp_params);
         isp_params = (struct rkisp1_isp_params_cfg*)v4l2buf->get_buf().m.userptr;
         *isp_params = _full_active_isp_params;
 
@@ -1027,6 +1247,9 @@ IspController::set_3a_config_sync ()
                    buf_index, errno, strerror(errno));
             return ret;
         }
+        commit_submitted_modules (&_full_active_isp_params);
+        // the driver keeps the configs, only changes go in the next buffer
+        _full_active_isp_params.module_cfg_update = 0;
         XCAM_LOG_DEBUG ("device(%s) queue buffer index %d, queue cnt %d, check exit status again[exit: %d]",
             XCAM_STR (_isp_params_device->get_device_name()), buf_index, _isp_params_device->get_queued_bufcnt(), _is_exit);
         if (_is_exit)
@@ -1034,6 +1257,8 @@ IspController::set_3a_config_sync ()
     }
 #endif
 
+    XCAM_FRAME_TRACE (FrameTraceParamsApplied, _pending_params_frame_id,
+                      _frame_sequence < 0 ? 0 : _frame_sequence + 1);
     XCAM_LOG_DEBUG ("   set_3a_config done\n");
 
     return XCAM_RETURN_NO_ERROR;
@@ -1084,6 +1309,10 @@ IspController::set_3a_config (X3aIspConfig *config, bool first)
         _pending_ispparams_queue.erase(_pending_ispparams_queue.begin());
     }
     _pending_ispparams_queue.push_back(*isp_cfg);
+    if (config->get_frame_id () >= 0) {
+        _pending_params_frame_id = config->get_frame_id ();
+        XCAM_FRAME_TRACE (FrameTraceParamsQueued, _pending_params_frame_id);
+    }
 
     // set initial isp params
     if (_frame_sequence < 0 || first) {
@@ -1094,6 +1323,155 @@ IspController::set_3a_config (X3aIspConfig *config, bool first)
     return ret;
 }
 
+void
+IspController::load_exposure_delay ()
+{
+    SensorExposureDelay delay;
+    char value[32] = {0};
+
+    delay.delay[ExposureComponentTime] = EXPOSURE_TIME_DELAY - 1;
+    delay.delay[ExposureComponentAgain] = EXPOSURE_GAIN_DELAY - 1;
+    delay.delay[ExposureComponentDgain] = EXPOSURE_GAIN_DELAY - 1;
+
+    // "time,again,dgain" latencies in frames of the sensor in use
+#ifdef ANDROID_OS
+    property_get ("persist.vendor.rkisp.exp_delay", value, "");
+#else
+    const char *env = getenv ("persist_camera_engine_exp_delay");
+    if (env)
+        strncpy (value, env, sizeof (value) - 1);
+#endif
+    if (value[0] && !ExposureScheduler::parse_delay (value, delay))
+        XCAM_LOG_WARNING ("ignore malformed exposure delay \"%s\"", value);
+
+    _exp_scheduler.set_delay (delay);
+    XCAM_LOG_DEBUG ("exposure delay time:%d again:%d dgain:%d",
+                    delay.delay[ExposureComponentTime],
+                    delay.delay[ExposureComponentAgain],
+                    delay.delay[ExposureComponentDgain]);
+}
+
+void
+IspController::record_effecting_exposure (int frame_id, const struct rkisp_exposure &exposure)
+{
+    if (_effecting_exposure_map.size() > 10)
+        _effecting_exposure_map.erase(_effecting_exposure_map.begin());
+    _effecting_exposure_map[frame_id] = exposure;
+}
+
+void
+IspController::schedule_exposure (int start_step)
+{
+    // the next SOF is the first one that can still be written
+    int next_sof = _frame_sequence < 0 ? 0 : _frame_sequence + 1;
+    int target = next_sof + _exp_scheduler.get_max_delay ();
+
+    for (int i = start_step; i < _used_exp_que_len; i++, target++) {
+        const struct rkisp_exposure &step = _exposure_queue[i];
+        int32_t value[ExposureComponentCount];
+        uint32_t mask = 0;
+
+        // same writes as set_3a_exposure, vts goes out on every step
+        value[ExposureComponentTime] = step.RegSmoothTime[0];
+        value[ExposureComponentAgain] = step.RegSmoothGains[0];
+        value[ExposureComponentDgain] = step.RegSmoothGains[0];
+        if (step.analog_gain >= 0)
+            mask |= XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentAgain);
+        if (step.coarse_integration_time != 0)
+            mask |= XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentTime);
+        if (step.digital_gain != 0)
+            mask |= XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentDgain);
+
+        _exp_scheduler.schedule (next_sof, target, mask, value, step.RegSmoothFll[0]);
+        record_effecting_exposure (target, step);
+
+        LOGD("|||schedule exposure (%d-%d) fll 0x%x for frame %d expsync in sof %d\n",
+             step.RegSmoothTime[0], step.RegSmoothGains[0], step.RegSmoothFll[0],
+             target, _frame_sequence);
+    }
+}
+
+void
+IspController::apply_scheduled_exposure (int frameid)
+{
+    ExposureWrite write;
+
+    if (_is_exit || !_exp_scheduler.take_writes (frameid, write))
+        return;
+
+    LOGD("|||apply scheduled exposure mask 0x%x time %d again %d dgain %d"
+         " for frame %d-%d-%d expsync in sof %d\n",
+         write.mask,
+         write.value[ExposureComponentTime],
+         write.value[ExposureComponentAgain],
+         write.value[ExposureComponentDgain],
+         write.target[ExposureComponentTime],
+         write.target[ExposureComponentAgain],
+         write.target[ExposureComponentDgain],
+         frameid);
+    write_sensor_exposure (write);
+}
+
+XCamReturn
+IspController::write_sensor_exposure (const ExposureWrite &write)
+{
+    struct v4l2_control ctrl;
+
+    // set vts before exposure time firstly
+    if (write.vts >= 0) {
+        rk_aiq_exposure_sensor_descriptor sensor_desc;
+        get_sensor_descriptor (&sensor_desc);
+
+        int frame_line_length =
+            (sensor_desc.line_periods_per_field < write.vts) ?
+            write.vts : sensor_desc.line_periods_per_field;
+        memset(&ctrl, 0, sizeof(ctrl));
+        ctrl.id = V4L2_CID_VBLANK;
+        ctrl.value = frame_line_length - sensor_desc.sensor_output_height;
+        if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
+            XCAM_LOG_ERROR ("failed to set vblank result(val: %d)", ctrl.value);
+            return XCAM_RETURN_ERROR_IOCTL;
+        }
+    }
+
+    if (write.mask & XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentAgain)) {
+        memset(&ctrl, 0, sizeof(ctrl));
+        ctrl.id = V4L2_CID_ANALOGUE_GAIN;
+        ctrl.value = write.value[ExposureComponentAgain];
+        if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
+            XCAM_LOG_ERROR ("failed to  set again result(val: %d)", ctrl.value);
+            return XCAM_RETURN_ERROR_IOCTL;
+        }
+    }
+    if (write.mask & XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentDgain)) {
+        memset(&ctrl, 0, sizeof(ctrl));
+        ctrl.id = V4L2_CID_GAIN;
+        ctrl.value = write.value[ExposureComponentDgain];
+        if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
+            XCAM_LOG_ERROR ("failed to set dgain result(val: %d)", ctrl.value);
+            return XCAM_RETURN_ERROR_IOCTL;
+        }
+    }
+    if (write.mask & XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentTime)) {
+        memset(&ctrl, 0, sizeof(ctrl));
+        ctrl.id = V4L2_CID_EXPOSURE;
+        ctrl.value = write.value[ExposureComponentTime];
+        if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
+            XCAM_LOG_ERROR ("failed to set integration time result(val: %d)", ctrl.value);
+            return XCAM_RETURN_ERROR_IOCTL;
+        }
+    }
+
+    return XCAM_RETURN_NO_ERROR;
+}
+
+void
+IspController::get_exposure_schedule_stats (ExposureScheduleStats &stats)
+{
+    SmartLock locker (_mutex);
+    _exp_scheduler.get_stats (stats);
+}
+
 void
 IspController::exposure_delay(struct rkisp_exposure isp_exposure, bool first)
 {
@@ -1178,6 +1556,9 @@ IspController::exposure_delay(struct rkisp_exposure isp_exposure, bool first)
             if (i>0 && memcmp(&_exposure_queue[i], &_exposure_queue[i-1], sizeof(_exposure_queue[0])) == 0)
                 _cur_apply_index++;
         }
+
+        if (use_exposure_scheduler (isp_exposure))
+            schedule_exposure (_cur_apply_index);
     }
     // set the initial exposure before streaming
     if (_frame_sequence < 0 || first) {
@@ -1212,13 +1593,11 @@ IspController::set_3a_exposure (struct rkisp_exposure isp_exposure)
     if (_is_exit)
         return XCAM_RETURN_BYPASS;
 
-    if (_effecting_exposure_map.size() > 10)
-        _effecting_exposure_map.erase(_effecting_exposure_map.begin());
     // map the exposure to corresponded effect frame id
     int effecting_frame_id = _frame_sequence + EXPOSURE_TIME_DELAY - 1;
     if (effecting_frame_id < 0)
         effecting_frame_id = 0;
-    _effecting_exposure_map[effecting_frame_id] = isp_exposure;
+    record_effecting_exposure (effecting_frame_id, isp_exposure);
 
     LOGD("----------------------------------------------");
     if (!isp_exposure.IsHdrExp)
@@ -1261,54 +1640,27 @@ IspController::set_3a_exposure (struct rkisp_exposure isp_exposure)
         }
     } else {
         if (!isp_exposure.IsHdrExp) {
-            struct v4l2_control ctrl;
-
-            // set vts before exposure time firstly
-            rk_aiq_exposure_sensor_descriptor sensor_desc;
-            get_sensor_descriptor (&sensor_desc);
-
-            isp_exposure.frame_line_length =
-                (sensor_desc.line_periods_per_field < isp_exposure.RegSmoothFll[0]) ?
-                isp_exposure.RegSmoothFll[0] : sensor_desc.line_periods_per_field;
-            memset(&ctrl, 0, sizeof(ctrl));
-            ctrl.id = V4L2_CID_VBLANK;
-            ctrl.value = isp_exposure.frame_line_length - sensor_desc.sensor_output_height;
-            if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
-                XCAM_LOG_ERROR ("failed to set vblank result(val: %d)", ctrl.value);
-                return XCAM_RETURN_ERROR_IOCTL;
-            }
+            ExposureWrite write;
 
+            xcam_mem_clear (write);
+            write.sof_frame = _frame_sequence;
+            write.vts = isp_exposure.RegSmoothFll[0];
             if (isp_exposure.analog_gain >= 0) {
-                memset(&ctrl, 0, sizeof(ctrl));
-                ctrl.id = V4L2_CID_ANALOGUE_GAIN;
-                /* ctrl.value = isp_exposure.analog_gain; */
-                ctrl.value = isp_exposure.RegSmoothGains[0];
-                if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
-                    XCAM_LOG_ERROR ("failed to  set again result(val: %d)", isp_exposure.RegSmoothGains[0]);
-                    return XCAM_RETURN_ERROR_IOCTL;
-                }
+                write.mask |= XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentAgain);
+                write.value[ExposureComponentAgain] = isp_exposure.RegSmoothGains[0];
             }
             if (isp_exposure.digital_gain!= 0) {
-                memset(&ctrl, 0, sizeof(ctrl));
-                ctrl.id = V4L2_CID_GAIN;
-                /* ctrl.value = isp_exposure.digital_gain; */
-                ctrl.value = isp_exposure.RegSmoothGains[0];
-                if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
-                    XCAM_LOG_ERROR ("failed to set dgain result(val: %d)", isp_exposure.digital_gain);
-                    return XCAM_RETURN_ERROR_IOCTL;
-                }
+                write.mask |= XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentDgain);
+                write.value[ExposureComponentDgain] = isp_exposure.RegSmoothGains[0];
             }
-
             if (isp_exposure.coarse_integration_time!= 0) {
-                memset(&ctrl, 0, sizeof(ctrl));
-                ctrl.id = V4L2_CID_EXPOSURE;
-                /* ctrl.value = isp_exposure.coarse_integration_time; */
-                ctrl.value = isp_exposure.RegSmoothTime[0];
-                if (_sensor_subdev->io_control(VIDIOC_S_CTRL, &ctrl) < 0) {
-                    XCAM_LOG_ERROR ("failed to set integration time result(val: %d)", isp_exposure.RegSmoothTime[0]);
-                    return XCAM_RETURN_ERROR_IOCTL;
-                }
+                write.mask |= XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentTime);
+                write.value[ExposureComponentTime] = isp_exposure.RegSmoothTime[0];
             }
+
+            XCamReturn ret = write_sensor_exposure (write);
+            if (ret != XCAM_RETURN_NO_ERROR)
+                return ret;
         } else {
             struct preisp_hdrae_exp_s hdrae;
 
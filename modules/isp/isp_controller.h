@@ -24,9 +24,22 @@
 #include <map>
 #include "x3a_isp_config.h"
 #include <v4l2_buffer_proxy.h>
+#include <frame_sequencer.h>
+#include "exposure_scheduler.h"
 #include <rk_aiq.h>
 #include <v4l2-subdev.h>
 
+/*
+ * stats buffers in flight with zero-copy stats: 2 queued to the driver,
+ * 1 in the poll thread, 1 being analyzed, 1 held by the 3a compositor
+ * and the analyzer queue, bounded to XCAM_ZERO_COPY_STATS_MAX_QUEUED
+ * with XAnalyzer::set_max_queued_stats so the driver keeps its 2
+ */
+#define XCAM_ZERO_COPY_STATS_MAX_QUEUED 3
+#define XCAM_ZERO_COPY_STATS_BUF_COUNT (5 + XCAM_ZERO_COPY_STATS_MAX_QUEUED)
+// stats wait this long for the SOF of their frame before warning
+#define XCAM_STATS_SOF_TIMEOUT_US (100 * 1000)
+
 namespace XCam {
 
 class V4l2Device;
@@ -66,6 +79,12 @@ public:
     XCamReturn get_vcm_time (struct rk_cam_vcm_tim *vcm_tim);
 
     XCamReturn get_3a_statistics (SmartPtr<X3aIspStatistics> &stats);
+    /*
+     * stats wrap the dequeued v4l2 stats buffer instead of a copy, it is
+     * requeued when the last reference drops. Enabled by property
+     * persist.vendor.rkisp.zerocopystats (env persist_camera_engine_zero_copy_stats)
+     */
+    static bool zero_copy_stats_enabled ();
     XCamReturn set_3a_config (X3aIspConfig *config, bool first = false);
 
     void push_3a_exposure (X3aIspExposureResult *res, bool first = false);
@@ -76,6 +95,7 @@ public:
     XCamReturn set_3a_focus (X3aIspFocusResult *res, bool first = false);
 
     void exposure_delay(struct rkisp_exposure isp_exposure, bool first = false);
+    void get_exposure_schedule_stats (ExposureScheduleStats &stats);
 #if RKISP
     void dump_isp_config(struct rkisp1_isp_params_cfg* isp_params,
                                 struct rkisp_parameters *isp_cfg);
@@ -84,6 +104,8 @@ public:
     XCamReturn set_3a_fl (int fl_mode, float fl_intensity[ISP_CONTRLLER_FLASH_MAX_NUM],
                           int fl_timeout, int fl_on);
     int get_flash_info ();
+    // isp modules sent to the driver vs dropped as unchanged since start
+    void get_module_update_counts (uint64_t &submitted, uint64_t &skipped);
 
 private:
 
@@ -92,9 +114,25 @@ private:
     void gen_full_isp_params(const struct rkisp1_isp_params_cfg *update_params,
                              struct rkisp1_isp_params_cfg *full_params);
     XCamReturn set_3a_config_sync ();
+    void filter_unchanged_modules (struct rkisp1_isp_params_cfg *params);
+    void commit_submitted_modules (const struct rkisp1_isp_params_cfg *params);
+    /*
+     * non-hdr sensors behind a subdev get each smooth exposure step planned
+     * per component latency and written at SOF by the exposure scheduler
+     */
+    bool use_exposure_scheduler (const struct rkisp_exposure &exposure) {
+        return !exposure.IsHdrExp && !_device.ptr () && _sensor_subdev.ptr ();
+    }
+    void load_exposure_delay ();
+    void schedule_exposure (int start_step);
+    void apply_scheduled_exposure (int frameid);
+    XCamReturn write_sensor_exposure (const ExposureWrite &write);
+    void record_effecting_exposure (int frame_id, const struct rkisp_exposure &exposure);
+    void reset_submitted_modules ();
     XCamReturn apply_otp_config (struct rkisp_parameters *isp_cfg);
 private:
     volatile bool            _is_exit;
+    bool                     _zero_copy_stats;
     /* rkisp1x */
     SmartPtr<V4l2Device>     _device;
     SmartPtr<V4l2Device>     _isp_device;
@@ -123,21 +161,52 @@ private:
     int                   _cur_apply_index;
     int                   _max_exp_que_len;
     int                   _used_exp_que_len;
+    ExposureScheduler     _exp_scheduler;
 
     Mutex             _mutex;
-    XCam::Cond        _frame_sequence_cond;
+    // pairs SOF events with the stats of the same frame
+    FrameSequencer    _frame_sequencer;
 
     struct rkisp1_isp_params_cfg _full_active_isp_params;
+    /*
+     * module configs the driver last received, a module is only flagged in
+     * module_cfg_update when its config changed
+     */
+#define ISP_PARAMS_MODULE_NUM (CIFISP_RK_IESHARP_ID + 1)
+    struct rkisp1_isp_params_cfg _submitted_isp_params;
+    uint32_t          _submitted_modules;
+    uint64_t          _module_submitted_count;
+    uint64_t          _module_skipped_count;
     int               _isp_ver;
     std::map<int, struct rkisp_exposure> _effecting_exposure_map;
+    /*
+     * params in effect for the recent frames, slot frame_id % depth.
+     * Only the modules get_isp_parameter hands back are kept, not the
+     * whole rkisp1_isp_params_cfg.
+     */
+#define ISP_EFFECT_PARAMS_RING_DEPTH 16
     struct rkisp_effect_params {
-        struct rkisp1_isp_params_cfg isp_params;
+        int frame_id; // -1 for unused slot
+        struct cifisp_awb_gain_config awb_gain_config;
+        struct cifisp_ctk_config ctk_config;
+        struct cifisp_bls_config bls_config;
+        struct cifisp_awb_meas_config awb_meas_config;
         struct rkisp_awb_algo awb_algo_results;
         int64_t frame_sof_ts;
         rkisp_flash_setting_t flash_settings;
     };
-    std::map<int, struct rkisp_effect_params> _effecting_ispparm_map;
+    struct rkisp_effect_params _effecting_ispparm_ring[ISP_EFFECT_PARAMS_RING_DEPTH];
+    int _effecting_ispparm_latest;
+    void reset_effect_params ();
+    // slot of @frame_id, a stale slot is cleared and claimed
+    struct rkisp_effect_params* get_effect_params (int frame_id);
+    // params of @frame_id or the closest older frame still in the ring
+    struct rkisp_effect_params* find_effect_params (int frame_id);
+    void set_effect_isp_params (struct rkisp_effect_params *effect,
+                                const struct rkisp1_isp_params_cfg *isp_params);
     std::vector<struct rkisp_parameters> _pending_ispparams_queue;
+    // stats frame id of the latest pending params, for frame tracing
+    int _pending_params_frame_id;
     int _isp_acq_out_width;
     int _isp_acq_out_height;
     rkisp_flash_setting_t _flash_settings;
@@ -202,7 +202,7 @@ IspImageProcessor::apply_exposure_result (X3aResultList &results)
     {
         XCAM_LOG_DEBUG ("apply_exposure_result type: %x", (*iter)->get_type());
         if ((*iter)->get_type() == X3aIspConfig::IspExposureParameters) {
-            SmartPtr<X3aIspExposureResult> res = (*iter).dynamic_cast_ptr<X3aIspExposureResult> ();
+            BorrowedPtr<X3aIspExposureResult> res = (*iter).dynamic_cast_borrow<X3aIspExposureResult> ();
 
             if (!res.ptr ()) {
                 XCAM_LOG_WARNING ("isp 3a exposure result is null");
@@ -218,7 +218,7 @@ IspImageProcessor::apply_exposure_result (X3aResultList &results)
 
             results.erase (iter++);
         } else if ((*iter)->get_type() == XCAM_3A_RESULT_EXPOSURE) {
-            SmartPtr<X3aExposureResult> res = (*iter).dynamic_cast_ptr<X3aExposureResult> ();
+            BorrowedPtr<X3aExposureResult> res = (*iter).dynamic_cast_borrow<X3aExposureResult> ();
             struct rkisp_exposure isp_exposure;
             xcam_mem_clear (isp_exposure);
             XCAM_ASSERT (res.ptr ());
@@ -252,7 +252,7 @@ IspImageProcessor::apply_focus_result (X3aResultList &results)
     {
         XCAM_LOG_DEBUG ("apply_focus_result type: %d", (*iter)->get_type());
         if ((*iter)->get_type() == X3aIspConfig::IspFocusParameters) {
-            SmartPtr<X3aIspFocusResult> res = (*iter).dynamic_cast_ptr<X3aIspFocusResult> ();
+            BorrowedPtr<X3aIspFocusResult> res = (*iter).dynamic_cast_borrow<X3aIspFocusResult> ();
             if (!res.ptr ()) {
                 XCAM_LOG_WARNING ("isp 3a exposure result is null");
             } else {
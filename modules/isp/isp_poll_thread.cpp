@@ -63,6 +63,9 @@ IspPollThread::start ()
     if (_3a_stats_pool.ptr() == nullptr) {
         SmartPtr<X3aStatsPool> stats_pool = new X3aStatisticsQueue;
         XCAM_ASSERT (stats_pool.ptr ());
+        // per-frame pool of bounded depth, see init_3a_stats_pool,
+        // keep its free list off the heap
+        stats_pool->set_ring_capacity (12);
         _3a_stats_pool = stats_pool;
     }
 
@@ -117,6 +120,8 @@ IspPollThread::init_3a_stats_pool ()
         XCAM_LOG_WARNING ("init_3a_stats_pool failed to reserve stats buffer.");
         return XCAM_RETURN_ERROR_MEM;
     }
+    // absorb short analyzer stalls instead of blocking the stats poll
+    _3a_stats_pool->set_elastic (12);
     XCAM_LOG_WARNING ("init_3a_stats_pool successed.");
     return XCAM_RETURN_NO_ERROR;
 }
@@ -20,6 +20,7 @@ using namespace XCam;
 _AiqInputParams::_AiqInputParams():
     reqId(0)
     ,tuningFlag(0)
+    ,tuningGroups(0)
 {
     memset(&aeInputParams, 0, sizeof(AeInputParams));
     memset(&awbInputParams, 0, sizeof(AwbInputParams));
@@ -54,6 +55,7 @@ _AiqInputParams &_AiqInputParams::operator=(const _AiqInputParams &other)
 
     this->reqId = other.reqId;
     this->tuningFlag = other.tuningFlag;
+    this->tuningGroups = other.tuningGroups;
     memcpy(&this->aeInputParams, &other.aeInputParams, sizeof(AeInputParams));
     memcpy(&this->awbInputParams, &other.awbInputParams, sizeof(AwbInputParams));
     memcpy(&this->afInputParams, &other.afInputParams, sizeof(AfInputParams));
@@ -26,6 +26,7 @@ using ::android::hardware::camera::common::V1_0::helper::CameraMetadata;
 #include <camera/CameraMetadata.h>
 #endif
 #include <base/xcam_params.h>
+#include <object_pool.h>
 
 using namespace android;
 namespace XCam {
@@ -317,7 +318,10 @@ typedef struct _RestartInputParams {
   uint8_t on;
 }__attribute__((packed)) RestartInputParams;
 
-typedef struct _AiqInputParams {
+typedef struct _AiqInputParams
+    : public RefObj
+    , public PooledObject<_AiqInputParams>
+{
     _AiqInputParams &operator=(const _AiqInputParams &other);
     unsigned int    reqId;
     AeInputParams   aeInputParams;
@@ -336,6 +340,7 @@ typedef struct _AiqInputParams {
     FltInputParams   fltInputParams;
     RestartInputParams restartInputParams;
     bool                  tuningFlag;
+    uint32_t              tuningGroups;   // rkcamera3_privatemeta_enum_tuning_group_t mask
     // for tuning tool END
     AfInputParams   afInputParams;
     AAAControls     aaaControls;
@@ -30,6 +30,7 @@
 
 #define MAX_STATISTICS_WIDTH 150
 #define MAX_STATISTICS_HEIGHT 150
+#define EXIF_MAKERNOTE_SIZE 600
 
 //#define USE_RGBS_GRID_WEIGHTING
 #define USE_HIST_GRID_WEIGHTING
@@ -252,7 +253,7 @@ AiqAeHandler::processAeMetaResults(AecResult_t aec_results, X3aResultList &outpu
     }
 
     if (!res.ptr()) {
-        res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
+        res = _aiq_compositor->new_meta_result ();
         XCAM_ASSERT (res.ptr());
         output.push_back(res);
     }
@@ -453,7 +454,7 @@ AiqAwbHandler::processAwbMetaResults(CamIA10_AWB_Result_t awb_results, X3aResult
     }
 
     if (!res.ptr()) {
-        res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
+        res = _aiq_compositor->new_meta_result ();
         XCAM_ASSERT (res.ptr());
         output.push_back(res);
     }
@@ -528,7 +529,7 @@ AiqAfHandler::processAfMetaResults(XCam3aResultFocus af_results, X3aResultList &
     }
 
     if (!res.ptr()) {
-        res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
+        res = _aiq_compositor->new_meta_result ();
         XCAM_ASSERT (res.ptr());
         output.push_back(res);
     }
@@ -674,7 +675,7 @@ AiqCommonHandler::processMiscMetaResults(struct CamIA10_Results &ia10_results, X
     }
 
     if (!res.ptr()) {
-        res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
+        res = _aiq_compositor->new_meta_result ();
         XCAM_ASSERT (res.ptr());
         output.push_back(res);
     }
@@ -690,23 +691,41 @@ AiqCommonHandler::processMiscMetaResults(struct CamIA10_Results &ia10_results, X
     metadata->update(RKCAMERA3_PRIVATEDATA_FRAME_SOF_TIMESTAMP,
                      &frame_sof_ts,
                      1);
-    int en = _aiq_compositor->getAiqInputParams().ptr() ? _aiq_compositor->getAiqInputParams()->tuningFlag : 0;
-    if(en){
+    uint32_t groups = _aiq_compositor->getAiqInputParams().ptr() ? _aiq_compositor->getAiqInputParams()->tuningGroups : 0;
+    if (groups != _tuning_groups || first) {
+        // (re)subscribed groups start over with a full report
+        LOGD("tuning tool groups 0x%x -> 0x%x", _tuning_groups, groups);
+        _tuning_groups = groups;
+        _tuning_meta_cache.clear();
+    }
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_MODULE_INFO)
         processTuningToolModuleInfoMetaResults(metadata);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_SENSOR_INFO)
         processTuningToolSensorInfoMetaResults(metadata);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_PROTOCOL_INFO)
         processTuningToolProtocolInfoMetaResults(metadata);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_BLS)
         processTuningToolBlsMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_LSC)
         processTuningToolLscMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_CCM)
         processTuningToolCcmMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB)
         processTuningToolAwbMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB_WP)
         processTuningToolAwbWpMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB_CURV)
         processTuningToolAwbCurvMetaResults(metadata);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_AWB_REFGAIN)
         processTuningToolAwbRefGainMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_GOC)
         processTuningToolGocMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_CPROC)
         processTuningToolCprocMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_DPF)
         processTuningToolDpfMetaResults(metadata, ia10_results);
+    if (groups & RKCAMERA3_PRIVATEDATA_TUNING_GROUP_FLT)
         processTuningToolFltMetaResults(metadata, ia10_results);
-    }
     processExifMakernote(metadata, ia10_results);
     // Update reqId for the result in order to match the setting param
     int reqId = _aiq_compositor->getAiqInputParams().ptr() ? _aiq_compositor->getAiqInputParams()->reqId : -1;
@@ -767,6 +786,20 @@ AiqCommonHandler::processMiscMetaResults(struct CamIA10_Results &ia10_results, X
     return ret;
 }
 
+void
+AiqCommonHandler::updateTuningMeta(CameraMetadata* metadata, uint32_t tag, const uint8_t *data, size_t size)
+{
+    std::vector<uint8_t> &last = _tuning_meta_cache[tag];
+
+    if (last.size() == size && !memcmp(&last[0], data, size)) {
+        ++_tuning_meta_unchanged;
+        return;
+    }
+    last.assign(data, data + size);
+    ++_tuning_meta_updated;
+    metadata->update(tag, data, size);
+}
+
 void
 AiqCommonHandler::processTuningToolModuleInfoMetaResults(CameraMetadata* metadata)
 {
@@ -803,7 +836,7 @@ AiqCommonHandler::processTuningToolModuleInfoMetaResults(CameraMetadata* metadat
      pchr += sizeof(_otp_info.awb.golden_gb_value);
      memcpy(pchr, &_otp_info.awb.golden_b_value, sizeof(_otp_info.awb.golden_b_value));
      pchr += sizeof(_otp_info.awb.golden_b_value);
-     metadata->update(RKCAMERA3_PRIVATEDATA_ISP_MODULE_INFO,(uint8_t*)moduleinfo,sizeof(moduleinfo));
+     updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_MODULE_INFO, moduleinfo, sizeof(moduleinfo));
 }
 
 void
@@ -814,7 +847,7 @@ AiqCommonHandler::processTuningToolProtocolInfoMetaResults(CameraMetadata* metad
      magicCode = _aiq_compositor->_isp10_engine->getCalibdbMagicVerCode();
      memset(protocolinfo, 0, sizeof(protocolinfo));
      memcpy(protocolinfo, &magicCode, sizeof(magicCode));
-     metadata->update(RKCAMERA3_PRIVATEDATA_ISP_PROTOCOL_INFO,(uint8_t*)protocolinfo,sizeof(protocolinfo));
+     updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_PROTOCOL_INFO, protocolinfo, sizeof(protocolinfo));
 }
 
 void
@@ -840,7 +873,7 @@ AiqCommonHandler::processTuningToolSensorInfoMetaResults(CameraMetadata* metadat
         sensor_info[10] = 1;
     else
         sensor_info[10] = 0;
-    metadata->update(RKCAMERA3_PRIVATEDATA_ISP_SENSOR_INFO,(uint8_t*)sensor_info,sizeof(sensor_info));
+    updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_SENSOR_INFO, sensor_info, sizeof(sensor_info));
 
 }
 
@@ -893,7 +926,7 @@ AiqCommonHandler::processTuningToolBlsMetaResults(CameraMetadata* metadata, stru
     memcpy(pbuf, &_aiq_compositor->tool_isp_params.bls_config.fixed_val.gr,2);
     pbuf += 2;
     memcpy(pbuf, &_aiq_compositor->tool_isp_params.bls_config.fixed_val.r,2);
-    metadata->update(RKCAMERA3_PRIVATEDATA_ISP_BLS,(uint8_t*)blc_param,sizeof(blc_param));
+    updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_BLS, blc_param, sizeof(blc_param));
 
 }
 
@@ -936,7 +969,7 @@ AiqCommonHandler::processTuningToolLscMetaResults(CameraMetadata* metadata, stru
         memcpy(pbuf, plsc->LscYSizeTbl, sizeof(plsc->LscYSizeTbl));
         pbuf += sizeof(plsc->LscYSizeTbl);
         memcpy(pbuf, plsc->LscMatrix, sizeof(plsc->LscMatrix));
-        metadata->update(RKCAMERA3_PRIVATEDATA_ISP_LSC_GET, (uint8_t*)lsc_param, sizeof(lsc_param));
+        updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_LSC_GET, lsc_param, sizeof(lsc_param));
     }
 }
 
@@ -1029,7 +1062,7 @@ AiqCommonHandler::processTuningToolCcmMetaResults(CameraMetadata* metadata, stru
     }
 #endif
 
-    metadata->update(RKCAMERA3_PRIVATEDATA_ISP_CCM_GET, (uint8_t*)ccm_param, sizeof(ccm_param));
+    updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_CCM_GET, ccm_param, sizeof(ccm_param));
 }
 
 void
@@ -1044,7 +1077,7 @@ AiqCommonHandler::processTuningToolAwbMetaResults(CameraMetadata* metadata, stru
     pbuf += sizeof(ia10_results.awb.forceWbGains);
     *pbuf++ = (ia10_results.awb.forceIlluFlag==BOOL_TRUE) ? 1 : 0;
     strcpy((char*)pbuf, ia10_results.awb.forceIllName);
-    metadata->update(RKCAMERA3_PRIVATEDATA_ISP_AWB_GET, (uint8_t*)awb_param, sizeof(awb_param));
+    updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_AWB_GET, awb_param, sizeof(awb_param));
 }
 
 void
@@ -1101,7 +1134,7 @@ AiqCommonHandler::processTuningToolAwbWpMetaResults(CameraMetadata* metadata, st
     memcpy(pbuf, &ia10_results.awb.WbClippedGainsOverG.GainBOverG, 4);//wbClipGainOver.GainBOverG
     pbuf += 4;
     memcpy(pbuf, &ia10_results.awb.WbGainsOverG.GainBOverG, 4);//wbGainOver.GainBOverG
-    metadata->update(RKCAMERA3_PRIVATEDATA_ISP_AWB_WP, (uint8_t*)awb_wp, sizeof(awb_wp));
+    updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_AWB_WP, awb_wp, sizeof(awb_wp));
 }
 
 void
@@ -1140,7 +1173,7 @@ AiqCommonHandler::processTuningToolAwbCurvMetaResults(CameraMetadata* metadata)
         pbuf += pAwbGlobal->AwbGlobalFadeParm.ArraySize2*4;
         memcpy(pbuf, pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2, pAwbGlobal->AwbGlobalFadeParm.ArraySize2*4);
         pbuf += pAwbGlobal->AwbGlobalFadeParm.ArraySize2*4;
-        metadata->update(RKCAMERA3_PRIVATEDATA_ISP_AWB_CURV, (uint8_t*)awb_cur, sizeof(awb_cur));
+        updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_AWB_CURV, awb_cur, sizeof(awb_cur));
     }
 }
 
@@ -1154,7 +1187,7 @@ AiqCommonHandler::processTuningToolAwbRefGainMetaResults(CameraMetadata* metadat
     memcpy(pbuf, &ia10_results.awb.curIllName, sizeof(ia10_results.awb.curIllName));
     pbuf += sizeof(ia10_results.awb.curIllName);
     memcpy(pbuf, &ia10_results.awb.refWbgain, sizeof(ia10_results.awb.refWbgain));
-    metadata->update(RKCAMERA3_PRIVATEDATA_ISP_AWB_REFGAIN, (uint8_t*)awb_ref_gain_param, sizeof(awb_ref_gain_param));
+    updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_AWB_REFGAIN, awb_ref_gain_param, sizeof(awb_ref_gain_param));
 }
 
 void
@@ -1182,7 +1215,7 @@ AiqCommonHandler::processTuningToolGocMetaResults(CameraMetadata* metadata, stru
             *pbuf++ = (uint8_t)ia10_results.wdr.enabled;//wdr status;
             *pbuf++ = (uint8_t)pGocProfile->def_cfg_mode;
             memcpy(pbuf, pGocProfile->GammaY, sizeof(pGocProfile->GammaY));
-            metadata->update(RKCAMERA3_PRIVATEDATA_ISP_GOC_NORMAL+i,(uint8_t*)goc_param,sizeof(goc_param));
+            updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_GOC_NORMAL+i, goc_param, sizeof(goc_param));
         }
     }
 
@@ -1218,7 +1251,7 @@ AiqCommonHandler::processTuningToolCprocMetaResults(CameraMetadata* metadata, st
         temp = -temp;
         *pbuf = (int8_t)temp;
     }
-    metadata->update(RKCAMERA3_PRIVATEDATA_ISP_CPROC_PREVIEW,(uint8_t*)cproc_param,sizeof(cproc_param));
+    updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_CPROC_PREVIEW, cproc_param, sizeof(cproc_param));
 }
 
 void
@@ -1258,7 +1291,7 @@ AiqCommonHandler::processTuningToolDpfMetaResults(CameraMetadata* metadata, stru
         memcpy(pbuf, &pDpfProfile->NfGains.fCoeff[2], 4);
         pbuf +=4;
         memcpy(pbuf, &pDpfProfile->NfGains.fCoeff[3], 4);
-        metadata->update(RKCAMERA3_PRIVATEDATA_ISP_DPF_GET,(uint8_t*)dpf_param,sizeof(dpf_param));
+        updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_DPF_GET, dpf_param, sizeof(dpf_param));
     }
 }
 
@@ -1334,7 +1367,7 @@ AiqCommonHandler::processTuningToolFltMetaResults(CameraMetadata* metadata, stru
                 memcpy(pbuf,pFilterProfile->FiltLevelRegConf.p_fac_bl0,pFilterProfile->FiltLevelRegConf.ArraySize*4);
                 pbuf += pFilterProfile->FiltLevelRegConf.ArraySize*4;
                 memcpy(pbuf,pFilterProfile->FiltLevelRegConf.p_fac_bl1,pFilterProfile->FiltLevelRegConf.ArraySize*4);
-                metadata->update(RKCAMERA3_PRIVATEDATA_ISP_FLT_NORMAL+i, (uint8_t*)flt_param, sizeof(flt_param));
+                updateTuningMeta(metadata, RKCAMERA3_PRIVATEDATA_ISP_FLT_NORMAL+i, flt_param, sizeof(flt_param));
             }
         }
     }
@@ -1343,7 +1376,7 @@ AiqCommonHandler::processTuningToolFltMetaResults(CameraMetadata* metadata, stru
 void
 AiqCommonHandler::processExifMakernote(CameraMetadata* metadata, struct CamIA10_Results &ia10_results)
 {
-    char makernote[600], str[64], illName[32];
+    char makernote[EXIF_MAKERNOTE_SIZE], str[64], illName[32];
     char *pbuf = makernote;
     int noIlluProfiles = 0;
     CamCalibDbHandle_t  hCalib;
@@ -1393,7 +1426,7 @@ AiqCommonHandler::processToneMapsMetaResults(CamerIcIspGocConfig_t goc, X3aResul
     }
 
     if (!res.ptr()) {
-        res = new XmetaResult(XCAM_IMAGE_PROCESS_ONCE);
+        res = _aiq_compositor->new_meta_result ();
         XCAM_ASSERT (res.ptr());
         output.push_back(res);
     }
@@ -1418,6 +1451,10 @@ AiqAeHandler::analyze (X3aResultList &output, bool first)
         _latestInputParams = *inputParams.ptr();
     }
 
+    // converged on a static scene, the last exposure stays in effect
+    if (!first && !_aiq_compositor->need_run_3a (ConvergeAlgoAe))
+        return XCAM_RETURN_NO_ERROR;
+
     if (forceAeRun || mAeState->getState() != ANDROID_CONTROL_AE_STATE_LOCKED) {
 
         SmartPtr<X3aResult> result;
@@ -1825,6 +1862,9 @@ AiqAwbHandler::analyze (X3aResultList &output, bool first)
         bool forceAwbRun = (inputParams->reqId == 0);
     }
 
+    if (!first && !_aiq_compositor->need_run_3a (ConvergeAlgoAwb))
+        return XCAM_RETURN_NO_ERROR;
+
     if (forceAwbRun || mAwbState->getState() != ANDROID_CONTROL_AWB_STATE_LOCKED) {
 
         if (inputParams.ptr())
@@ -1890,6 +1930,9 @@ AiqAfHandler::analyze (X3aResultList &output, bool first)
     xcam_mem_clear(isp_result);
     XCamAfParam param = this->get_params_unlock();
 
+    if (!first && !_aiq_compositor->need_run_3a (ConvergeAlgoAf))
+        return XCAM_RETURN_NO_ERROR;
+
     if (_aiq_compositor->_isp10_engine->runAf(&param, &isp_result, first) != 0)
         return XCAM_RETURN_NO_ERROR;
 
@@ -1910,12 +1953,18 @@ AiqCommonHandler::AiqCommonHandler (SmartPtr<RKiqCompositor> &aiq_compositor)
     , _gbce_result (NULL)
     , _stillcap_sync_needed(false)
     , _stillcap_sync_state(STILLCAP_SYNC_STATE_IDLE)
+    , _tuning_groups(0)
+    , _tuning_meta_updated(0)
+    , _tuning_meta_unchanged(0)
 {
     initTonemaps();
     memset(&_otp_info, 0, sizeof(_otp_info));
 }
 AiqCommonHandler::~AiqCommonHandler ()
 {
+    if (_tuning_meta_updated || _tuning_meta_unchanged)
+        LOGD("tuning tool metadata: %llu reported, %llu unchanged and skipped",
+             (unsigned long long)_tuning_meta_updated, (unsigned long long)_tuning_meta_unchanged);
     delete[] mRGammaLut;
     delete[] mGGammaLut;
     delete[] mBGammaLut;
@@ -1969,12 +2018,16 @@ RKiqCompositor::RKiqCompositor ()
     ,_procReqId(-1)
 {
     xcam_mem_clear (_frame_params);
-    xcam_mem_clear (_isp_stats);
+    xcam_mem_clear (_no_isp_stats);
+    _isp_stats = &_no_isp_stats;
     xcam_mem_clear (_ia_stat);
     xcam_mem_clear (_ia_dcfg);
     xcam_mem_clear (_ia_results);
     xcam_mem_clear (_isp_cfg);
-    _isp_stats.frame_id = -1;
+    _no_isp_stats.frame_id = -1;
+    xcam_mem_clear (_planned_ae_params);
+    xcam_mem_clear (_planned_awb_params);
+    xcam_mem_clear (_planned_af_params);
     _handle_manager = new X3aHandlerManager();
 #if 1
     _ae_desc = _handle_manager->get_ae_handler_desc();
@@ -1999,6 +2052,14 @@ RKiqCompositor::~RKiqCompositor ()
         _isp10_engine = NULL;
     }
 
+    if (_converge_scheduler.is_enabled ()) {
+        ConvergeScheduleStats stats;
+        _converge_scheduler.get_stats (stats);
+        XCAM_LOG_INFO (
+            "3a converge schedule over %lld frames skipped ae:%lld awb:%lld af:%lld",
+            (long long)stats.frames, (long long)stats.skipped[ConvergeAlgoAe],
+            (long long)stats.skipped[ConvergeAlgoAwb], (long long)stats.skipped[ConvergeAlgoAf]);
+    }
     XCAM_LOG_DEBUG ("~RKiqCompositor destructed");
 }
 
@@ -2012,9 +2073,74 @@ RKiqCompositor::open (ia_binary_data &cpf)
 void
 RKiqCompositor::close ()
 {
+    _isp_stats = &_no_isp_stats;
+    _isp_stats_buf.release ();
+    _converge_scheduler.reset ();
     XCAM_LOG_DEBUG ("Aiq compositor closed");
 }
 
+void
+RKiqCompositor::set_converge_schedule (const ConvergeScheduleConfig &config)
+{
+    _converge_scheduler.set_config (config);
+    _converge_scheduler.set_enabled (true);
+    XCAM_LOG_INFO ("3a converge schedule cadence:%d max skip:%d tolerance:%d",
+                   config.cadence, config.max_skip, config.tolerance);
+}
+
+uint32_t
+RKiqCompositor::get_converged_3a ()
+{
+    uint32_t converged = 0;
+
+    if (_ia_results.aec.converged)
+        converged |= XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAe);
+    if (_ia_results.awb.converged)
+        converged |= XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAwb);
+    if (_ia_results.af.status != rk_aiq_af_status_local_search &&
+            _ia_results.af.status != rk_aiq_af_status_extended_search &&
+            _ia_results.af.status != rk_aiq_af_status_depth_search)
+        converged |= XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAf);
+    return converged;
+}
+
+void
+RKiqCompositor::plan_3a_runs ()
+{
+    StatsSignature sig;
+    uint32_t force = 0;
+
+    if (!_converge_scheduler.is_enabled ())
+        return;
+
+    // flash, capture and tuning frames always get fresh results
+    if (_ia_stat.frame_status != CAMIA10_FRAME_STATUS_OK ||
+            _ia_stat.uc == UC_PRE_CAPTRUE || _ia_stat.uc == UC_CAPTURE || _tuning_flag)
+        force = XCAM_CONVERGE_ALGO_ALL;
+
+    if (_inputParams.ptr ()) {
+        if (_inputParams->aaaControls.ae.aePreCaptureTrigger || _inputParams->stillCapSyncCmd)
+            force = XCAM_CONVERGE_ALGO_ALL;
+        if (_inputParams->aaaControls.af.afTrigger)
+            force |= XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAf);
+
+        if (memcmp (&_planned_ae_params, &_inputParams->aeInputParams.aeParams, sizeof (XCamAeParam)))
+            force |= XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAe);
+        if (memcmp (&_planned_awb_params, &_inputParams->awbInputParams.awbParams, sizeof (XCamAwbParam)))
+            force |= XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAwb);
+        if (memcmp (&_planned_af_params, &_inputParams->afInputParams.afParams, sizeof (XCamAfParam)))
+            force |= XCAM_CONVERGE_ALGO_MASK (ConvergeAlgoAf);
+        _planned_ae_params = _inputParams->aeInputParams.aeParams;
+        _planned_awb_params = _inputParams->awbInputParams.awbParams;
+        _planned_af_params = _inputParams->afInputParams.afParams;
+    }
+
+    ConvergeScheduler::compute_signature (_isp_stats, sig);
+    uint32_t run = _converge_scheduler.plan (sig, get_converged_3a (), force);
+    XCAM_LOG_DEBUG ("3a converge schedule frame %d run mask 0x%x (force 0x%x)",
+                    _isp_stats->frame_id, run, force);
+}
+
 void RKiqCompositor::set_isp_ctrl_device(Isp10Engine* dev) {
     if (dev == NULL) {
         XCAM_LOG_ERROR ("ISP control device is null");
@@ -2111,7 +2237,7 @@ RKiqCompositor::set_sensor_mode_data (struct isp_supplemental_sensor_mode_data *
         }
         LOGD("stats id %d, usecase %d -> %d, frameUseCase %d, new_aestate %d, "
              "stillcap_sync_needed %d, sync_cmd %d, sync_state %d",
-             _isp_stats.frame_id, cur_usecase, new_usecase, frameUseCase,
+             _isp_stats->frame_id, cur_usecase, new_usecase, frameUseCase,
              new_aestate, _common_handler->_stillcap_sync_needed,
              _inputParams->stillCapSyncCmd, _common_handler->_stillcap_sync_state);
         _ia_dcfg.uc = new_usecase;
@@ -2253,9 +2379,11 @@ RKiqCompositor::set_3a_stats (SmartPtr<X3aIspStatistics> &stats)
         return false;
     }
 
-    _isp_stats = *(struct cifisp_stat_buffer*)stats->get_isp_stats();
+    // keep the stats alive instead of copying them, zero-copy stats hold the v4l2 buffer
+    _isp_stats_buf = stats;
+    _isp_stats = (struct cifisp_stat_buffer*)stats->get_isp_stats();
     frame_ts = _ia_stat.stats_sof_ts / 1000;
-    XCAM_LOG_DEBUG ("set_3a_stats meas type: %d", _isp_stats.meas_type);
+    XCAM_LOG_DEBUG ("set_3a_stats meas type: %d", _isp_stats->meas_type);
 
     vcm_ts = (int64_t)_ia_stat.vcm_tim.vcm_end_t.tv_sec * 1000 * 1000 +
              (int64_t)_ia_stat.vcm_tim.vcm_end_t.tv_usec;
@@ -2291,13 +2419,13 @@ RKiqCompositor::set_3a_stats (SmartPtr<X3aIspStatistics> &stats)
 
         }
         XCAM_LOG_DEBUG ("stats id %d,frame_status: %d, effect_ts %lld, cur_exptime %f, frame_ts %lld",
-            _isp_stats.frame_id,  _ia_stat.frame_status,
+            _isp_stats->frame_id,  _ia_stat.frame_status,
             _ia_stat.flash_status.effect_ts / 1000, cur_exptime / 1000, frame_ts / 1000);
     } else
         _ia_stat.frame_status = CAMIA10_FRAME_STATUS_OK;
     // clear old value 
     _ia_stat.meas_type = 0;
-    _isp10_engine->convertIspStats(&_isp_stats, &_ia_stat);
+    _isp10_engine->convertIspStats(_isp_stats, &_ia_stat);
     // record all stats types fore same frame before,
     // stats of one frame may come in several times
     _all_stats_meas_types |= _ia_stat.meas_type;
@@ -2433,6 +2561,8 @@ void RKiqCompositor::tuning_tool_set_lsc()
                     memcpy(plsc->LscXSizeTbl,lscprofile.LscXSizeTbl,sizeof(lscprofile.LscXSizeTbl));
                     memcpy(plsc->LscYSizeTbl,lscprofile.LscYSizeTbl,sizeof(lscprofile.LscYSizeTbl));
                     memcpy(plsc->LscMatrix,lscprofile.LscMatrix,sizeof(lscprofile.LscMatrix));
+                    // changed in place, the engine must not reuse what it cached from it
+                    CamCalibDbTouch(hCalib);
                 }
             }
             struct HAL_ISP_cfg_s cfg;
@@ -2498,9 +2628,8 @@ void RKiqCompositor::tuning_tool_set_ccm(CamIA10_AWB_Result_t &awb_results)
             cfg.ctk_cfg->ct_offset_r = ccProfile.CrossTalkOffset.fCoeff[0];
             cfg.ctk_cfg->ct_offset_g = ccProfile.CrossTalkOffset.fCoeff[1];
             cfg.ctk_cfg->ct_offset_b = ccProfile.CrossTalkOffset.fCoeff[2];
-            for(int i=0; i<9; i++){
-                _results_for_tool.awb.CcMatrix.Coeff[i] = UtlFloatToFix_S0407(ccProfile.CrossTalkCoeff.fCoeff[i]);
-             }
+            UtlFloatToFixArray_S0407(ccProfile.CrossTalkCoeff.fCoeff,
+                                     _results_for_tool.awb.CcMatrix.Coeff, 9);
             _results_for_tool.awb.CcOffset.Red = UtlFloatToFix_S1200(ccProfile.CrossTalkOffset.fCoeff[0]);
             _results_for_tool.awb.CcOffset.Green = UtlFloatToFix_S1200(ccProfile.CrossTalkOffset.fCoeff[1]);
             _results_for_tool.awb.CcOffset.Blue = UtlFloatToFix_S1200(ccProfile.CrossTalkOffset.fCoeff[2]);
@@ -2509,9 +2638,8 @@ void RKiqCompositor::tuning_tool_set_ccm(CamIA10_AWB_Result_t &awb_results)
             _isp10_engine->configureISP(&cfg);
             _isp10_engine->setTuningToolAwbParams(NULL);
             #else
-            for(int i=0; i<9; i++){
-                _results_for_tool.awb.CcMatrix.Coeff[i] = UtlFloatToFix_S0407(ccProfile.CrossTalkCoeff.fCoeff[i]);
-             }
+            UtlFloatToFixArray_S0407(ccProfile.CrossTalkCoeff.fCoeff,
+                                     _results_for_tool.awb.CcMatrix.Coeff, 9);
             _results_for_tool.awb.CcOffset.Red = UtlFloatToFix_S1200(ccProfile.CrossTalkOffset.fCoeff[0]);
             _results_for_tool.awb.CcOffset.Green = UtlFloatToFix_S1200(ccProfile.CrossTalkOffset.fCoeff[1]);
             _results_for_tool.awb.CcOffset.Blue = UtlFloatToFix_S1200(ccProfile.CrossTalkOffset.fCoeff[2]);
@@ -2660,6 +2788,7 @@ void RKiqCompositor::tuning_tool_set_awb_wp()
             pAwbGlobal->fRegionSize = _inputParams->awbWpInputParams.fRegionSize;
             pAwbGlobal->fRegionSizeInc = _inputParams->awbWpInputParams.fRegionSizeInc;
             pAwbGlobal->fRegionSizeDec = _inputParams->awbWpInputParams.fRegionSizeDec;
+            CamCalibDbTouch(hCalib);
         }
         #if 0
         memset(&cfg, 0, sizeof(cfg));
@@ -2723,6 +2852,7 @@ void RKiqCompositor::tuning_tool_set_awb_curve()
               pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2[i] = _inputParams->awbCurveInputParams.afGlobalFade2[i];
               pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2[i] = _inputParams->awbCurveInputParams.afGlobalGainDistance2[i];
             }
+            CamCalibDbTouch(hCalib);
         }
         struct HAL_ISP_cfg_s cfg;
         memset(&cfg, 0, sizeof(cfg));
@@ -2753,6 +2883,7 @@ void RKiqCompositor::tuning_tool_set_awb_refgain()
             pIllumination->referenceWBgain.fCoeff[1] = _inputParams->awbRefGainInputParams.refGrGain;
             pIllumination->referenceWBgain.fCoeff[2] = _inputParams->awbRefGainInputParams.refGbGain;
             pIllumination->referenceWBgain.fCoeff[3] = _inputParams->awbRefGainInputParams.refBGain;
+            CamCalibDbTouch(hCalib);
             _isp10_engine->setTuningToolAwbParams(NULL);
         }
     }
@@ -2773,6 +2904,7 @@ void RKiqCompositor::tuning_tool_set_goc()
             CamCalibDbGetGocProfileByName(hCalib, goc_name, &pGocProfile);
             pGocProfile->def_cfg_mode = _inputParams->gocInputParams.cfg_mode;
             memcpy(pGocProfile->GammaY, _inputParams->gocInputParams.gamma_y, 34*2);
+            CamCalibDbTouch(hCalib);
             struct HAL_ISP_cfg_s cfg;
             memset(&cfg, 0, sizeof(cfg));
             cfg.updated_mask = HAL_ISP_GOC_MASK;
@@ -2843,6 +2975,7 @@ void RKiqCompositor::tuning_tool_set_dpf()
                 pDpfProfile->NfGains.fCoeff[1] = _inputParams->adpfInputParams.fGreenR;
                 pDpfProfile->NfGains.fCoeff[2] = _inputParams->adpfInputParams.fGreenB;
                 pDpfProfile->NfGains.fCoeff[3] = _inputParams->adpfInputParams.fBlue;
+                CamCalibDbTouch(hCalib);
 
                 struct HAL_ISP_cfg_s cfg;
                 struct HAL_ISP_dpf_cfg_s dpf_cfg;
@@ -2919,6 +3052,7 @@ void RKiqCompositor::tuning_tool_set_flt()
                         break;
                     }
                 }
+                CamCalibDbTouch(hCalib);
                 #if 0
                 struct HAL_ISP_cfg_s cfg;
                 memset(&cfg, 0, sizeof(cfg));
@@ -2954,6 +3088,57 @@ void RKiqCompositor::tuning_tool_restart_engine()
     }
 }
 
+SmartPtr<XmetaResult>
+RKiqCompositor::new_meta_result ()
+{
+    if (_meta_template.is_empty ()) {
+        // tags written on every reported frame, conditional ones must
+        // stay out or they would report the layout's data
+        static const struct {
+            uint32_t tag;
+            size_t count;
+        } layout[] = {
+            {ANDROID_STATISTICS_SCENE_FLICKER, 1},
+            {ANDROID_CONTROL_AE_EXPOSURE_COMPENSATION, 1},
+            {ANDROID_SENSOR_FRAME_DURATION, 1},
+            {ANDROID_SENSOR_EXPOSURE_TIME, 1},
+            {ANDROID_SENSOR_SENSITIVITY, 1},
+            {ANDROID_SENSOR_TEST_PATTERN_MODE, 1},
+            {ANDROID_STATISTICS_HISTOGRAM_MODE, 1},
+            {ANDROID_STATISTICS_HISTOGRAM, CIFISP_HIST_BIN_N_MAX},
+            {ANDROID_STATISTICS_INFO_HISTOGRAM_BUCKET_COUNT, 1},
+            {ANDROID_STATISTICS_INFO_MAX_HISTOGRAM_COUNT, 1},
+            {(uint32_t)RKCAMERA3_PRIVATEDATA_EXP_MEANS, CIFISP_AE_MEAN_MAX},
+            {(uint32_t)RKCAMERA3_PRIVATEDATA_EXP_MEANS_COUNT, 1},
+            {ANDROID_COLOR_CORRECTION_MODE, 1},
+            {ANDROID_COLOR_CORRECTION_ABERRATION_MODE, 1},
+            {ANDROID_COLOR_CORRECTION_GAINS, 4},
+            {(uint32_t)RKCAMERA3_PRIVATEDATA_EFFECTIVE_DRIVER_FRAME_ID, 1},
+            {(uint32_t)RKCAMERA3_PRIVATEDATA_FRAME_SOF_TIMESTAMP, 1},
+            {ANDROID_REQUEST_ID, 1},
+            {(uint32_t)RKCAMERA3_PRIVATEDATA_STILLCAP_ISP_PARAM, EXIF_MAKERNOTE_SIZE},
+        };
+        for (uint32_t i = 0; i < sizeof (layout) / sizeof (layout[0]); i++)
+            _meta_template.reserve (layout[i].tag, layout[i].count);
+    }
+
+    return new XmetaResult (_meta_template, XCAM_IMAGE_PROCESS_ONCE);
+}
+
+void
+RKiqCompositor::finish_meta_result (X3aResultList &results)
+{
+    for (X3aResultList::iterator iter = results.begin ();
+            iter != results.end (); iter++)
+    {
+        if ((*iter)->get_type() == XCAM_3A_METADATA_RESULT_TYPE) {
+            SmartPtr<XmetaResult> res = (*iter).dynamic_cast_ptr<XmetaResult> ();
+            _meta_template.fit (*res->get_metadata_result ());
+            break ;
+        }
+    }
+}
+
 void RKiqCompositor::tuning_tool_process(struct CamIA10_Results &ia10_results)
 {
     tuning_tool_set_bls();
@@ -3002,6 +3187,7 @@ XCamReturn RKiqCompositor::integrate (X3aResultList &results, bool first)
             _af_handler->processAfMetaResults(_ia_results.af, results);
             _common_handler->processToneMapsMetaResults(_ia_results.goc, results);
             _common_handler->processMiscMetaResults(_ia_results, results, first);
+            finish_meta_result (results);
             _all_stats_meas_types = 0;
         }
     }
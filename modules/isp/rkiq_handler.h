@@ -37,8 +37,11 @@
 #include "af_state_machine.h"
 #include "ae_state_machine.h"
 #include "x3a_meta_result.h"
+#include "converge_scheduler.h"
 
 #include <isp10_engine.h>
+#include <map>
+#include <vector>
 
 typedef struct ia_isp_t ia_isp;
 
@@ -281,6 +284,8 @@ public:
     void processExifMakernote(CameraMetadata* metadata, struct CamIA10_Results &ia10_results);
 private:
     XCamReturn initTonemaps();
+    // report @tag only if @data differs from what was reported last
+    void updateTuningMeta(CameraMetadata* metadata, uint32_t tag, const uint8_t *data, size_t size);
     XCamReturn fillTonemapCurve(CamerIcIspGocConfig_t goc, AiqInputParams* inputParams, CameraMetadata* metadata);
     XCAM_DEAD_COPY (AiqCommonHandler);
     // for tonemaps result
@@ -298,6 +303,11 @@ private:
     stillcap_sync_state_t _stillcap_sync_state;
     int _flash_stillcap_reg_time;
     int _flash_stillcap_reg_gain;
+    // tuning tool groups subscribed and the last values reported per tag
+    uint32_t _tuning_groups;
+    std::map<uint32_t, std::vector<uint8_t> > _tuning_meta_cache;
+    uint64_t _tuning_meta_updated;
+    uint64_t _tuning_meta_unchanged;
 protected:
     SmartPtr<RKiqCompositor>     _aiq_compositor;
     ia_aiq_gbce_results        *_gbce_result;
@@ -350,12 +360,20 @@ public:
     struct CamIA10_SensorModeData &get_sensor_mode_data() { return _ia_stat.sensor_mode; };
     bool set_3a_stats (SmartPtr<X3aIspStatistics> &stats);
     struct CamIA10_Stats& get_3a_ia10_stats () { return _ia_stat; };
-    struct cifisp_stat_buffer& get_3a_isp_stats () { return _isp_stats; };
+    struct cifisp_stat_buffer& get_3a_isp_stats () { return *_isp_stats; };
     bool set_vcm_time (struct rk_cam_vcm_tim *vcm_tim);
     bool set_frame_softime (int64_t sof_tim);
     bool set_effect_ispparams (struct rkisp_parameters& isp_params);
     bool set_flash_status_info (rkisp_flash_setting_t& flash_info);
 
+    // skip converged 3a algorithms on static scenes, off until configured
+    void set_converge_schedule (const ConvergeScheduleConfig &config);
+    // after set_3a_stats, decides which algorithms run on this frame
+    void plan_3a_runs ();
+    bool need_run_3a (ConvergeAlgo algo) const {
+        return _converge_scheduler.need_run (algo);
+    }
+
     ia_aiq  * get_handle () {
         return _ia_handle;
     }
@@ -364,6 +382,8 @@ public:
     }
 
     XCamReturn integrate (  X3aResultList &results, bool first = false);
+    // result metadata of a frame, cloned from the preallocated layout
+    SmartPtr<XmetaResult> new_meta_result ();
 
     SmartPtr<X3aResult> generate_3a_configs (struct rkisp_parameters *parameters);
     void convert_window_to_ia (const XCam3AWindow &window, ia_rectangle &ia_window);
@@ -396,6 +416,8 @@ private:
     void tuning_tool_set_flt();
     void tuning_tool_restart_engine();
     void tuning_tool_process(struct CamIA10_Results &ia10_results);
+    uint32_t get_converged_3a ();
+    void finish_meta_result (X3aResultList &results);
 public:
     Isp10Engine* _isp10_engine;
     struct rkisp_parameters    tool_isp_params;
@@ -424,7 +446,10 @@ private:
     ia_aiq_frame_use           _frame_use;
     ia_aiq_frame_params        _frame_params;
 
-    struct cifisp_stat_buffer _isp_stats;
+    // points into _isp_stats_buf, held until the next stats replace it
+    struct cifisp_stat_buffer *_isp_stats;
+    struct cifisp_stat_buffer _no_isp_stats;
+    SmartPtr<X3aIspStatistics> _isp_stats_buf;
     struct CamIA10_Stats _ia_stat = {0};
     struct CamIA10_DyCfg _ia_dcfg;
     struct CamIA10_Results _ia_results = {0};
@@ -448,6 +473,12 @@ private:
     struct CamIA10_Results     _results_for_tool = {0};
     // processed request id
     unsigned int    _procReqId;
+    ConvergeScheduler          _converge_scheduler;
+    // 3a params of the last planned frame, a change forces a run
+    XCamAeParam                _planned_ae_params;
+    XCamAwbParam               _planned_awb_params;
+    XCamAfParam                _planned_af_params;
+    XmetaTemplate              _meta_template;
 };
 
 };
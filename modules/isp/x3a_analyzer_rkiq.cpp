@@ -21,11 +21,48 @@
 #include "x3a_analyzer_rkiq.h"
 #include "rkiq_handler.h"
 #include "isp_controller.h"
+#include "frame_tracer.h"
 #include "ia_types.h"
 #include "isp_ctrl.h"
+#ifdef ANDROID_OS
+#include <cutils/properties.h>
+#endif
 
 namespace XCam {
 
+/*
+ * CamIA10Engine runs AWB and AF on the AE result of the same frame, so
+ * only those two may overlap, AE always goes first.
+ */
+static bool
+parallel_3a_enabled ()
+{
+    char value[16] = {0};
+#ifdef ANDROID_OS
+    property_get ("persist.vendor.rkisp.parallel3a", value, "0");
+#else
+    const char *env = getenv ("persist_camera_engine_parallel_3a");
+    if (env)
+        strncpy (value, env, sizeof (value) - 1);
+#endif
+    return atoi (value) != 0;
+}
+
+// "cadence,max_skip,tolerance", unset or invalid keeps every 3a algorithm on every frame
+static bool
+converge_3a_config (ConvergeScheduleConfig &config)
+{
+    char value[32] = {0};
+#ifdef ANDROID_OS
+    property_get ("persist.vendor.rkisp.converge3a", value, "");
+#else
+    const char *env = getenv ("persist_camera_engine_converge_3a");
+    if (env)
+        strncpy (value, env, sizeof (value) - 1);
+#endif
+    return ConvergeScheduler::parse_config (value, config);
+}
+
 X3aAnalyzerRKiq::X3aAnalyzerRKiq (SmartPtr<IspController> &isp, const char *cpf_path)
     : X3aAnalyzerRKiq(NULL, isp, cpf_path)
 {
@@ -38,6 +75,7 @@ X3aAnalyzerRKiq::X3aAnalyzerRKiq (RkispDeviceManager* device_manager, SmartPtr<I
     , _isp_ctrl_dev (NULL)
     , _sensor_data_ready (false)
     , _cpf_path (NULL)
+    , _frame_id (-1)
 {
     if (cpf_path)
         _cpf_path = strndup (cpf_path, XCAM_MAX_STR_SIZE);
@@ -46,6 +84,15 @@ X3aAnalyzerRKiq::X3aAnalyzerRKiq (RkispDeviceManager* device_manager, SmartPtr<I
     _rkiq_compositor = new RKiqCompositor ();
     XCAM_ASSERT (_rkiq_compositor.ptr());
     xcam_mem_clear (_sensor_mode_data);
+    if (parallel_3a_enabled ())
+        set_parallel_mode (X3aParallelAwbAf);
+
+    ConvergeScheduleConfig converge_config;
+    converge_config.cadence = XCAM_CONVERGE_DEFAULT_CADENCE;
+    converge_config.max_skip = XCAM_CONVERGE_DEFAULT_MAX_SKIP;
+    converge_config.tolerance = XCAM_CONVERGE_DEFAULT_TOLERANCE;
+    if (converge_3a_config (converge_config))
+        _rkiq_compositor->set_converge_schedule (converge_config);
 
     XCAM_LOG_DEBUG ("X3aAnalyzerRKiq constructed");
 }
@@ -55,6 +102,7 @@ X3aAnalyzerRKiq::X3aAnalyzerRKiq (struct isp_supplemental_sensor_mode_data &sens
     , _sensor_mode_data (sensor_data)
     , _sensor_data_ready (true)
     , _cpf_path (NULL)
+    , _frame_id (-1)
 {
     if (cpf_path)
         _cpf_path = strndup (cpf_path, XCAM_MAX_STR_SIZE);
@@ -62,6 +110,15 @@ X3aAnalyzerRKiq::X3aAnalyzerRKiq (struct isp_supplemental_sensor_mode_data &sens
     memset(&_otpInfo, 0, sizeof(_otpInfo));
     _rkiq_compositor = new RKiqCompositor ();
     XCAM_ASSERT (_rkiq_compositor.ptr());
+    if (parallel_3a_enabled ())
+        set_parallel_mode (X3aParallelAwbAf);
+
+    ConvergeScheduleConfig converge_config;
+    converge_config.cadence = XCAM_CONVERGE_DEFAULT_CADENCE;
+    converge_config.max_skip = XCAM_CONVERGE_DEFAULT_MAX_SKIP;
+    converge_config.tolerance = XCAM_CONVERGE_DEFAULT_TOLERANCE;
+    if (converge_3a_config (converge_config))
+        _rkiq_compositor->set_converge_schedule (converge_config);
 
     XCAM_LOG_DEBUG ("X3aAnalyzerRKiq constructed");
 }
@@ -176,6 +233,14 @@ X3aAnalyzerRKiq::internal_deinit ()
     return XCAM_RETURN_NO_ERROR;
 }
 
+void
+X3aAnalyzerRKiq::release_stats ()
+{
+    // the compositor holds the last stats, zero-copy ones keep a v4l2 buffer
+    if (_rkiq_compositor.ptr ())
+        _rkiq_compositor->close ();
+}
+
 XCamReturn X3aAnalyzerRKiq::restart()
 {
     XCamReturn ret;
@@ -331,6 +396,8 @@ X3aAnalyzerRKiq::pre_3a_analyze (SmartPtr<X3aStats> &stats)
     XCAM_ASSERT (_isp.ptr());
 
     struct cifisp_stat_buffer* stats_3a = (struct cifisp_stat_buffer*)xcam_isp_stats->get_isp_stats();
+    _frame_id = stats_3a->frame_id;
+    XCAM_FRAME_TRACE (FrameTraceAnalyzeBegin, _frame_id);
 
     ret = _isp->get_isp_parameter (isp_params, stats_3a->frame_id);
     XCAM_FAIL_RETURN (WARNING, ret == XCAM_RETURN_NO_ERROR, ret,
@@ -384,6 +451,7 @@ X3aAnalyzerRKiq::pre_3a_analyze (SmartPtr<X3aStats> &stats)
         XCAM_LOG_WARNING ("Aiq compositor set 3a stats failed");
         return XCAM_RETURN_ERROR_UNKNOWN;
     }
+    _rkiq_compositor->plan_3a_runs ();
 
     return ret;
 }
@@ -396,6 +464,10 @@ X3aAnalyzerRKiq::post_3a_analyze (X3aResultList &results)
     ret = _rkiq_compositor->integrate (results);
     XCAM_FAIL_RETURN (WARNING, ret == XCAM_RETURN_NO_ERROR, ret, "AIQ integrate 3A results failed");
 
+    for (X3aResultList::iterator iter = results.begin (); iter != results.end (); ++iter)
+        (*iter)->set_frame_id (_frame_id);
+    XCAM_FRAME_TRACE (FrameTraceAnalyzeEnd, _frame_id);
+
     _rkiq_compositor->setAiqInputParams(NULL);
     return XCAM_RETURN_NO_ERROR;
 }
@@ -58,6 +58,7 @@ protected:
 
     virtual XCamReturn internal_init (uint32_t width, uint32_t height, double framerate);
     virtual XCamReturn internal_deinit ();
+    virtual void release_stats ();
 
     virtual XCamReturn configure_3a ();
     virtual XCamReturn analyze (const SmartPtr<VideoBuffer> &buffer);
@@ -73,6 +74,7 @@ private:
     bool                              _sensor_data_ready;
     char                             *_cpf_path;
     CamOTPGlobal_t                   _otpInfo;
+    int32_t                          _frame_id;
 };
 
 };
@@ -36,6 +36,7 @@ AtomIspConfigContent::copy (const struct rkisp_parameters &isp_params)
 }
 
 X3aIspConfig::X3aIspConfig ()
+    : _frame_id (-1)
 {
 }
 
@@ -49,6 +50,7 @@ bool X3aIspConfig::clear()
 {
     _isp_content.clear ();
     _3a_results.clear ();
+    _frame_id = -1;
     return true;
 }
 
@@ -157,6 +159,7 @@ X3aIspConfig::attach (SmartPtr<X3aResult> &result, IspConfigTranslator *translat
     }
 
     _3a_results.push_back (result);
+    _frame_id = result->get_frame_id ();
     return true;
 }
 
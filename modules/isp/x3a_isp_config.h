@@ -23,6 +23,7 @@
 
 #include <xcam_std.h>
 #include <x3a_result.h>
+#include <object_pool.h>
 #include <linux/rkisp.h>
 #include <base/xcam_3a_result.h>
 
@@ -90,6 +91,9 @@ public:
     }
     bool clear ();
     bool attach (SmartPtr<X3aResult> &result, IspConfigTranslator *translator);
+    int32_t get_frame_id () const {
+        return _frame_id;
+    }
 
 private:
     XCAM_DEAD_COPY (X3aIspConfig);
@@ -97,11 +101,13 @@ private:
 protected:
     AtomIspConfigContent             _isp_content;
     std::list< SmartPtr<X3aResult> > _3a_results;
+    int32_t                          _frame_id;
 };
 
 template <typename IspConfig, typename StandardResult, uint32_t type>
 class X3aIspResultT
     : public X3aStandardResultT<StandardResult>
+    , public PooledObject<X3aIspResultT<IspConfig, StandardResult, type> >
 {
 public:
     X3aIspResultT (
@@ -131,6 +137,7 @@ private:
 template <>
 class X3aIspResultT<struct rkisp_parameters, X3aIspConfig::X3aIspResultDummy, X3aIspConfig::IspAllParameters>
         : public X3aStandardResultT<X3aIspConfig::X3aIspResultDummy>
+        , public PooledObject<X3aIspResultT<struct rkisp_parameters, X3aIspConfig::X3aIspResultDummy, X3aIspConfig::IspAllParameters> >
     {
 public:
         X3aIspResultT (
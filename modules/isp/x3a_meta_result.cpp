@@ -0,0 +1,129 @@
+/*
+ * x3a_meta_result.cpp - 3A metadata result
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "x3a_meta_result.h"
+#include <stdlib.h>
+
+namespace XCam {
+
+XmetaTemplate::XmetaTemplate ()
+    : _data_size (0)
+    , _max_entry (0)
+    , _extra_entries (DEFAULT_ENTRY_CAP)
+    , _extra_data (DEFAULT_DATA_CAP)
+    , _layout (NULL)
+{
+}
+
+XmetaTemplate::~XmetaTemplate ()
+{
+    if (_layout)
+        free_camera_metadata (_layout);
+}
+
+bool
+XmetaTemplate::reserve (uint32_t tag, size_t count)
+{
+    int type = get_camera_metadata_tag_type (tag);
+
+    XCAM_FAIL_RETURN (
+        WARNING, type >= 0 && count > 0, false,
+        "metadata template can't reserve tag 0x%x", tag);
+    XCAM_ASSERT (!_layout);
+
+    for (size_t i = 0; i < _tags.size (); i++) {
+        if (_tags[i].tag == tag)
+            return true;
+    }
+
+    TagLayout layout = {tag, count};
+    size_t size = calculate_camera_metadata_entry_data_size (type, count);
+    _tags.push_back (layout);
+    _data_size += size;
+    _max_entry = XCAM_MAX (_max_entry, size);
+    return true;
+}
+
+XCamReturn
+XmetaTemplate::build ()
+{
+    // CameraMetadata::update makes room for one more entry before it
+    // looks the tag up, keep that much spare so it never reallocates
+    size_t entries = _tags.size () + _extra_entries + 1;
+    size_t data = _data_size + _extra_data + _max_entry;
+    std::vector<uint8_t> zero (_max_entry ? _max_entry : 1, 0);
+
+    if (_layout)
+        free_camera_metadata (_layout);
+    _layout = allocate_camera_metadata (entries, data);
+    XCAM_FAIL_RETURN (
+        ERROR, _layout, XCAM_RETURN_ERROR_MEM,
+        "metadata template alloc failed, entries:%zu data:%zu", entries, data);
+
+    for (size_t i = 0; i < _tags.size (); i++) {
+        if (add_camera_metadata_entry (_layout, _tags[i].tag, &zero[0], _tags[i].count) != 0) {
+            XCAM_LOG_ERROR ("metadata template add tag 0x%x failed", _tags[i].tag);
+            free_camera_metadata (_layout);
+            _layout = NULL;
+            return XCAM_RETURN_ERROR_PARAM;
+        }
+    }
+    sort_camera_metadata (_layout);
+    return XCAM_RETURN_NO_ERROR;
+}
+
+camera_metadata_t *
+XmetaTemplate::clone ()
+{
+    if (!_layout && build () != XCAM_RETURN_NO_ERROR)
+        return NULL;
+
+    size_t size = get_camera_metadata_size (_layout);
+    camera_metadata_t *meta = (camera_metadata_t *) malloc (size);
+    if (meta)
+        memcpy (meta, _layout, size);
+    return meta;
+}
+
+void
+XmetaTemplate::fit (CameraMetadata &result)
+{
+    const camera_metadata_t *meta = result.getAndLock ();
+    size_t entries = get_camera_metadata_entry_count (meta);
+    size_t data = get_camera_metadata_data_count (meta);
+    result.unlock (meta);
+
+    // in place updates never grow the data, a result that needed more
+    // carried tags outside the layout
+    entries = entries > _tags.size () ? entries - _tags.size () : 0;
+    data = data > _data_size ? data - _data_size : 0;
+    if (_layout && (entries > _extra_entries || data > _extra_data)) {
+        XCAM_LOG_DEBUG (
+            "metadata template grows extra room to entries:%zu data:%zu",
+            entries, data);
+        _extra_entries = XCAM_MAX (_extra_entries, entries);
+        _extra_data = XCAM_MAX (_extra_data, data);
+        free_camera_metadata (_layout);
+        _layout = NULL;
+    }
+
+    result.sort ();
+}
+
+};
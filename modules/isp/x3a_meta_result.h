@@ -34,6 +34,7 @@ using ::android::hardware::camera::common::V1_0::helper::CameraMetadata;
 #include <fcntl.h>
 #include <string.h>
 #include <string>
+#include <vector>
 
 namespace XCam {
 
@@ -44,6 +45,48 @@ namespace XCam {
 #define DEFAULT_DATA_CAP 1024
 
 using namespace android;
+
+/*
+ * Sorted result metadata layout with every tag of @reserve preallocated
+ * at its full count. Results cloned from it update those tags in place
+ * and keep binary searching, tags outside the layout land in reserved
+ * room instead of growing the buffer. Only reserve tags written on every
+ * result, the data of a cloned tag is left from the layout otherwise.
+ */
+class XmetaTemplate
+{
+public:
+    explicit XmetaTemplate ();
+    ~XmetaTemplate ();
+
+    // declare before the first clone
+    bool reserve (uint32_t tag, size_t count);
+    bool is_empty () const {
+        return _tags.empty ();
+    }
+
+    // one memcpy of the layout, NULL on failure
+    camera_metadata_t *clone ();
+    // grow the room for extra tags to what @result needed, sort @result
+    void fit (CameraMetadata &result);
+
+private:
+    XCamReturn build ();
+    XCAM_DEAD_COPY (XmetaTemplate);
+
+private:
+    struct TagLayout {
+        uint32_t tag;
+        size_t   count;
+    };
+    std::vector<TagLayout>  _tags;
+    size_t                  _data_size;     // data bytes of the reserved tags
+    size_t                  _max_entry;     // largest entry data, bytes
+    size_t                  _extra_entries;
+    size_t                  _extra_data;
+    camera_metadata_t      *_layout;
+};
+
 class XmetaResult : public X3aResult
 {
 public:
@@ -59,6 +102,21 @@ public:
         set_ptr ((void*) _metadata);
     }
 
+    XmetaResult (
+                 XmetaTemplate &layout,
+                 XCamImageProcessType process_type = XCAM_IMAGE_PROCESS_ALWAYS)
+        : X3aResult (XCAM_3A_METADATA_RESULT_TYPE, process_type)
+          , _meta (NULL)
+          , _metadata (NULL)
+    {
+        _meta = layout.clone ();
+        if (!_meta)
+            _meta = allocate_camera_metadata(DEFAULT_ENTRY_CAP, DEFAULT_DATA_CAP);
+        XCAM_ASSERT (_meta);
+        _metadata = new CameraMetadata(_meta);
+        set_ptr ((void*) _metadata);
+    }
+
     virtual ~XmetaResult () {
         /* free_camera_metadata(_meta); */
         delete _metadata;
@@ -28,17 +28,45 @@ namespace XCam {
 X3aIspStatsData::X3aIspStatsData (struct cifisp_stat_buffer *isp_data, XCam3AStats *data)
     : X3aStatsData (data)
     , _isp_data (isp_data)
+    , _own_isp_data (isp_data)
 {
     XCAM_ASSERT (_isp_data);
 }
 
 X3aIspStatsData::~X3aIspStatsData ()
 {
-    if (_isp_data) {
-        xcam_free (_isp_data);
+    detach_v4l2_buffer ();
+    if (_own_isp_data) {
+        xcam_free (_own_isp_data);
     }
 }
 
+void
+X3aIspStatsData::attach_v4l2_buffer (SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device)
+{
+    XCAM_ASSERT (buf.ptr () && device.ptr ());
+    detach_v4l2_buffer ();
+
+    _v4l2_buf = buf;
+    _v4l2_dev = device;
+    _isp_data = (struct cifisp_stat_buffer*)buf->map ();
+}
+
+void
+X3aIspStatsData::detach_v4l2_buffer ()
+{
+    if (!_v4l2_buf.ptr ())
+        return;
+
+    // a stopped device has released its buffers, nothing to hand back
+    if (_v4l2_dev->is_activated () &&
+            _v4l2_dev->queue_buffer (_v4l2_buf) != XCAM_RETURN_NO_ERROR)
+        XCAM_LOG_WARNING ("requeue zero-copy stats buffer failed");
+    _v4l2_buf.release ();
+    _v4l2_dev.release ();
+    _isp_data = _own_isp_data;
+}
+
 bool
 X3aIspStatsData::fill_standard_stats ()
 {
@@ -126,12 +154,31 @@ X3aIspStatistics::X3aIspStatistics (const SmartPtr<X3aIspStatsData> &stats_data)
 
 X3aIspStatistics::~X3aIspStatistics ()
 {
+    // last reference, hand the v4l2 buffer back before the data returns to the pool
+    BorrowedPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_borrow<X3aIspStatsData> ();
+    if (stats.ptr ())
+        stats->detach_v4l2_buffer ();
+}
+
+bool
+X3aIspStatistics::attach_v4l2_buffer (SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device)
+{
+    BorrowedPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_borrow<X3aIspStatsData> ();
+
+    XCAM_FAIL_RETURN(
+        WARNING,
+        stats.ptr(),
+        false,
+        "X3aIspStatistics attach v4l2 buffer failed with NULL stats data");
+
+    stats->attach_v4l2_buffer (buf, device);
+    return true;
 }
 
 void *
 X3aIspStatistics::get_isp_stats ()
 {
-    SmartPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_ptr<X3aIspStatsData> ();
+    BorrowedPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_borrow<X3aIspStatsData> ();
 
     XCAM_FAIL_RETURN(
         WARNING,
@@ -145,7 +192,7 @@ X3aIspStatistics::get_isp_stats ()
 bool
 X3aIspStatistics::fill_standard_stats ()
 {
-    SmartPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_ptr<X3aIspStatsData> ();
+    BorrowedPtr<X3aIspStatsData> stats = get_buffer_data ().dynamic_cast_borrow<X3aIspStatsData> ();
 
     XCAM_FAIL_RETURN(
         WARNING,
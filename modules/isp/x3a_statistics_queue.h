@@ -24,6 +24,8 @@
 #include <xcam_std.h>
 #include <xcam_mutex.h>
 #include <x3a_stats_pool.h>
+#include <v4l2_device.h>
+#include <v4l2_buffer_proxy.h>
 #include <linux/rkisp.h>
 #include <rk-isp-config.h>
 
@@ -50,11 +52,18 @@ public:
 
     bool fill_standard_stats ();
 
+    // zero-copy, isp stats point into @buf until it is detached and requeued
+    void attach_v4l2_buffer (SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device);
+    void detach_v4l2_buffer ();
+
 private:
     XCAM_DEAD_COPY (X3aIspStatsData);
 
 private:
     struct cifisp_stat_buffer *_isp_data;
+    struct cifisp_stat_buffer *_own_isp_data;
+    SmartPtr<V4l2Buffer>       _v4l2_buf;
+    SmartPtr<V4l2Device>       _v4l2_dev;
 };
 
 class X3aIspStatistics
@@ -69,6 +78,8 @@ public:
     void *get_isp_stats ();
 
     bool fill_standard_stats ();
+    // the v4l2 buffer is requeued to @device when the last reference drops
+    bool attach_v4l2_buffer (SmartPtr<V4l2Buffer> &buf, const SmartPtr<V4l2Device> &device);
 
 private:
     XCAM_DEAD_COPY (X3aIspStatistics);
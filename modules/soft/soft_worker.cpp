@@ -57,11 +57,11 @@ public:
     WorkItem (
         const SmartPtr<SoftWorker> &worker,
         const SmartPtr<Worker::Arguments> &args,
-        const WorkSize &item,
+        const WorkRange &range,
         SmartPtr<ItemSynch> &sync)
         : _worker (worker)
         , _args (args)
-        , _item (item)
+        , _range (range)
         , _sync (sync)
     {
     }
@@ -72,7 +72,7 @@ public:
 private:
     SmartPtr<SoftWorker>         _worker;
     SmartPtr<Worker::Arguments>  _args;
-    WorkSize                     _item;
+    WorkRange                    _range;
     SmartPtr<ItemSynch>          _sync;
 };
 
@@ -83,7 +83,7 @@ WorkItem::run ()
     if (!xcam_ret_is_ok (ret))
         return ret;
 
-    ret = _worker->work_impl (_args, _item);
+    ret = _worker->work_range (_args, _range);
     if (!xcam_ret_is_ok (ret))
         _sync->update_error (ret);
 
@@ -103,6 +103,7 @@ WorkItem::done (XCamReturn err)
 
 SoftWorker::SoftWorker (const char *name, const SmartPtr<Callback> &cb)
     : Worker (name, cb)
+    , _priority (WorkScheduler::PriorityNormal)
     , _global (1, 1, 1)
     , _local (1, 1, 1)
     , _work_unit (1, 1, 1)
@@ -136,6 +137,26 @@ SoftWorker::set_threads (const SmartPtr<ThreadPool> &threads)
     return true;
 }
 
+bool
+SoftWorker::set_scheduler (const SmartPtr<WorkScheduler> &scheduler)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, !_scheduler.ptr () && !_threads.ptr (), false,
+        "SoftWorker(%s) set scheduler failed, threads or scheduler already set before.", XCAM_STR (get_name ()));
+    _scheduler = scheduler;
+    return true;
+}
+
+bool
+SoftWorker::set_priority (WorkScheduler::Priority priority)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, priority >= WorkScheduler::PriorityHigh && priority < WorkScheduler::PriorityCount, false,
+        "SoftWorker(%s) set priority(%d) failed.", XCAM_STR (get_name ()), priority);
+    _priority = priority;
+    return true;
+}
+
 bool
 SoftWorker::set_global_size (const WorkSize &size)
 {
@@ -163,10 +184,20 @@ SoftWorker::set_local_size (const WorkSize &size)
 XCamReturn
 SoftWorker::stop ()
 {
-    _threads->stop ();
+    // the shared scheduler outlives the worker, only a private pool is stopped
+    if (_threads.ptr ())
+        _threads->stop ();
     return XCAM_RETURN_NO_ERROR;
 }
 
+XCamReturn
+SoftWorker::queue_item (const SmartPtr<ThreadPool::UserData> &item)
+{
+    if (_threads.ptr ())
+        return _threads->queue (item);
+    return _scheduler->queue (item, _priority);
+}
+
 XCamReturn
 SoftWorker::work (const SmartPtr<Worker::Arguments> &args)
 {
@@ -193,18 +224,11 @@ SoftWorker::work (const SmartPtr<Worker::Arguments> &args)
         return ret;
     }
 
-    if (!_threads.ptr ()) {
-        char thr_name [XCAM_MAX_STR_SIZE];
-        snprintf (thr_name, XCAM_MAX_STR_SIZE, "%s-thrs", XCAM_STR(get_name ()));
-
-        SmartPtr<ThreadPool> threads = new ThreadPool (thr_name);
-        XCAM_ASSERT (threads.ptr ());
-        _threads = threads;
-        _threads->set_threads (max_items, max_items + 1); //extra thread to process all_items_done
-        ret = _threads->start ();
+    if (!_threads.ptr () && !_scheduler.ptr ()) {
+        _scheduler = WorkScheduler::instance ();
         XCAM_FAIL_RETURN (
-            ERROR, xcam_ret_is_ok (ret), ret,
-            "SoftWorker(%s) work failed when starting threads", XCAM_STR(get_name()));
+            ERROR, _scheduler.ptr (), XCAM_RETURN_ERROR_THREAD,
+            "SoftWorker(%s) work failed since no work scheduler", XCAM_STR(get_name()));
     }
 
     SmartPtr<ItemSynch> sync = new ItemSynch (max_items);
@@ -212,8 +236,8 @@ SoftWorker::work (const SmartPtr<Worker::Arguments> &args)
         for (uint32_t y = 0; y < items.value[1]; ++y)
             for (uint32_t x = 0; x < items.value[0]; ++x)
             {
-                SmartPtr<WorkItem> item = new WorkItem (this, args, WorkSize(x, y, z), sync);
-                ret = _threads->queue (item);
+                SmartPtr<WorkItem> item = new WorkItem (this, args, get_range (WorkSize(x, y, z)), sync);
+                ret = queue_item (item);
                 if (!xcam_ret_is_ok (ret)) {
                     //consider half queued but half failed
                     sync->update_error (ret);
@@ -23,6 +23,7 @@
 
 #include <xcam_std.h>
 #include <worker.h>
+#include <work_scheduler.h>
 
 #define SOFT_MAX_DIM 3
 
@@ -64,7 +65,10 @@ public:
         return _work_unit;
     }
 
+    // private thread pool, items go to the process-wide WorkScheduler if not set
     bool set_threads (const SmartPtr<ThreadPool> &threads);
+    bool set_scheduler (const SmartPtr<WorkScheduler> &scheduler);
+    bool set_priority (WorkScheduler::Priority priority);
     bool set_global_size (const WorkSize &size);
     const WorkSize &get_global_size () const {
         return _global;
@@ -85,12 +89,15 @@ private:
     virtual XCamReturn work_unit (const SmartPtr<Arguments> &args, const WorkSize &unit);
 
     XCamReturn work_impl (const SmartPtr<Arguments> &args, const WorkSize &item);
+    XCamReturn queue_item (const SmartPtr<ThreadPool::UserData> &item);
     void all_items_done (const SmartPtr<Arguments> &args, XCamReturn error);
 
     XCAM_DEAD_COPY (SoftWorker);
 
 private:
     SmartPtr<ThreadPool>    _threads;
+    SmartPtr<WorkScheduler> _scheduler;
+    WorkScheduler::Priority _priority;
     WorkSize                _global;
     WorkSize                _local;
     WorkSize                _work_unit;
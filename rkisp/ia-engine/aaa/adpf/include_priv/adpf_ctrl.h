@@ -58,6 +58,59 @@ typedef enum AdpfState_e {
 
 
 
+/*****************************************************************************/
+/**
+ * @brief   Gain dependent curves of a light mode which are looked up
+ *          through the gain table.
+ */
+/*****************************************************************************/
+typedef enum AdpfGainCurve_e {
+  ADPF_GAIN_CURVE_DENOISE_LEVEL    = 0,
+  ADPF_GAIN_CURVE_SHARPENING_LEVEL = 1,
+  ADPF_GAIN_CURVE_DEMOSAIC_TH      = 2,
+  ADPF_GAIN_CURVE_DSP_3DNR         = 3,
+  ADPF_GAIN_CURVE_NEW_DSP_3DNR     = 4,
+  ADPF_GAIN_CURVE_MAX
+} AdpfGainCurve_t;
+
+#define ADPF_GAIN_TABLE_MAX_NODES   64      /**< gain nodes of all curves together */
+#define ADPF_GAIN_TABLE_MAX_CELLS   (2 * ADPF_GAIN_TABLE_MAX_NODES + 1)
+#define ADPF_GAIN_NODE_NEAREST      0x80    /**< pick the nearer of node and node + 1 */
+
+#define ADPF_LP_CURVES              34      /**< interpolated demosaic lp values */
+#define ADPF_LP_NODES               6
+#define ADPF_LP_BELOW               0xfe    /**< gain below the first lp node */
+#define ADPF_LP_ABOVE               0xff    /**< gain above the last lp node */
+
+/*****************************************************************************/
+/**
+ * @brief   Gain nodes of all gain dependent curves of a light mode, merged
+ *          at configuration. The gain axis is cut into cells, one below the
+ *          first node, one on each node and one between each node and the
+ *          next, inside a cell every curve takes the same path through its
+ *          lookup. A single search for the cell of the sensor gain gives the
+ *          node of the level curves and the segment of the demosaic lp ones.
+ */
+/*****************************************************************************/
+typedef struct AdpfGainTable_s {
+  uint16_t      NoNodes;                                      /**< merged gain nodes */
+  float         Gain[ADPF_GAIN_TABLE_MAX_NODES];              /**< ascending */
+
+  bool_t        CurveValid[ADPF_GAIN_CURVE_MAX];
+  const float*  pCurveGain[ADPF_GAIN_CURVE_MAX];              /**< gain nodes of the curve in calibration */
+  uint16_t      CurveSize[ADPF_GAIN_CURVE_MAX];
+  uint8_t       CurveNode[ADPF_GAIN_TABLE_MAX_CELLS][ADPF_GAIN_CURVE_MAX];
+
+  bool_t        LpValid;
+  const CamDemosaicLpProfile_t* pLpConf;
+  float         LpGain[ADPF_LP_NODES];
+  uint8_t       LpSegment[ADPF_GAIN_TABLE_MAX_CELLS];
+  float         LpValue[ADPF_LP_NODES][ADPF_LP_CURVES];       /**< curve values at each node */
+  float         LpSlope[ADPF_LP_NODES - 1][ADPF_LP_CURVES];   /**< curve slopes of each segment */
+} AdpfGainTable_t;
+
+
+
 /*****************************************************************************/
 /**
  * @brief   Context of the ADPF module.
@@ -110,6 +163,12 @@ typedef struct AdpfContext_s {
 
   enum LIGHT_MODE LightMode;
   bool forceApplyConfigure;
+
+  AdpfGainTable_t GainTable[LIGHT_MODE_MAX];
+  AdpfGainTable_t *pGainTable;                        /**< table of the current light mode */
+  const AdpfGainTable_t *pGainCellTable;              /**< table GainCell was looked up in */
+  float GainCellGain;
+  uint16_t GainCell;
 } AdpfContext_t;
 
 
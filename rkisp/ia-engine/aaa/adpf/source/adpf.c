@@ -109,6 +109,173 @@ static RESULT Interpolate
 }
 
 
+/*****************************************************************************/
+/**
+ * @brief   This local function finds the curve node nearest to the sensor
+ *          gain, the way the level curves are looked up. The gain is
+ *          clamped to the curve, a gain exactly between two nodes gets
+ *          the upper one.
+ *
+ * @param   pSensorGain     gain nodes of the curve, ascending
+ * @param   ArraySize       number of gain nodes
+ * @param   fSensorGain     current sensor gain
+ *
+ * @return                  Return the index of the nearest node.
+ *
+ *****************************************************************************/
+static uint16_t AdpfGainCurveNearestNode
+(
+    const float*    pSensorGain,
+    const uint16_t  ArraySize,
+    const float     fSensorGain
+) {
+  uint16_t n    = 0U;
+  uint16_t nMax = (ArraySize - 1U);
+  float Dgain = fSensorGain;
+
+  /* lower range check */
+  if (Dgain < pSensorGain[0]) {
+    Dgain = pSensorGain[0];
+  }
+
+  /* upper range check */
+  if (Dgain > pSensorGain[nMax]) {
+    Dgain = pSensorGain[nMax];
+  }
+
+  /* find x area */
+  n = 0;
+  while ((n <= nMax) && (Dgain >= pSensorGain[n])) {
+    ++n;
+  }
+  --n;
+
+  /**
+   * If n was larger than nMax, which means fSensorGain lies exactly on the
+   * last interval border, we count fSensorGain to the last interval and
+   * have to decrease n one more time */
+  if (n == nMax) {
+    --n;
+  }
+
+  float sub1 = ABS(pSensorGain[n] - Dgain);
+  float sub2 = ABS(pSensorGain[n + 1] - Dgain);
+
+  return (sub1 < sub2 ? n : n + 1);
+}
+
+
+/*****************************************************************************/
+/**
+ * @brief   This local function returns the gain table cell of the sensor
+ *          gain. Cell 0 is below the first node, cell 2i+1 is node i and
+ *          cell 2i+2 is between node i and node i+1, or above the last.
+ *
+ * @param   pTable          gain table
+ * @param   fSensorGain     current sensor gain
+ *
+ * @return                  Return the cell index.
+ *
+ *****************************************************************************/
+static uint16_t AdpfGainTableCell
+(
+    const AdpfGainTable_t*  pTable,
+    const float             fSensorGain
+) {
+  uint16_t lo = 0U;
+  uint16_t hi = pTable->NoNodes;
+
+  /* number of nodes not above the gain */
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2U;
+    if (pTable->Gain[mid] <= fSensorGain) {
+      lo = mid + 1U;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if (lo == 0U) {
+    return (0U);
+  }
+
+  return ((pTable->Gain[lo - 1U] == fSensorGain) ? (2U * lo - 1U) : (2U * lo));
+}
+
+
+/*****************************************************************************/
+/**
+ * @brief   This local function returns the gain table cell of the sensor
+ *          gain in the table of the current light mode. The cell is kept,
+ *          so the curves looked up for the same gain search only once.
+ *
+ * @param   pAdpfCtx        adpf context
+ * @param   fSensorGain     current sensor gain
+ *
+ * @return                  Return the cell index.
+ *
+ *****************************************************************************/
+static uint16_t AdpfGainTableLookup
+(
+    AdpfContext_t*  pAdpfCtx,
+    const float     fSensorGain
+) {
+  if ((pAdpfCtx->pGainCellTable != pAdpfCtx->pGainTable)
+      || (pAdpfCtx->GainCellGain != fSensorGain)) {
+    pAdpfCtx->GainCell       = AdpfGainTableCell(pAdpfCtx->pGainTable, fSensorGain);
+    pAdpfCtx->GainCellGain   = fSensorGain;
+    pAdpfCtx->pGainCellTable = pAdpfCtx->pGainTable;
+  }
+
+  return (pAdpfCtx->GainCell);
+}
+
+
+/*****************************************************************************/
+/**
+ * @brief   This local function finds the node of a level curve nearest
+ *          to the sensor gain, from the gain table when the curve is in
+ *          the table of the current light mode.
+ *
+ * @param   pAdpfCtx        adpf context
+ * @param   curve           which curve of the light mode
+ * @param   pSensorGain     gain nodes of the curve
+ * @param   ArraySize       number of gain nodes
+ * @param   fSensorGain     current sensor gain
+ *
+ * @return                  Return the index of the nearest node.
+ *
+ *****************************************************************************/
+static uint16_t AdpfGainCurveNode
+(
+    AdpfContext_t*          pAdpfCtx,
+    const AdpfGainCurve_t   curve,
+    const float*            pSensorGain,
+    const uint16_t          ArraySize,
+    const float             fSensorGain
+) {
+  const AdpfGainTable_t* pTable = pAdpfCtx->pGainTable;
+
+  if ((pTable != NULL)
+      && pTable->CurveValid[curve]
+      && (pTable->pCurveGain[curve] == pSensorGain)
+      && (pTable->CurveSize[curve] == ArraySize)) {
+    uint8_t node = pTable->CurveNode[AdpfGainTableLookup(pAdpfCtx, fSensorGain)][curve];
+
+    if (node & ADPF_GAIN_NODE_NEAREST) {
+      uint16_t n = node & ~ADPF_GAIN_NODE_NEAREST;
+      float sub1 = ABS(pSensorGain[n] - fSensorGain);
+      float sub2 = ABS(pSensorGain[n + 1] - fSensorGain);
+      return (sub1 < sub2 ? n : n + 1);
+    }
+
+    return (node);
+  }
+
+  return (AdpfGainCurveNearestNode(pSensorGain, ArraySize, fSensorGain));
+}
+
+
 /*****************************************************************************/
 /**
  * @brief   This array defines the green square radius for the spatial
@@ -550,10 +717,7 @@ static RESULT AdpfCalculateDenoiseLevel
     CamDenoiseLevelCurve_t*   pDenoiseLevelCurve,
     CamerIcIspFltDeNoiseLevel_t* deNoiseLevel
 ) {
-  (void) pAdpfCtx;
   uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;//Denoise level gain
   // initial check
   if (pDenoiseLevelCurve == NULL) {
     LOGV("%s: pDenoiseLevelCurve == NULL \n", __func__);
@@ -568,34 +732,8 @@ static RESULT AdpfCalculateDenoiseLevel
   
   LOGV( "%s:(enter) fSensorGain(%f) size(%d)\n", __func__, fSensorGain, pDenoiseLevelCurve->ArraySize);
 
-  nMax = (pDenoiseLevelCurve->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pDenoiseLevelCurve->pSensorGain[0]) {
-    Dgain = pDenoiseLevelCurve->pSensorGain[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pDenoiseLevelCurve->pSensorGain[nMax]) {
-    Dgain = pDenoiseLevelCurve->pSensorGain[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pDenoiseLevelCurve->pSensorGain[n])) {
-    ++n;
-  }
-  --n;
-
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-  float sub1 = ABS(pDenoiseLevelCurve->pSensorGain[n] - Dgain);
-  float sub2 = ABS(pDenoiseLevelCurve->pSensorGain[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  n = AdpfGainCurveNode(pAdpfCtx, ADPF_GAIN_CURVE_DENOISE_LEVEL,
+                        pDenoiseLevelCurve->pSensorGain, pDenoiseLevelCurve->ArraySize, fSensorGain);
 
   *deNoiseLevel = pDenoiseLevelCurve->pDlevel[n];
   if (*deNoiseLevel >  CAMERIC_ISP_FLT_DENOISE_LEVEL_MAX)
@@ -605,7 +743,7 @@ static RESULT AdpfCalculateDenoiseLevel
     *deNoiseLevel = CAMERIC_ISP_FLT_DENOISE_LEVEL_INVALID + 1;
 
   *deNoiseLevel = *deNoiseLevel - 1;
-  LOGV( "%s: gain=%f,dLelvel=%d\n", __func__, Dgain, *deNoiseLevel);
+  LOGV( "%s: gain=%f,dLelvel=%d\n", __func__, fSensorGain, *deNoiseLevel);
   LOGV( "%s: (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -632,7 +770,6 @@ static RESULT AdpfCalculateSharpeningLevel
     CamSharpeningLevelCurve_t*   pSharpeningLevelCurve,
     CamerIcIspFltSharpeningLevel_t* sharpeningLevel
 ) {
-  (void) pAdpfCtx;
 
   LOGV( "%s: (enter)\n", __func__);
 
@@ -646,37 +783,8 @@ static RESULT AdpfCalculateSharpeningLevel
     LOGV("%s: fSensorGain  < 1.0f  \n", __func__);
     return (RET_INVALID_PARM);
   }
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;//sharping level gain
-  nMax = (pSharpeningLevelCurve->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pSharpeningLevelCurve->pSensorGain[0]) {
-    Dgain = pSharpeningLevelCurve->pSensorGain[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pSharpeningLevelCurve->pSensorGain[nMax]) {
-    Dgain = pSharpeningLevelCurve->pSensorGain[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pSharpeningLevelCurve->pSensorGain[n])) {
-    ++n;
-  }
-  --n;
-
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-  float sub1 = ABS(pSharpeningLevelCurve->pSensorGain[n] - Dgain);
-  float sub2 = ABS(pSharpeningLevelCurve->pSensorGain[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  uint16_t n = AdpfGainCurveNode(pAdpfCtx, ADPF_GAIN_CURVE_SHARPENING_LEVEL,
+                                 pSharpeningLevelCurve->pSensorGain, pSharpeningLevelCurve->ArraySize, fSensorGain);
 
   *sharpeningLevel  = pSharpeningLevelCurve->pSlevel[n];
   if (*sharpeningLevel >  CAMERIC_ISP_FLT_SHARPENING_LEVEL_MAX)
@@ -686,7 +794,7 @@ static RESULT AdpfCalculateSharpeningLevel
     *sharpeningLevel = CAMERIC_ISP_FLT_SHARPENING_LEVEL_INVALID + 1;
 
   *sharpeningLevel = *sharpeningLevel - 1;
-  LOGV( "%s: gain=%f,sLelvel=%d\n", __func__, Dgain, *sharpeningLevel);
+  LOGV( "%s: gain=%f,sLelvel=%d\n", __func__, fSensorGain, *sharpeningLevel);
   LOGV( "%s: (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -699,7 +807,6 @@ static RESULT AdpfCalculateDemosaicThLevel
     CamDemosaicThCurve_t*   pDemosaicThCurve,
     uint8_t* demosaic_th_level
 ) {
-  (void) pAdpfCtx;
 
   LOGV( "%s: (enter)\n", __func__);
 
@@ -713,41 +820,12 @@ static RESULT AdpfCalculateDemosaicThLevel
     LOGV("%s: fSensorGain  < 1.0f  \n", __func__);
     return (RET_INVALID_PARM);
   }
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;//sharping level gain
-  nMax = (pDemosaicThCurve->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pDemosaicThCurve->pSensorGain[0]) {
-    Dgain = pDemosaicThCurve->pSensorGain[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pDemosaicThCurve->pSensorGain[nMax]) {
-    Dgain = pDemosaicThCurve->pSensorGain[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pDemosaicThCurve->pSensorGain[n])) {
-    ++n;
-  }
-  --n;
-
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-  float sub1 = ABS(pDemosaicThCurve->pSensorGain[n] - Dgain);
-  float sub2 = ABS(pDemosaicThCurve->pSensorGain[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  uint16_t n = AdpfGainCurveNode(pAdpfCtx, ADPF_GAIN_CURVE_DEMOSAIC_TH,
+                                 pDemosaicThCurve->pSensorGain, pDemosaicThCurve->ArraySize, fSensorGain);
 
   *demosaic_th_level  = pDemosaicThCurve->pThlevel[n];
 
-  LOGV( "%s: gain=%f,demosaic_th=%d\n", __func__, Dgain, *demosaic_th_level);
+  LOGV( "%s: gain=%f,demosaic_th=%d\n", __func__, fSensorGain, *demosaic_th_level);
   LOGV( "%s: (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -760,7 +838,6 @@ static RESULT AdpfCalculate3DNRResult(
     CamDsp3DNRSettingProfile_t* pCamDsp3DNRSettingProfile,
     Dsp3DnrResult_t*     pDsp3DNRResult
 ) {
-  (void) pAdpfCtx;
   CamDsp3DNRLumaSetting_t *pLumaSetting = &pCamDsp3DNRSettingProfile->sLumaSetting;
   CamDsp3DNRChrmSetting_t *pChrmSetting = &pCamDsp3DNRSettingProfile->sChrmSetting;
   CamDsp3DNRShpSetting_t *pSharpSetting = &pCamDsp3DNRSettingProfile->sSharpSetting;
@@ -791,38 +868,8 @@ static RESULT AdpfCalculate3DNRResult(
 	}
   }
   
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;
-  nMax = (pCamDsp3DNRSettingProfile->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pCamDsp3DNRSettingProfile->pgain_Level[0]) {
-    Dgain = pCamDsp3DNRSettingProfile->pgain_Level[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pCamDsp3DNRSettingProfile->pgain_Level[nMax]) {
-    Dgain = pCamDsp3DNRSettingProfile->pgain_Level[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((n <= nMax) && (Dgain >=  pCamDsp3DNRSettingProfile->pgain_Level[n])) {
-    ++n;
-  }
-  --n;
-
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-
-  float sub1 = ABS(pCamDsp3DNRSettingProfile->pgain_Level[n] - Dgain);
-  float sub2 = ABS(pCamDsp3DNRSettingProfile->pgain_Level[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  uint16_t n = AdpfGainCurveNode(pAdpfCtx, ADPF_GAIN_CURVE_DSP_3DNR,
+                                 pCamDsp3DNRSettingProfile->pgain_Level, pCamDsp3DNRSettingProfile->ArraySize, fSensorGain);
 
   pDsp3DNRResult->noise_coef_num = pCamDsp3DNRSettingProfile->pnoise_coef_numerator[n];
   pDsp3DNRResult->noise_coef_den= pCamDsp3DNRSettingProfile->pnoise_coef_denominator[n];
@@ -899,7 +946,7 @@ static RESULT AdpfCalculate3DNRResult(
   						  | ((pSharpSetting->psrc_shp_weight[24][n]&0x3f));
 
   LOGV( "%s: oyyf gain=%f, n=%d, luma_sp:%d luma_te:%d chrm_sp:%d chrm_te:%d shp:%d noise:num(%d) den(%d)\n", 
-  		__func__, Dgain, n,
+  		__func__, fSensorGain, n,
         pDsp3DNRResult->luma_sp_nr_level, pDsp3DNRResult->luma_te_nr_level, 
         pDsp3DNRResult->chrm_sp_nr_level, pDsp3DNRResult->chrm_te_nr_level, pDsp3DNRResult->shp_level,
         pDsp3DNRResult->noise_coef_num, pDsp3DNRResult->noise_coef_den);
@@ -916,7 +963,6 @@ static RESULT AdpfCalculateNew3DNRResult(
     CamNewDsp3DNRProfile_t* pCamNewDsp3DNRProfile,
     NewDsp3DnrResult_t*     pNewDsp3DnrResult
 ) {
-  (void) pAdpfCtx;
   
   LOGV( "%s: (enter) \n", __func__);
 
@@ -933,38 +979,8 @@ static RESULT AdpfCalculateNew3DNRResult(
     return (RET_INVALID_PARM);
   }
   
-  uint16_t n    = 0U;
-  uint16_t nMax = 0U;
-  float Dgain = fSensorGain;
-  nMax = (pCamNewDsp3DNRProfile->ArraySize - 1U);
-  /* lower range check */
-  if (Dgain < pCamNewDsp3DNRProfile->pgain_Level[0]) {
-    Dgain = pCamNewDsp3DNRProfile->pgain_Level[0];
-  }
-
-  /* upper range check */
-  if (Dgain > pCamNewDsp3DNRProfile->pgain_Level[nMax]) {
-    Dgain = pCamNewDsp3DNRProfile->pgain_Level[nMax];
-  }
-
-  /* find x area */
-  n = 0;
-  while ((Dgain >=  pCamNewDsp3DNRProfile->pgain_Level[n]) && (n <= nMax)) {
-    ++n;
-  }
-  --n;
-
-  /**
-   * If n was larger than nMax, which means fSensorGain lies exactly on the
-  * last interval border, we count fSensorGain to the last interval and
-   * have to decrease n one more time */
-  if (n == nMax) {
-    --n;
-  }
-
-  float sub1 = ABS(pCamNewDsp3DNRProfile->pgain_Level[n] - Dgain);
-  float sub2 = ABS(pCamNewDsp3DNRProfile->pgain_Level[n + 1] - Dgain);
-  n = sub1 < sub2 ? n : n + 1;
+  uint16_t n = AdpfGainCurveNode(pAdpfCtx, ADPF_GAIN_CURVE_NEW_DSP_3DNR,
+                                 pCamNewDsp3DNRProfile->pgain_Level, pCamNewDsp3DNRProfile->ArraySize, fSensorGain);
 
   pNewDsp3DnrResult->ynr_time_weight = pCamNewDsp3DNRProfile->ynr.pynr_time_weight_level[n];
   pNewDsp3DnrResult->ynr_spat_weight = pCamNewDsp3DNRProfile->ynr.pynr_spat_weight_level[n];
@@ -972,7 +988,7 @@ static RESULT AdpfCalculateNew3DNRResult(
   pNewDsp3DnrResult->sharp_weight = pCamNewDsp3DNRProfile->sharp.psharp_weight_level[n];
 
   LOGV( "%s: gain=%f, n=%d, ynr_time_weight:%d ynr_spat_weight:%d uvnr_weight:%d sharp_weight:%d\n", 
-  		__func__, Dgain, n,
+  		__func__, fSensorGain, n,
 		pNewDsp3DnrResult->ynr_time_weight,
 		pNewDsp3DnrResult->ynr_spat_weight,
 		pNewDsp3DnrResult->uvnr_weight,
@@ -983,6 +999,49 @@ static RESULT AdpfCalculateNew3DNRResult(
   return (RET_SUCCESS);
 }
 
+/*****************************************************************************/
+/**
+ * @brief   Offsets of the interpolated demosaic lp curves in the profile,
+ *          in the order AdpfRKLpCalMatrix writes them to the result.
+ */
+/*****************************************************************************/
+static const size_t AdpfLpCurveOffset[ADPF_LP_CURVES] = {
+  offsetof(CamDemosaicLpProfile_t, thH_divided0),
+  offsetof(CamDemosaicLpProfile_t, thH_divided1),
+  offsetof(CamDemosaicLpProfile_t, thH_divided2),
+  offsetof(CamDemosaicLpProfile_t, thH_divided3),
+  offsetof(CamDemosaicLpProfile_t, thH_divided4),
+  offsetof(CamDemosaicLpProfile_t, thCSC_divided0),
+  offsetof(CamDemosaicLpProfile_t, thCSC_divided1),
+  offsetof(CamDemosaicLpProfile_t, thCSC_divided2),
+  offsetof(CamDemosaicLpProfile_t, thCSC_divided3),
+  offsetof(CamDemosaicLpProfile_t, thCSC_divided4),
+  offsetof(CamDemosaicLpProfile_t, diff_divided0),
+  offsetof(CamDemosaicLpProfile_t, diff_divided1),
+  offsetof(CamDemosaicLpProfile_t, diff_divided2),
+  offsetof(CamDemosaicLpProfile_t, diff_divided3),
+  offsetof(CamDemosaicLpProfile_t, diff_divided4),
+  offsetof(CamDemosaicLpProfile_t, varTh_divided0),
+  offsetof(CamDemosaicLpProfile_t, varTh_divided1),
+  offsetof(CamDemosaicLpProfile_t, varTh_divided2),
+  offsetof(CamDemosaicLpProfile_t, varTh_divided3),
+  offsetof(CamDemosaicLpProfile_t, varTh_divided4),
+  offsetof(CamDemosaicLpProfile_t, th_grad),
+  offsetof(CamDemosaicLpProfile_t, th_diff),
+  offsetof(CamDemosaicLpProfile_t, th_csc),
+  offsetof(CamDemosaicLpProfile_t, th_var),
+  offsetof(CamDemosaicLpProfile_t, thgrad_r_fct),
+  offsetof(CamDemosaicLpProfile_t, thdiff_r_fct),
+  offsetof(CamDemosaicLpProfile_t, thvar_r_fct),
+  offsetof(CamDemosaicLpProfile_t, thgrad_b_fct),
+  offsetof(CamDemosaicLpProfile_t, thdiff_b_fct),
+  offsetof(CamDemosaicLpProfile_t, thvar_b_fct),
+  offsetof(CamDemosaicLpProfile_t, similarity_th),
+  offsetof(CamDemosaicLpProfile_t, flat_level_sel),
+  offsetof(CamDemosaicLpProfile_t, pattern_level_sel),
+  offsetof(CamDemosaicLpProfile_t, edge_level_sel),
+};
+
 uint16_t AdpfRKLpInterpolate
 (
 	float *src_divided,
@@ -1024,6 +1083,214 @@ uint16_t AdpfRKLpInterpolate
 }
 
 
+/*****************************************************************************/
+/**
+ * @brief   This local function merges the gain nodes of a curve into the
+ *          gain table. Only ascending curves that fit are merged.
+ *
+ * @param   pTable          gain table
+ * @param   pSensorGain     gain nodes of the curve
+ * @param   ArraySize       number of gain nodes
+ *
+ * @return                  Return BOOL_TRUE when the curve was merged.
+ *
+ *****************************************************************************/
+static bool_t AdpfGainTableAddNodes
+(
+    AdpfGainTable_t*    pTable,
+    const float*        pSensorGain,
+    const uint16_t      ArraySize
+) {
+  uint16_t added = 0U;
+  uint16_t i, j;
+
+  if ((pSensorGain == NULL) || (ArraySize < 2U) || (ArraySize > ADPF_GAIN_TABLE_MAX_NODES)) {
+    return (BOOL_FALSE);
+  }
+
+  for (i = 0U; i < ArraySize; i++) {
+    if ((i > 0U) && !(pSensorGain[i - 1U] < pSensorGain[i])) {
+      return (BOOL_FALSE);
+    }
+    for (j = 0U; (j < pTable->NoNodes) && (pTable->Gain[j] != pSensorGain[i]); j++);
+    if (j == pTable->NoNodes) {
+      added++;
+    }
+  }
+
+  if ((pTable->NoNodes + added) > ADPF_GAIN_TABLE_MAX_NODES) {
+    return (BOOL_FALSE);
+  }
+
+  for (i = 0U; i < ArraySize; i++) {
+    for (j = 0U; (j < pTable->NoNodes) && (pTable->Gain[j] < pSensorGain[i]); j++);
+    if ((j < pTable->NoNodes) && (pTable->Gain[j] == pSensorGain[i])) {
+      continue;
+    }
+    memmove(&pTable->Gain[j + 1U], &pTable->Gain[j], (pTable->NoNodes - j) * sizeof(float));
+    pTable->Gain[j] = pSensorGain[i];
+    pTable->NoNodes++;
+  }
+
+  return (BOOL_TRUE);
+}
+
+
+/*****************************************************************************/
+/**
+ * @brief   This local function builds the gain table of a light mode from
+ *          its filter and 3dnr profiles. Curves which can't be merged are
+ *          left out and are looked up on their own.
+ *
+ * @param   pTable          gain table
+ * @param   pFilterProfile  filter profile of the light mode
+ * @param   p3DNRProfile    dsp 3dnr profile of the light mode
+ * @param   pNew3DNRProfile new dsp 3dnr profile in use
+ *
+ *****************************************************************************/
+static void AdpfGainTableBuild
+(
+    AdpfGainTable_t*                    pTable,
+    const CamFilterProfile_t*           pFilterProfile,
+    const CamDsp3DNRSettingProfile_t*   p3DNRProfile,
+    const CamNewDsp3DNRProfile_t*       pNew3DNRProfile
+) {
+  const CamDemosaicLpProfile_t* pLpConf = &pFilterProfile->DemosaicLpConf;
+  const float* pLpCurve[ADPF_LP_CURVES];
+  uint16_t cell, n;
+  int curve, i;
+
+  MEMSET(pTable, 0, sizeof(*pTable));
+
+  pTable->pCurveGain[ADPF_GAIN_CURVE_DENOISE_LEVEL]    = pFilterProfile->DenoiseLevelCurve.pSensorGain;
+  pTable->CurveSize[ADPF_GAIN_CURVE_DENOISE_LEVEL]     = pFilterProfile->DenoiseLevelCurve.ArraySize;
+  pTable->pCurveGain[ADPF_GAIN_CURVE_SHARPENING_LEVEL] = pFilterProfile->SharpeningLevelCurve.pSensorGain;
+  pTable->CurveSize[ADPF_GAIN_CURVE_SHARPENING_LEVEL]  = pFilterProfile->SharpeningLevelCurve.ArraySize;
+  pTable->pCurveGain[ADPF_GAIN_CURVE_DEMOSAIC_TH]      = pFilterProfile->DemosaicThCurve.pSensorGain;
+  pTable->CurveSize[ADPF_GAIN_CURVE_DEMOSAIC_TH]       = pFilterProfile->DemosaicThCurve.ArraySize;
+  pTable->pCurveGain[ADPF_GAIN_CURVE_DSP_3DNR]         = p3DNRProfile->pgain_Level;
+  pTable->CurveSize[ADPF_GAIN_CURVE_DSP_3DNR]          = p3DNRProfile->ArraySize;
+  pTable->pCurveGain[ADPF_GAIN_CURVE_NEW_DSP_3DNR]     = pNew3DNRProfile->pgain_Level;
+  pTable->CurveSize[ADPF_GAIN_CURVE_NEW_DSP_3DNR]      = pNew3DNRProfile->ArraySize;
+
+  for (curve = 0; curve < ADPF_GAIN_CURVE_MAX; curve++) {
+    pTable->CurveValid[curve] = AdpfGainTableAddNodes(pTable, pTable->pCurveGain[curve], pTable->CurveSize[curve]);
+  }
+
+  pTable->LpValid = BOOL_TRUE;
+  for (i = 0; i < ADPF_LP_CURVES; i++) {
+    pLpCurve[i] = *(float* const*)((const uint8_t*)pLpConf + AdpfLpCurveOffset[i]);
+    if (pLpCurve[i] == NULL) {
+      pTable->LpValid = BOOL_FALSE;
+    }
+  }
+  if (pTable->LpValid) {
+    pTable->LpValid = AdpfGainTableAddNodes(pTable, pLpConf->gainsArray, ADPF_LP_NODES);
+  }
+
+  if (pTable->LpValid) {
+    pTable->pLpConf = pLpConf;
+    MEMCPY(pTable->LpGain, pLpConf->gainsArray, sizeof(pTable->LpGain));
+    for (n = 0U; n < ADPF_LP_NODES; n++) {
+      for (i = 0; i < ADPF_LP_CURVES; i++) {
+        pTable->LpValue[n][i] = pLpCurve[i][n];
+        if (n < (ADPF_LP_NODES - 1U)) {
+          pTable->LpSlope[n][i] = (pLpCurve[i][n + 1] - pLpCurve[i][n]) / (pTable->LpGain[n + 1] - pTable->LpGain[n]);
+        }
+      }
+    }
+  }
+
+  if (pTable->NoNodes == 0U) {
+    return;
+  }
+
+  /*
+   * Every gain inside a cell compares the same against all the nodes, so
+   * any gain of the cell gives the path all its gains take through each
+   * lookup. Only between two nodes of a level curve the nearest node
+   * still depends on the gain, which of the two is left to the lookup.
+   */
+  for (cell = 0U; cell < (2U * pTable->NoNodes + 1U); cell++) {
+    float x;
+
+    if (cell == 0U) {
+      x = nextafterf(pTable->Gain[0], -INFINITY);
+    } else if (cell & 1U) {
+      x = pTable->Gain[cell / 2U];
+    } else if ((cell / 2U) < pTable->NoNodes) {
+      x = nextafterf(pTable->Gain[cell / 2U - 1U], pTable->Gain[cell / 2U]);
+    } else {
+      x = nextafterf(pTable->Gain[cell / 2U - 1U], INFINITY);
+    }
+
+    for (curve = 0; curve < ADPF_GAIN_CURVE_MAX; curve++) {
+      const float* pSensorGain = pTable->pCurveGain[curve];
+      uint16_t nMax = pTable->CurveSize[curve] - 1U;
+
+      if (!pTable->CurveValid[curve]) {
+        continue;
+      }
+
+      if (!(cell & 1U) && (x > pSensorGain[0]) && (x < pSensorGain[nMax])) {
+        for (n = 0U; (n <= nMax) && (x >= pSensorGain[n]); n++);
+        pTable->CurveNode[cell][curve] = (uint8_t)((n - 1U) | ADPF_GAIN_NODE_NEAREST);
+      } else {
+        pTable->CurveNode[cell][curve] = (uint8_t)AdpfGainCurveNearestNode(pSensorGain, pTable->CurveSize[curve], x);
+      }
+    }
+
+    if (pTable->LpValid) {
+      if (x < pTable->LpGain[0]) {
+        pTable->LpSegment[cell] = ADPF_LP_BELOW;
+      } else if (x > pTable->LpGain[ADPF_LP_NODES - 1]) {
+        pTable->LpSegment[cell] = ADPF_LP_ABOVE;
+      } else {
+        for (n = 0U; (n < ADPF_LP_NODES) && (x >= pTable->LpGain[n]); n++);
+        /* a gain on the last node belongs to the last segment */
+        pTable->LpSegment[cell] = (uint8_t)((n == ADPF_LP_NODES) ? (n - 2U) : (n - 1U));
+      }
+    }
+  }
+}
+
+
+/*****************************************************************************/
+/**
+ * @brief   This local function interpolates all demosaic lp curves for
+ *          the sensor gain in the gain table cell of the gain.
+ *
+ * @param   pTable          gain table
+ * @param   cell            gain table cell of the sensor gain
+ * @param   fSensorGain     current sensor gain
+ * @param   pValue          resulted values, in AdpfLpCurveOffset order
+ *
+ *****************************************************************************/
+static void AdpfGainTableLpValues
+(
+    const AdpfGainTable_t*  pTable,
+    const uint16_t          cell,
+    const float             fSensorGain,
+    uint16_t*               pValue
+) {
+  uint8_t n = pTable->LpSegment[cell];
+  int i;
+
+  if ((n == ADPF_LP_BELOW) || (n == ADPF_LP_ABOVE)) {
+    const float* pY = pTable->LpValue[(n == ADPF_LP_BELOW) ? 0 : (ADPF_LP_NODES - 1)];
+    for (i = 0; i < ADPF_LP_CURVES; i++) {
+      pValue[i] = (uint16_t)pY[i];
+    }
+    return;
+  }
+
+  float dx = fSensorGain - pTable->LpGain[n];
+  for (i = 0; i < ADPF_LP_CURVES; i++) {
+    pValue[i] = (uint16_t)(pTable->LpSlope[n][i] * dx + pTable->LpValue[n][i]);
+  }
+}
+
+
 /*****************************************************************************
 *AdpfRKLpCalMatrix
 ********************************************************************************/
@@ -1035,9 +1302,9 @@ static RESULT AdpfRKLpCalMatrix
 	RKDemosiacLpResult_t   *prkDLpResult
 )
 {
-    (void) pAdpfCtx;
-	uint8_t counts = 6;
+	uint8_t counts = ADPF_LP_NODES;
 	RESULT result = RET_SUCCESS;
+	uint16_t value[ADPF_LP_CURVES];
 
 	
 	if (pRKDLpConf == NULL) {
@@ -1056,40 +1323,51 @@ static RESULT AdpfRKLpCalMatrix
 		return (RET_INVALID_PARM);
 	}
 	
-	prkDLpResult->thgrad_divided[0] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thgrad_divided[1] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thgrad_divided[2] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thgrad_divided[3] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thgrad_divided[4] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thcsc_divided[0] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thcsc_divided[1] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thcsc_divided[2] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thcsc_divided[3] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thcsc_divided[4] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thdiff_divided[0] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thdiff_divided[1] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thdiff_divided[2] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thdiff_divided[3] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thdiff_divided[4] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thvar_divided[0] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thvar_divided[1] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thvar_divided[2] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thvar_divided[3] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thvar_divided[4] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->th_grad = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->th_grad), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->th_diff = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->th_diff), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->th_csc = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->th_csc), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->th_var = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->th_var), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thgrad_r_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thgrad_r_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thdiff_r_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thdiff_r_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thvar_r_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thvar_r_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thgrad_b_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thgrad_b_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thdiff_b_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thdiff_b_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->thvar_b_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thvar_b_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->similarity_th = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->similarity_th), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->flat_level_sel= (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->flat_level_sel), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->pattern_level_sel = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->pattern_level_sel), (pRKDLpConf->gainsArray), counts, fSensorGain);
-	prkDLpResult->edge_level_sel = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->edge_level_sel), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	if ((pAdpfCtx->pGainTable != NULL)
+	    && pAdpfCtx->pGainTable->LpValid
+	    && (pAdpfCtx->pGainTable->pLpConf == pRKDLpConf)) {
+		AdpfGainTableLpValues(pAdpfCtx->pGainTable, AdpfGainTableLookup(pAdpfCtx, fSensorGain), fSensorGain, value);
+	} else {
+		for (int i = 0; i < ADPF_LP_CURVES; i++) {
+			float *pCurve = *(float **)((uint8_t *)pRKDLpConf + AdpfLpCurveOffset[i]);
+			value[i] = AdpfRKLpInterpolate(pCurve, pRKDLpConf->gainsArray, counts, fSensorGain);
+		}
+	}
+
+	prkDLpResult->thgrad_divided[0] = (uint8_t)value[0];
+	prkDLpResult->thgrad_divided[1] = (uint8_t)value[1];
+	prkDLpResult->thgrad_divided[2] = (uint8_t)value[2];
+	prkDLpResult->thgrad_divided[3] = (uint8_t)value[3];
+	prkDLpResult->thgrad_divided[4] = (uint8_t)value[4];
+	prkDLpResult->thcsc_divided[0] = (uint8_t)value[5];
+	prkDLpResult->thcsc_divided[1] = (uint8_t)value[6];
+	prkDLpResult->thcsc_divided[2] = (uint8_t)value[7];
+	prkDLpResult->thcsc_divided[3] = (uint8_t)value[8];
+	prkDLpResult->thcsc_divided[4] = (uint8_t)value[9];
+	prkDLpResult->thdiff_divided[0] = (uint8_t)value[10];
+	prkDLpResult->thdiff_divided[1] = (uint8_t)value[11];
+	prkDLpResult->thdiff_divided[2] = (uint8_t)value[12];
+	prkDLpResult->thdiff_divided[3] = (uint8_t)value[13];
+	prkDLpResult->thdiff_divided[4] = (uint8_t)value[14];
+	prkDLpResult->thvar_divided[0] = (uint16_t)value[15];
+	prkDLpResult->thvar_divided[1] = (uint16_t)value[16];
+	prkDLpResult->thvar_divided[2] = (uint16_t)value[17];
+	prkDLpResult->thvar_divided[3] = (uint16_t)value[18];
+	prkDLpResult->thvar_divided[4] = (uint16_t)value[19];
+	prkDLpResult->th_grad = (uint8_t)value[20];
+	prkDLpResult->th_diff = (uint8_t)value[21];
+	prkDLpResult->th_csc = (uint8_t)value[22];
+	prkDLpResult->th_var = (uint16_t)value[23];
+	prkDLpResult->thgrad_r_fct = (uint8_t)value[24];
+	prkDLpResult->thdiff_r_fct = (uint8_t)value[25];
+	prkDLpResult->thvar_r_fct = (uint8_t)value[26];
+	prkDLpResult->thgrad_b_fct = (uint8_t)value[27];
+	prkDLpResult->thdiff_b_fct = (uint8_t)value[28];
+	prkDLpResult->thvar_b_fct = (uint8_t)value[29];
+	prkDLpResult->similarity_th = (uint8_t)value[30];
+	prkDLpResult->flat_level_sel = (uint8_t)value[31];
+	prkDLpResult->pattern_level_sel = (uint8_t)value[32];
+	prkDLpResult->edge_level_sel = (uint8_t)value[33];
 	
 	return ( result );
 }
@@ -1170,6 +1448,11 @@ static RESULT AdpfApplyConfiguration
       return (RET_INVALID_PARM);
     }
 
+    // the gain tables are rebuilt from the new profiles below
+    MEMSET(pAdpfCtx->GainTable, 0, sizeof(pAdpfCtx->GainTable));
+    pAdpfCtx->pGainTable = NULL;
+    pAdpfCtx->pGainCellTable = NULL;
+
     // initialize calibration database access
     result = AdpfPrepareCalibDbAccess(pAdpfCtx,
                                       pConfig->data.db.hCamCalibDb,
@@ -1401,6 +1684,15 @@ static RESULT AdpfApplyConfiguration
       pAdpfCtx->Nll.NllCoeff[i] = (pDpfProfile->nll_coeff.uCoeff[i] >> 2);
     }
 
+    // merge the gain nodes of the curves looked up per frame
+    for (int32_t i = 0; i < LIGHT_MODE_MAX; i++) {
+      AdpfGainTableBuild(&pAdpfCtx->GainTable[i],
+                         &pAdpfCtx->FilterProfile[i],
+                         &pAdpfCtx->Dsp3DNRSettingProfile[i],
+                         pAdpfCtx->pNew3DNRProfile);
+    }
+    pAdpfCtx->pGainTable = &pAdpfCtx->GainTable[pAdpfCtx->LightMode];
+
   } else if (pConfig->type == ADPF_USE_DEFAULT_CONFIG) {
     // initialize Adpf context with values from calibration database
     pAdpfCtx->gain                  = pConfig->fSensorGain;
@@ -1717,6 +2009,7 @@ RESULT AdpfRun
   }
   pAdpfCtx->pFilterProfile = &(pAdpfCtx->FilterProfile[LightMode]);
   pAdpfCtx->pDsp3DNRSettingProfile = &(pAdpfCtx->Dsp3DNRSettingProfile[LightMode]);
+  pAdpfCtx->pGainTable = &(pAdpfCtx->GainTable[LightMode]);
   
   if (pAdpfCtx->pFilterProfile->FilterEnable >= 1.0) {
   	if (dgain > 0.15f || pAdpfCtx->LightMode != LightMode){  
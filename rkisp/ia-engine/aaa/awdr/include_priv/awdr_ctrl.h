@@ -58,6 +58,27 @@ typedef enum AwdrState_e {
 
 
 
+#define AWDR_GAIN_TABLE_MAX_NODES   32
+#define AWDR_GAIN_TABLE_MAX_CELLS   (2 * AWDR_GAIN_TABLE_MAX_NODES + 1)
+
+/*****************************************************************************/
+/**
+ * @brief   Max gain level of the wdr max gain curve, resolved at
+ *          configuration for each cell of the gain axis. Cell 0 is below
+ *          the first node, cell 2i+1 is node i and cell 2i+2 is between
+ *          node i and node i+1, or above the last.
+ */
+/*****************************************************************************/
+typedef struct AwdrGainTable_s {
+  bool_t          Valid;
+  const float*    pSensorGain;                          /**< gain nodes of the curve in calibration */
+  const float*    pMaxGain;
+  uint16_t        NoNodes;
+  uint8_t         MaxGainLevel[AWDR_GAIN_TABLE_MAX_CELLS];
+} AwdrGainTable_t;
+
+
+
 /*****************************************************************************/
 /**
  * @brief   Context of the AWDR module.
@@ -81,6 +102,8 @@ typedef struct AwdrContext_s {
   //wdr max gain dynamic set with ae gain    --oyyf add
   //CamCalibWdrMaxGainLevelCurve_t *pWdrMaxGainLevelCurve;
   AwdrResult_t awdr_result;
+
+  AwdrGainTable_t GainTable;
 } AwdrContext_t;
 
 
@@ -69,47 +69,41 @@ static uint8_t  cam_ia_wdr_def_segment[AWDR_WDR_SECTION_MAX - 1] = {
  * local macro definitions
  *****************************************************************************/
 
-static RESULT AwdrCalculateWdrMaxGainLevel
+/*****************************************************************************/
+/**
+ * @brief   This local function looks the max gain level register value of
+ *          the sensor gain up in the wdr max gain curve.
+ *
+ * @param   pCurve          wdr max gain curve
+ * @param   fSensorGain     current sensor gain
+ *
+ * @return                  Return the max gain level register value.
+ *
+ *****************************************************************************/
+static uint8_t AwdrWdrMaxGainLevel
 (
-    CamCalibWdrMaxGainLevelCurve_t* pWdrMaxGainLevelCurve,
-    const float             fSensorGain,
-    uint8_t*       MaxGainLevelRegValue
+    const CamCalibWdrMaxGainLevelCurve_t* pCurve,
+    const float             fSensorGain
 ) {
-  LOGV( "%s: (enter)\n", __func__);
-  if (pWdrMaxGainLevelCurve == NULL) {
-    LOGE("%s: (exit) pWdrMaxGainLevelCurve == NULL \n", __func__);
-    return (RET_NULL_POINTER);
-  }
-
-  if (fSensorGain < 1.0f) {
-    LOGE("%s: fSensorGain  < 1.0f  \n", __func__);
-    return (RET_INVALID_PARM);
-  }
-
-  if (pWdrMaxGainLevelCurve->nSize < 1) {
-    LOGE("%s: (exit) nSize == 0 \n", __func__);
-    return (RET_INVALID_PARM);
-  }
-
   uint16_t n    = 0U;
   uint16_t nMax = 0U;
   float Dgain = fSensorGain;
   float MaxGainResult = 1.0;
-  nMax = (pWdrMaxGainLevelCurve->nSize - 1U);
+  nMax = (pCurve->nSize - 1U);
 
   /* lower range check */
-  if (Dgain < pWdrMaxGainLevelCurve->pfSensorGain_level[0]) {
-    Dgain = pWdrMaxGainLevelCurve->pfSensorGain_level[0];
+  if (Dgain < pCurve->pfSensorGain_level[0]) {
+    Dgain = pCurve->pfSensorGain_level[0];
   }
 
   /* upper range check */
-  if (Dgain > pWdrMaxGainLevelCurve->pfSensorGain_level[nMax]) {
-    Dgain = pWdrMaxGainLevelCurve->pfSensorGain_level[nMax];
+  if (Dgain > pCurve->pfSensorGain_level[nMax]) {
+    Dgain = pCurve->pfSensorGain_level[nMax];
   }
 
   /* find x area */
   n = 0;
-  while ((Dgain >=  pWdrMaxGainLevelCurve->pfSensorGain_level[n]) && (n <= nMax)) {
+  while ((Dgain >=  pCurve->pfSensorGain_level[n]) && (n <= nMax)) {
     ++n;
   }
   --n;
@@ -125,14 +119,14 @@ static RESULT AwdrCalculateWdrMaxGainLevel
 #if 0
   //interpolate
   MaxGainResult
-    = ((pWdrMaxGainLevelCurve->pfMaxGain_level[n + 1] - pWdrMaxGainLevelCurve->pfMaxGain_level[n]) / (pWdrMaxGainLevelCurve->pfSensorGain_level[n + 1] - pWdrMaxGainLevelCurve->pfSensorGain_level[n]))
-      * (Dgain - pWdrMaxGainLevelCurve->pfSensorGain_level[n])
-      + (pWdrMaxGainLevelCurve->pfMaxGain_level[n]);
+    = ((pCurve->pfMaxGain_level[n + 1] - pCurve->pfMaxGain_level[n]) / (pCurve->pfSensorGain_level[n + 1] - pCurve->pfSensorGain_level[n]))
+      * (Dgain - pCurve->pfSensorGain_level[n])
+      + (pCurve->pfMaxGain_level[n]);
 #else
-  MaxGainResult = pWdrMaxGainLevelCurve->pfMaxGain_level[n + 1];
+  MaxGainResult = pCurve->pfMaxGain_level[n + 1];
 
-  if (Dgain == pWdrMaxGainLevelCurve->pfSensorGain_level[0])
-    MaxGainResult = pWdrMaxGainLevelCurve->pfMaxGain_level[0];
+  if (Dgain == pCurve->pfSensorGain_level[0])
+    MaxGainResult = pCurve->pfMaxGain_level[0];
 
 #endif
 
@@ -142,9 +136,134 @@ static RESULT AwdrCalculateWdrMaxGainLevel
   if (MaxGainResult > 15.0)
     MaxGainResult = 15.0;
 
-  *MaxGainLevelRegValue = (((uint8_t)MaxGainResult) << 4);
+  return (((uint8_t)MaxGainResult) << 4);
+}
+
+/*****************************************************************************/
+/**
+ * @brief   This local function resolves the max gain level of every cell
+ *          of the gain axis, so the level of a gain takes a single search.
+ *          Curves which don't fit or aren't ascending are left out and
+ *          are looked up on each call.
+ *
+ * @param   pTable          gain table
+ * @param   pCurve          wdr max gain curve
+ *
+ *****************************************************************************/
+static void AwdrGainTableBuild
+(
+    AwdrGainTable_t*        pTable,
+    const CamCalibWdrMaxGainLevelCurve_t* pCurve
+) {
+  const float* pGain = pCurve->pfSensorGain_level;
+  uint16_t cell, i;
+
+  MEMSET(pTable, 0, sizeof(*pTable));
+
+  if ((pGain == NULL) || (pCurve->pfMaxGain_level == NULL)
+      || (pCurve->nSize < 2U) || (pCurve->nSize > AWDR_GAIN_TABLE_MAX_NODES)) {
+    return;
+  }
+
+  for (i = 1U; i < pCurve->nSize; i++) {
+    if (!(pGain[i - 1U] < pGain[i])) {
+      return;
+    }
+  }
+
+  pTable->pSensorGain = pGain;
+  pTable->pMaxGain    = pCurve->pfMaxGain_level;
+  pTable->NoNodes     = pCurve->nSize;
+
+  /* every gain inside a cell takes the same path through the lookup */
+  for (cell = 0U; cell < (2U * pTable->NoNodes + 1U); cell++) {
+    float x;
+
+    if (cell == 0U) {
+      x = nextafterf(pGain[0], -INFINITY);
+    } else if (cell & 1U) {
+      x = pGain[cell / 2U];
+    } else if ((cell / 2U) < pTable->NoNodes) {
+      x = nextafterf(pGain[cell / 2U - 1U], pGain[cell / 2U]);
+    } else {
+      x = nextafterf(pGain[cell / 2U - 1U], INFINITY);
+    }
+
+    pTable->MaxGainLevel[cell] = AwdrWdrMaxGainLevel(pCurve, x);
+  }
+
+  pTable->Valid = BOOL_TRUE;
+}
+
+/*****************************************************************************/
+/**
+ * @brief   This local function returns the gain table cell of the sensor
+ *          gain.
+ *
+ * @param   pTable          gain table
+ * @param   fSensorGain     current sensor gain
+ *
+ * @return                  Return the cell index.
+ *
+ *****************************************************************************/
+static uint16_t AwdrGainTableCell
+(
+    const AwdrGainTable_t*  pTable,
+    const float             fSensorGain
+) {
+  uint16_t lo = 0U;
+  uint16_t hi = pTable->NoNodes;
+
+  /* number of nodes not above the gain */
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2U;
+    if (pTable->pSensorGain[mid] <= fSensorGain) {
+      lo = mid + 1U;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if (lo == 0U) {
+    return (0U);
+  }
+
+  return ((pTable->pSensorGain[lo - 1U] == fSensorGain) ? (2U * lo - 1U) : (2U * lo));
+}
+
+static RESULT AwdrCalculateWdrMaxGainLevel
+(
+    AwdrContext_t*   pAwdrCtx,
+    CamCalibWdrMaxGainLevelCurve_t* pWdrMaxGainLevelCurve,
+    const float             fSensorGain,
+    uint8_t*       MaxGainLevelRegValue
+) {
+  LOGV( "%s: (enter)\n", __func__);
+  if (pWdrMaxGainLevelCurve == NULL) {
+    LOGE("%s: (exit) pWdrMaxGainLevelCurve == NULL \n", __func__);
+    return (RET_NULL_POINTER);
+  }
+
+  if (fSensorGain < 1.0f) {
+    LOGE("%s: fSensorGain  < 1.0f  \n", __func__);
+    return (RET_INVALID_PARM);
+  }
+
+  if (pWdrMaxGainLevelCurve->nSize < 1) {
+    LOGE("%s: (exit) nSize == 0 \n", __func__);
+    return (RET_INVALID_PARM);
+  }
+
+  if (pAwdrCtx->GainTable.Valid
+      && (pAwdrCtx->GainTable.pSensorGain == pWdrMaxGainLevelCurve->pfSensorGain_level)
+      && (pAwdrCtx->GainTable.pMaxGain == pWdrMaxGainLevelCurve->pfMaxGain_level)
+      && (pAwdrCtx->GainTable.NoNodes == pWdrMaxGainLevelCurve->nSize)) {
+    *MaxGainLevelRegValue = pAwdrCtx->GainTable.MaxGainLevel[AwdrGainTableCell(&pAwdrCtx->GainTable, fSensorGain)];
+  } else {
+    *MaxGainLevelRegValue = AwdrWdrMaxGainLevel(pWdrMaxGainLevelCurve, fSensorGain);
+  }
 
-  LOGV( "%s: SensorGain(%f) MaxGainLimit(0x%02x) \n", __func__, Dgain, *MaxGainLevelRegValue);
+  LOGV( "%s: SensorGain(%f) MaxGainLimit(0x%02x) \n", __func__, fSensorGain, *MaxGainLevelRegValue);
 
   LOGV( "%s: (exit)\n", __func__);
 
@@ -170,11 +289,13 @@ static RESULT AwdrApplyConfiguration
     return (RET_INVALID_PARM);
   }
 
+  MEMSET(&pAwdrCtx->GainTable, 0, sizeof(pAwdrCtx->GainTable));
   result = CamCalibDbGetWdrGlobal(pConfig->hCamCalibDb, &pAwdrCtx->pWdrGlobal);
   if (result == RET_SUCCESS) {
     pAwdrCtx->hCamCalibDb = pConfig->hCamCalibDb;
     if (pAwdrCtx->pWdrGlobal != NULL && pAwdrCtx->pWdrGlobal->Enabled) {
       pAwdrCtx->WdrEnable = 1;
+      AwdrGainTableBuild(&pAwdrCtx->GainTable, &pAwdrCtx->pWdrGlobal->wdr_MaxGain_Level_curve);
       if (pAwdrCtx->pWdrGlobal->wdr_MaxGain_Level_curve.filter_enable) {
         pAwdrCtx->WdrMaxGainEnable = 1;
       } else {
@@ -262,7 +383,7 @@ static RESULT AwdrApplyConfiguration
     switch (pConfig->mode) {
       case AWDR_MODE_CONTROL_BY_GAIN:
         // caluclate init strength
-        result = AwdrCalculateWdrMaxGainLevel(&pAwdrCtx->pWdrGlobal->wdr_MaxGain_Level_curve, pConfig->fSensorGain, &pAwdrCtx->awdr_result.wdr_gain_max_value);
+        result = AwdrCalculateWdrMaxGainLevel(pAwdrCtx, &pAwdrCtx->pWdrGlobal->wdr_MaxGain_Level_curve, pConfig->fSensorGain, &pAwdrCtx->awdr_result.wdr_gain_max_value);
         if (result != RET_SUCCESS) {
           LOGV( "%s : AwdrCalculateWdrMaxGainLevel failed", __func__);
           return (result);
@@ -425,7 +546,7 @@ RESULT AwdrRun
     dgain = (gain > pAwdrCtx->gain) ? (gain - pAwdrCtx->gain) : (pAwdrCtx->gain - gain);
     if (dgain > 0.15f) {
       uint8_t Wdr_MaxGain_level_RegValue;
-      result = AwdrCalculateWdrMaxGainLevel(&pAwdrCtx->pWdrGlobal->wdr_MaxGain_Level_curve, gain, &Wdr_MaxGain_level_RegValue);
+      result = AwdrCalculateWdrMaxGainLevel(pAwdrCtx, &pAwdrCtx->pWdrGlobal->wdr_MaxGain_Level_curve, gain, &Wdr_MaxGain_level_RegValue);
       RETURN_RESULT_IF_DIFFERENT(result, RET_SUCCESS);
 
       if (Wdr_MaxGain_level_RegValue != pAwdrCtx->awdr_result.wdr_gain_max_value) {
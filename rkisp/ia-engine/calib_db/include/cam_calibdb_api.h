@@ -1254,6 +1254,104 @@ RESULT CamCalibDbLoadFile
     const char* CamCalibDbIqData
 );
 
+
+
+/*****************************************************************************/
+/**
+ * @brief   This function writes the CamCalibDb instance created from an
+ *          IQ xml to a memory mappable file in the CAMERA_ENGINE_RKISP_XML_DB
+ *          directory. The file holds the whole database in place, so it is
+ *          specific to the ABI it was generated with.
+ *
+ * @param   hCamCalibDb         Handle to the CamCalibDb instance.
+ * @param   xml_path            IQ xml the instance was created from.
+ * @param   magic_version_code  Magic version code of the xml parser.
+ *
+ * @return  Return the result of the function call.
+ * @retval  RET_SUCCESS         function succeed
+ * @retval  RET_WRONG_HANDLE    invalid instance handle
+ * @retval  RET_NOTAVAILABLE    no CAMERA_ENGINE_RKISP_XML_DB directory
+ * @retval  RET_FAILURE         the file could not be written
+ *
+ *****************************************************************************/
+RESULT CamCalibDbGenerateMapFile
+(
+    CamCalibDbHandle_t  hCamCalibDb,
+    const char* xml_path,
+    uint32_t magic_version_code
+);
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   This function maps the file CamCalibDbGenerateMapFile wrote for
+ *          an IQ xml and uses it as CamCalibDb instance without loading it.
+ *          The instance can not be cleared, CamCalibDbRelease unmaps it.
+ *
+ * @param   hCamCalibDb         Returns the handle to the CamCalibDb instance.
+ * @param   xml_path            IQ xml the file was generated from.
+ * @param   magic_version_code  Magic version code of the xml parser.
+ *
+ * @return  Return the result of the function call.
+ * @retval  RET_SUCCESS         function succeed
+ * @retval  RET_NOTAVAILABLE    no file for this xml
+ * @retval  RET_WRONG_CONFIG    file is from another xml, parser, version or ABI
+ * @retval  RET_FAILURE         file could not be mapped or is corrupted
+ *
+ *****************************************************************************/
+RESULT CamCalibDbMapFile
+(
+    CamCalibDbHandle_t*  hCamCalibDb,
+    const char* xml_path,
+    uint32_t magic_version_code
+);
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   This function returns the generation of the CamCalibDb instance.
+ *          It moves on with every Add, Replace, Del, Clear or Touch call
+ *          and when an instance is released, so what was derived from the
+ *          instance at one generation still holds while the generation is
+ *          the same. The generation is shared by all instances.
+ *
+ * @param   hCamCalibDb         Handle to the CamCalibDb instance.
+ * @param   pGeneration         Returns the generation.
+ *
+ * @return  Return the result of the function call.
+ * @retval  RET_SUCCESS         function succeed
+ * @retval  RET_WRONG_HANDLE    invalid instance handle
+ * @retval  RET_INVALID_PARM    invalid parameter
+ *
+ *****************************************************************************/
+RESULT CamCalibDbGetGeneration
+(
+    CamCalibDbHandle_t  hCamCalibDb,
+    uint32_t*           pGeneration
+);
+
+
+
+/*****************************************************************************/
+/**
+ * @brief   This function moves the generation on after a profile returned
+ *          by a CamCalibDbGet* function was changed in place, the way the
+ *          tuning tool does, so nothing derived from it is kept.
+ *
+ * @param   hCamCalibDb         Handle to the CamCalibDb instance.
+ *
+ * @return  Return the result of the function call.
+ * @retval  RET_SUCCESS         function succeed
+ * @retval  RET_WRONG_HANDLE    invalid instance handle
+ *
+ *****************************************************************************/
+RESULT CamCalibDbTouch
+(
+    CamCalibDbHandle_t  hCamCalibDb
+);
+
 #ifdef __cplusplus
 }
 #endif
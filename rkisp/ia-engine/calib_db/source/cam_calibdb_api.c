@@ -29,7 +29,12 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <ctype.h>
+#include <pthread.h>
 
 #define LOAD_IQ_TRACE_INFO_ON
 // if defined, bin file should be included in following
@@ -2598,38 +2603,7 @@ static RESULT DumpBin2CSource(const char *bin_path, const char *c_path) {
   return (RET_SUCCESS);
 }
 
-RESULT CamCalibDbDumpFile
-(
-    CamCalibDbHandle_t  hCamCalibDb,
-    const char *dump_path
-) {
-  CamCalibDbContext_t* pCamCalibDbCtx = (CamCalibDbContext_t*)hCamCalibDb;
-  RESULT result;
-  FILE* fp = NULL;
-  List* l;
-  char xml_dump_bin_file[128]; 
-  char xml_dump_db_file[128]; 
-  char* xml_path_split;
-
-  LOGD( "%s (enter)\n", __FUNCTION__);
-
-  if (NULL == pCamCalibDbCtx) {
-    return (RET_WRONG_HANDLE);
-  }
-
-  if (NULL == GetXmlDbDir())
-    return RET_FAILURE;
-
-  xml_path_split = strrchr(dump_path, '/');
-
-  sprintf(xml_dump_bin_file, "%s/%s.bin", GetXmlDbDir(), xml_path_split + 1);
-  
-  fp = fopen(xml_dump_bin_file, "wb");
-  if (!fp) {
-    LOGE( "%s:open %s failed %s!!\n", __func__, xml_dump_bin_file, strerror(errno));
-    return RET_FAILURE;
-  }
-
+static void DumpCamCalibDb(CamCalibDbContext_t* pCamCalibDbCtx, FILE* fp) {
   fwrite(pCamCalibDbCtx, sizeof(CamCalibDbContext_t), 1, fp);
 
   DumpResolutionList(&pCamCalibDbCtx->resolution, fp);
@@ -2697,6 +2671,41 @@ RESULT CamCalibDbDumpFile
   DumpIeSharpenProfileList(&pCamCalibDbCtx->iesharpen_profile, fp);
   if (pCamCalibDbCtx->pOTPGlobal)
     fwrite(pCamCalibDbCtx->pOTPGlobal, sizeof(CamOTPGlobal_t), 1, fp);
+}
+
+RESULT CamCalibDbDumpFile
+(
+    CamCalibDbHandle_t  hCamCalibDb,
+    const char *dump_path
+) {
+  CamCalibDbContext_t* pCamCalibDbCtx = (CamCalibDbContext_t*)hCamCalibDb;
+  RESULT result;
+  FILE* fp = NULL;
+  List* l;
+  char xml_dump_bin_file[128]; 
+  char xml_dump_db_file[128]; 
+  char* xml_path_split;
+
+  LOGD( "%s (enter)\n", __FUNCTION__);
+
+  if (NULL == pCamCalibDbCtx) {
+    return (RET_WRONG_HANDLE);
+  }
+
+  if (NULL == GetXmlDbDir())
+    return RET_FAILURE;
+
+  xml_path_split = strrchr(dump_path, '/');
+
+  sprintf(xml_dump_bin_file, "%s/%s.bin", GetXmlDbDir(), xml_path_split + 1);
+  
+  fp = fopen(xml_dump_bin_file, "wb");
+  if (!fp) {
+    LOGE( "%s:open %s failed %s!!\n", __func__, xml_dump_bin_file, strerror(errno));
+    return RET_FAILURE;
+  }
+
+  DumpCamCalibDb(pCamCalibDbCtx, fp);
 
   fclose(fp);
   { /* sync file data */
@@ -2770,6 +2779,61 @@ static unsigned int getCamCalibDbIqIdx() {
   return gCamCalibDbIqIdx;
 }
 
+/******************************************************************************
+ * Where the load functions place the database: plain malloc without an
+ * arena, otherwise one contiguous block the map image is built in. An
+ * arena without pBase only measures, its allocations are kept in
+ * pTracked to be freed again.
+ *****************************************************************************/
+#define CAM_CALIBDB_IQ_ARENA_ALIGN    16
+
+typedef struct CamCalibDbIqArena_s {
+  char*     pBase;
+  size_t    size;
+  size_t    used;
+  void**    pTracked;
+  size_t    tracked;
+  size_t    trackedMax;
+} CamCalibDbIqArena_t;
+
+static CamCalibDbIqArena_t* gpCamCalibDbIqArena = NULL;
+
+static void* allocCamCalibDbIq(size_t size) {
+  CamCalibDbIqArena_t* pArena = gpCamCalibDbIqArena;
+  void* p;
+
+  if (pArena == NULL)
+    return malloc(size);
+
+  // zero sized arrays still get an address of their own
+  size = size ? (size + CAM_CALIBDB_IQ_ARENA_ALIGN - 1) & ~(size_t)(CAM_CALIBDB_IQ_ARENA_ALIGN - 1)
+         : CAM_CALIBDB_IQ_ARENA_ALIGN;
+
+  if (pArena->pBase == NULL) {
+    if (pArena->tracked == pArena->trackedMax) {
+      size_t max = pArena->trackedMax ? pArena->trackedMax * 2 : 256;
+      void** pTracked = realloc(pArena->pTracked, max * sizeof(void*));
+      if (pTracked == NULL) {
+        LOGE( "%s:realloc failed!!\n", __func__);
+        return NULL;
+      }
+      pArena->pTracked = pTracked;
+      pArena->trackedMax = max;
+    }
+    p = calloc(1, size);
+    pArena->pTracked[pArena->tracked++] = p;
+  } else {
+    if (pArena->used + size > pArena->size) {
+      LOGE( "%s:arena of %zu bytes exhausted!!\n", __func__, pArena->size);
+      return NULL;
+    }
+    p = pArena->pBase + pArena->used;
+  }
+  pArena->used += size;
+
+  return p;
+}
+
 static void LoadFrameRateList(List* l) {
   CamFrameRate_t* pNew;
 
@@ -2777,11 +2841,11 @@ static void LoadFrameRateList(List* l) {
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
   if (!ListEmpty(l)) {
-    CamFrameRate_t* pFrameRate = malloc(sizeof(CamFrameRate_t));
+    CamFrameRate_t* pFrameRate = allocCamCalibDbIq(sizeof(CamFrameRate_t));
     l->p_next = (List*)pFrameRate;
     readCamCalibDbIq(pFrameRate, sizeof(CamFrameRate_t));
     while (pFrameRate->p_next) {
-      pNew = malloc(sizeof(CamFrameRate_t));
+      pNew = allocCamCalibDbIq(sizeof(CamFrameRate_t));
       readCamCalibDbIq(pNew, sizeof(CamFrameRate_t));
 
       pFrameRate->p_next = pNew;
@@ -2802,14 +2866,14 @@ static void LoadResolutionList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamResolution_t* pResolution = malloc(sizeof(CamResolution_t));
+    CamResolution_t* pResolution = allocCamCalibDbIq(sizeof(CamResolution_t));
     l->p_next = (List*)pResolution;
     readCamCalibDbIq(pResolution, sizeof(CamResolution_t));
     LOGD("pResolution->p_next %p, pResolution->list %p", pResolution->p_next,
         pResolution->framerates.p_next);
     LoadFrameRateList(&pResolution->framerates);
     while (pResolution->p_next) {
-      pNew = malloc(sizeof(CamResolution_t));
+      pNew = allocCamCalibDbIq(sizeof(CamResolution_t));
       readCamCalibDbIq(pNew, sizeof(CamResolution_t));
       LoadFrameRateList(&pNew->framerates);
 
@@ -2828,53 +2892,53 @@ static void LoadAwb_V10_GlobalSubList(CamCalibAwb_V10_Global_t* pAwbGlobal) {
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
 
-  pAwbGlobal->AwbClipParam.pRg1 = malloc(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pRg1 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pRg1, pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbClipParam.pMaxDist1 = malloc(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pMaxDist1 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pMaxDist1, pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbClipParam.pRg2 = malloc(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pRg2 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pRg2, pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
-  pAwbGlobal->AwbClipParam.pMaxDist2 = malloc(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pMaxDist2 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pMaxDist2, pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
 
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1, pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1, pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2, pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2, pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
 
-  pAwbGlobal->AwbFade2Parm.pFade = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pFade = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pFade, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pCbMinRegionMax = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pCbMinRegionMax = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pCbMinRegionMax, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pCrMinRegionMax = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pCrMinRegionMax = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pCrMinRegionMax, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMax = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMax = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMax, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pCbMinRegionMin = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pCbMinRegionMin = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pCbMinRegionMin, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pCrMinRegionMin = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pCrMinRegionMin = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pCrMinRegionMin, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMin = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMin = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxCSumRegionMin, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinCRegionMax = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinCRegionMax = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinCRegionMax, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinCRegionMin = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinCRegionMin = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinCRegionMin, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMaxYRegionMax = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxYRegionMax = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxYRegionMax, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMaxYRegionMin = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxYRegionMin = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxYRegionMin, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMax = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMax = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMax, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMin = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMin = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinYMaxGRegionMin, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pRefCb = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pRefCb = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pRefCb, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pRefCr = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pRefCr = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pRefCr, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
 
 #ifdef LOAD_IQ_TRACE_INFO_ON
@@ -2889,12 +2953,12 @@ static void LoadAwb_V10_GlobalList(List* l) {
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
   if (!ListEmpty(l)) {
-    CamCalibAwb_V10_Global_t* pAwbGlobal = malloc(sizeof(CamCalibAwb_V10_Global_t));
+    CamCalibAwb_V10_Global_t* pAwbGlobal = allocCamCalibDbIq(sizeof(CamCalibAwb_V10_Global_t));
     l->p_next = (List*)pAwbGlobal;
     readCamCalibDbIq(pAwbGlobal, sizeof(CamCalibAwb_V10_Global_t));
     LoadAwb_V10_GlobalSubList(pAwbGlobal);
     while (pAwbGlobal->p_next) {
-      pNew = malloc(sizeof(CamCalibAwb_V10_Global_t));
+      pNew = allocCamCalibDbIq(sizeof(CamCalibAwb_V10_Global_t));
       readCamCalibDbIq(pNew, sizeof(CamCalibAwb_V10_Global_t));
       LoadAwb_V10_GlobalSubList(pNew);
 
@@ -2912,48 +2976,48 @@ static void LoadAwb_V11_GlobalSubList(CamCalibAwb_V11_Global_t* pAwbGlobal) {
 #ifdef LOAD_IQ_TRACE_INFO_ON
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
-  pAwbGlobal->AwbClipParam.pRg1 = malloc(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pRg1 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pRg1, pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbClipParam.pMaxDist1 = malloc(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pMaxDist1 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pMaxDist1, pAwbGlobal->AwbClipParam.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbClipParam.pRg2 = malloc(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pRg2 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pRg2, pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
-  pAwbGlobal->AwbClipParam.pMaxDist2 = malloc(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbClipParam.pMaxDist2 = allocCamCalibDbIq(pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbClipParam.pMaxDist2, pAwbGlobal->AwbClipParam.ArraySize2 * sizeof(float));
 
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade1, pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance1, pAwbGlobal->AwbGlobalFadeParm.ArraySize1 * sizeof(float));
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalFade2, pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
-  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2 = malloc(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
+  pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2 = allocCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbGlobalFadeParm.pGlobalGainDistance2, pAwbGlobal->AwbGlobalFadeParm.ArraySize2 * sizeof(float));
 
-  pAwbGlobal->AwbFade2Parm.pFade = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pFade = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pFade, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
 
-  pAwbGlobal->AwbFade2Parm.pMaxCSum_br = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxCSum_br = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxCSum_br, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMaxCSum_sr = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxCSum_sr = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxCSum_sr, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinC_br = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinC_br = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinC_br, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinC_sr = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinC_sr = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinC_sr, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
 
-  pAwbGlobal->AwbFade2Parm.pMaxY_br = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxY_br = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxY_br, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMaxY_sr = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMaxY_sr = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMaxY_sr, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinY_br = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinY_br = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinY_br, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pMinY_sr = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pMinY_sr = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pMinY_sr, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
 
-  pAwbGlobal->AwbFade2Parm.pRefCb = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pRefCb = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pRefCb, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
-  pAwbGlobal->AwbFade2Parm.pRefCr = malloc(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
+  pAwbGlobal->AwbFade2Parm.pRefCr = allocCamCalibDbIq(pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
   readCamCalibDbIq(pAwbGlobal->AwbFade2Parm.pRefCr, pAwbGlobal->AwbFade2Parm.ArraySize * sizeof(float));
 
 #ifdef LOAD_IQ_TRACE_INFO_ON
@@ -2968,12 +3032,12 @@ static void LoadAwb_V11_GlobalList(List* l) {
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
   if (!ListEmpty(l)) {
-    CamCalibAwb_V11_Global_t* pAwbGlobal = malloc(sizeof(CamCalibAwb_V11_Global_t));
+    CamCalibAwb_V11_Global_t* pAwbGlobal = allocCamCalibDbIq(sizeof(CamCalibAwb_V11_Global_t));
     l->p_next = (List*)pAwbGlobal;
     readCamCalibDbIq(pAwbGlobal, sizeof(CamCalibAwb_V11_Global_t));
     LoadAwb_V11_GlobalSubList(pAwbGlobal);
     while (pAwbGlobal->p_next) {
-      pNew = malloc(sizeof(CamCalibAwb_V11_Global_t));
+      pNew = allocCamCalibDbIq(sizeof(CamCalibAwb_V11_Global_t));
       readCamCalibDbIq(pNew, sizeof(CamCalibAwb_V11_Global_t));
       LoadAwb_V11_GlobalSubList(pNew);
 
@@ -2994,11 +3058,11 @@ static void LoadEcmSchemeList(List* l) {
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
   if (!ListEmpty(l)) {
-    CamEcmScheme_t* pEcmScheme = malloc(sizeof(CamEcmScheme_t));
+    CamEcmScheme_t* pEcmScheme = allocCamCalibDbIq(sizeof(CamEcmScheme_t));
     l->p_next = (List*)pEcmScheme;
     readCamCalibDbIq(pEcmScheme, sizeof(CamEcmScheme_t));
     while (pEcmScheme->p_next) {
-      pNew = malloc(sizeof(CamEcmScheme_t));
+      pNew = allocCamCalibDbIq(sizeof(CamEcmScheme_t));
       readCamCalibDbIq(pNew, sizeof(CamEcmScheme_t));
 
       pEcmScheme->p_next = pNew;
@@ -3019,12 +3083,12 @@ static void LoadEcmProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamEcmProfile_t* pEcmProfile = malloc(sizeof(CamEcmProfile_t));
+    CamEcmProfile_t* pEcmProfile = allocCamCalibDbIq(sizeof(CamEcmProfile_t));
     l->p_next = (List*)pEcmProfile;
     readCamCalibDbIq(pEcmProfile, sizeof(CamEcmProfile_t));
     LoadEcmSchemeList(&pEcmProfile->ecm_scheme);
     while (pEcmProfile->p_next) {
-      pNew = malloc(sizeof(CamEcmProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamEcmProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamEcmProfile_t));
       LoadEcmSchemeList(&pNew->ecm_scheme);
 
@@ -3043,17 +3107,17 @@ static void LoadAwb_V10_IlluminationSubList(CamAwb_V10_IlluProfile_t* pIlluminat
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
 
-  pIllumination->SaturationCurve.pSensorGain = malloc(pIllumination->SaturationCurve.ArraySize * sizeof(float));
+  pIllumination->SaturationCurve.pSensorGain = allocCamCalibDbIq(pIllumination->SaturationCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->SaturationCurve.pSensorGain,
     pIllumination->SaturationCurve.ArraySize * sizeof(float));
-  pIllumination->SaturationCurve.pSaturation = malloc(pIllumination->SaturationCurve.ArraySize * sizeof(float));
+  pIllumination->SaturationCurve.pSaturation = allocCamCalibDbIq(pIllumination->SaturationCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->SaturationCurve.pSaturation,
     pIllumination->SaturationCurve.ArraySize * sizeof(float));
 
-  pIllumination->VignettingCurve.pSensorGain = malloc(pIllumination->VignettingCurve.ArraySize * sizeof(float));
+  pIllumination->VignettingCurve.pSensorGain = allocCamCalibDbIq(pIllumination->VignettingCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->VignettingCurve.pSensorGain,
     pIllumination->VignettingCurve.ArraySize * sizeof(float));
-  pIllumination->VignettingCurve.pVignetting = malloc(pIllumination->VignettingCurve.ArraySize * sizeof(float));
+  pIllumination->VignettingCurve.pVignetting = allocCamCalibDbIq(pIllumination->VignettingCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->VignettingCurve.pVignetting,
     pIllumination->VignettingCurve.ArraySize * sizeof(float));
 
@@ -3070,12 +3134,12 @@ static void LoadAwb_V10_IlluminationList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamAwb_V10_IlluProfile_t* pIllumination = malloc(sizeof(CamAwb_V10_IlluProfile_t));
+    CamAwb_V10_IlluProfile_t* pIllumination = allocCamCalibDbIq(sizeof(CamAwb_V10_IlluProfile_t));
     l->p_next = (List*)pIllumination;
     readCamCalibDbIq(pIllumination, sizeof(CamAwb_V10_IlluProfile_t));
     LoadAwb_V10_IlluminationSubList(pIllumination);
     while (pIllumination->p_next) {
-      pNew = malloc(sizeof(CamAwb_V10_IlluProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamAwb_V10_IlluProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamAwb_V10_IlluProfile_t));
       LoadAwb_V10_IlluminationSubList(pNew);
 
@@ -3094,17 +3158,17 @@ static void LoadAwb_V11_IlluminationSubList(CamAwb_V11_IlluProfile_t* pIlluminat
   LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
 #endif
 
-  pIllumination->SaturationCurve.pSensorGain = malloc(pIllumination->SaturationCurve.ArraySize * sizeof(float));
+  pIllumination->SaturationCurve.pSensorGain = allocCamCalibDbIq(pIllumination->SaturationCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->SaturationCurve.pSensorGain,
     pIllumination->SaturationCurve.ArraySize * sizeof(float));
-  pIllumination->SaturationCurve.pSaturation = malloc(pIllumination->SaturationCurve.ArraySize * sizeof(float));
+  pIllumination->SaturationCurve.pSaturation = allocCamCalibDbIq(pIllumination->SaturationCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->SaturationCurve.pSaturation,
     pIllumination->SaturationCurve.ArraySize * sizeof(float));
 
-  pIllumination->VignettingCurve.pSensorGain = malloc(pIllumination->VignettingCurve.ArraySize * sizeof(float));
+  pIllumination->VignettingCurve.pSensorGain = allocCamCalibDbIq(pIllumination->VignettingCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->VignettingCurve.pSensorGain,
     pIllumination->VignettingCurve.ArraySize * sizeof(float));
-  pIllumination->VignettingCurve.pVignetting = malloc(pIllumination->VignettingCurve.ArraySize * sizeof(float));
+  pIllumination->VignettingCurve.pVignetting = allocCamCalibDbIq(pIllumination->VignettingCurve.ArraySize * sizeof(float));
   readCamCalibDbIq(pIllumination->VignettingCurve.pVignetting,
     pIllumination->VignettingCurve.ArraySize * sizeof(float));
 
@@ -3121,12 +3185,12 @@ static void LoadAwb_V11_IlluminationList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamAwb_V11_IlluProfile_t* pIllumination = malloc(sizeof(CamAwb_V11_IlluProfile_t));
+    CamAwb_V11_IlluProfile_t* pIllumination = allocCamCalibDbIq(sizeof(CamAwb_V11_IlluProfile_t));
     l->p_next = (List*)pIllumination;
     readCamCalibDbIq(pIllumination, sizeof(CamAwb_V11_IlluProfile_t));
     LoadAwb_V11_IlluminationSubList(pIllumination);
     while (pIllumination->p_next) {
-      pNew = malloc(sizeof(CamAwb_V11_IlluProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamAwb_V11_IlluProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamAwb_V11_IlluProfile_t));
       LoadAwb_V11_IlluminationSubList(pNew);
 
@@ -3148,11 +3212,11 @@ static void LoadLscProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamLscProfile_t* pLscProfile = malloc(sizeof(CamLscProfile_t));
+    CamLscProfile_t* pLscProfile = allocCamCalibDbIq(sizeof(CamLscProfile_t));
     l->p_next = (List*)pLscProfile;
     readCamCalibDbIq(pLscProfile, sizeof(CamLscProfile_t));
     while (pLscProfile->p_next) {
-      pNew = malloc(sizeof(CamLscProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamLscProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamLscProfile_t));
 
       pLscProfile->p_next = pNew;
@@ -3173,11 +3237,11 @@ static void LoadCcProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamCcProfile_t* pCcProfile = malloc(sizeof(CamCcProfile_t));
+    CamCcProfile_t* pCcProfile = allocCamCalibDbIq(sizeof(CamCcProfile_t));
     l->p_next = (List*)pCcProfile;
     readCamCalibDbIq(pCcProfile, sizeof(CamCcProfile_t));
     while (pCcProfile->p_next) {
-      pNew = malloc(sizeof(CamCcProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamCcProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamCcProfile_t));
 
       pCcProfile->p_next = pNew;
@@ -3198,11 +3262,11 @@ static void LoadBlsProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamBlsProfile_t* pBlsProfile = malloc(sizeof(CamBlsProfile_t));
+    CamBlsProfile_t* pBlsProfile = allocCamCalibDbIq(sizeof(CamBlsProfile_t));
     l->p_next = (List*)pBlsProfile;
     readCamCalibDbIq(pBlsProfile, sizeof(CamBlsProfile_t));
     while (pBlsProfile->p_next) {
-      pNew = malloc(sizeof(CamBlsProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamBlsProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamBlsProfile_t));
 
       pBlsProfile->p_next = pNew;
@@ -3223,11 +3287,11 @@ static void LoadCacProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamCacProfile_t* pCacProfile = malloc(sizeof(CamCacProfile_t));
+    CamCacProfile_t* pCacProfile = allocCamCalibDbIq(sizeof(CamCacProfile_t));
     l->p_next = (List*)pCacProfile;
     readCamCalibDbIq(pCacProfile, sizeof(CamCacProfile_t));
     while (pCacProfile->p_next) {
-      pNew = malloc(sizeof(CamCacProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamCacProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamCacProfile_t));
 
       pCacProfile->p_next = pNew;
@@ -3246,86 +3310,86 @@ static void LoadDsp3DNRSubList(CamDsp3DNRSettingProfile_t * pDsp3DNR) {
 #endif
 
   if(pDsp3DNR->pgain_Level){
-    pDsp3DNR->pgain_Level = malloc(pDsp3DNR->ArraySize * sizeof(float));
+    pDsp3DNR->pgain_Level = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(float));
     readCamCalibDbIq(pDsp3DNR->pgain_Level, pDsp3DNR->ArraySize * sizeof(float));
   }
   if(pDsp3DNR->pnoise_coef_denominator){
-    pDsp3DNR->pnoise_coef_denominator = malloc(pDsp3DNR->ArraySize * sizeof(uint16_t));
+    pDsp3DNR->pnoise_coef_denominator = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(uint16_t));
     readCamCalibDbIq(pDsp3DNR->pnoise_coef_denominator, pDsp3DNR->ArraySize * sizeof(uint16_t));
   }
   if(pDsp3DNR->pnoise_coef_numerator){
-    pDsp3DNR->pnoise_coef_numerator = malloc(pDsp3DNR->ArraySize * sizeof(uint16_t));
+    pDsp3DNR->pnoise_coef_numerator = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(uint16_t));
     readCamCalibDbIq(pDsp3DNR->pnoise_coef_numerator, pDsp3DNR->ArraySize * sizeof(uint16_t));
   }
   if(pDsp3DNR->sDefaultLevelSetting.pchrm_sp_nr_level){
-    pDsp3DNR->sDefaultLevelSetting.pchrm_sp_nr_level = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sDefaultLevelSetting.pchrm_sp_nr_level = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sDefaultLevelSetting.pchrm_sp_nr_level, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sDefaultLevelSetting.pchrm_te_nr_level){
-    pDsp3DNR->sDefaultLevelSetting.pchrm_te_nr_level = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sDefaultLevelSetting.pchrm_te_nr_level = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sDefaultLevelSetting.pchrm_te_nr_level, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sDefaultLevelSetting.pluma_sp_nr_level){
-    pDsp3DNR->sDefaultLevelSetting.pluma_sp_nr_level = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sDefaultLevelSetting.pluma_sp_nr_level = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sDefaultLevelSetting.pluma_sp_nr_level, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sDefaultLevelSetting.pluma_te_nr_level){
-    pDsp3DNR->sDefaultLevelSetting.pluma_te_nr_level = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sDefaultLevelSetting.pluma_te_nr_level = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sDefaultLevelSetting.pluma_te_nr_level, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sDefaultLevelSetting.pshp_level){
-    pDsp3DNR->sDefaultLevelSetting.pshp_level = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sDefaultLevelSetting.pshp_level = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sDefaultLevelSetting.pshp_level, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
 
   if(pDsp3DNR->sLumaSetting.pluma_sp_rad){
-    pDsp3DNR->sLumaSetting.pluma_sp_rad = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sLumaSetting.pluma_sp_rad = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sLumaSetting.pluma_sp_rad, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sLumaSetting.pluma_te_max_bi_num){
-    pDsp3DNR->sLumaSetting.pluma_te_max_bi_num = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sLumaSetting.pluma_te_max_bi_num = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sLumaSetting.pluma_te_max_bi_num, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
 
   if(pDsp3DNR->sChrmSetting.pchrm_sp_rad){
-    pDsp3DNR->sChrmSetting.pchrm_sp_rad = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sChrmSetting.pchrm_sp_rad = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sChrmSetting.pchrm_sp_rad, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sChrmSetting.pchrm_te_max_bi_num){
-    pDsp3DNR->sChrmSetting.pchrm_te_max_bi_num = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sChrmSetting.pchrm_te_max_bi_num = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sChrmSetting.pchrm_te_max_bi_num, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
 
   if(pDsp3DNR->sSharpSetting.psrc_shp_c){
-    pDsp3DNR->sSharpSetting.psrc_shp_c = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sSharpSetting.psrc_shp_c = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sSharpSetting.psrc_shp_c, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sSharpSetting.psrc_shp_div){
-    pDsp3DNR->sSharpSetting.psrc_shp_div = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sSharpSetting.psrc_shp_div = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sSharpSetting.psrc_shp_div, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sSharpSetting.psrc_shp_l){
-    pDsp3DNR->sSharpSetting.psrc_shp_l = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sSharpSetting.psrc_shp_l = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sSharpSetting.psrc_shp_l, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
   if(pDsp3DNR->sSharpSetting.psrc_shp_thr){
-    pDsp3DNR->sSharpSetting.psrc_shp_thr = malloc(pDsp3DNR->ArraySize * sizeof(unsigned char));
+    pDsp3DNR->sSharpSetting.psrc_shp_thr = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(unsigned char));
     readCamCalibDbIq(pDsp3DNR->sSharpSetting.psrc_shp_thr, pDsp3DNR->ArraySize * sizeof(unsigned char));
   }
 
   for(int i=0; i<CAM_CALIBDB_3DNR_WEIGHT_NUM; i++){
     if(pDsp3DNR->sLumaSetting.pluma_weight[i]){
-       pDsp3DNR->sLumaSetting.pluma_weight[i] = malloc(pDsp3DNR->ArraySize * sizeof(uint8_t));
+       pDsp3DNR->sLumaSetting.pluma_weight[i] = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(uint8_t));
        readCamCalibDbIq(pDsp3DNR->sLumaSetting.pluma_weight[i], pDsp3DNR->ArraySize * sizeof(uint8_t));
     }
 
     if(pDsp3DNR->sChrmSetting.pchrm_weight[i]){
-       pDsp3DNR->sChrmSetting.pchrm_weight[i] = malloc(pDsp3DNR->ArraySize * sizeof(uint8_t));
+       pDsp3DNR->sChrmSetting.pchrm_weight[i] = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(uint8_t));
        readCamCalibDbIq(pDsp3DNR->sChrmSetting.pchrm_weight[i], pDsp3DNR->ArraySize * sizeof(uint8_t));
     }
 
     if(pDsp3DNR->sSharpSetting.psrc_shp_weight[i]){
-       pDsp3DNR->sSharpSetting.psrc_shp_weight[i] = malloc(pDsp3DNR->ArraySize * sizeof(int8_t));
+       pDsp3DNR->sSharpSetting.psrc_shp_weight[i] = allocCamCalibDbIq(pDsp3DNR->ArraySize * sizeof(int8_t));
        readCamCalibDbIq(pDsp3DNR->sSharpSetting.psrc_shp_weight[i], pDsp3DNR->ArraySize * sizeof(int8_t));
     }
   }
@@ -3343,12 +3407,12 @@ static void LoadDsp3DNRList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamDsp3DNRSettingProfile_t * pDsp3DNR = malloc(sizeof(CamDsp3DNRSettingProfile_t));
+    CamDsp3DNRSettingProfile_t * pDsp3DNR = allocCamCalibDbIq(sizeof(CamDsp3DNRSettingProfile_t));
     l->p_next = (List*)pDsp3DNR;
     readCamCalibDbIq(pDsp3DNR, sizeof(CamDsp3DNRSettingProfile_t));
     LoadDsp3DNRSubList(pDsp3DNR);
     while (pDsp3DNR->p_next) {
-      pNew = malloc(sizeof(CamDsp3DNRSettingProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamDsp3DNRSettingProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamDsp3DNRSettingProfile_t));
       LoadDsp3DNRSubList(pNew);
 
@@ -3368,27 +3432,27 @@ static void LoadNewDsp3DNRSubList(CamNewDsp3DNRProfile_t * pNewDsp3DNR) {
 #endif
 
   if(pNewDsp3DNR->pgain_Level) {
-    pNewDsp3DNR->pgain_Level = malloc(pNewDsp3DNR->ArraySize * sizeof(float));
+    pNewDsp3DNR->pgain_Level = allocCamCalibDbIq(pNewDsp3DNR->ArraySize * sizeof(float));
     readCamCalibDbIq(pNewDsp3DNR->pgain_Level, pNewDsp3DNR->ArraySize * sizeof(float));
   }
 
   if(pNewDsp3DNR->ynr.pynr_time_weight_level) {
-    pNewDsp3DNR->ynr.pynr_time_weight_level = malloc(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
+    pNewDsp3DNR->ynr.pynr_time_weight_level = allocCamCalibDbIq(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pNewDsp3DNR->ynr.pynr_time_weight_level, pNewDsp3DNR->ArraySize * sizeof(uint32_t));
   }
 
   if(pNewDsp3DNR->ynr.pynr_spat_weight_level) {
-    pNewDsp3DNR->ynr.pynr_spat_weight_level = malloc(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
+    pNewDsp3DNR->ynr.pynr_spat_weight_level = allocCamCalibDbIq(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pNewDsp3DNR->ynr.pynr_spat_weight_level, pNewDsp3DNR->ArraySize * sizeof(uint32_t));
   }
 
   if(pNewDsp3DNR->uvnr.puvnr_weight_level) {
-    pNewDsp3DNR->uvnr.puvnr_weight_level = malloc(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
+    pNewDsp3DNR->uvnr.puvnr_weight_level = allocCamCalibDbIq(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pNewDsp3DNR->uvnr.puvnr_weight_level, pNewDsp3DNR->ArraySize * sizeof(uint32_t));
   }
 
   if(pNewDsp3DNR->sharp.psharp_weight_level) {
-    pNewDsp3DNR->sharp.psharp_weight_level = malloc(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
+    pNewDsp3DNR->sharp.psharp_weight_level = allocCamCalibDbIq(pNewDsp3DNR->ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pNewDsp3DNR->sharp.psharp_weight_level, pNewDsp3DNR->ArraySize * sizeof(uint32_t));
   }
 
@@ -3405,12 +3469,12 @@ static void LoadNewDsp3DNRList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamNewDsp3DNRProfile_t * pNewDsp3DNR = malloc(sizeof(CamNewDsp3DNRProfile_t));
+    CamNewDsp3DNRProfile_t * pNewDsp3DNR = allocCamCalibDbIq(sizeof(CamNewDsp3DNRProfile_t));
     l->p_next = (List*)pNewDsp3DNR;
     readCamCalibDbIq(pNewDsp3DNR, sizeof(CamNewDsp3DNRProfile_t));
     LoadNewDsp3DNRSubList(pNewDsp3DNR);
     while (pNewDsp3DNR->p_next) {
-      pNew = malloc(sizeof(CamNewDsp3DNRProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamNewDsp3DNRProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamNewDsp3DNRProfile_t));
       LoadNewDsp3DNRSubList(pNew);
 
@@ -3430,84 +3494,84 @@ static void LoadFilterSubList(CamFilterProfile_t * pFilter) {
 #endif
 
   if(pFilter->DemosaicThCurve.pSensorGain){
-    pFilter->DemosaicThCurve.pSensorGain = malloc(pFilter->DemosaicThCurve.ArraySize * sizeof(float));
+    pFilter->DemosaicThCurve.pSensorGain = allocCamCalibDbIq(pFilter->DemosaicThCurve.ArraySize * sizeof(float));
     readCamCalibDbIq(pFilter->DemosaicThCurve.pSensorGain, pFilter->DemosaicThCurve.ArraySize * sizeof(float));
   }
   if(pFilter->DemosaicThCurve.pThlevel){
-    pFilter->DemosaicThCurve.pThlevel = malloc(pFilter->DemosaicThCurve.ArraySize * sizeof(uint8_t));
+    pFilter->DemosaicThCurve.pThlevel = allocCamCalibDbIq(pFilter->DemosaicThCurve.ArraySize * sizeof(uint8_t));
     readCamCalibDbIq(pFilter->DemosaicThCurve.pThlevel, pFilter->DemosaicThCurve.ArraySize * sizeof(uint8_t));
   }
 
   if(pFilter->DenoiseLevelCurve.pSensorGain){
-    pFilter->DenoiseLevelCurve.pSensorGain = malloc(pFilter->DenoiseLevelCurve.ArraySize * sizeof(float));
+    pFilter->DenoiseLevelCurve.pSensorGain = allocCamCalibDbIq(pFilter->DenoiseLevelCurve.ArraySize * sizeof(float));
     readCamCalibDbIq(pFilter->DenoiseLevelCurve.pSensorGain, pFilter->DenoiseLevelCurve.ArraySize * sizeof(float));
   }
   if(pFilter->DenoiseLevelCurve.pDlevel){
-    pFilter->DenoiseLevelCurve.pDlevel = malloc(pFilter->DenoiseLevelCurve.ArraySize * sizeof(CamerIcIspFltDeNoiseLevel_t));
+    pFilter->DenoiseLevelCurve.pDlevel = allocCamCalibDbIq(pFilter->DenoiseLevelCurve.ArraySize * sizeof(CamerIcIspFltDeNoiseLevel_t));
     readCamCalibDbIq(pFilter->DenoiseLevelCurve.pDlevel,
       pFilter->DenoiseLevelCurve.ArraySize * sizeof(CamerIcIspFltDeNoiseLevel_t));
   }
 
   if(pFilter->SharpeningLevelCurve.pSensorGain){
-    pFilter->SharpeningLevelCurve.pSensorGain = malloc(pFilter->SharpeningLevelCurve.ArraySize * sizeof(float));
+    pFilter->SharpeningLevelCurve.pSensorGain = allocCamCalibDbIq(pFilter->SharpeningLevelCurve.ArraySize * sizeof(float));
     readCamCalibDbIq(pFilter->SharpeningLevelCurve.pSensorGain, pFilter->SharpeningLevelCurve.ArraySize * sizeof(float));
   }
   if(pFilter->SharpeningLevelCurve.pSlevel){
-    pFilter->SharpeningLevelCurve.pSlevel = malloc(pFilter->SharpeningLevelCurve.ArraySize * sizeof(CamerIcIspFltSharpeningLevel_t));
+    pFilter->SharpeningLevelCurve.pSlevel = allocCamCalibDbIq(pFilter->SharpeningLevelCurve.ArraySize * sizeof(CamerIcIspFltSharpeningLevel_t));
     readCamCalibDbIq(pFilter->SharpeningLevelCurve.pSlevel,
       pFilter->SharpeningLevelCurve.ArraySize * sizeof(CamerIcIspFltSharpeningLevel_t));
   }
 
   if(pFilter->FiltLevelRegConf.p_chr_h_mode){
-    pFilter->FiltLevelRegConf.p_chr_h_mode = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
+    pFilter->FiltLevelRegConf.p_chr_h_mode = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_chr_h_mode, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
   }
   if(pFilter->FiltLevelRegConf.p_chr_v_mode){
-    pFilter->FiltLevelRegConf.p_chr_v_mode = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
+    pFilter->FiltLevelRegConf.p_chr_v_mode = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_chr_v_mode, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
   }
   if(pFilter->FiltLevelRegConf.p_fac_bl0){
-    pFilter->FiltLevelRegConf.p_fac_bl0 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_fac_bl0 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_fac_bl0, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
   if(pFilter->FiltLevelRegConf.p_fac_bl1){
-    pFilter->FiltLevelRegConf.p_fac_bl1 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_fac_bl1 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_fac_bl1, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
   if(pFilter->FiltLevelRegConf.p_fac_mid){
-    pFilter->FiltLevelRegConf.p_fac_mid = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_fac_mid = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_fac_mid, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
   if(pFilter->FiltLevelRegConf.p_fac_sh0){
-    pFilter->FiltLevelRegConf.p_fac_sh0 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_fac_sh0 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_fac_sh0, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
   if(pFilter->FiltLevelRegConf.p_fac_sh1){
-    pFilter->FiltLevelRegConf.p_fac_sh1 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_fac_sh1 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_fac_sh1, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
   if(pFilter->FiltLevelRegConf.p_FiltLevel){
-    pFilter->FiltLevelRegConf.p_FiltLevel = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
+    pFilter->FiltLevelRegConf.p_FiltLevel = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_FiltLevel, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
   }
   if(pFilter->FiltLevelRegConf.p_grn_stage1){
-    pFilter->FiltLevelRegConf.p_grn_stage1 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
+    pFilter->FiltLevelRegConf.p_grn_stage1 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_grn_stage1, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
   }
   if(pFilter->FiltLevelRegConf.p_thresh_bl0){
-    pFilter->FiltLevelRegConf.p_thresh_bl0 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_thresh_bl0 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_thresh_bl0, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
   if(pFilter->FiltLevelRegConf.p_thresh_bl1){
-    pFilter->FiltLevelRegConf.p_thresh_bl1 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_thresh_bl1 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_thresh_bl1, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
   if(pFilter->FiltLevelRegConf.p_thresh_sh0){
-    pFilter->FiltLevelRegConf.p_thresh_sh0 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
+    pFilter->FiltLevelRegConf.p_thresh_sh0 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_thresh_sh0, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint8_t));
   }
   if(pFilter->FiltLevelRegConf.p_thresh_sh1){
-    pFilter->FiltLevelRegConf.p_thresh_sh1 = malloc(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
+    pFilter->FiltLevelRegConf.p_thresh_sh1 = allocCamCalibDbIq(pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
     readCamCalibDbIq(pFilter->FiltLevelRegConf.p_thresh_sh1, pFilter->FiltLevelRegConf.ArraySize * sizeof(uint32_t));
   }
 
@@ -3524,12 +3588,12 @@ static void LoadFilterList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamFilterProfile_t * pFilter = malloc(sizeof(CamFilterProfile_t));
+    CamFilterProfile_t * pFilter = allocCamCalibDbIq(sizeof(CamFilterProfile_t));
     l->p_next = (List*)pFilter;
     readCamCalibDbIq(pFilter, sizeof(CamFilterProfile_t));
     LoadFilterSubList(pFilter);
     while (pFilter->p_next) {
-      pNew = malloc(sizeof(CamFilterProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamFilterProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamFilterProfile_t));
       LoadFilterSubList(pNew);
 
@@ -3551,14 +3615,14 @@ static void LoadDpfProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamDpfProfile_t* pDpfProfile = malloc(sizeof(CamDpfProfile_t));
+    CamDpfProfile_t* pDpfProfile = allocCamCalibDbIq(sizeof(CamDpfProfile_t));
     l->p_next = (List*)pDpfProfile;
     readCamCalibDbIq(pDpfProfile, sizeof(CamDpfProfile_t));
     LoadDsp3DNRList(&pDpfProfile->Dsp3DNRSettingProfileList);
     LoadNewDsp3DNRList(&pDpfProfile->newDsp3DNRProfileList);
     LoadFilterList(&pDpfProfile->FilterList);
     while (pDpfProfile->p_next) {
-      pNew = malloc(sizeof(CamDpfProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamDpfProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamDpfProfile_t));
       LoadDsp3DNRList(&pNew->Dsp3DNRSettingProfileList);
       LoadNewDsp3DNRList(&pNew->newDsp3DNRProfileList);
@@ -3582,11 +3646,11 @@ static void LoadDpccProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamDpccProfile_t* pDpccProfile = malloc(sizeof(CamDpccProfile_t));
+    CamDpccProfile_t* pDpccProfile = allocCamCalibDbIq(sizeof(CamDpccProfile_t));
     l->p_next = (List*)pDpccProfile;
     readCamCalibDbIq(pDpccProfile, sizeof(CamDpccProfile_t));
     while (pDpccProfile->p_next) {
-      pNew = malloc(sizeof(CamDpccProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamDpccProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamDpccProfile_t));
 
       pDpccProfile->p_next = pNew;
@@ -3607,11 +3671,11 @@ static void LoadGocProfileList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamCalibGocProfile_t* pGocProfile = malloc(sizeof(CamCalibGocProfile_t));
+    CamCalibGocProfile_t* pGocProfile = allocCamCalibDbIq(sizeof(CamCalibGocProfile_t));
     l->p_next = (List*)pGocProfile;
     readCamCalibDbIq(pGocProfile, sizeof(CamCalibGocProfile_t));
     while (pGocProfile->p_next) {
-      pNew = malloc(sizeof(CamCalibGocProfile_t));
+      pNew = allocCamCalibDbIq(sizeof(CamCalibGocProfile_t));
       readCamCalibDbIq(pNew, sizeof(CamCalibGocProfile_t));
 
       pGocProfile->p_next = pNew;
@@ -3624,122 +3688,122 @@ static void LoadGocProfileList(List* l) {
 #endif
 }
 
-static void LoadIeSharpenProfileList(List* l) {
-  CamIesharpenProfile_t* pNew;
-
-#ifdef LOAD_IQ_TRACE_INFO_ON
-  LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
-#endif
-
-  if (!ListEmpty(l)) {
-    CamIesharpenProfile_t* pIeSharpenProfile = malloc(sizeof(CamIesharpenProfile_t));
-    l->p_next = (List*)pIeSharpenProfile;
-    readCamCalibDbIq(pIeSharpenProfile, sizeof(CamIesharpenProfile_t));
-    while (pIeSharpenProfile->p_next) {
-      pNew = malloc(sizeof(CamIesharpenProfile_t));
-      readCamCalibDbIq(pNew, sizeof(CamIesharpenProfile_t));
-
-      if (pIeSharpenProfile->yavg_thr) {
-          pIeSharpenProfile->yavg_thr = malloc(pIeSharpenProfile->yavg_thr_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->yavg_thr, pIeSharpenProfile->yavg_thr_ArraySize * sizeof(uint8_t));
+static void LoadIeSharpenProfileSubList(CamIesharpenProfile_t* pIeSharpenProfile) {
+  if (pIeSharpenProfile->yavg_thr) {
+      pIeSharpenProfile->yavg_thr = allocCamCalibDbIq(pIeSharpenProfile->yavg_thr_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->yavg_thr, pIeSharpenProfile->yavg_thr_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->P_delta1) {
+      pIeSharpenProfile->P_delta1 = allocCamCalibDbIq(pIeSharpenProfile->P_delta1_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->P_delta1, pIeSharpenProfile->P_delta1_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->P_delta2) {
+      pIeSharpenProfile->P_delta2 = allocCamCalibDbIq(pIeSharpenProfile->P_delta2_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->P_delta2, pIeSharpenProfile->P_delta2_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->pmaxnumber) {
+      pIeSharpenProfile->pmaxnumber = allocCamCalibDbIq(pIeSharpenProfile->pmaxnumber_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->pmaxnumber, pIeSharpenProfile->pmaxnumber_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->pminnumber) {
+      pIeSharpenProfile->pminnumber = allocCamCalibDbIq(pIeSharpenProfile->pminnumber_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->pminnumber, pIeSharpenProfile->pminnumber_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->gauss_flat_coe) {
+      pIeSharpenProfile->gauss_flat_coe = allocCamCalibDbIq(pIeSharpenProfile->gauss_flat_coe_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->gauss_flat_coe, pIeSharpenProfile->gauss_flat_coe_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->gauss_noise_coe) {
+      pIeSharpenProfile->gauss_noise_coe = allocCamCalibDbIq(pIeSharpenProfile->gauss_noise_coe_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->gauss_noise_coe, pIeSharpenProfile->gauss_noise_coe_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->gauss_other_coe) {
+      pIeSharpenProfile->gauss_other_coe = allocCamCalibDbIq(pIeSharpenProfile->gauss_other_coe_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->gauss_other_coe, pIeSharpenProfile->gauss_other_coe_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->uv_gauss_flat_coe) {
+      pIeSharpenProfile->uv_gauss_flat_coe = allocCamCalibDbIq(pIeSharpenProfile->uv_gauss_flat_coe_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->uv_gauss_flat_coe, pIeSharpenProfile->uv_gauss_flat_coe_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->uv_gauss_noise_coe) {
+      pIeSharpenProfile->uv_gauss_noise_coe = allocCamCalibDbIq(pIeSharpenProfile->uv_gauss_noise_coe_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->uv_gauss_noise_coe, pIeSharpenProfile->uv_gauss_noise_coe_ArraySize * sizeof(uint8_t));
+  }
+  if (pIeSharpenProfile->uv_gauss_other_coe) {
+      pIeSharpenProfile->uv_gauss_other_coe = allocCamCalibDbIq(pIeSharpenProfile->uv_gauss_other_coe_ArraySize * sizeof(uint8_t));
+      readCamCalibDbIq(pIeSharpenProfile->uv_gauss_other_coe, pIeSharpenProfile->uv_gauss_other_coe_ArraySize * sizeof(uint8_t));
+  }
+  {
+     // CamIesharpenGridConf_t
+      if (pIeSharpenProfile->lgridconf.p_grad) {
+          pIeSharpenProfile->lgridconf.p_grad = allocCamCalibDbIq(pIeSharpenProfile->lgridconf.p_grad_ArraySize * sizeof(uint16_t));
+          readCamCalibDbIq(pIeSharpenProfile->lgridconf.p_grad, pIeSharpenProfile->lgridconf.p_grad_ArraySize * sizeof(uint16_t));
       }
-
-      if (pIeSharpenProfile->yavg_thr) {
-          pIeSharpenProfile->yavg_thr = malloc(pIeSharpenProfile->yavg_thr_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->yavg_thr, pIeSharpenProfile->yavg_thr_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->lgridconf.sharp_factor) {
+          pIeSharpenProfile->lgridconf.sharp_factor = allocCamCalibDbIq(pIeSharpenProfile->lgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->lgridconf.sharp_factor, pIeSharpenProfile->lgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->P_delta1) {
-          pIeSharpenProfile->P_delta1 = malloc(pIeSharpenProfile->P_delta1_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->P_delta1, pIeSharpenProfile->P_delta1_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->lgridconf.line1_filter_coe) {
+          pIeSharpenProfile->lgridconf.line1_filter_coe = allocCamCalibDbIq(pIeSharpenProfile->lgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->lgridconf.line1_filter_coe, pIeSharpenProfile->lgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->P_delta2) {
-          pIeSharpenProfile->P_delta2 = malloc(pIeSharpenProfile->P_delta2_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->P_delta2, pIeSharpenProfile->P_delta2_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->lgridconf.line2_filter_coe) {
+          pIeSharpenProfile->lgridconf.line2_filter_coe = allocCamCalibDbIq(pIeSharpenProfile->lgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->lgridconf.line2_filter_coe, pIeSharpenProfile->lgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->pmaxnumber) {
-          pIeSharpenProfile->pmaxnumber = malloc(pIeSharpenProfile->pmaxnumber_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->pmaxnumber, pIeSharpenProfile->pmaxnumber_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->lgridconf.line3_filter_coe) {
+          pIeSharpenProfile->lgridconf.line3_filter_coe = allocCamCalibDbIq(pIeSharpenProfile->lgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->lgridconf.line3_filter_coe, pIeSharpenProfile->lgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->pminnumber) {
-          pIeSharpenProfile->pminnumber = malloc(pIeSharpenProfile->pminnumber_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->pminnumber, pIeSharpenProfile->pminnumber_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->lgridconf.lap_mat_coe) {
+          pIeSharpenProfile->lgridconf.lap_mat_coe = allocCamCalibDbIq(pIeSharpenProfile->lgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->lgridconf.lap_mat_coe, pIeSharpenProfile->lgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->gauss_flat_coe) {
-          pIeSharpenProfile->gauss_flat_coe = malloc(pIeSharpenProfile->gauss_flat_coe_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->gauss_flat_coe, pIeSharpenProfile->gauss_flat_coe_ArraySize * sizeof(uint8_t));
+
+      if (pIeSharpenProfile->hgridconf.p_grad) {
+          pIeSharpenProfile->hgridconf.p_grad = allocCamCalibDbIq(pIeSharpenProfile->hgridconf.p_grad_ArraySize * sizeof(uint16_t));
+          readCamCalibDbIq(pIeSharpenProfile->hgridconf.p_grad, pIeSharpenProfile->hgridconf.p_grad_ArraySize * sizeof(uint16_t));
       }
-      if (pIeSharpenProfile->gauss_noise_coe) {
-          pIeSharpenProfile->gauss_noise_coe = malloc(pIeSharpenProfile->gauss_noise_coe_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->gauss_noise_coe, pIeSharpenProfile->gauss_noise_coe_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->hgridconf.sharp_factor) {
+          pIeSharpenProfile->hgridconf.sharp_factor = allocCamCalibDbIq(pIeSharpenProfile->hgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->hgridconf.sharp_factor, pIeSharpenProfile->hgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->gauss_other_coe) {
-          pIeSharpenProfile->gauss_other_coe = malloc(pIeSharpenProfile->gauss_other_coe_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->gauss_other_coe, pIeSharpenProfile->gauss_other_coe_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->hgridconf.line1_filter_coe) {
+          pIeSharpenProfile->hgridconf.line1_filter_coe = allocCamCalibDbIq(pIeSharpenProfile->hgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->hgridconf.line1_filter_coe, pIeSharpenProfile->hgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->uv_gauss_flat_coe) {
-          pIeSharpenProfile->uv_gauss_flat_coe = malloc(pIeSharpenProfile->uv_gauss_flat_coe_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->uv_gauss_flat_coe, pIeSharpenProfile->uv_gauss_flat_coe_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->hgridconf.line2_filter_coe) {
+          pIeSharpenProfile->hgridconf.line2_filter_coe = allocCamCalibDbIq(pIeSharpenProfile->hgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->hgridconf.line2_filter_coe, pIeSharpenProfile->hgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->uv_gauss_noise_coe) {
-          pIeSharpenProfile->uv_gauss_noise_coe = malloc(pIeSharpenProfile->uv_gauss_noise_coe_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->uv_gauss_noise_coe, pIeSharpenProfile->uv_gauss_noise_coe_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->hgridconf.line3_filter_coe) {
+          pIeSharpenProfile->hgridconf.line3_filter_coe = allocCamCalibDbIq(pIeSharpenProfile->hgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->hgridconf.line3_filter_coe, pIeSharpenProfile->hgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
       }
-      if (pIeSharpenProfile->uv_gauss_other_coe) {
-          pIeSharpenProfile->uv_gauss_other_coe = malloc(pIeSharpenProfile->uv_gauss_other_coe_ArraySize * sizeof(uint8_t));
-          readCamCalibDbIq(pIeSharpenProfile->uv_gauss_noise_coe, pIeSharpenProfile->uv_gauss_other_coe_ArraySize * sizeof(uint8_t));
+      if (pIeSharpenProfile->hgridconf.lap_mat_coe) {
+          pIeSharpenProfile->hgridconf.lap_mat_coe = allocCamCalibDbIq(pIeSharpenProfile->hgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
+          readCamCalibDbIq(pIeSharpenProfile->hgridconf.lap_mat_coe, pIeSharpenProfile->hgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
       }
-      {
-         // CamIesharpenGridConf_t
-          if (pIeSharpenProfile->lgridconf.p_grad) {
-              pIeSharpenProfile->lgridconf.p_grad = malloc(pIeSharpenProfile->lgridconf.p_grad_ArraySize * sizeof(uint16_t));
-              readCamCalibDbIq(pIeSharpenProfile->lgridconf.p_grad, pIeSharpenProfile->lgridconf.p_grad_ArraySize * sizeof(uint16_t));
-          }
-          if (pIeSharpenProfile->lgridconf.sharp_factor) {
-              pIeSharpenProfile->lgridconf.sharp_factor = malloc(pIeSharpenProfile->lgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->lgridconf.sharp_factor, pIeSharpenProfile->lgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->lgridconf.line1_filter_coe) {
-              pIeSharpenProfile->lgridconf.line1_filter_coe = malloc(pIeSharpenProfile->lgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->lgridconf.line1_filter_coe, pIeSharpenProfile->lgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->lgridconf.line2_filter_coe) {
-              pIeSharpenProfile->lgridconf.line2_filter_coe = malloc(pIeSharpenProfile->lgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->lgridconf.line2_filter_coe, pIeSharpenProfile->lgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->lgridconf.line3_filter_coe) {
-              pIeSharpenProfile->lgridconf.line3_filter_coe = malloc(pIeSharpenProfile->lgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->lgridconf.line3_filter_coe, pIeSharpenProfile->lgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->lgridconf.lap_mat_coe) {
-              pIeSharpenProfile->lgridconf.lap_mat_coe = malloc(pIeSharpenProfile->lgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->lgridconf.lap_mat_coe, pIeSharpenProfile->lgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
-          }
+  }
+}
+
+static void LoadIeSharpenProfileList(List* l) {
+  CamIesharpenProfile_t* pNew;
+
+#ifdef LOAD_IQ_TRACE_INFO_ON
+  LOGD( "%s (enter): file pos 0x%x\n", __FUNCTION__, getCamCalibDbIqIdx());
+#endif
+
+  if (!ListEmpty(l)) {
+    CamIesharpenProfile_t* pIeSharpenProfile = allocCamCalibDbIq(sizeof(CamIesharpenProfile_t));
+    l->p_next = (List*)pIeSharpenProfile;
+    readCamCalibDbIq(pIeSharpenProfile, sizeof(CamIesharpenProfile_t));
+    LoadIeSharpenProfileSubList(pIeSharpenProfile);
+    while (pIeSharpenProfile->p_next) {
+      pNew = allocCamCalibDbIq(sizeof(CamIesharpenProfile_t));
+      readCamCalibDbIq(pNew, sizeof(CamIesharpenProfile_t));
+      LoadIeSharpenProfileSubList(pNew);
 
-          if (pIeSharpenProfile->hgridconf.p_grad) {
-              pIeSharpenProfile->hgridconf.p_grad = malloc(pIeSharpenProfile->hgridconf.p_grad_ArraySize * sizeof(uint16_t));
-              readCamCalibDbIq(pIeSharpenProfile->hgridconf.p_grad, pIeSharpenProfile->hgridconf.p_grad_ArraySize * sizeof(uint16_t));
-          }
-          if (pIeSharpenProfile->hgridconf.sharp_factor) {
-              pIeSharpenProfile->hgridconf.sharp_factor = malloc(pIeSharpenProfile->hgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->hgridconf.sharp_factor, pIeSharpenProfile->hgridconf.sharp_factor_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->hgridconf.line1_filter_coe) {
-              pIeSharpenProfile->hgridconf.line1_filter_coe = malloc(pIeSharpenProfile->hgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->hgridconf.line1_filter_coe, pIeSharpenProfile->hgridconf.line1_filter_coe_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->hgridconf.line2_filter_coe) {
-              pIeSharpenProfile->hgridconf.line2_filter_coe = malloc(pIeSharpenProfile->hgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->hgridconf.line2_filter_coe, pIeSharpenProfile->hgridconf.line2_filter_coe_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->hgridconf.line3_filter_coe) {
-              pIeSharpenProfile->hgridconf.line3_filter_coe = malloc(pIeSharpenProfile->hgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->hgridconf.line3_filter_coe, pIeSharpenProfile->hgridconf.line3_filter_coe_ArraySize * sizeof(uint8_t));
-          }
-          if (pIeSharpenProfile->hgridconf.lap_mat_coe) {
-              pIeSharpenProfile->hgridconf.lap_mat_coe = malloc(pIeSharpenProfile->hgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
-              readCamCalibDbIq(pIeSharpenProfile->hgridconf.lap_mat_coe, pIeSharpenProfile->hgridconf.lap_mat_coe_ArraySize * sizeof(uint8_t));
-          }
-      }
       pIeSharpenProfile->p_next = pNew;
       pIeSharpenProfile = pNew;
     }
@@ -3758,26 +3822,26 @@ static void LoadDySetpointList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamCalibAecDynamicSetpoint_t* pDySetpoint = malloc(sizeof(CamCalibAecDynamicSetpoint_t));
+    CamCalibAecDynamicSetpoint_t* pDySetpoint = allocCamCalibDbIq(sizeof(CamCalibAecDynamicSetpoint_t));
     l->p_next = (List*)pDySetpoint;
     readCamCalibDbIq(pDySetpoint, sizeof(CamCalibAecDynamicSetpoint_t));
     if(pDySetpoint->pDySetpoint != NULL) {
-      pDySetpoint->pDySetpoint = malloc(pDySetpoint->array_size * sizeof(float));
+      pDySetpoint->pDySetpoint = allocCamCalibDbIq(pDySetpoint->array_size * sizeof(float));
       readCamCalibDbIq(pDySetpoint->pDySetpoint, pDySetpoint->array_size * sizeof(float));
     }
     if(pDySetpoint->pExpValue != NULL) {
-      pDySetpoint->pExpValue = malloc(pDySetpoint->array_size * sizeof(float));
+      pDySetpoint->pExpValue = allocCamCalibDbIq(pDySetpoint->array_size * sizeof(float));
       readCamCalibDbIq(pDySetpoint->pExpValue, pDySetpoint->array_size * sizeof(float));
     }
     while (pDySetpoint->p_next) {
-      pNew = malloc(sizeof(CamCalibAecDynamicSetpoint_t));
+      pNew = allocCamCalibDbIq(sizeof(CamCalibAecDynamicSetpoint_t));
       readCamCalibDbIq(pNew, sizeof(CamCalibAecDynamicSetpoint_t));
       if(pNew->pDySetpoint != NULL) {
-        pNew->pDySetpoint = malloc(pNew->array_size * sizeof(float));
+        pNew->pDySetpoint = allocCamCalibDbIq(pNew->array_size * sizeof(float));
         readCamCalibDbIq(pNew->pDySetpoint, pNew->array_size * sizeof(float));
       }
       if(pNew->pExpValue != NULL) {
-        pNew->pExpValue = malloc(pNew->array_size * sizeof(float));
+        pNew->pExpValue = allocCamCalibDbIq(pNew->array_size * sizeof(float));
         readCamCalibDbIq(pNew->pExpValue, pNew->array_size * sizeof(float));
       }
 
@@ -3799,11 +3863,11 @@ static void LoadExpSeparateList(List* l) {
 #endif
 
   if (!ListEmpty(l)) {
-    CamCalibAecExpSeparate_t* pExpSeparate = malloc(sizeof(CamCalibAecExpSeparate_t));
+    CamCalibAecExpSeparate_t* pExpSeparate = allocCamCalibDbIq(sizeof(CamCalibAecExpSeparate_t));
     l->p_next = (List*)pExpSeparate;
     readCamCalibDbIq(pExpSeparate, sizeof(CamCalibAecExpSeparate_t));
     while (pExpSeparate->p_next) {
-      pNew = malloc(sizeof(CamCalibAecExpSeparate_t));
+      pNew = allocCamCalibDbIq(sizeof(CamCalibAecExpSeparate_t));
       readCamCalibDbIq(pNew, sizeof(CamCalibAecExpSeparate_t));
 
       pExpSeparate->p_next = pNew;
@@ -3816,26 +3880,13 @@ static void LoadExpSeparateList(List* l) {
 #endif
 }
 
-RESULT CamCalibDbLoadFile
-(
-    CamCalibDbHandle_t*  hCamCalibDb,
-    const char* CamCalibDbIqData
-) {
-  char *pIqBuf;
+static CamCalibDbContext_t* LoadCamCalibDb(void) {
   CamCalibDbContext_t* pCamCalibDbCtx;
-  RESULT result;
-  List* l;
-
-#ifdef LOAD_IQ_TRACE_INFO_ON
-  LOGD( "%s (enter)\n", __FUNCTION__);
-#endif
 
-  if (GetXmlDbDir() == NULL || initCamCalibDbIq(CamCalibDbIqData) != RET_SUCCESS)
-    return (RET_FAILURE);
-  pCamCalibDbCtx = malloc(sizeof(CamCalibDbContext_t));
+  pCamCalibDbCtx = allocCamCalibDbIq(sizeof(CamCalibDbContext_t));
   readCamCalibDbIq(pCamCalibDbCtx, sizeof(CamCalibDbContext_t));
   LoadResolutionList(&pCamCalibDbCtx->resolution);
-  pCamCalibDbCtx->pAwbProfile = malloc(sizeof(CamCalibAwbPara_t));
+  pCamCalibDbCtx->pAwbProfile = allocCamCalibDbIq(sizeof(CamCalibAwbPara_t));
   readCamCalibDbIq(pCamCalibDbCtx->pAwbProfile, sizeof(CamCalibAwbPara_t));
 #ifdef LOAD_IQ_TRACE_INFO_ON
   LOGD( "%s:%d: file pos 0x%x\n", __FUNCTION__, __LINE__, getCamCalibDbIqIdx());
@@ -3845,18 +3896,18 @@ RESULT CamCalibDbLoadFile
   LoadAwb_V11_GlobalList(&pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global);
   LoadAwb_V11_IlluminationList(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination);
   if (pCamCalibDbCtx->pAfGlobal) {
-    pCamCalibDbCtx->pAfGlobal = malloc(sizeof(CamCalibAfGlobal_t));
+    pCamCalibDbCtx->pAfGlobal = allocCamCalibDbIq(sizeof(CamCalibAfGlobal_t));
     readCamCalibDbIq(pCamCalibDbCtx->pAfGlobal, sizeof(CamCalibAfGlobal_t));
     if (pCamCalibDbCtx->pAfGlobal->contrast_af.FullSteps > 0) {
        pCamCalibDbCtx->pAfGlobal->contrast_af.FullRangeTbl =
-         malloc(pCamCalibDbCtx->pAfGlobal->contrast_af.FullSteps * sizeof(uint16_t));
+         allocCamCalibDbIq(pCamCalibDbCtx->pAfGlobal->contrast_af.FullSteps * sizeof(uint16_t));
        readCamCalibDbIq(pCamCalibDbCtx->pAfGlobal->contrast_af.FullRangeTbl,
          pCamCalibDbCtx->pAfGlobal->contrast_af.FullSteps * sizeof(uint16_t));
     }
 
     if (pCamCalibDbCtx->pAfGlobal->contrast_af.AdaptiveSteps > 0) {
        pCamCalibDbCtx->pAfGlobal->contrast_af.AdaptRangeTbl =
-         malloc(pCamCalibDbCtx->pAfGlobal->contrast_af.FullSteps * sizeof(uint16_t));
+         allocCamCalibDbIq(pCamCalibDbCtx->pAfGlobal->contrast_af.FullSteps * sizeof(uint16_t));
        readCamCalibDbIq(pCamCalibDbCtx->pAfGlobal->contrast_af.AdaptRangeTbl,
          pCamCalibDbCtx->pAfGlobal->contrast_af.AdaptiveSteps * sizeof(uint16_t));
     }
@@ -3865,23 +3916,23 @@ RESULT CamCalibDbLoadFile
   LOGD( "%s:%d: file pos 0x%x\n", __FUNCTION__, __LINE__, getCamCalibDbIqIdx());
 #endif
   if (pCamCalibDbCtx->pAecGlobal) {
-    pCamCalibDbCtx->pAecGlobal = malloc(sizeof(CamCalibAecGlobal_t));
+    pCamCalibDbCtx->pAecGlobal = allocCamCalibDbIq(sizeof(CamCalibAecGlobal_t));
     readCamCalibDbIq(pCamCalibDbCtx->pAecGlobal, sizeof(CamCalibAecGlobal_t));
     if(pCamCalibDbCtx->pAecGlobal->GridWeights.ArraySize != 0){
        pCamCalibDbCtx->pAecGlobal->GridWeights.pWeight =
-         malloc(pCamCalibDbCtx->pAecGlobal->GridWeights.ArraySize * sizeof(uint8_t));
+         allocCamCalibDbIq(pCamCalibDbCtx->pAecGlobal->GridWeights.ArraySize * sizeof(uint8_t));
        readCamCalibDbIq(pCamCalibDbCtx->pAecGlobal->GridWeights.pWeight,
          pCamCalibDbCtx->pAecGlobal->GridWeights.ArraySize * sizeof(uint8_t));
     }
     if(pCamCalibDbCtx->pAecGlobal->NightGridWeights.ArraySize != 0){
        pCamCalibDbCtx->pAecGlobal->NightGridWeights.pWeight =
-         malloc(pCamCalibDbCtx->pAecGlobal->NightGridWeights.ArraySize * sizeof(uint8_t));
+         allocCamCalibDbIq(pCamCalibDbCtx->pAecGlobal->NightGridWeights.ArraySize * sizeof(uint8_t));
        readCamCalibDbIq(pCamCalibDbCtx->pAecGlobal->NightGridWeights.pWeight,
          pCamCalibDbCtx->pAecGlobal->NightGridWeights.ArraySize * sizeof(uint8_t));
     }
     if(pCamCalibDbCtx->pAecGlobal->GainRange.array_size != 0){
        pCamCalibDbCtx->pAecGlobal->GainRange.pGainRange =
-         malloc(pCamCalibDbCtx->pAecGlobal->GainRange.array_size * sizeof(float));
+         allocCamCalibDbIq(pCamCalibDbCtx->pAecGlobal->GainRange.array_size * sizeof(float));
        readCamCalibDbIq(pCamCalibDbCtx->pAecGlobal->GainRange.pGainRange,
          pCamCalibDbCtx->pAecGlobal->GainRange.array_size * sizeof(float));
     }
@@ -3893,17 +3944,17 @@ RESULT CamCalibDbLoadFile
 #endif
 
   if (pCamCalibDbCtx->pWdrGlobal) {
-    pCamCalibDbCtx->pWdrGlobal = malloc(sizeof(CamCalibWdrGlobal_t));
+    pCamCalibDbCtx->pWdrGlobal = allocCamCalibDbIq(sizeof(CamCalibWdrGlobal_t));
     readCamCalibDbIq(pCamCalibDbCtx->pWdrGlobal, sizeof(CamCalibWdrGlobal_t));
     if (pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfMaxGain_level != NULL) {
       pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfMaxGain_level =
-        malloc(sizeof(float) * pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.nSize);
+        allocCamCalibDbIq(sizeof(float) * pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.nSize);
       readCamCalibDbIq(pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfMaxGain_level,
           sizeof(float) * pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.nSize);
     }
     if (pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfSensorGain_level != NULL) {
       pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfSensorGain_level =
-        malloc(sizeof(float) * pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.nSize);
+        allocCamCalibDbIq(sizeof(float) * pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.nSize);
       readCamCalibDbIq(pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.pfSensorGain_level,
           sizeof(float) * pCamCalibDbCtx->pWdrGlobal->wdr_MaxGain_Level_curve.nSize);
     }
@@ -3913,7 +3964,7 @@ RESULT CamCalibDbLoadFile
 #endif
 
   if (pCamCalibDbCtx->pCprocGlobal) {
-    pCamCalibDbCtx->pCprocGlobal = malloc(sizeof(CamCprocProfile_t));
+    pCamCalibDbCtx->pCprocGlobal = allocCamCalibDbIq(sizeof(CamCprocProfile_t));
     readCamCalibDbIq(pCamCalibDbCtx->pCprocGlobal, sizeof(CamCprocProfile_t));
   }
 #ifdef LOAD_IQ_TRACE_INFO_ON
@@ -3930,10 +3981,31 @@ RESULT CamCalibDbLoadFile
   LoadGocProfileList(&pCamCalibDbCtx->gocProfile);
   LoadIeSharpenProfileList(&pCamCalibDbCtx->iesharpen_profile);
   if (pCamCalibDbCtx->pOTPGlobal) {
-    pCamCalibDbCtx->pOTPGlobal = malloc(sizeof(CamOTPGlobal_t));
+    pCamCalibDbCtx->pOTPGlobal = allocCamCalibDbIq(sizeof(CamOTPGlobal_t));
     readCamCalibDbIq(pCamCalibDbCtx->pOTPGlobal, sizeof(CamOTPGlobal_t));
   }
 
+  return (pCamCalibDbCtx);
+}
+
+RESULT CamCalibDbLoadFile
+(
+    CamCalibDbHandle_t*  hCamCalibDb,
+    const char* CamCalibDbIqData
+) {
+  char *pIqBuf;
+  CamCalibDbContext_t* pCamCalibDbCtx;
+  RESULT result;
+  List* l;
+
+#ifdef LOAD_IQ_TRACE_INFO_ON
+  LOGD( "%s (enter)\n", __FUNCTION__);
+#endif
+
+  if (GetXmlDbDir() == NULL || initCamCalibDbIq(CamCalibDbIqData) != RET_SUCCESS)
+    return (RET_FAILURE);
+  pCamCalibDbCtx = LoadCamCalibDb();
+
   *hCamCalibDb = (CamCalibDbHandle_t)pCamCalibDbCtx;
 
 #ifndef USE_C_SOURCE_XML_BIN
@@ -3951,6 +4023,870 @@ RESULT CamCalibDbLoadFile
   return (RET_SUCCESS);
 }
 
+/******************************************************************************
+ * Memory mappable calibration database
+ *
+ * The map file holds the database as LoadCamCalibDb lays it out in one
+ * arena, behind a header and followed by the image offsets of all pointers
+ * in it. The pointers are linked against link_base: a mapping that lands
+ * there is used as is and its pages stay shared by every process and
+ * camera using the file, anywhere else the pointers get relocated in the
+ * private copy of the pages holding them.
+ *****************************************************************************/
+#define CAM_CALIBDB_MAP_MAGIC         0x4d424443  /* "CDBM" */
+#define CAM_CALIBDB_MAP_VERSION       1
+#define CAM_CALIBDB_MAP_HEADER_SIZE   80
+
+typedef struct CamCalibDbMapHeader_s {
+  uint32_t  magic;
+  uint32_t  version;
+  uint32_t  layout;         /**< crc of the structure sizes the image was built with */
+  uint32_t  checksum;       /**< crc of the file behind the header */
+  uint64_t  xml_size;       /**< size and mtime of the source xml */
+  int64_t   xml_mtime;
+  uint64_t  link_base;      /**< address the pointers in the image are linked against */
+  uint64_t  map_size;       /**< size of the whole file */
+  uint32_t  image_offset;
+  uint32_t  image_size;
+  uint32_t  reloc_offset;   /**< uint32_t image offsets of the pointers */
+  uint32_t  reloc_count;
+  uint32_t  magic_version_code; /**< of the xml parser that created the database */
+} CamCalibDbMapHeader_t;
+
+DCT_ASSERT_STATIC(sizeof(CamCalibDbMapHeader_t) <= CAM_CALIBDB_MAP_HEADER_SIZE);
+
+typedef struct CamCalibDbMapping_s {
+  struct CamCalibDbMapping_s* p_next;
+  void*                       pBase;
+  size_t                      size;
+  CamCalibDbContext_t*        pCamCalibDbCtx;
+} CamCalibDbMapping_t;
+
+/* protects the mappings, the crc table and the load state while generating */
+static pthread_mutex_t gCamCalibDbMapLock = PTHREAD_MUTEX_INITIALIZER;
+static CamCalibDbMapping_t* gpCamCalibDbMappings = NULL;
+
+static uint32_t CamCalibDbMapCrc(uint32_t crc, const void* pData, size_t size) {
+  static uint32_t table[256];
+  const uint8_t* p = (const uint8_t*)pData;
+  size_t i;
+
+  if (table[1] == 0) {
+    for (i = 0; i < 256; i++) {
+      uint32_t c = i;
+      int k;
+      for (k = 0; k < 8; k++)
+        c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+  }
+
+  crc = ~crc;
+  for (i = 0; i < size; i++)
+    crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+
+  return ~crc;
+}
+
+static uint32_t CamCalibDbMapLayout(void) {
+  const uint32_t sizes[] = {
+    sizeof(void*), CAM_CALIBDB_IQ_ARENA_ALIGN,
+    sizeof(CamCalibDbContext_t), sizeof(CamResolution_t), sizeof(CamFrameRate_t),
+    sizeof(CamCalibAwbPara_t), sizeof(CamCalibAwb_V10_Global_t), sizeof(CamCalibAwb_V11_Global_t),
+    sizeof(CamAwb_V10_IlluProfile_t), sizeof(CamAwb_V11_IlluProfile_t),
+    sizeof(CamCalibAfGlobal_t), sizeof(CamCalibAecGlobal_t), sizeof(CamCalibAecDynamicSetpoint_t),
+    sizeof(CamCalibAecExpSeparate_t), sizeof(CamCalibWdrGlobal_t), sizeof(CamCprocProfile_t),
+    sizeof(CamEcmProfile_t), sizeof(CamEcmScheme_t), sizeof(CamLscProfile_t), sizeof(CamCcProfile_t),
+    sizeof(CamBlsProfile_t), sizeof(CamCacProfile_t), sizeof(CamDpfProfile_t),
+    sizeof(CamDsp3DNRSettingProfile_t), sizeof(CamNewDsp3DNRProfile_t), sizeof(CamFilterProfile_t),
+    sizeof(CamDpccProfile_t), sizeof(CamCalibGocProfile_t), sizeof(CamIesharpenProfile_t),
+    sizeof(CamOTPGlobal_t),
+  };
+
+  return CamCalibDbMapCrc(0, sizes, sizeof(sizes));
+}
+
+static RESULT GetCamCalibDbMapFile(const char* xml_path, char* map_file, size_t size) {
+  const char* name = strrchr(xml_path, '/');
+
+  if (GetXmlDbDir() == NULL)
+    return RET_NOTAVAILABLE;
+
+  name = name ? name + 1 : xml_path;
+  if (snprintf(map_file, size, "%s/%s.map", GetXmlDbDir(), name) >= (int)size)
+    return RET_OUTOFRANGE;
+
+  return RET_SUCCESS;
+}
+
+/* same address for every generation of a sensor's file, only a hint to mmap */
+static uint64_t GetCamCalibDbMapLinkBase(const char* xml_path) {
+  const char* name = strrchr(xml_path, '/');
+  uint32_t seed;
+
+  name = name ? name + 1 : xml_path;
+  seed = CamCalibDbMapCrc(0, name, strlen(name));
+#if UINTPTR_MAX > 0xffffffffu
+  return 0x500000000000ull + ((uint64_t)(seed & 0xfff) << 28);
+#else
+  return 0x50000000u + ((seed & 0x3f) << 22);
+#endif
+}
+
+static int IsCamCalibDbMapHeaderValid
+(
+    const CamCalibDbMapHeader_t* pHeader,
+    uint64_t file_size,
+    const struct stat* pXmlStat,
+    uint32_t magic_version_code
+) {
+  if (pHeader->magic != CAM_CALIBDB_MAP_MAGIC || pHeader->version != CAM_CALIBDB_MAP_VERSION ||
+      pHeader->layout != CamCalibDbMapLayout() || pHeader->magic_version_code != magic_version_code)
+    return 0;
+
+  if (pHeader->xml_size != (uint64_t)pXmlStat->st_size ||
+      pHeader->xml_mtime != (int64_t)pXmlStat->st_mtime)
+    return 0;
+
+  if (pHeader->map_size != file_size || pHeader->link_base != (uintptr_t)pHeader->link_base ||
+      pHeader->image_offset < CAM_CALIBDB_MAP_HEADER_SIZE ||
+      pHeader->image_offset % CAM_CALIBDB_IQ_ARENA_ALIGN ||
+      pHeader->image_size < sizeof(CamCalibDbContext_t) ||
+      (uint64_t)pHeader->image_offset + pHeader->image_size > pHeader->reloc_offset ||
+      pHeader->reloc_offset % sizeof(uint32_t) ||
+      (uint64_t)pHeader->reloc_offset + (uint64_t)pHeader->reloc_count * sizeof(uint32_t) > file_size)
+    return 0;
+
+  return 1;
+}
+
+static CamCalibDbContext_t* LoadCamCalibDbArena
+(
+    const char* pData,
+    size_t size,
+    CamCalibDbIqArena_t* pArena
+) {
+  CamCalibDbContext_t* pCamCalibDbCtx;
+
+  gpCamCalibDbIqData = pData;
+  gCamCalibDbIqIdx = 0;
+  gpCamCalibDbIqArena = pArena;
+  pCamCalibDbCtx = LoadCamCalibDb();
+  gpCamCalibDbIqArena = NULL;
+  gpCamCalibDbIqData = NULL;
+
+  if (gCamCalibDbIqIdx != size) {
+    LOGE( "%s:loaded %u of %zu bytes!!\n", __func__, gCamCalibDbIqIdx, size);
+    return (NULL);
+  }
+
+  return (pCamCalibDbCtx);
+}
+
+RESULT CamCalibDbGenerateMapFile
+(
+    CamCalibDbHandle_t  hCamCalibDb,
+    const char* xml_path,
+    uint32_t magic_version_code
+) {
+  CamCalibDbContext_t* pCamCalibDbCtx = (CamCalibDbContext_t*)hCamCalibDb;
+  CamCalibDbIqArena_t measure, arena[2];
+  CamCalibDbMapHeader_t header;
+  struct stat xml_st;
+  char map_file[128];
+  char tmp_file[160];
+  char* pDump = NULL;
+  char* pMap = NULL;
+  uint32_t* pRelocs;
+  size_t dump_size, words, i;
+  uintptr_t delta;
+  FILE* fp;
+  int fd;
+  RESULT result;
+
+  LOGD( "%s (enter)\n", __FUNCTION__);
+
+  if (NULL == pCamCalibDbCtx) {
+    return (RET_WRONG_HANDLE);
+  }
+
+  if (NULL == xml_path) {
+    return (RET_NULL_POINTER);
+  }
+
+  result = GetCamCalibDbMapFile(xml_path, map_file, sizeof(map_file));
+  if (result != RET_SUCCESS)
+    return (result);
+
+  if (stat(xml_path, &xml_st)) {
+    LOGE( "%s:stat %s failed %s!!\n", __func__, xml_path, strerror(errno));
+    return (RET_FAILURE);
+  }
+
+  // serialize in the dump format, then load that into two arenas
+  fp = tmpfile();
+  if (!fp) {
+    LOGE( "%s:tmpfile failed %s!!\n", __func__, strerror(errno));
+    return (RET_FAILURE);
+  }
+  DumpCamCalibDb(pCamCalibDbCtx, fp);
+  dump_size = ftell(fp);
+  rewind(fp);
+  pDump = malloc(dump_size);
+  if (!pDump || fread(pDump, 1, dump_size, fp) != dump_size) {
+    LOGE( "%s:reading back the dump failed!!\n", __func__);
+    fclose(fp);
+    free(pDump);
+    return (RET_FAILURE);
+  }
+  fclose(fp);
+
+  memset(&measure, 0, sizeof(measure));
+  memset(arena, 0, sizeof(arena));
+  result = RET_FAILURE;
+
+  pthread_mutex_lock(&gCamCalibDbMapLock);
+
+  if (!LoadCamCalibDbArena(pDump, dump_size, &measure))
+    goto out;
+
+  /*
+   * Both loads run the same code on the same data, so the arenas only
+   * differ in the pointers into them, by the distance of their bases.
+   */
+  for (i = 0; i < 2; i++) {
+    arena[i].size = measure.used;
+    arena[i].pBase = calloc(1, measure.used);
+    if (!arena[i].pBase) {
+      result = RET_OUTOFMEM;
+      goto out;
+    }
+    if (LoadCamCalibDbArena(pDump, dump_size, &arena[i]) != (CamCalibDbContext_t*)arena[i].pBase ||
+        arena[i].used != measure.used)
+      goto out;
+  }
+
+  delta = (uintptr_t)arena[1].pBase - (uintptr_t)arena[0].pBase;
+  words = measure.used / sizeof(uintptr_t);
+
+  memset(&header, 0, sizeof(header));
+  header.magic = CAM_CALIBDB_MAP_MAGIC;
+  header.version = CAM_CALIBDB_MAP_VERSION;
+  header.layout = CamCalibDbMapLayout();
+  header.magic_version_code = magic_version_code;
+  header.xml_size = xml_st.st_size;
+  header.xml_mtime = xml_st.st_mtime;
+  header.link_base = GetCamCalibDbMapLinkBase(xml_path);
+  header.image_offset = CAM_CALIBDB_MAP_HEADER_SIZE;
+  header.image_size = measure.used;
+  header.reloc_offset = header.image_offset + header.image_size;
+
+  // room for a relocation per word, trimmed to the ones found
+  pMap = calloc(1, header.reloc_offset + words * sizeof(uint32_t));
+  if (!pMap) {
+    result = RET_OUTOFMEM;
+    goto out;
+  }
+  memcpy(pMap + header.image_offset, arena[0].pBase, header.image_size);
+  pRelocs = (uint32_t*)(pMap + header.reloc_offset);
+
+  for (i = 0; i < words; i++) {
+    uintptr_t a = ((uintptr_t*)arena[0].pBase)[i];
+    uintptr_t b = ((uintptr_t*)arena[1].pBase)[i];
+
+    if (a == b)
+      continue;
+    if (b - a != delta || a < (uintptr_t)arena[0].pBase ||
+        a > (uintptr_t)arena[0].pBase + measure.used) {
+      LOGE( "%s:word at 0x%zx differs between loads!!\n", __func__, i * sizeof(uintptr_t));
+      goto out;
+    }
+
+    ((uintptr_t*)(pMap + header.image_offset))[i] =
+      (uintptr_t)header.link_base + header.image_offset + (a - (uintptr_t)arena[0].pBase);
+    pRelocs[header.reloc_count++] = i * sizeof(uintptr_t);
+  }
+
+  header.map_size = header.reloc_offset + header.reloc_count * sizeof(uint32_t);
+  header.checksum = CamCalibDbMapCrc(0, pMap + CAM_CALIBDB_MAP_HEADER_SIZE,
+                                     header.map_size - CAM_CALIBDB_MAP_HEADER_SIZE);
+  memcpy(pMap, &header, sizeof(header));
+
+  // readers only ever see a complete file
+  snprintf(tmp_file, sizeof(tmp_file), "%s.%d", map_file, (int)getpid());
+  fd = open(tmp_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOGE( "%s:open %s failed %s!!\n", __func__, tmp_file, strerror(errno));
+    goto out;
+  }
+  if (write(fd, pMap, header.map_size) != (ssize_t)header.map_size || fdatasync(fd)) {
+    LOGE( "%s:write %s failed %s!!\n", __func__, tmp_file, strerror(errno));
+    close(fd);
+    unlink(tmp_file);
+    goto out;
+  }
+  close(fd);
+  if (rename(tmp_file, map_file)) {
+    LOGE( "%s:rename to %s failed %s!!\n", __func__, map_file, strerror(errno));
+    unlink(tmp_file);
+    goto out;
+  }
+
+  LOGD( "%s: %s, %u bytes image, %u pointers\n", __FUNCTION__, map_file,
+        header.image_size, header.reloc_count);
+  result = RET_SUCCESS;
+
+out:
+  pthread_mutex_unlock(&gCamCalibDbMapLock);
+  for (i = 0; i < measure.tracked; i++)
+    free(measure.pTracked[i]);
+  free(measure.pTracked);
+  free(arena[0].pBase);
+  free(arena[1].pBase);
+  free(pMap);
+  free(pDump);
+
+  LOGD( "%s (exit)\n", __FUNCTION__);
+
+  return (result);
+}
+
+RESULT CamCalibDbMapFile
+(
+    CamCalibDbHandle_t*  hCamCalibDb,
+    const char* xml_path,
+    uint32_t magic_version_code
+) {
+  CamCalibDbMapHeader_t header;
+  CamCalibDbMapping_t* pMapping;
+  struct stat xml_st, map_st;
+  char map_file[128];
+  const uint32_t* pRelocs;
+  char* pBase;
+  uintptr_t delta;
+  uint32_t i;
+  int fd;
+  RESULT result;
+
+  if (NULL == hCamCalibDb || NULL == xml_path) {
+    return (RET_NULL_POINTER);
+  }
+
+  result = GetCamCalibDbMapFile(xml_path, map_file, sizeof(map_file));
+  if (result != RET_SUCCESS)
+    return (result);
+
+  if (stat(xml_path, &xml_st))
+    return (RET_FAILURE);
+
+  fd = open(map_file, O_RDONLY);
+  if (fd < 0)
+    return (RET_NOTAVAILABLE);
+
+  if (fstat(fd, &map_st) || read(fd, &header, sizeof(header)) != sizeof(header)) {
+    close(fd);
+    return (RET_FAILURE);
+  }
+
+  pMapping = malloc(sizeof(CamCalibDbMapping_t));
+  if (!pMapping) {
+    close(fd);
+    return (RET_OUTOFMEM);
+  }
+
+  pthread_mutex_lock(&gCamCalibDbMapLock);
+
+  if (!IsCamCalibDbMapHeaderValid(&header, map_st.st_size, &xml_st, magic_version_code)) {
+    LOGD( "%s: %s is stale or invalid\n", __FUNCTION__, map_file);
+    result = RET_WRONG_CONFIG;
+    goto fail;
+  }
+
+  // writable private pages, copied only once written or relocated
+  pBase = mmap((void*)(uintptr_t)header.link_base, header.map_size,
+               PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (pBase == MAP_FAILED) {
+    LOGE( "%s:mmap %s failed %s!!\n", __func__, map_file, strerror(errno));
+    result = RET_FAILURE;
+    goto fail;
+  }
+
+  if (CamCalibDbMapCrc(0, pBase + CAM_CALIBDB_MAP_HEADER_SIZE,
+                       header.map_size - CAM_CALIBDB_MAP_HEADER_SIZE) != header.checksum) {
+    LOGE( "%s:%s checksum mismatch!!\n", __func__, map_file);
+    munmap(pBase, header.map_size);
+    result = RET_FAILURE;
+    goto fail;
+  }
+
+  delta = (uintptr_t)pBase - (uintptr_t)header.link_base;
+  pRelocs = (const uint32_t*)(pBase + header.reloc_offset);
+  for (i = 0; delta && i < header.reloc_count; i++) {
+    if (pRelocs[i] % sizeof(uintptr_t) || pRelocs[i] > header.image_size - sizeof(uintptr_t)) {
+      LOGE( "%s:%s bad relocation 0x%x!!\n", __func__, map_file, pRelocs[i]);
+      munmap(pBase, header.map_size);
+      result = RET_FAILURE;
+      goto fail;
+    }
+    *(uintptr_t*)(pBase + header.image_offset + pRelocs[i]) += delta;
+  }
+
+  pMapping->pBase = pBase;
+  pMapping->size = header.map_size;
+  pMapping->pCamCalibDbCtx = (CamCalibDbContext_t*)(pBase + header.image_offset);
+  pMapping->p_next = gpCamCalibDbMappings;
+  gpCamCalibDbMappings = pMapping;
+  pthread_mutex_unlock(&gCamCalibDbMapLock);
+  close(fd);
+
+  LOGD( "%s: mapped %s at %p%s\n", __FUNCTION__, map_file, pBase,
+        delta ? ", relocated" : "");
+  *hCamCalibDb = (CamCalibDbHandle_t)pMapping->pCamCalibDbCtx;
+
+  return (RET_SUCCESS);
+
+fail:
+  pthread_mutex_unlock(&gCamCalibDbMapLock);
+  close(fd);
+  free(pMapping);
+
+  return (result);
+}
+
+static RESULT UnmapCamCalibDb(CamCalibDbContext_t* pCamCalibDbCtx) {
+  CamCalibDbMapping_t** ppMapping;
+  CamCalibDbMapping_t* pMapping = NULL;
+
+  pthread_mutex_lock(&gCamCalibDbMapLock);
+  for (ppMapping = &gpCamCalibDbMappings; *ppMapping; ppMapping = &(*ppMapping)->p_next) {
+    if ((*ppMapping)->pCamCalibDbCtx == pCamCalibDbCtx) {
+      pMapping = *ppMapping;
+      *ppMapping = pMapping->p_next;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&gCamCalibDbMapLock);
+
+  if (!pMapping)
+    return (RET_NOTAVAILABLE);
+
+  munmap(pMapping->pBase, pMapping->size);
+  free(pMapping);
+
+  return (RET_SUCCESS);
+}
+
+static int IsCamCalibDbMapped(CamCalibDbContext_t* pCamCalibDbCtx) {
+  CamCalibDbMapping_t* pMapping;
+  int mapped = 0;
+
+  pthread_mutex_lock(&gCamCalibDbMapLock);
+  for (pMapping = gpCamCalibDbMappings; pMapping; pMapping = pMapping->p_next) {
+    if (pMapping->pCamCalibDbCtx == pCamCalibDbCtx) {
+      mapped = 1;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&gCamCalibDbMapLock);
+
+  return (mapped);
+}
+
+/******************************************************************************
+ * Lookup index
+ *
+ * The Get functions find items through hash tables over the lists they
+ * search, built on first use, instead of running the search callback over
+ * the list. The tables are kept per database beside it, the dump and map
+ * formats copy the context as is. A table only narrows the candidates down,
+ * the search callback still decides, so the result is the first match in
+ * list order as with ListSearch. Every change of a database drops all its
+ * tables and moves the generation on.
+ *****************************************************************************/
+#define CAM_CALIBDB_INDEX_BUCKETS     64
+
+typedef enum CamCalibDbIndexKind_e {
+  CAM_CALIBDB_INDEX_NAME,           /**< string, compared by strncmp */
+  CAM_CALIBDB_INDEX_NAME_NOCASE,    /**< string, compared by strncasecmp */
+  CAM_CALIBDB_INDEX_VALUE           /**< raw bytes */
+} CamCalibDbIndexKind_t;
+
+typedef struct CamCalibDbIndexKey_s {
+  pSearchFunc             search;
+  CamCalibDbIndexKind_t   kind;
+  size_t                  offset;       /**< of the key in the items */
+  size_t                  key_offset;   /**< of the key in the search key */
+  size_t                  size;         /**< of the key, the most compared of a name */
+} CamCalibDbIndexKey_t;
+
+#define CAM_CALIBDB_INDEX_NAME_KEY(func, type, field, kind) \
+  { func, kind, offsetof(type, field), 0, sizeof(((type*)0)->field) }
+
+static const CamCalibDbIndexKey_t ResolutionByWidthHeightKey = {
+  SearchResolutionByWidthHeight, CAM_CALIBDB_INDEX_VALUE,
+  offsetof(CamResolution_t, width), offsetof(CamResolution_t, width),
+  offsetof(CamResolution_t, height) + sizeof(uint16_t) - offsetof(CamResolution_t, width)
+};
+static const CamCalibDbIndexKey_t ResolutionByIdxKey = {
+  SearchResolutionByIdx, CAM_CALIBDB_INDEX_VALUE,
+  offsetof(CamResolution_t, id), 0, sizeof(uint32_t)
+};
+static const CamCalibDbIndexKey_t Awb_V10_GlobalByResolutionKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchAwb_V10_GlobalByResolution, CamCalibAwb_V10_Global_t, resolution, CAM_CALIBDB_INDEX_NAME_NOCASE);
+static const CamCalibDbIndexKey_t Awb_V11_GlobalByResolutionKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchAwb_V11_GlobalByResolution, CamCalibAwb_V11_Global_t, resolution, CAM_CALIBDB_INDEX_NAME_NOCASE);
+static const CamCalibDbIndexKey_t EcmProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchEcmProfileByName, CamEcmProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t EcmSchemeByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchEcmSchemeByName, CamEcmScheme_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t DySetpointByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchDySetpointProfileByName, CamCalibAecDynamicSetpoint_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t ExpSeparateByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchExpSeparateProfileByName, CamCalibAecExpSeparate_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t Awb_V11_IlluminationByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchAwb_V11_IlluminationByName, CamAwb_V11_IlluProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t Awb_V10_IlluminationByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchAwb_V10_IlluminationByName, CamAwb_V10_IlluProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t LscProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchLscProfileByName, CamLscProfile_t, name, CAM_CALIBDB_INDEX_NAME_NOCASE);
+static const CamCalibDbIndexKey_t CcProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchCcProfileByName, CamCcProfile_t, name, CAM_CALIBDB_INDEX_NAME_NOCASE);
+static const CamCalibDbIndexKey_t BlsProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchBlsProfileByName, CamBlsProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t BlsProfileByResolutionKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchBlsProfileByResolution, CamBlsProfile_t, resolution, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t CacProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchCacProfileByName, CamCacProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t CacProfileByResolutionKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchCacProfileByResolution, CamCacProfile_t, resolution, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t DpfProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchDpfProfileByName, CamDpfProfile_t, name, CAM_CALIBDB_INDEX_NAME_NOCASE);
+static const CamCalibDbIndexKey_t DpfProfileByResolutionKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchDpfProfileByResolution, CamDpfProfile_t, resolution, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t FilterProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchFilterProfileByName, CamFilterProfile_t, name, CAM_CALIBDB_INDEX_NAME_NOCASE);
+static const CamCalibDbIndexKey_t NewDsp3DNRSettingByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchNewDsp3DNRSettingByName, CamNewDsp3DNRProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t Dsp3DNRSettingByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchDsp3DNRSettingByName, CamDsp3DNRSettingProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t DpccProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchDpccProfileByName, CamDpccProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t DpccProfileByResolutionKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchDpccProfileByResolution, CamDpccProfile_t, resolution, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t IesharpenProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchIesharpenProfileByName, CamIesharpenProfile_t, name, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t IesharpenProfileByResolutionKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchIesharpenProfileByResolution, CamIesharpenProfile_t, resolution, CAM_CALIBDB_INDEX_NAME);
+static const CamCalibDbIndexKey_t GocProfileByNameKey = CAM_CALIBDB_INDEX_NAME_KEY(
+  SearchGocProfileByName, CamCalibGocProfile_t, name, CAM_CALIBDB_INDEX_NAME_NOCASE);
+
+typedef struct CamCalibDbIndexSlot_s {
+  uint32_t  hash;
+  uint32_t  pos;            /**< of the item plus one, 0 while the slot is free */
+} CamCalibDbIndexSlot_t;
+
+typedef struct CamCalibDbIndexTable_s {
+  struct CamCalibDbIndexTable_s*  p_next;
+  const List*                     pList;
+  const CamCalibDbIndexKey_t*     pKey;     /**< NULL for the item order only */
+  uint32_t                        count;
+  uint32_t                        mask;
+  List**                          ppItems;  /**< in list order */
+  CamCalibDbIndexSlot_t*          pSlots;   /**< open addressing, linear probing */
+} CamCalibDbIndexTable_t;
+
+typedef struct CamCalibDbIndex_s {
+  struct CamCalibDbIndex_s*   p_next;
+  const CamCalibDbContext_t*  pCamCalibDbCtx;
+  CamCalibDbIndexTable_t*     pTables[CAM_CALIBDB_INDEX_BUCKETS];
+} CamCalibDbIndex_t;
+
+/* protects the indexes, lookups run under it as a change drops the tables */
+static pthread_mutex_t gCamCalibDbIndexLock = PTHREAD_MUTEX_INITIALIZER;
+static CamCalibDbIndex_t* gpCamCalibDbIndexes = NULL;
+static uint32_t gCamCalibDbGeneration = 0;
+
+/* equal for keys the search callback matches, up to the first 0 of a name */
+static uint32_t HashCamCalibDbIndexKey(const CamCalibDbIndexKey_t* pKey, const char* p) {
+  const unsigned char* c = (const unsigned char*)p;
+  const unsigned char* end = c + pKey->size;
+  uint32_t hash = 2166136261u;
+
+  switch (pKey->kind) {
+    case CAM_CALIBDB_INDEX_NAME:
+      for (; c < end && *c; c++)
+        hash = (hash ^ *c) * 16777619u;
+      break;
+    case CAM_CALIBDB_INDEX_NAME_NOCASE:
+      for (; c < end && *c; c++)
+        hash = (hash ^ (unsigned char)tolower(*c)) * 16777619u;
+      break;
+    default:
+      for (; c < end; c++)
+        hash = (hash ^ *c) * 16777619u;
+      break;
+  }
+
+  return (hash);
+}
+
+static uint32_t GetCamCalibDbIndexBucket(const List* pList, const CamCalibDbIndexKey_t* pKey) {
+  uintptr_t v = (uintptr_t)pList ^ ((uintptr_t)pKey << 4);
+
+  return ((uint32_t)(v ^ (v >> 7) ^ (v >> 13)) & (CAM_CALIBDB_INDEX_BUCKETS - 1));
+}
+
+static void FreeCamCalibDbIndexTable(CamCalibDbIndexTable_t* pTable) {
+  free(pTable->ppItems);
+  free(pTable->pSlots);
+  free(pTable);
+}
+
+static CamCalibDbIndexTable_t* BuildCamCalibDbIndexTable
+(
+    const List*                 pList,
+    const CamCalibDbIndexKey_t* pKey
+) {
+  CamCalibDbIndexTable_t* pTable;
+  const List* l;
+  uint32_t pos, i;
+
+  pTable = calloc(1, sizeof(CamCalibDbIndexTable_t));
+  if (!pTable)
+    return (NULL);
+
+  pTable->pList = pList;
+  pTable->pKey = pKey;
+  for (l = ListHead(pList); l; l = l->p_next)
+    pTable->count++;
+
+  pTable->ppItems = malloc((pTable->count + 1) * sizeof(List*));
+  if (!pTable->ppItems) {
+    FreeCamCalibDbIndexTable(pTable);
+    return (NULL);
+  }
+  for (l = ListHead(pList), pos = 0; l; l = l->p_next)
+    pTable->ppItems[pos++] = (List*)l;
+
+  if (pKey) {
+    // at most half full
+    for (pTable->mask = 3; pTable->mask < pTable->count * 2; pTable->mask = pTable->mask * 2 + 1)
+      ;
+    pTable->pSlots = calloc(pTable->mask + 1, sizeof(CamCalibDbIndexSlot_t));
+    if (!pTable->pSlots) {
+      FreeCamCalibDbIndexTable(pTable);
+      return (NULL);
+    }
+
+    // in list order, the first item of a key is probed first
+    for (pos = 0; pos < pTable->count; pos++) {
+      uint32_t hash = HashCamCalibDbIndexKey(pKey, (const char*)pTable->ppItems[pos] + pKey->offset);
+
+      for (i = hash & pTable->mask; pTable->pSlots[i].pos; i = (i + 1) & pTable->mask)
+        ;
+      pTable->pSlots[i].hash = hash;
+      pTable->pSlots[i].pos = pos + 1;
+    }
+  }
+
+  return (pTable);
+}
+
+/* with gCamCalibDbIndexLock held, NULL if out of memory */
+static CamCalibDbIndexTable_t* GetCamCalibDbIndexTable
+(
+    const CamCalibDbContext_t*  pCamCalibDbCtx,
+    const List*                 pList,
+    const CamCalibDbIndexKey_t* pKey
+) {
+  CamCalibDbIndex_t* pIndex;
+  CamCalibDbIndexTable_t* pTable;
+  uint32_t bucket = GetCamCalibDbIndexBucket(pList, pKey);
+
+  for (pIndex = gpCamCalibDbIndexes; pIndex; pIndex = pIndex->p_next) {
+    if (pIndex->pCamCalibDbCtx == pCamCalibDbCtx)
+      break;
+  }
+
+  if (!pIndex) {
+    pIndex = calloc(1, sizeof(CamCalibDbIndex_t));
+    if (!pIndex)
+      return (NULL);
+    pIndex->pCamCalibDbCtx = pCamCalibDbCtx;
+    pIndex->p_next = gpCamCalibDbIndexes;
+    gpCamCalibDbIndexes = pIndex;
+  }
+
+  for (pTable = pIndex->pTables[bucket]; pTable; pTable = pTable->p_next) {
+    if (pTable->pList == pList && pTable->pKey == pKey)
+      return (pTable);
+  }
+
+  pTable = BuildCamCalibDbIndexTable(pList, pKey);
+  if (pTable) {
+    pTable->p_next = pIndex->pTables[bucket];
+    pIndex->pTables[bucket] = pTable;
+  }
+
+  return (pTable);
+}
+
+/* ListSearch with pKey->search */
+static List* SearchCamCalibDbIndex
+(
+    const CamCalibDbContext_t*  pCamCalibDbCtx,
+    List*                       pList,
+    const CamCalibDbIndexKey_t* pKey,
+    void*                       key
+) {
+  CamCalibDbIndexTable_t* pTable;
+  List* l = NULL;
+  uint32_t hash, i;
+
+  if (NULL == key)
+    return (ListSearch(pList, pKey->search, key));
+
+  pthread_mutex_lock(&gCamCalibDbIndexLock);
+  pTable = GetCamCalibDbIndexTable(pCamCalibDbCtx, pList, pKey);
+  if (!pTable) {
+    pthread_mutex_unlock(&gCamCalibDbIndexLock);
+    return (ListSearch(pList, pKey->search, key));
+  }
+
+  hash = HashCamCalibDbIndexKey(pKey, (const char*)key + pKey->key_offset);
+  for (i = hash & pTable->mask; pTable->pSlots[i].pos; i = (i + 1) & pTable->mask) {
+    List* item = pTable->ppItems[pTable->pSlots[i].pos - 1];
+
+    if (pTable->pSlots[i].hash == hash && pKey->search(item, key)) {
+      l = item;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&gCamCalibDbIndexLock);
+
+  return (l);
+}
+
+/* ListGetItemByIdx */
+static List* GetCamCalibDbIndexItemByIdx
+(
+    const CamCalibDbContext_t*  pCamCalibDbCtx,
+    List*                       pList,
+    const int                   idx
+) {
+  CamCalibDbIndexTable_t* pTable;
+  List* l = NULL;
+
+  pthread_mutex_lock(&gCamCalibDbIndexLock);
+  pTable = GetCamCalibDbIndexTable(pCamCalibDbCtx, pList, NULL);
+  if (!pTable) {
+    pthread_mutex_unlock(&gCamCalibDbIndexLock);
+    return (ListGetItemByIdx(pList, idx));
+  }
+
+  // a negative index stays at the head
+  if (pTable->count && (idx < 0 || (uint32_t)idx < pTable->count))
+    l = pTable->ppItems[idx < 0 ? 0 : idx];
+  pthread_mutex_unlock(&gCamCalibDbIndexLock);
+
+  return (l);
+}
+
+/* ListNoItems */
+static int GetCamCalibDbIndexNoItems
+(
+    const CamCalibDbContext_t*  pCamCalibDbCtx,
+    List*                       pList
+) {
+  CamCalibDbIndexTable_t* pTable;
+  int count;
+
+  pthread_mutex_lock(&gCamCalibDbIndexLock);
+  pTable = GetCamCalibDbIndexTable(pCamCalibDbCtx, pList, NULL);
+  count = pTable ? (int)pTable->count : ListNoItems(pList);
+  pthread_mutex_unlock(&gCamCalibDbIndexLock);
+
+  return (count);
+}
+
+/*
+ * before and after any change of the database, and before it is released:
+ * a lookup racing the change may rebuild the index from the old lists, the
+ * drop after it makes sure that index doesn't outlive the change
+ */
+static void DropCamCalibDbIndex(const CamCalibDbContext_t* pCamCalibDbCtx) {
+  CamCalibDbIndex_t** ppIndex;
+  CamCalibDbIndex_t* pIndex = NULL;
+  uint32_t i;
+
+  pthread_mutex_lock(&gCamCalibDbIndexLock);
+  gCamCalibDbGeneration++;
+  for (ppIndex = &gpCamCalibDbIndexes; *ppIndex; ppIndex = &(*ppIndex)->p_next) {
+    if ((*ppIndex)->pCamCalibDbCtx == pCamCalibDbCtx) {
+      pIndex = *ppIndex;
+      *ppIndex = pIndex->p_next;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&gCamCalibDbIndexLock);
+
+  if (!pIndex)
+    return;
+
+  for (i = 0; i < CAM_CALIBDB_INDEX_BUCKETS; i++) {
+    while (pIndex->pTables[i]) {
+      CamCalibDbIndexTable_t* pTable = pIndex->pTables[i];
+      pIndex->pTables[i] = pTable->p_next;
+      FreeCamCalibDbIndexTable(pTable);
+    }
+  }
+  free(pIndex);
+}
+
+/******************************************************************************
+ * CamCalibDbGetGeneration
+ *****************************************************************************/
+RESULT CamCalibDbGetGeneration
+(
+    CamCalibDbHandle_t  hCamCalibDb,
+    uint32_t*           pGeneration
+) {
+  CamCalibDbContext_t* pCamCalibDbCtx = (CamCalibDbContext_t*)hCamCalibDb;
+
+  if (NULL == pCamCalibDbCtx) {
+    return (RET_WRONG_HANDLE);
+  }
+
+  if (NULL == pGeneration) {
+    return (RET_INVALID_PARM);
+  }
+
+  pthread_mutex_lock(&gCamCalibDbIndexLock);
+  *pGeneration = gCamCalibDbGeneration;
+  pthread_mutex_unlock(&gCamCalibDbIndexLock);
+
+  return (RET_SUCCESS);
+}
+
+/******************************************************************************
+ * CamCalibDbTouch
+ *****************************************************************************/
+RESULT CamCalibDbTouch
+(
+    CamCalibDbHandle_t  hCamCalibDb
+) {
+  CamCalibDbContext_t* pCamCalibDbCtx = (CamCalibDbContext_t*)hCamCalibDb;
+
+  if (NULL == pCamCalibDbCtx) {
+    return (RET_WRONG_HANDLE);
+  }
+
+  // a profile may have been renamed, the index goes as well
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
+  return (RET_SUCCESS);
+}
+
 /******************************************************************************
  * See header file for detailed comment.
  *****************************************************************************/
@@ -4062,6 +4998,13 @@ RESULT CamCalibDbRelease
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
+  if (UnmapCamCalibDb(pCamCalibDbCtx) == RET_SUCCESS) {
+    *handle = NULL;
+    return (RET_SUCCESS);
+  }
+
   result = ClearContext(pCamCalibDbCtx);
   free(pCamCalibDbCtx);
   *handle = NULL;
@@ -4090,8 +5033,17 @@ RESULT CamCalibDbClear
     return (RET_WRONG_HANDLE);
   }
 
+  // a mapped database is released as a whole
+  if (IsCamCalibDbMapped(pCamCalibDbCtx)) {
+    return (RET_WRONG_STATE);
+  }
+
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ClearContext(pCamCalibDbCtx);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (result);
@@ -4234,6 +5186,8 @@ RESULT CamCalibDbAddFrameRate
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   if (NULL == pResolution) {
     return (RET_INVALID_PARM);
   }
@@ -4259,6 +5213,8 @@ RESULT CamCalibDbAddFrameRate
   ListPrepareItem(pNewFrameRate);
   ListAddTail(&pResolution->framerates, pNewFrameRate);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -4284,6 +5240,8 @@ RESULT CamCalibDbAddResolution
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateResolution(pAddRes);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4323,6 +5281,8 @@ RESULT CamCalibDbAddResolution
   LOGD("%s added resolution %s, id=%08x, w:%d, h:%d\n",
         __func__, pNewRes->name, pNewRes->id, pNewRes->width, pNewRes->height);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -4350,7 +5310,7 @@ RESULT CamCalibDbGetNoOfResolutions
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->resolution);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->resolution);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4422,8 +5382,8 @@ RESULT CamCalibDbGetResolutionByWidthHeight
   SearchParam.height     = height;
 
   /* search resolution by name */
-  *pResolution = (CamResolution_t*)ListSearch(&pCamCalibDbCtx->resolution,
-                                              SearchResolutionByWidthHeight, (void*)&SearchParam);
+  *pResolution = (CamResolution_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->resolution,
+                                              &ResolutionByWidthHeightKey, (void*)&SearchParam);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4463,8 +5423,8 @@ RESULT CamCalibDbGetResolutionNameByWidthHeight
   SearchParam.height     = height;
 
   /* search resolution by name */
-  pResolution = (CamResolution_t*)ListSearch(&pCamCalibDbCtx->resolution,
-                                             SearchResolutionByWidthHeight, (void*)&SearchParam);
+  pResolution = (CamResolution_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->resolution,
+                                             &ResolutionByWidthHeightKey, (void*)&SearchParam);
   if (pResolution) {
     strncpy((char*)pResolutionName, (char*)pResolution->name, sizeof(CamResolutionName_t));
   } else {
@@ -4537,7 +5497,7 @@ RESULT CamCalibDbGetResolutionNameByIdx
   }
 
   /* search resolution by name */
-  pResolution = (CamResolution_t*)ListSearch(&pCamCalibDbCtx->resolution, SearchResolutionByIdx, (void*)&idx);
+  pResolution = (CamResolution_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->resolution, &ResolutionByIdxKey, (void*)&idx);
   strncpy((char*)pName, (char*)pResolution->name, sizeof(CamResolutionName_t));
 
   LOGV("%s: (exit)\n", __func__);
@@ -4565,6 +5525,8 @@ RESULT CamCalibDbAddAwb_V10_Global
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateAwb_V10_Data(pAddAwbGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4652,6 +5614,8 @@ RESULT CamCalibDbAddAwb_V10_Global
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -4678,10 +5642,14 @@ RESULT CamCalibDbAddAwb_VersionName
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "valid_version :%d \n", vName);
   pCamCalibDbCtx->pAwbProfile->valid_version =	vName;
 
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -4729,8 +5697,11 @@ RESULT CamCalibDbAddAwb_FlashProfiles
       return (RET_WRONG_HANDLE);
     }
 
+    DropCamCalibDbIndex(pCamCalibDbCtx);
+
     MEMCPY(&pCamCalibDbCtx->pAwbProfile->Para_Flash,&flash,sizeof(CamAwbPara_Flash_t));
 
+    DropCamCalibDbIndex(pCamCalibDbCtx);
     return (RET_SUCCESS);
     LOGV( "%s (exit)\n", __func__);
 }
@@ -4783,6 +5754,8 @@ RESULT CamCalibDbAddAwb_V11_Global
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateAwb_V11_Data(pAddAwbGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -4862,6 +5835,8 @@ RESULT CamCalibDbAddAwb_V11_Global
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -4893,7 +5868,7 @@ RESULT CamCalibDbGetAwb_V10_GlobalByResolution
   }
 
   /* search resolution by name */
-  *pAwbGlobal = (CamCalibAwb_V10_Global_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V10.awb_global, SearchAwb_V10_GlobalByResolution, (void*)ResName);
+  *pAwbGlobal = (CamCalibAwb_V10_Global_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.awb_global, &Awb_V10_GlobalByResolutionKey, (void*)ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -4924,7 +5899,7 @@ RESULT CamCalibDbGetAwb_V11_GlobalByResolution
   }
 
   /* search resolution by name */
-  *pAwbGlobal = (CamCalibAwb_V11_Global_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global, SearchAwb_V11_GlobalByResolution, (void*)ResName);
+  *pAwbGlobal = (CamCalibAwb_V11_Global_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.awb_global, &Awb_V11_GlobalByResolutionKey, (void*)ResName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -4948,6 +5923,8 @@ RESULT CamCalibDbAddAfGlobal
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   /* check if data already exists */
   if (NULL != pCamCalibDbCtx->pAfGlobal) {
     return (RET_INVALID_PARM);
@@ -4963,6 +5940,8 @@ RESULT CamCalibDbAddAfGlobal
 
   pCamCalibDbCtx->pAfGlobal = pNewAfGlobal;
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit) %d\n", __func__, result);
 
   return (RET_SUCCESS);
@@ -5015,6 +5994,8 @@ RESULT CamCalibDbAddAecGlobal
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateAecGlobalData(pAddAecGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -5057,6 +6038,8 @@ RESULT CamCalibDbAddAecGlobal
   }
   pCamCalibDbCtx->pAecGlobal = pNewAecGlobal;
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -5113,6 +6096,8 @@ RESULT CamCalibDbAddEcmProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateEcmProfile(pAddEcmProfile);
   if (result != RET_SUCCESS) {
     return (result);
@@ -5146,6 +6131,8 @@ RESULT CamCalibDbAddEcmProfile
     pEcmScheme = (CamEcmScheme_t*)pEcmScheme->p_next;
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -5173,7 +6160,7 @@ RESULT CamCalibDbGetNoOfEcmProfiles
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->ecm_profile);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->ecm_profile);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5240,7 +6227,7 @@ RESULT CamCalibDbGetEcmProfileByName
   }
 
   /* search profile by name */
-  *ppEcmProfile = (CamEcmProfile_t*)ListSearch(&pCamCalibDbCtx->ecm_profile, SearchEcmProfileByName, (void*)EcmProfileName);
+  *ppEcmProfile = (CamEcmProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->ecm_profile, &EcmProfileByNameKey, (void*)EcmProfileName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5271,7 +6258,7 @@ RESULT CamCalibDbGetEcmProfileByIdx
   }
 
   /* search profile by index */
-  *ppEcmProfile = (CamEcmProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->ecm_profile, idx);
+  *ppEcmProfile = (CamEcmProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pCamCalibDbCtx->ecm_profile, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5300,6 +6287,8 @@ RESULT CamCalibDbAddEcmScheme
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   if (NULL == pEcmProfile) {
     return (RET_INVALID_PARM);
   }
@@ -5325,6 +6314,8 @@ RESULT CamCalibDbAddEcmScheme
   ListPrepareItem(pNewEcmScheme);
   ListAddTail(&pEcmProfile->ecm_scheme, pNewEcmScheme);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -5357,7 +6348,7 @@ RESULT CamCalibDbGetNoOfEcmSchemes
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pEcmProfile->ecm_scheme);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pEcmProfile->ecm_scheme);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5389,7 +6380,7 @@ RESULT CamCalibDbGetEcmSchemeByName
   }
 
   /* search scheme by name */
-  *ppEcmScheme = (CamEcmScheme_t*)ListSearch(&pEcmProfile->ecm_scheme, SearchEcmSchemeByName, (void*)EcmSchemeName);
+  *ppEcmScheme = (CamEcmScheme_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pEcmProfile->ecm_scheme, &EcmSchemeByNameKey, (void*)EcmSchemeName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5425,7 +6416,7 @@ RESULT CamCalibDbGetEcmSchemeByIdx
   }
 
   /* search EC scheme by index */
-  *ppEcmScheme = (CamEcmScheme_t*)ListGetItemByIdx(&pEcmProfile->ecm_scheme, idx);
+  *ppEcmScheme = (CamEcmScheme_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pEcmProfile->ecm_scheme, idx);
 
   return (RET_SUCCESS);
 }
@@ -5452,6 +6443,8 @@ RESULT CamCalibDbAddDySetpoint
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   if (NULL == pAecGlobal) {
     return (RET_INVALID_PARM);
   }
@@ -5496,6 +6489,8 @@ RESULT CamCalibDbAddDySetpoint
   ListPrepareItem(pNewDySetpoint);
   ListAddTail(&pAecGlobal->DySetpointList, pNewDySetpoint);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -5527,7 +6522,7 @@ RESULT CamCalibDbGetNoOfDySetpoint
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pAecGlobal->DySetpointList);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pAecGlobal->DySetpointList);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -5559,7 +6554,7 @@ RESULT CamCalibDbGetDySetpointByName
   }
 
   /* search scheme by name */
-  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)ListSearch(&pAecGlobal->DySetpointList, SearchDySetpointProfileByName, (void*)DySetpointName);
+  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pAecGlobal->DySetpointList, &DySetpointByNameKey, (void*)DySetpointName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -5594,7 +6589,7 @@ RESULT CamCalibDbGetDySetpointByIdx
   }
 
   /* search EC scheme by index */
-  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)ListGetItemByIdx(&pAecGlobal->DySetpointList, idx);
+  *ppDySetpoint = (CamCalibAecDynamicSetpoint_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pAecGlobal->DySetpointList, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -5622,6 +6617,8 @@ RESULT CamCalibDbAddExpSeparate
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   if (NULL == pAecGlobal) {
     return (RET_INVALID_PARM);
   }
@@ -5647,6 +6644,8 @@ RESULT CamCalibDbAddExpSeparate
   ListPrepareItem(pNewExpSeparate);
   ListAddTail(&pAecGlobal->ExpSeparateList, pNewExpSeparate);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -5678,7 +6677,7 @@ RESULT CamCalibDbGetNoOfExpSeparate
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pAecGlobal->ExpSeparateList);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pAecGlobal->ExpSeparateList);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -5710,7 +6709,7 @@ RESULT CamCalibDbGetExpSeparateByName
   }
 
   /* search scheme by name */
-  *ppExpSeparate = (CamCalibAecExpSeparate_t*)ListSearch(&pAecGlobal->ExpSeparateList, SearchExpSeparateProfileByName, (void*)ExpSeparateName);
+  *ppExpSeparate = (CamCalibAecExpSeparate_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pAecGlobal->ExpSeparateList, &ExpSeparateByNameKey, (void*)ExpSeparateName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -5745,7 +6744,7 @@ RESULT CamCalibDbGetExpSeparateByIdx
   }
 
   /* search EC scheme by index */
-  *ppExpSeparate = (CamCalibAecExpSeparate_t*)ListGetItemByIdx(&pAecGlobal->ExpSeparateList, idx);
+  *ppExpSeparate = (CamCalibAecExpSeparate_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pAecGlobal->ExpSeparateList, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -5774,7 +6773,7 @@ RESULT CamCalibDbGetNoOfAwb_V11_Illuminations
   }
 
   /* search resolution by name */
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.illumination);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -5803,7 +6802,7 @@ RESULT CamCalibDbGetNoOfAwb_V10_Illuminations
   }
 
   /* search resolution by name */
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.illumination);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -5858,6 +6857,8 @@ RESULT CamCalibDbAddAwb_V11_Illumination
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateAwb_V11_Illumination(pAddIllu);
   if (result != RET_SUCCESS) {
     return (result);
@@ -5906,6 +6907,7 @@ RESULT CamCalibDbAddAwb_V11_Illumination
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
   return (RET_SUCCESS);
 }
 
@@ -5928,6 +6930,8 @@ RESULT CamCalibDbAddAwb_V10_Illumination
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateAwb_V10_Illumination(pAddIllu);
   if (result != RET_SUCCESS) {
     return (result);
@@ -5977,6 +6981,8 @@ RESULT CamCalibDbAddAwb_V10_Illumination
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
   return (RET_SUCCESS);
 }
@@ -6002,7 +7008,7 @@ RESULT CamCalibDbGetAwb_V11_IlluminationByName
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V11_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, SearchAwb_V11_IlluminationByName, (void*)name);
+  *pIllumination = (CamAwb_V11_IlluProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, &Awb_V11_IlluminationByNameKey, (void*)name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6033,7 +7039,7 @@ RESULT CamCalibDbGetAwb_V10_IlluminationByName
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V10_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, SearchAwb_V10_IlluminationByName, (void*)name);
+  *pIllumination = (CamAwb_V10_IlluProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, &Awb_V10_IlluminationByNameKey, (void*)name);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -6095,7 +7101,7 @@ RESULT CamCalibDbGetAwb_V11_IlluminationByIdx
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V11_IlluProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, idx);
+  *pIllumination = (CamAwb_V11_IlluProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -6126,7 +7132,7 @@ RESULT CamCalibDbGetAwb_V10_IlluminationByIdx
   }
 
   /* search resolution by name */
-  *pIllumination = (CamAwb_V10_IlluProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, idx);
+  *pIllumination = (CamAwb_V10_IlluProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -6151,6 +7157,8 @@ RESULT CamCalibDbReplaceAwb_V10_IlluminationAll
   if (NULL == pCamCalibDbCtx) {
     return (RET_WRONG_HANDLE);
   }
+
+  DropCamCalibDbIndex(pCamCalibDbCtx);
   pNewIllum = (CamAwb_V10_IlluProfile_t*)ListHead(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination);
   while (pNewIllum) {
     pNewIllum->CrossTalkCoeff = pIllumination->CrossTalkCoeff;
@@ -6158,6 +7166,8 @@ RESULT CamCalibDbReplaceAwb_V10_IlluminationAll
     pNewIllum = pNewIllum->p_next;
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
   return (RET_SUCCESS);
 }
@@ -6177,6 +7187,8 @@ RESULT CamCalibDbReplaceAwb_V11_IlluminationAll
   if (NULL == pCamCalibDbCtx) {
     return (RET_WRONG_HANDLE);
   }
+
+  DropCamCalibDbIndex(pCamCalibDbCtx);
   pNewIllum = (CamAwb_V11_IlluProfile_t*)ListHead(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination);
   while (pNewIllum) {
     pNewIllum->CrossTalkCoeff = pIllumination->CrossTalkCoeff;
@@ -6184,6 +7196,8 @@ RESULT CamCalibDbReplaceAwb_V11_IlluminationAll
     pNewIllum = pNewIllum->p_next;
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
   return (RET_SUCCESS);
 }
@@ -6207,11 +7221,14 @@ RESULT CamCalibDbReplaceAwb_V10_IlluminationByName
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   pNewIllum = (CamAwb_V10_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V10.illumination, SearchForEqualIllumination, (void*)pIllumination);
 
   if (NULL != pNewIllum) {
     pNewIllum->CrossTalkCoeff = pIllumination->CrossTalkCoeff;
     pNewIllum->CrossTalkOffset = pIllumination->CrossTalkOffset;
+    DropCamCalibDbIndex(pCamCalibDbCtx);
     return (RET_SUCCESS);
   }
 
@@ -6236,11 +7253,14 @@ RESULT CamCalibDbReplaceAwb_V11_IlluminationByName
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   pNewIllum = (CamAwb_V11_IlluProfile_t*)ListSearch(&pCamCalibDbCtx->pAwbProfile->Para_V11.illumination, SearchForEqualIllumination, (void*)pIllumination);
 
   if (NULL != pNewIllum) {
     pNewIllum->CrossTalkCoeff = pIllumination->CrossTalkCoeff;
     pNewIllum->CrossTalkOffset = pIllumination->CrossTalkOffset;
+    DropCamCalibDbIndex(pCamCalibDbCtx);
     return (RET_SUCCESS);
   }
 
@@ -6268,6 +7288,8 @@ RESULT CamCalibDbAddLscProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateLscProfile(pAddLsc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6285,6 +7307,8 @@ RESULT CamCalibDbAddLscProfile
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6314,7 +7338,7 @@ RESULT CamCalibDbGetLscProfileByName
   }
 
   /* search resolution by name */
-  *pLscProfile = (CamLscProfile_t*)ListSearch(&pCamCalibDbCtx->lsc_profile, SearchLscProfileByName, (void*)name);
+  *pLscProfile = (CamLscProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->lsc_profile, &LscProfileByNameKey, (void*)name);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -6343,7 +7367,7 @@ RESULT CamCalibDbGetLscProfileByIdx
   }
 
   /* search resolution by name */
-  *pLscProfile = (CamLscProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->lsc_profile, idx);
+  *pLscProfile = (CamLscProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pCamCalibDbCtx->lsc_profile, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -6367,9 +7391,13 @@ RESULT CamCalibDbDelLscProfileByName
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   /* search resolution by name */
   *pLscProfile = (CamLscProfile_t*)ListRemoveItem(&pCamCalibDbCtx->lsc_profile, SearchLscProfileByName, (void*)name);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6391,9 +7419,13 @@ RESULT CamCalibDbReplaceLscProfileAll
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   /* search resolution by name */
   ListForEach(&pCamCalibDbCtx->lsc_profile, ReplaceLscProfile, (void*)pLscProfile);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6418,6 +7450,8 @@ RESULT CamCalibDbAddCcProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateCcProfile(pAddCc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6435,6 +7469,8 @@ RESULT CamCalibDbAddCcProfile
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6459,6 +7495,8 @@ RESULT CamCalibDbReplaceCcProfileByName
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateCcProfile(pAddCc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6469,6 +7507,7 @@ RESULT CamCalibDbReplaceCcProfileByName
   if (NULL != pNewCc) {
     pNewCc->CrossTalkCoeff = pAddCc->CrossTalkCoeff;
     pNewCc->CrossTalkOffset = pAddCc->CrossTalkOffset;
+    DropCamCalibDbIndex(pCamCalibDbCtx);
     return (RET_SUCCESS);
   }
 
@@ -6496,6 +7535,8 @@ RESULT CamCalibDbReplaceCcProfileAll
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateCcProfile(pAddCc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6508,6 +7549,8 @@ RESULT CamCalibDbReplaceCcProfileAll
     pNewCc = (CamCcProfile_t *)pNewCc->p_next;
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6535,7 +7578,7 @@ RESULT CamCalibDbGetCcProfileByName
   }
 
   /* search resolution by name */
-  *pCcProfile = (CamCcProfile_t*)ListSearch(&pCamCalibDbCtx->cc_profile, SearchCcProfileByName, (void*)name);
+  *pCcProfile = (CamCcProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->cc_profile, &CcProfileByNameKey, (void*)name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6563,6 +7606,8 @@ RESULT CamCalibDbAddBlsProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateBlsProfile(pAddBls);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6580,6 +7625,8 @@ RESULT CamCalibDbAddBlsProfile
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6609,7 +7656,7 @@ RESULT CamCalibDbGetBlsProfileByName
   }
 
   /* search resolution by name */
-  *pBlsProfile = (CamBlsProfile_t*)ListSearch(&pCamCalibDbCtx->bls_profile, SearchBlsProfileByName, (void*)name);
+  *pBlsProfile = (CamBlsProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->bls_profile, &BlsProfileByNameKey, (void*)name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6640,7 +7687,7 @@ RESULT CamCalibDbGetBlsProfileByResolution
   }
 
   /* search resolution by name */
-  *pBlsProfile = (CamBlsProfile_t*)ListSearch(&pCamCalibDbCtx->bls_profile, SearchBlsProfileByResolution, (void*)ResName);
+  *pBlsProfile = (CamBlsProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->bls_profile, &BlsProfileByResolutionKey, (void*)ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6668,6 +7715,8 @@ RESULT CamCalibDbAddCacProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateCacProfile(pAddCac);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6685,6 +7734,8 @@ RESULT CamCalibDbAddCacProfile
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6714,7 +7765,7 @@ RESULT CamCalibDbGetCacProfileByName
   }
 
   /* search resolution by name */
-  *pCacProfile = (CamCacProfile_t*)ListSearch(&pCamCalibDbCtx->cac_profile, SearchCacProfileByName, (void*)name);
+  *pCacProfile = (CamCacProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->cac_profile, &CacProfileByNameKey, (void*)name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6745,7 +7796,7 @@ RESULT CamCalibDbGetCacProfileByResolution
   }
 
   /* search resolution by name */
-  *pCacProfile = (CamCacProfile_t*)ListSearch(&pCamCalibDbCtx->cac_profile, SearchCacProfileByResolution, (void*)ResName);
+  *pCacProfile = (CamCacProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->cac_profile, &CacProfileByResolutionKey, (void*)ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6770,6 +7821,8 @@ RESULT CamCalibDbReplaceDpfProfileAll
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateDpfProfile(pRepDpf);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6788,6 +7841,8 @@ RESULT CamCalibDbReplaceDpfProfileAll
     pNewDpf = (CamDpfProfile_t *)pNewDpf->p_next;
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6812,6 +7867,8 @@ RESULT CamCalibDbReplaceDpfProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateDpfProfile(pRepDpf);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6832,6 +7889,8 @@ RESULT CamCalibDbReplaceDpfProfile
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6856,6 +7915,8 @@ RESULT CamCalibDbAddDpfProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateDpfProfile(pAddDpf);
   if (result != RET_SUCCESS) {
     return (result);
@@ -6909,6 +7970,8 @@ RESULT CamCalibDbAddDpfProfile
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -6938,7 +8001,7 @@ RESULT CamCalibDbGetDpfProfileByName
   }
 
   /* search resolution by name */
-  *pDpfProfile = (CamDpfProfile_t*)ListSearch(&pCamCalibDbCtx->dpf_profile, SearchDpfProfileByName, (void*)name);
+  *pDpfProfile = (CamDpfProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->dpf_profile, &DpfProfileByNameKey, (void*)name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6969,7 +8032,7 @@ RESULT CamCalibDbGetDpfProfileByResolution
   }
 
   /* search resolution by name */
-  *pDpfProfile = (CamDpfProfile_t*)ListSearch(&pCamCalibDbCtx->dpf_profile, SearchDpfProfileByResolution, (void*)ResName);
+  *pDpfProfile = (CamDpfProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->dpf_profile, &DpfProfileByResolutionKey, (void*)ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -6998,6 +8061,8 @@ RESULT CamCalibDbAddFilterProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   if (NULL == pDpfProfile) {
     return (RET_INVALID_PARM);
   }
@@ -7023,6 +8088,8 @@ RESULT CamCalibDbAddFilterProfile
   ListPrepareItem(pNewFilter);
   ListAddTail(&pDpfProfile->FilterList, pNewFilter);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -7053,7 +8120,7 @@ RESULT CamCalibDbGetNoOfFilterProfile
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pDpfProfile->FilterList);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pDpfProfile->FilterList);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7083,7 +8150,7 @@ RESULT CamCalibDbGetFilterProfileByName
   }
 
   /* search scheme by name */
-  *ppFilterProfile = (CamFilterProfile_t*)ListSearch(&pDpfProfile->FilterList, SearchFilterProfileByName, (void*)FilterProfileName);
+  *ppFilterProfile = (CamFilterProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pDpfProfile->FilterList, &FilterProfileByNameKey, (void*)FilterProfileName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7117,7 +8184,7 @@ RESULT CamCalibDbGetFilterProfileByIdx
   }
 
   /* search EC scheme by index */
-  *ppFilterProfile = (CamFilterProfile_t*)ListGetItemByIdx(&pDpfProfile->FilterList, idx);
+  *ppFilterProfile = (CamFilterProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pDpfProfile->FilterList, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7145,6 +8212,8 @@ RESULT CamCalibDbAddNewDsp3DNRSetting
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   if (NULL == pDpfProfile) {
     return (RET_INVALID_PARM);
   }
@@ -7170,6 +8239,8 @@ RESULT CamCalibDbAddNewDsp3DNRSetting
   ListPrepareItem(pNewDsp3dnrSetting);
   ListAddTail(&pDpfProfile->newDsp3DNRProfileList, pNewDsp3dnrSetting);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -7200,7 +8271,7 @@ RESULT CamCalibDbGetNoOfNewDsp3DNRSetting
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pDpfProfile->newDsp3DNRProfileList);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pDpfProfile->newDsp3DNRProfileList);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -7230,7 +8301,7 @@ RESULT CamCalibDbGetNewDsp3DNRSettingByName
   }
 
   /* search scheme by name */
-  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)ListSearch(&pDpfProfile->newDsp3DNRProfileList, SearchNewDsp3DNRSettingByName, (void*)NewDsp3DNRSettingName);
+  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pDpfProfile->newDsp3DNRProfileList, &NewDsp3DNRSettingByNameKey, (void*)NewDsp3DNRSettingName);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -7264,7 +8335,7 @@ RESULT CamCalibDbGetNewDsp3DNRByIdx
   }
 
   /* search EC scheme by index */
-  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)ListGetItemByIdx(&pDpfProfile->newDsp3DNRProfileList, idx);
+  *ppNewDsp3DnrSetting = (CamNewDsp3DNRProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pDpfProfile->newDsp3DNRProfileList, idx);
 
   LOGV( "%s (exit)\n", __func__);
 
@@ -7292,6 +8363,8 @@ RESULT CamCalibDbAddDsp3DNRSetting
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   if (NULL == pDpfProfile) {
     return (RET_INVALID_PARM);
   }
@@ -7317,6 +8390,8 @@ RESULT CamCalibDbAddDsp3DNRSetting
   ListPrepareItem(pNewDsp3dnrSetting);
   ListAddTail(&pDpfProfile->Dsp3DNRSettingProfileList, pNewDsp3dnrSetting);
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -7347,7 +8422,7 @@ RESULT CamCalibDbGetNoOfDsp3DNRSetting
     return (RET_INVALID_PARM);
   }
 
-  *no = (uint32_t)ListNoItems(&pDpfProfile->Dsp3DNRSettingProfileList);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pDpfProfile->Dsp3DNRSettingProfileList);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7379,7 +8454,7 @@ RESULT CamCalibDbGetDsp3DNRSettingByName
   }
 
   /* search scheme by name */
-  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)ListSearch(&pDpfProfile->Dsp3DNRSettingProfileList, SearchDsp3DNRSettingByName, (void*)Dsp3DNRSettingName);
+  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pDpfProfile->Dsp3DNRSettingProfileList, &Dsp3DNRSettingByNameKey, (void*)Dsp3DNRSettingName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7415,7 +8490,7 @@ RESULT CamCalibDbGetDsp3DNRByIdx
   }
 
   /* search EC scheme by index */
-  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)ListGetItemByIdx(&pDpfProfile->Dsp3DNRSettingProfileList, idx);
+  *ppDsp3DnrSetting = (CamDsp3DNRSettingProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pDpfProfile->Dsp3DNRSettingProfileList, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7443,6 +8518,8 @@ RESULT CamCalibDbAddDpccProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateDpccProfile(pAddDpcc);
   if (result != RET_SUCCESS) {
     return (result);
@@ -7460,6 +8537,8 @@ RESULT CamCalibDbAddDpccProfile
     return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -7489,7 +8568,7 @@ RESULT CamCalibDbGetDpccfProfileByName
   }
 
   /* search resolution by name */
-  *pDpccProfile = (CamDpccProfile_t*)ListSearch(&pCamCalibDbCtx->dpcc_profile, SearchDpccProfileByName, (void*)name);
+  *pDpccProfile = (CamDpccProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->dpcc_profile, &DpccProfileByNameKey, (void*)name);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7520,7 +8599,7 @@ RESULT CamCalibDbGetDpccProfileByResolution
   }
 
   /* search resolution by name */
-  *pDpccProfile = (CamDpccProfile_t*)ListSearch(&pCamCalibDbCtx->dpcc_profile, SearchDpccProfileByResolution, (void*)ResName);
+  *pDpccProfile = (CamDpccProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->dpcc_profile, &DpccProfileByResolutionKey, (void*)ResName);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7550,6 +8629,8 @@ RESULT CamCalibDbAddRKsharpenProfile
         return ( RET_WRONG_HANDLE );
     }
 
+    DropCamCalibDbIndex( pCamCalibDbCtx );
+
     result = ValidateIesharpenProfile( pAddIesharpen );
     if ( result != RET_SUCCESS )
     {
@@ -7571,6 +8652,8 @@ RESULT CamCalibDbAddRKsharpenProfile
         return ( RET_INVALID_PARM );
     }
 
+    DropCamCalibDbIndex( pCamCalibDbCtx );
+
     LOGV("%s (exit)\n", __func__);
 
     return ( RET_SUCCESS );
@@ -7603,7 +8686,7 @@ RESULT CamCalibDbGetRKsharpenProfileByName
     }
 
     /* search resolution by name */
-    *pIesharpenProfile = (CamIesharpenProfile_t *)ListSearch( &pCamCalibDbCtx->iesharpen_profile, SearchIesharpenProfileByName, (void *)name );
+    *pIesharpenProfile = (CamIesharpenProfile_t *)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->iesharpen_profile, &IesharpenProfileByNameKey, (void *)name );
 
     LOGV("%s (exit)\n", __func__);
 
@@ -7637,7 +8720,7 @@ RESULT CamCalibDbGetRKsharpenProfileByResolution
     }
 
     /* search resolution by name */
-    *pIesharpenProfile = (CamIesharpenProfile_t *)ListSearch( &pCamCalibDbCtx->iesharpen_profile, SearchIesharpenProfileByResolution, (void *)ResName );
+    *pIesharpenProfile = (CamIesharpenProfile_t *)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->iesharpen_profile, &IesharpenProfileByResolutionKey, (void *)ResName );
 
     LOGV("%s (exit)\n", __func__);
 
@@ -7719,6 +8802,8 @@ RESULT CamCalibDbAddGocProfile
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateGocProfileData(pAddGocProfile);
   if (result != RET_SUCCESS) {
     return (result);
@@ -7739,6 +8824,8 @@ RESULT CamCalibDbAddGocProfile
    return (RET_INVALID_PARM);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -7766,7 +8853,7 @@ RESULT CamCalibDbGetNoOfGocProfile
   }
 
   /* search resolution by name */
-  *no = (uint32_t)ListNoItems(&pCamCalibDbCtx->gocProfile);
+  *no = (uint32_t)GetCamCalibDbIndexNoItems(pCamCalibDbCtx, &pCamCalibDbCtx->gocProfile);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7796,7 +8883,7 @@ RESULT CamCalibDbGetGocProfileByName
    }
 
    /* search resolution by name */
-   *ppGocProfile = (CamCalibGocProfile_t*)ListSearch(&pCamCalibDbCtx->gocProfile, SearchGocProfileByName, (void*)name);
+   *ppGocProfile = (CamCalibGocProfile_t*)SearchCamCalibDbIndex(pCamCalibDbCtx, &pCamCalibDbCtx->gocProfile, &GocProfileByNameKey, (void*)name);
 
    LOGV("%s (exit)\n", __func__);
 
@@ -7826,7 +8913,7 @@ RESULT CamCalibDbGetGocProfileByIdx
   }
 
   /* search resolution by name */
-  *ppGocProfile = (CamCalibGocProfile_t*)ListGetItemByIdx(&pCamCalibDbCtx->gocProfile, idx);
+  *ppGocProfile = (CamCalibGocProfile_t*)GetCamCalibDbIndexItemByIdx(pCamCalibDbCtx, &pCamCalibDbCtx->gocProfile, idx);
 
   LOGV("%s (exit)\n", __func__);
 
@@ -7865,6 +8952,8 @@ RESULT CamCalibDbAddWdrGlobal
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateWdrGlobalData(pAddWdrGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -7884,6 +8973,8 @@ RESULT CamCalibDbAddWdrGlobal
 
   pCamCalibDbCtx->pWdrGlobal = pNewWdrGlobal;
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -7936,6 +9027,8 @@ RESULT CamCalibDbAddCproc
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   /* check if data already exists */
   if (NULL != pCamCalibDbCtx->pCprocGlobal) {
     return (RET_INVALID_PARM);
@@ -7950,6 +9043,8 @@ RESULT CamCalibDbAddCproc
 
   pCamCalibDbCtx->pCprocGlobal = pNewCprocGlobal;
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV("%s (exit)\n", __func__);
 
   return (RET_SUCCESS);
@@ -7998,6 +9093,8 @@ RESULT CamCalibDbAddOTPGlobal
     return (RET_WRONG_HANDLE);
   }
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   result = ValidateOTPGlobalData(pAddOTPGlobal);
   if (result != RET_SUCCESS) {
     return (result);
@@ -8018,6 +9115,8 @@ RESULT CamCalibDbAddOTPGlobal
 
   pCamCalibDbCtx->pOTPGlobal = pNewOTPGlobal;
 
+  DropCamCalibDbIndex(pCamCalibDbCtx);
+
   LOGV( "%s (exit) %d\n", __func__, result);
 
   return (RET_SUCCESS);
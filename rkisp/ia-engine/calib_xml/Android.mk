@@ -5,6 +5,7 @@ LOCAL_SRC_FILES:=\
 				calibdb.cpp\
 				xmltags.cpp\
 				calibtags.cpp\
+				xmlstream.cpp\
 
 LOCAL_C_INCLUDES := \
 				bionic\
@@ -24,6 +25,16 @@ LOCAL_C_INCLUDES += \
 
 endif
 
+ifeq ($(IS_NEED_COMPILE_EXPAT), true)
+LOCAL_C_INCLUDES += \
+    $(LOCAL_PATH)/../../../ext/expat/lib \
+
+else
+LOCAL_C_INCLUDES += \
+    external/expat/lib \
+
+endif
+
 
 LOCAL_CPPFLAGS := -fuse-cxa-atexit -Wall -Wextra -Werror -Wno-unused -Wformat-nonliteral -g -O0 -Wno-error=unused-function 
 
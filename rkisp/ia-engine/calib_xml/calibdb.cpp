@@ -20,6 +20,8 @@
 #include <common/cam_types.h>
 
 #include <cam_calibdb/cam_calibdb_api.h>
+#include <ctype.h>
+#include <stdlib.h>
 #include <string>
 #include <iostream>
 
@@ -130,7 +132,11 @@ static std::ofstream redirectOut("/dev/null");
 		calib_check_tag_mark(cur_tag_id, parent_tag_id); \
 	}
 
+// an xml error ends the visit early, it is logged by the reader already
 #define XML_CHECK_END() \
+	if (m_Reader && m_Reader->Error()) { \
+		return (false); \
+	} \
 	calib_check_nonleaf_tag_end(parent_tag_id);
 
 #define XML_CHECK_CELL_SET_SIZE(size) \
@@ -142,7 +148,12 @@ static std::ofstream redirectOut("/dev/null");
 #define XML_CHECK_TAGID_COMPARE(tag_id) \
 		cur_tag_id == tag_id
 
+// the text of pchild is read up to its first child or end tag, a truncated
+// or broken document is caught there before the tag values are checked
 #define XML_CHECK_WHILE_SUBTAG_MARK(tag_name, type, size) \
+		if (m_Reader && (pchild->GetText(), m_Reader->Error())) { \
+			break; \
+		} \
 		XML_CHECK_SET_CUR_ID(CALIB_IQ_TAG_END); \
 		XML_CHECK_GET_TAG_ID(tag_name); \
 		XML_CHECK_MARK_IF_NEED(type, size);
@@ -197,6 +208,187 @@ static int ParseCharToHex
 }
 
 
+/******************************************************************************
+ * ScanFloat
+ *
+ * Locale free sscanf(str, "%f", value) for the calibration arrays, same bits
+ * as the c library. Decimal numbers of up to 19 significant digits and
+ * small exponents are exact in a double and take the fast path; hex, inf,
+ * nan and longer numbers are handed to sscanf.
+ *****************************************************************************/
+static int ScanFloat
+(
+    const char*  str,
+    float*       value
+) {
+  static const double pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const char* p = str;
+  bool negative = false;
+  bool digit = false;
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+
+  while (isspace((unsigned char)*p)) {
+    p++;
+  }
+  if (*p == '+' || *p == '-') {
+    negative = (*p == '-');
+    p++;
+  }
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    return sscanf(str, "%f", value);
+  }
+
+  for (bool fraction = false; ; p++) {
+    if (*p == '.' && !fraction) {
+      fraction = true;
+      continue;
+    }
+    if (*p < '0' || *p > '9') {
+      break;
+    }
+    digit = true;
+    if (mantissa || *p != '0') {
+      if (digits == 19) {
+        return sscanf(str, "%f", value);
+      }
+      mantissa = mantissa * 10 + (*p - '0');
+      digits++;
+    }
+    if (fraction) {
+      exponent--;
+    }
+  }
+  if (!digit) {
+    return sscanf(str, "%f", value);
+  }
+
+  if (*p == 'e' || *p == 'E') {
+    const char* e = p + 1;
+    bool e_negative = false;
+    int e_value = 0;
+
+    if (*e == '+' || *e == '-') {
+      e_negative = (*e == '-');
+      e++;
+    }
+    if (*e < '0' || *e > '9') {
+      return sscanf(str, "%f", value);
+    }
+    for (; *e >= '0' && *e <= '9'; e++) {
+      if (e_value < 100000) {
+        e_value = e_value * 10 + (*e - '0');
+      }
+    }
+    exponent += e_negative ? -e_value : e_value;
+  }
+
+  if (!mantissa) {
+    *value = negative ? -0.0f : 0.0f;
+    return 1;
+  }
+
+  if (mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+    double d = (double)mantissa;
+    uint64_t bits;
+
+    d = (exponent < 0) ? d / pow10[-exponent] : d * pow10[exponent];
+
+    // a double half way between two floats may be rounded twice the wrong way
+    memcpy(&bits, &d, sizeof(bits));
+    if ((bits & 0x1FFFFFFFULL) != 0x10000000ULL) {
+      *value = negative ? -(float)d : (float)d;
+      return 1;
+    }
+  }
+
+  // no decimal point left, strtof is locale free on it
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%s%llue%d", negative ? "-" : "",
+           (unsigned long long)mantissa, exponent);
+  *value = strtof(buf, NULL);
+
+  return 1;
+}
+
+/******************************************************************************
+ * ScanUint
+ *
+ * sscanf(str, "%u", value) without the format parsing, callers narrow the
+ * result the same way sscanf does for its length modifiers.
+ *****************************************************************************/
+static int ScanUint
+(
+    const char*     str,
+    unsigned long*  value
+) {
+  const char* p = str;
+  bool negative = false;
+  unsigned long v = 0;
+  int digits = 0;
+
+  while (isspace((unsigned char)*p)) {
+    p++;
+  }
+  if (*p == '+' || *p == '-') {
+    negative = (*p == '-');
+    p++;
+  }
+  for (; *p >= '0' && *p <= '9'; p++) {
+    // longer numbers may saturate, depending on the width of long
+    if (++digits > 9) {
+      *value = strtoul(str, NULL, 10);
+      return 1;
+    }
+    v = v * 10 + (*p - '0');
+  }
+  if (!digits) {
+    return 0;
+  }
+
+  *value = negative ? -v : v;
+  return 1;
+}
+
+/******************************************************************************
+ * ScanInt
+ *****************************************************************************/
+static int ScanInt
+(
+    const char*  str,
+    long*        value
+) {
+  const char* p = str;
+
+  while (isspace((unsigned char)*p)) {
+    p++;
+  }
+  if (*p == '+' || *p == '-') {
+    p++;
+  }
+
+  // at most 9 digits never saturate, the sign is applied by ScanUint
+  unsigned long v;
+  int digits = 0;
+  while (p[digits] >= '0' && p[digits] <= '9') {
+    digits++;
+  }
+  if (digits > 9) {
+    *value = strtol(str, NULL, 10);
+    return 1;
+  }
+  if (ScanUint(str, &v) != 1) {
+    return 0;
+  }
+
+  *value = (long)v;
+  return 1;
+}
+
 /******************************************************************************
  * ParseFloatArray
  *****************************************************************************/
@@ -261,7 +453,7 @@ static int ParseFloatArray
 
   /* parse the c-string */
   while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%f", &f);
+    scanned = ScanFloat(str, &f);
     if (scanned != 1) {
       LOGE( "%s(%d): %f err\n", __FUNCTION__,__LINE__,f);
       goto err1;
@@ -360,10 +552,12 @@ static int ParseUintArray
   int cnt = 0;
   int scanned;
   uint32_t f;
+  unsigned long u = 0;
 
   /* parse the c-string */
   while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%u", &f);
+    scanned = ScanUint(str, &u);
+    f = (uint32_t)u;
     if (scanned != 1) {
 	  LOGE( "%s(%d): f:%f error\n", __FUNCTION__, __LINE__, f);
       goto err1;
@@ -459,10 +653,12 @@ static int ParseUcharArray
   int cnt = 0;
   int scanned;
   uint8_t f;
+  unsigned long u = 0;
 
   /* parse the c-string */
   while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hhu", &f);
+    scanned = ScanUint(str, &u);
+    f = (uint8_t)u;
     if (scanned != 1) {
       LOGD( "%s(%d):f:%f\n", __FUNCTION__,__LINE__,f);
       goto err1;
@@ -557,10 +753,12 @@ static int ParseCharArray
   int cnt = 0;
   int scanned;
   int8_t f;
+  long l = 0;
 
   /* parse the c-string */
   while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hhd", &f);
+    scanned = ScanInt(str, &l);
+    f = (int8_t)l;
     if (scanned != 1) {
       redirectOut << __FUNCTION__ << "f" << f << "err" << std::endl;
       goto err1;
@@ -661,10 +859,12 @@ static int ParseUshortArray
   int cnt = 0;
   int scanned;
   uint16_t f;
+  unsigned long u = 0;
 
   /* parse the c-string */
   while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hu", &f);
+    scanned = ScanUint(str, &u);
+    f = (uint16_t)u;
     if (scanned != 1) {
       LOGD( "%s(%d): parse error!\n", __FUNCTION__,__LINE__);
       goto err1;
@@ -763,10 +963,12 @@ static int ParseShortArray
   int cnt = 0;
   int scanned;
   int16_t f;
+  long l = 0;
 
   /* parse the c-string */
   while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hd", &f);
+    scanned = ScanInt(str, &l);
+    f = (int16_t)l;
     if (scanned != 1) {
       LOGE( "%s(%d): parse error!\n", __FUNCTION__,__LINE__);
       goto err1;
@@ -856,10 +1058,12 @@ static int ParseByteArray
   int cnt = 0;
   int scanned;
   uint16_t f;
+  unsigned long u = 0;
 
   /* parse the c-string */
   while ((str != str_last) && (cnt < num)) {
-    scanned = sscanf(str, "%hu", &f);
+    scanned = ScanUint(str, &u);
+    f = (uint16_t)u;
     if (scanned != 1) {
       LOGE( "%s(%d): parse error!\n", __FUNCTION__,__LINE__);
       goto err1;
@@ -1046,6 +1250,7 @@ CalibDb::CalibDb
 (
 ) {
   m_CalibDbHandle = NULL;
+  m_Reader = NULL;
   uint32_t MagicVerCode = calib_check_calc_checksum();
   LOGI("\n***************************************************************\n"
          "  Calibdb Version IS:%s   Magic Version Code IS %u"
@@ -1070,68 +1275,30 @@ CalibDb::~CalibDb() {
 
 
 /******************************************************************************
- * CalibDb::CalibDb
+ * CalibDb::CreateCalibDb
  *****************************************************************************/
 bool CalibDb::CreateCalibDb
 (
     const XMLElement*  root
 ) {
-  bool res = true;
-
-  // create calibration-database (c-code)
-  RESULT result = CamCalibDbCreate(&m_CalibDbHandle);
-  DCT_ASSERT(result == RET_SUCCESS);
-
-#ifdef DEBUG_LOG
-  LOGD( "%s(%d): (enter)\n", __FUNCTION__,__LINE__);
-#endif
-
-  XML_CHECK_START(CALIB_FILESTART_TAG_ID, CALIB_FILESTART_TAG_ID);
-
-  // get and parse header section
-  const XMLElement* header = root->FirstChildElement(TAG_NAME(CALIB_HEADER_TAG_ID));
-  XmlTag tag = XmlTag(header);
-  if (!header) {
-    res = parseEntryHeader(header->ToElement(), NULL);
-    if (!res) {
-      return (res);
-    }
-	XML_CHECK_TOPTAG_MARK(CALIB_HEADER_TAG_ID, tag.Type(), tag.Size());
-
-  }
-
-
-  // get and parse sensor section
-  const XMLElement* sensor = root->FirstChildElement(TAG_NAME(CALIB_SENSOR_TAG_ID));
-  XmlTag tag1 = XmlTag(sensor);
-  if (!sensor) {
-    res = parseEntrySensor(sensor->ToElement(), NULL);
-    if (!res) {
-      return (res);
-    }
-	XML_CHECK_TOPTAG_MARK(CALIB_SENSOR_TAG_ID, tag1.Type(), tag1.Size());
-
-  }
-
-  // get and parse system section
-  const XMLElement* system = root->FirstChildElement(TAG_NAME(CALIB_SYSTEM_TAG_ID));
-  XmlTag tag2 = XmlTag(system);
-  if (!system) {
-    res = parseEntrySystem(system->ToElement(), NULL);
-    if (!res) {
-      return (res);
-    }
-	XML_CHECK_TOPTAG_MARK(CALIB_SYSTEM_TAG_ID, tag2.Type(), tag2.Size());
+  XMLPrinter printer;
+  XmlStreamReader reader;
 
+  // same parser as for files, on the printed element
+  root->Accept(&printer);
+  const XmlStreamNode* proot = reader.OpenBuffer(printer.CStr(), printer.CStrSize() - 1);
+  if (!proot) {
+    return (false);
   }
 
-  XML_CHECK_END();
+  RESULT result = CamCalibDbCreate(&m_CalibDbHandle);
+  DCT_ASSERT(result == RET_SUCCESS);
 
-#ifdef DEBUG_LOG
-  LOGD( "%s(%d): (exit)\n", __FUNCTION__,__LINE__);
-#endif
+  m_Reader = &reader;
+  bool res = parseEntryFile(proot);
+  m_Reader = NULL;
 
-  return (true);
+  return (res);
 }
 
 
@@ -1143,83 +1310,42 @@ bool CalibDb::CreateCalibDb
 (
     const char* device
 ) {
-  //QString errorString;
-  int errorID;
-  XMLDocument doc;
+  XmlStreamReader reader;
 
   bool res = true;
 #ifdef DEBUG_LOG
   LOGD( "%s(%d): (enter)\n", __FUNCTION__,__LINE__);
 #endif
 
+  if (CamCalibDbMapFile(&m_CalibDbHandle, device, m_CalibInfo.IQMagicVerCode) == RET_SUCCESS)
+    return (res);
+
 #ifdef IQDATA_LOAD_SPEEDUP
   if (CamCalibDbLoadFile(&m_CalibDbHandle, device) == RET_SUCCESS)
     return (res);
 #endif
 
-  RESULT result = CamCalibDbCreate(&m_CalibDbHandle);
-  DCT_ASSERT(result == RET_SUCCESS);
-  errorID = doc.LoadFile(device);
+  const XmlStreamNode* proot = reader.OpenFile(device);
 #ifdef DEBUG_LOG
-  LOGD( "%s(%d): doc.LoadFile filename:%s  errorID:%d\n",
-  	 	__FUNCTION__, __LINE__, device, errorID);
-#endif
-  if (doc.Error()) {
-#if 0
-    LOGD( "%s(%d): Error: Parse error errorID %d\n",
-              __FUNCTION__,__LINE__,errorID);
+  LOGD( "%s(%d): reader.OpenFile filename:%s  error:%d\n",
+  	 	__FUNCTION__, __LINE__, device, reader.Error());
 #endif
+  if (!proot) {
     return (false);
   }
-  XMLElement* proot = doc.RootElement();
-  std::string tagname(proot->Name());
-  if (tagname != TAG_NAME(CALIB_FILESTART_TAG_ID)){
-    LOGE( "%s(%d): Error: Not a calibration data file\n");
-    return (false);
-  }
-
-  XML_CHECK_START(CALIB_FILESTART_TAG_ID, CALIB_FILESTART_TAG_ID);
-
-  // parse header section
-  XMLElement* pheader = proot->FirstChildElement(TAG_NAME(CALIB_HEADER_TAG_ID));
-  XmlTag tag = XmlTag(pheader);
-  if (pheader) {
-    res = parseEntryHeader(pheader->ToElement(), NULL);
-    if (!res) {
-	  LOGE( "%s(%d): parse error in Header section\n", __FUNCTION__, __LINE__);
-      return (res);
-    }
-	XML_CHECK_TOPTAG_MARK(CALIB_HEADER_TAG_ID, tag.Type(), tag.Size());
-
-  }
 
-  // parse sensor section
-  XMLElement* psensor = proot->FirstChildElement(TAG_NAME(CALIB_SENSOR_TAG_ID));
-  XmlTag tag1 = XmlTag(psensor);
-  if (psensor) {
-    res = parseEntrySensor(psensor->ToElement(), NULL);
-    if (!res) {
-  	  LOGE( "%s(%d): parse error in Sensor section\n", __FUNCTION__, __LINE__);
-      return (res);
-    }
-	XML_CHECK_TOPTAG_MARK(CALIB_SENSOR_TAG_ID, tag1.Type(), tag1.Size());
+  RESULT result = CamCalibDbCreate(&m_CalibDbHandle);
+  DCT_ASSERT(result == RET_SUCCESS);
 
+  m_Reader = &reader;
+  res = parseEntryFile(proot);
+  m_Reader = NULL;
+  if (!res) {
+    return (res);
   }
 
-  // parse system section
-  XMLElement* psystem = proot->FirstChildElement(TAG_NAME(CALIB_SYSTEM_TAG_ID));
-  XmlTag tag2 = XmlTag(psystem);
-  if (psystem) {
-    res = parseEntrySystem(psystem->ToElement(), NULL);
-    if (!res) {
-  	  LOGE( "%s(%d): parse error in System section\n", __FUNCTION__, __LINE__);
-      return (res);
-    }
-	XML_CHECK_TOPTAG_MARK(CALIB_SYSTEM_TAG_ID, tag2.Type(), tag2.Size());
-
-  }
-
-  XML_CHECK_END();
+  // only if CAMERA_ENGINE_RKISP_XML_DB is set
+  CamCalibDbGenerateMapFile(m_CalibDbHandle, device, m_CalibInfo.IQMagicVerCode);
 
 #ifdef IQDATA_LOAD_SPEEDUP
   CamCalibDbDumpFile(m_CalibDbHandle, device);
@@ -1234,16 +1360,86 @@ bool CalibDb::CreateCalibDb
 
 
 
+/******************************************************************************
+ * CalibDb::parseEntryFile
+ *
+ * The sections are parsed in document order while the reader streams the
+ * file, each of them once.
+ *****************************************************************************/
+bool CalibDb::parseEntryFile
+(
+    const XmlStreamNode*    proot
+) {
+  bool res = true;
+  bool header_done = false;
+  bool sensor_done = false;
+  bool system_done = false;
+
+  if (strcmp(proot->Name(), TAG_NAME(CALIB_FILESTART_TAG_ID))) {
+    LOGE( "%s(%d): Error: Not a calibration data file\n", __FUNCTION__, __LINE__);
+    return (false);
+  }
+
+  XML_CHECK_START(CALIB_FILESTART_TAG_ID, CALIB_FILESTART_TAG_ID);
+
+  const XmlStreamNode* pchild = proot->FirstChild();
+  while (pchild) {
+    XmlTag tag = XmlTag(pchild->ToElement());
+    const char* tagname = pchild->ToElement()->Name();
+
+    if (!header_done && !strcmp(tagname, TAG_NAME(CALIB_HEADER_TAG_ID))) {
+      // parse header section
+      res = parseEntryHeader(pchild->ToElement(), NULL);
+      if (!res) {
+        LOGE( "%s(%d): parse error in Header section\n", __FUNCTION__, __LINE__);
+        return (res);
+      }
+      XML_CHECK_TOPTAG_MARK(CALIB_HEADER_TAG_ID, tag.Type(), tag.Size());
+      header_done = true;
+    } else if (!sensor_done && !strcmp(tagname, TAG_NAME(CALIB_SENSOR_TAG_ID))) {
+      // parse sensor section
+      res = parseEntrySensor(pchild->ToElement(), NULL);
+      if (!res) {
+        LOGE( "%s(%d): parse error in Sensor section\n", __FUNCTION__, __LINE__);
+        return (res);
+      }
+      XML_CHECK_TOPTAG_MARK(CALIB_SENSOR_TAG_ID, tag.Type(), tag.Size());
+      sensor_done = true;
+    } else if (!system_done && !strcmp(tagname, TAG_NAME(CALIB_SYSTEM_TAG_ID))) {
+      // parse system section
+      res = parseEntrySystem(pchild->ToElement(), NULL);
+      if (!res) {
+        LOGE( "%s(%d): parse error in System section\n", __FUNCTION__, __LINE__);
+        return (res);
+      }
+      XML_CHECK_TOPTAG_MARK(CALIB_SYSTEM_TAG_ID, tag.Type(), tag.Size());
+      system_done = true;
+    }
+
+    pchild = pchild->NextSibling();
+  }
+
+  if (m_Reader->Error()) {
+    return (false);
+  }
+
+  XML_CHECK_END();
+
+  return (res);
+}
+
+
 
 /******************************************************************************
  * CalibDb::parseEntryCell  ---- old function not inclue xml check
  *****************************************************************************/
 bool CalibDb::parseEntryCell
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     int                 noElements,
     parseCellContent    func,
-    void*                param
+    void*                param,
+    int*                cells
 ) {
   int cnt = 0;
 
@@ -1251,7 +1447,7 @@ bool CalibDb::parseEntryCell
   LOGD( "%s(%d): (enter)\n", __FUNCTION__,__LINE__);
 #endif
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild && (cnt < noElements)) {
     XmlCellTag tag = XmlCellTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -1272,6 +1468,10 @@ bool CalibDb::parseEntryCell
     cnt ++;
   }
 
+  if (cells) {
+    *cells = cnt;
+  }
+
 #ifdef DEBUG_LOG
   LOGD( "%s(%d): (exit)\n", __FUNCTION__,__LINE__);
 #endif
@@ -1280,8 +1480,8 @@ bool CalibDb::parseEntryCell
 }
 
 bool CalibDb::parseEntryCellForCheck(
-	const XMLElement*   pelement,
 	int                 noElements,
+	int                 cell_size,
 	uint32_t			cur_id,
 	uint32_t	 		parent_id	)
 {
@@ -1289,17 +1489,16 @@ bool CalibDb::parseEntryCellForCheck(
 	  LOGD( "%s(%d): (enter)\n", __FUNCTION__,__LINE__);
 #endif
 
-	int cell_size = 0;
 	CALIB_IQ_TAG_ID_T cur_tag_id = (CALIB_IQ_TAG_ID_T)cur_id;
 	CALIB_IQ_TAG_ID_T parent_tag_id = (CALIB_IQ_TAG_ID_T)parent_id;
-    parseCellNoElement(pelement, noElements, &cell_size);
-    XML_CHECK_CELL_SET_SIZE(cell_size);
 
 	if(cell_size != noElements){
 		LOGD("%s(%d): Warning: parent_tagname:%s tag_name:%s define %d cell, but only use %d cells !!!!\n",
 			__FUNCTION__, __LINE__,
 			TAG_NAME(parent_tag_id), TAG_NAME(cur_tag_id),
 			noElements, cell_size);
+		// the parsed cells are marked already
+		calib_check_cell_set_size(cur_tag_id, parent_tag_id, 0);
   	}
 
 #ifdef DEBUG_LOG
@@ -1310,43 +1509,12 @@ bool CalibDb::parseEntryCellForCheck(
 }
 
 
-/******************************************************************************
- * CalibDb::parseCellNoElement
- *****************************************************************************/
-bool CalibDb::parseCellNoElement
-(
-    const XMLElement*   pelement,
-    int                 noElements,
-    int					*RealNo
-) {
-  int cnt = 0;
-
-#ifdef DEBUG_LOG
-  LOGD( "%s(%d): (enter)\n", __FUNCTION__,__LINE__);
-#endif
-
-  const XMLNode* pchild = pelement->FirstChild();
-  while (pchild && (cnt < noElements)) {
-    pchild = pchild->NextSibling();
-    cnt ++;
-  }
-
-  *RealNo = cnt;
-
-#ifdef DEBUG_LOG
-  LOGD( "%s(%d): (exit)\n", __FUNCTION__,__LINE__);
-#endif
-
-  return true;
-}
-
-
 /******************************************************************************
  * CalibDb::parseEntryCell  ---- new function inclue xml check
  *****************************************************************************/
 bool CalibDb::parseEntryCell
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     int                 noElements,
     parseCellContent    func,
     void*                param,
@@ -1357,9 +1525,15 @@ bool CalibDb::parseEntryCell
 	  LOGD( "%s(%d): (enter)\n", __FUNCTION__,__LINE__);
 #endif
 
-	parseEntryCellForCheck(pelement, noElements, cur_tag_id, parent_tag_id);
+	int cell_size = 0;
 
-	bool res = parseEntryCell(pelement, noElements, func, param);
+	// cells can't be counted ahead in a stream, expect the declared number
+	calib_check_cell_set_size((CALIB_IQ_TAG_ID_T)cur_tag_id, (CALIB_IQ_TAG_ID_T)parent_tag_id, noElements);
+
+	bool res = parseEntryCell(pelement, noElements, func, param, &cell_size);
+	if (res) {
+		parseEntryCellForCheck(noElements, cell_size, cur_tag_id, parent_tag_id);
+	}
 
 #ifdef DEBUG_LOG
 	  LOGD( "%s(%d): (exit)\n", __FUNCTION__,__LINE__);
@@ -1375,7 +1549,7 @@ bool CalibDb::parseEntryCell
  *****************************************************************************/
 bool CalibDb::parseEntryHeader
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -1390,7 +1564,7 @@ bool CalibDb::parseEntryHeader
 
   XML_CHECK_START(CALIB_HEADER_TAG_ID, CALIB_FILESTART_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     const char* value = tag.Value();
@@ -1494,7 +1668,7 @@ bool CalibDb::parseEntryHeader
  *****************************************************************************/
 bool CalibDb::parseEntryResolution
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -1510,7 +1684,7 @@ bool CalibDb::parseEntryResolution
 
   XML_CHECK_START(CALIB_HEADER_RESOLUTION_TAG_ID, CALIB_HEADER_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     const char* value = tag.Value();
@@ -1580,7 +1754,7 @@ bool CalibDb::parseEntryResolution
  *****************************************************************************/
 bool CalibDb::parseEntryFramerates
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -1598,7 +1772,7 @@ bool CalibDb::parseEntryFramerates
 
   XML_CHECK_START(CALIB_HEADER_RESOLUTION_FRATE_TAG_ID, CALIB_HEADER_RESOLUTION_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     const char* value = tag.Value();
@@ -1646,7 +1820,7 @@ bool CalibDb::parseEntryFramerates
  *****************************************************************************/
 bool CalibDb::parseEntrySensor
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -1655,7 +1829,7 @@ bool CalibDb::parseEntrySensor
 
   XML_CHECK_START(CALIB_SENSOR_TAG_ID, CALIB_FILESTART_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -1807,7 +1981,7 @@ bool CalibDb::parseEntrySensor
  *****************************************************************************/
 bool CalibDb::parseEntryAfWin
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param,
     uint32_t       parent_id
 ) {
@@ -1825,7 +1999,7 @@ bool CalibDb::parseEntryAfWin
   	return false;
   }
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -1871,7 +2045,7 @@ bool CalibDb::parseEntryAfWin
  *****************************************************************************/
  bool CalibDb::parseEntryContrastAf
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 
@@ -1887,7 +2061,7 @@ bool CalibDb::parseEntryAfWin
 
   XML_CHECK_START(CALIB_SENSOR_AF_CONTRAST_AF_TAG_ID, CALIB_SENSOR_AF_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -2015,7 +2189,7 @@ bool CalibDb::parseEntryAfWin
 
  bool CalibDb::parseEntryPdaf
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 
@@ -2031,7 +2205,7 @@ bool CalibDb::parseEntryAfWin
 
   XML_CHECK_START(CALIB_SENSOR_AF_PDAF_TAG_ID, CALIB_SENSOR_AF_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -2063,7 +2237,7 @@ bool CalibDb::parseEntryAfWin
 
  bool CalibDb::parseEntryLaserAf
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 
@@ -2079,7 +2253,7 @@ bool CalibDb::parseEntryAfWin
 
   XML_CHECK_START(CALIB_SENSOR_AF_LASER_AF_TAG_ID, CALIB_SENSOR_AF_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -2116,7 +2290,7 @@ bool CalibDb::parseEntryAfWin
 
 bool CalibDb::parseEntryAf
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -2130,7 +2304,7 @@ bool CalibDb::parseEntryAf
 
   XML_CHECK_START(CALIB_SENSOR_AF_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -2187,7 +2361,7 @@ bool CalibDb::parseEntryAf
 
 bool CalibDb::parseEntryAecDON
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2203,7 +2377,7 @@ bool CalibDb::parseEntryAecDON
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_DON_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2249,7 +2423,7 @@ bool CalibDb::parseEntryAecDON
 
 bool CalibDb::parseEntryAecFPSSetConfig
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2266,7 +2440,7 @@ bool CalibDb::parseEntryAecFPSSetConfig
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_FPS_FPS_SET_CONFIG_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2312,7 +2486,7 @@ bool CalibDb::parseEntryAecFPSSetConfig
 
 bool CalibDb::parseEntryAecHist2Hal
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2329,7 +2503,7 @@ bool CalibDb::parseEntryAecHist2Hal
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_HIST_2_HAL_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2367,7 +2541,7 @@ bool CalibDb::parseEntryAecHist2Hal
 
 bool CalibDb::parseEntryAecNLSC
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2384,7 +2558,7 @@ bool CalibDb::parseEntryAecNLSC
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_NLSC_CONFIG_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2447,7 +2621,7 @@ bool CalibDb::parseEntryAecNLSC
 
 bool CalibDb::parseEntryAecIntervalAdjustStrategy
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2464,7 +2638,7 @@ bool CalibDb::parseEntryAecIntervalAdjustStrategy
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_INTERVAL_ADJUST_STRATEGY_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2509,7 +2683,7 @@ bool CalibDb::parseEntryAecIntervalAdjustStrategy
 
 bool CalibDb::parseEntryAecBackLightWeightMethod
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2526,7 +2700,7 @@ bool CalibDb::parseEntryAecBackLightWeightMethod
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_BACKLIGHT_WEIGHT_METHOD_TAG_ID, CALIB_SENSOR_AEC_BACKLIGHT_CONFIG_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2573,7 +2747,7 @@ bool CalibDb::parseEntryAecBackLightWeightMethod
 
 bool CalibDb::parseEntryAecBackLightDarkROIMethod
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2590,7 +2764,7 @@ bool CalibDb::parseEntryAecBackLightDarkROIMethod
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_BACKLIGHT_DARKROI_METHOD_TAG_ID,CALIB_SENSOR_AEC_BACKLIGHT_CONFIG_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2647,7 +2821,7 @@ bool CalibDb::parseEntryAecBackLightDarkROIMethod
 
 bool CalibDb::parseEntryAecBacklight
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2664,7 +2838,7 @@ bool CalibDb::parseEntryAecBacklight
 
 	XML_CHECK_START(CALIB_SENSOR_AEC_BACKLIGHT_CONFIG_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2725,7 +2899,7 @@ bool CalibDb::parseEntryAecBacklight
 
 bool CalibDb::parseEntryAecLockAE
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2741,7 +2915,7 @@ bool CalibDb::parseEntryAecLockAE
 
 	XML_CHECK_START(CALIB_SENSOR_LOCK_AE_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2784,7 +2958,7 @@ bool CalibDb::parseEntryAecLockAE
 
 bool CalibDb::parseEntryAecHdrCtrlLframe
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2801,7 +2975,7 @@ bool CalibDb::parseEntryAecHdrCtrlLframe
 
 	XML_CHECK_START(CALIB_SENSOR_HDRCTRL_LFRAMECTRL_TAG_ID, CALIB_SENSOR_HDRCTRL_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2870,7 +3044,7 @@ bool CalibDb::parseEntryAecHdrCtrlLframe
 
 bool CalibDb::parseEntryAecHdrCtrlSframe
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2886,7 +3060,7 @@ bool CalibDb::parseEntryAecHdrCtrlSframe
 
 	XML_CHECK_START(CALIB_SENSOR_HDRCTRL_SFRAMECTRL_TAG_ID, CALIB_SENSOR_HDRCTRL_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -2937,7 +3111,7 @@ bool CalibDb::parseEntryAecHdrCtrlSframe
 
 bool CalibDb::parseEntryAecHdrCtrl
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -2954,7 +3128,7 @@ bool CalibDb::parseEntryAecHdrCtrl
 
 	XML_CHECK_START(CALIB_SENSOR_HDRCTRL_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -3020,7 +3194,7 @@ bool CalibDb::parseEntryAecHdrCtrl
 
 bool CalibDb::parseEntryAecFlashCtrl
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -3036,7 +3210,7 @@ bool CalibDb::parseEntryAecFlashCtrl
 
 	XML_CHECK_START(CALIB_SENSOR_FLASHCTRL_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -3140,7 +3314,7 @@ bool CalibDb::parseEntryAecFlashCtrl
  *****************************************************************************/
 bool CalibDb::parseEntryAec
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -3156,7 +3330,7 @@ bool CalibDb::parseEntryAec
 
   XML_CHECK_START(CALIB_SENSOR_AEC_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -3452,7 +3626,7 @@ bool CalibDb::parseEntryAec
  *****************************************************************************/
 bool CalibDb::parseEntryAecEcm
 (
-    const XMLElement* plement,
+    const XmlStreamNode* plement,
     void* param
 ) {
   (void)param;
@@ -3467,7 +3641,7 @@ bool CalibDb::parseEntryAecEcm
 
   XML_CHECK_START(CALIB_SENSOR_AEC_ECM_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-  const XMLNode* pchild = plement->FirstChild();
+  const XmlStreamNode* pchild = plement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -3526,7 +3700,7 @@ bool CalibDb::parseEntryAecEcm
  *****************************************************************************/
 bool CalibDb::parseEntryAecEcmPriorityScheme
 (
-    const XMLElement* pelement,
+    const XmlStreamNode* pelement,
     void* param
 ) {
   CamEcmProfile_t* pEcmProfile = (CamEcmProfile_t*)param;
@@ -3543,7 +3717,7 @@ bool CalibDb::parseEntryAecEcmPriorityScheme
 
   XML_CHECK_START(CALIB_SENSOR_AEC_ECM_SCHEMES_TAG_ID, CALIB_SENSOR_AEC_ECM_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -3592,7 +3766,7 @@ bool CalibDb::parseEntryAecEcmPriorityScheme
 
 bool CalibDb::parseAECDySetpoint
 (
-    const XMLElement* plement,
+    const XmlStreamNode* plement,
     void* param
 )
 {
@@ -3617,7 +3791,7 @@ bool CalibDb::parseAECDySetpoint
   int nExpValue = 0;
   int nDysetpoint = 0;
 
-  const XMLNode* pchild = plement->FirstChild();
+  const XmlStreamNode* pchild = plement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -3691,7 +3865,7 @@ bool CalibDb::parseAECDySetpoint
 
 bool CalibDb::parseAECExpSeparate
 (
-    const XMLElement* plement,
+    const XmlStreamNode* plement,
     void* param
 )
 {
@@ -3720,7 +3894,7 @@ bool CalibDb::parseAECExpSeparate
 
   XML_CHECK_START(CALIB_SENSOR_AEC_EXP_SEPARATE_TAG_ID, CALIB_SENSOR_AEC_TAG_ID);
 
-  const XMLNode* pchild = plement->FirstChild();
+  const XmlStreamNode* pchild = plement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -3803,7 +3977,7 @@ bool CalibDb::parseAECExpSeparate
  *****************************************************************************/
 bool CalibDb::parseEntryAwb
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -3815,7 +3989,7 @@ bool CalibDb::parseEntryAwb
 
   XML_CHECK_START(CALIB_SENSOR_AWB_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -3888,7 +4062,7 @@ bool CalibDb::parseEntryAwb
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V10_IIR
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -3904,7 +4078,7 @@ bool CalibDb::parseEntryAwb_V10_IIR
 
     XML_CHECK_START(CALIB_SENSOR_AWB_V10_GLOBALS_IIR_ID, CALIB_SENSOR_AWB_V10_GLOBALS_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
   	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -3966,7 +4140,7 @@ bool CalibDb::parseEntryAwb_V10_IIR
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V11_IIR
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -3982,7 +4156,7 @@ bool CalibDb::parseEntryAwb_V11_IIR
 
     XML_CHECK_START(CALIB_SENSOR_AWB_V10_GLOBALS_IIR_ID, CALIB_SENSOR_AWB_V11_GLOBALS_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
   	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -4041,7 +4215,7 @@ bool CalibDb::parseEntryAwb_V11_IIR
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V10_Para
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 
@@ -4053,7 +4227,7 @@ bool CalibDb::parseEntryAwb_V10_Para
   CAM_AwbVersion_t vName;
   XML_CHECK_START(CALIB_SENSOR_AWB_VERSION_10_TAG_ID, CALIB_SENSOR_AWB_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -4102,7 +4276,7 @@ bool CalibDb::parseEntryAwb_V10_Para
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V11_Para
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 
@@ -4115,7 +4289,7 @@ bool CalibDb::parseEntryAwb_V11_Para
 
   XML_CHECK_START(CALIB_SENSOR_AWB_VERSION_11_TAG_ID, CALIB_SENSOR_AWB_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -4166,7 +4340,7 @@ bool CalibDb::parseEntryAwb_V11_Para
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V11_Globals
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -4224,7 +4398,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V11_GLOBALS_TAG_ID, CALIB_SENSOR_AWB_VERSION_11_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     const char* value = tag.Value();
@@ -4534,7 +4708,7 @@ bool CalibDb::parseEntryAwb_V11_Globals
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V10_Globals
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -4603,7 +4777,7 @@ bool CalibDb::parseEntryAwb_V10_Globals
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V10_GLOBALS_TAG_ID, CALIB_SENSOR_AWB_VERSION_10_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     const char* value = tag.Value();
@@ -4973,7 +5147,7 @@ static void strtrim(char *p, int size)
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V10_IlluminationGMM
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -4989,7 +5163,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationGMM
 
     XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_GMM_TAG_ID, CALIB_SENSOR_AWB_V10_ILLUMINATION_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
   	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -5039,7 +5213,7 @@ return true;
 
 bool CalibDb::parseEntryAwb_V10_IlluminationSat
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -5060,7 +5234,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationSat
 
     XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_SAT_CT_TAG_ID, CALIB_SENSOR_AWB_V10_ILLUMINATION_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
   	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -5119,7 +5293,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationSat
 
 bool CalibDb::parseEntryAwb_V11_IlluminationSat
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -5140,7 +5314,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationSat
 
     XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_SAT_CT_TAG_ID, CALIB_SENSOR_AWB_V11_ILLUMINATION_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
   	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -5196,7 +5370,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationSat
 
 bool CalibDb::parseEntryAwb_V10_IlluminationVig
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -5217,7 +5391,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationVig
 
     XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_VIG_CT_TAG_ID, CALIB_SENSOR_AWB_V10_ILLUMINATION_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
   	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -5274,7 +5448,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationVig
 
 bool CalibDb::parseEntryAwb_V11_IlluminationVig
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -5295,7 +5469,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationVig
 
     XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_VIG_CT_TAG_ID, CALIB_SENSOR_AWB_V11_ILLUMINATION_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
   	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -5354,7 +5528,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationVig
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V10_Illumination
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -5368,7 +5542,7 @@ bool CalibDb::parseEntryAwb_V10_Illumination
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_TAG_ID, CALIB_SENSOR_AWB_VERSION_10_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -5487,7 +5661,7 @@ bool CalibDb::parseEntryAwb_V10_Illumination
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V11_Illumination
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -5501,7 +5675,7 @@ bool CalibDb::parseEntryAwb_V11_Illumination
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V11_ILLUMINATION_TAG_ID, CALIB_SENSOR_AWB_VERSION_11_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -5614,7 +5788,7 @@ bool CalibDb::parseEntryAwb_V11_Illumination
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V10_IlluminationAlsc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 #ifdef DEBUG_LOG
@@ -5627,12 +5801,12 @@ bool CalibDb::parseEntryAwb_V10_IlluminationAlsc
 
   CamAwb_V10_IlluProfile_t* pIllu = (CamAwb_V10_IlluProfile_t*)param;
 
-  char* lsc_profiles;
+  std::string lsc_profiles;
   int resIdx = -1;
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_ALSC_TAG_ID, CALIB_SENSOR_AWB_V10_ILLUMINATION_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -5661,7 +5835,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationAlsc
   XML_CHECK_END();
   DCT_ASSERT(resIdx != -1);
 
-  int no = ParseLscProfileArray(lsc_profiles, pIllu->lsc_profiles[resIdx], CAM_NO_LSC_PROFILES);
+  int no = ParseLscProfileArray(lsc_profiles.c_str(), pIllu->lsc_profiles[resIdx], CAM_NO_LSC_PROFILES);
   DCT_ASSERT((no <= CAM_NO_LSC_PROFILES));
   pIllu->lsc_no[resIdx] = no;
 
@@ -5681,7 +5855,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationAlsc
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V11_IlluminationAlsc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 #ifdef DEBUG_LOG
@@ -5694,12 +5868,12 @@ bool CalibDb::parseEntryAwb_V11_IlluminationAlsc
 
   CamAwb_V11_IlluProfile_t* pIllu = (CamAwb_V11_IlluProfile_t*)param;
 
-  char* lsc_profiles;
+  std::string lsc_profiles;
   int resIdx = -1;
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_ALSC_TAG_ID, CALIB_SENSOR_AWB_V11_ILLUMINATION_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -5729,7 +5903,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationAlsc
 
   DCT_ASSERT(resIdx != -1);
 
-  int no = ParseLscProfileArray(lsc_profiles, pIllu->lsc_profiles[resIdx], CAM_NO_LSC_PROFILES);
+  int no = ParseLscProfileArray(lsc_profiles.c_str(), pIllu->lsc_profiles[resIdx], CAM_NO_LSC_PROFILES);
   DCT_ASSERT((no <= CAM_NO_LSC_PROFILES));
   pIllu->lsc_no[resIdx] = no;
 
@@ -5747,7 +5921,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationAlsc
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V10_IlluminationAcc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -5764,7 +5938,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationAcc
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_ACC_TAG_ID, CALIB_SENSOR_AWB_V10_ILLUMINATION_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -5801,7 +5975,7 @@ bool CalibDb::parseEntryAwb_V10_IlluminationAcc
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_V11_IlluminationAcc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -5818,7 +5992,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationAcc
 
   XML_CHECK_START(CALIB_SENSOR_AWB_V10_ILLUMINATION_ACC_TAG_ID, CALIB_SENSOR_AWB_V11_ILLUMINATION_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -5855,7 +6029,7 @@ bool CalibDb::parseEntryAwb_V11_IlluminationAcc
  *****************************************************************************/
 bool CalibDb::parseEntryAwb_Flash_Para
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ){
     (void)param;
@@ -5867,7 +6041,7 @@ bool CalibDb::parseEntryAwb_Flash_Para
 
     XML_CHECK_START(CALIB_SENSOR_AWB_FLASH_PARA_TAG_ID, CALIB_SENSOR_AWB_TAG_ID);
 
-    const XMLNode* pchild = pelement->FirstChild();
+    const XmlStreamNode* pchild = pelement->FirstChild();
     while (pchild) {
         XmlTag tag = XmlTag(pchild->ToElement());
         std::string tagname(pchild->ToElement()->Name());
@@ -5947,7 +6121,7 @@ bool CalibDb::parseEntryAwb_Flash_Para
  *****************************************************************************/
 bool CalibDb::parseEntryLsc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 #ifdef DEBUG_LOG
@@ -5959,7 +6133,7 @@ bool CalibDb::parseEntryLsc
 
   XML_CHECK_START(CALIB_SENSOR_LSC_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -6053,7 +6227,7 @@ bool CalibDb::parseEntryLsc
  *****************************************************************************/
 bool CalibDb::parseEntryCc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -6067,7 +6241,7 @@ bool CalibDb::parseEntryCc
 
   XML_CHECK_START(CALIB_SENSOR_CC_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -6124,7 +6298,7 @@ bool CalibDb::parseEntryCc
  *****************************************************************************/
 bool CalibDb::parseEntryBls
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -6138,7 +6312,7 @@ bool CalibDb::parseEntryBls
 
   XML_CHECK_START(CALIB_SENSOR_BLS_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -6187,7 +6361,7 @@ bool CalibDb::parseEntryBls
  *****************************************************************************/
 bool CalibDb::parseEntryCac
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -6201,7 +6375,7 @@ bool CalibDb::parseEntryCac
 
   XML_CHECK_START(CALIB_SENSOR_CAC_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -6266,7 +6440,7 @@ bool CalibDb::parseEntryCac
 
 bool CalibDb::parseEntryFilterDemosiacTH
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -6288,7 +6462,7 @@ bool CalibDb::parseEntryFilterDemosiacTH
 
   	XML_CHECK_START(CALIB_SENSOR_DPF_FILT_DEMOSAIC_TH_CONF_TAG_ID, CALIB_SENSOR_DPF_FILTERSETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -6348,7 +6522,7 @@ bool CalibDb::parseEntryFilterDemosiacTH
 
 bool CalibDb::parseEntryFilterSharpLevel
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -6370,7 +6544,7 @@ bool CalibDb::parseEntryFilterSharpLevel
 
   	XML_CHECK_START(CALIB_SENSOR_DPF_SHARPENINGLEVEL_TAG_ID, CALIB_SENSOR_DPF_FILTERSETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -6434,7 +6608,7 @@ bool CalibDb::parseEntryFilterSharpLevel
 
 bool CalibDb::parseEntryFilterDenoiseLevel
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -6456,7 +6630,7 @@ bool CalibDb::parseEntryFilterDenoiseLevel
 
   	XML_CHECK_START(CALIB_SENSOR_DPF_DENOISELEVEL_TAG_ID, CALIB_SENSOR_DPF_FILTERSETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -6518,7 +6692,7 @@ bool CalibDb::parseEntryFilterDenoiseLevel
 
 bool CalibDb::parseEntryFilterRegConfig
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -6535,7 +6709,7 @@ bool CalibDb::parseEntryFilterRegConfig
 
   	XML_CHECK_START(CALIB_SENSOR_DPF_FILT_LEVEL_REG_CONF_TAG_ID, CALIB_SENSOR_DPF_FILTERSETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
@@ -6808,7 +6982,7 @@ bool CalibDb::parseEntryFilterRegConfig
 
 bool CalibDb::parseEntryFilter
 (
-    const XMLElement* plement,
+    const XmlStreamNode* plement,
     void* param
 )
 {
@@ -6830,7 +7004,7 @@ bool CalibDb::parseEntryFilter
 
   XML_CHECK_START(CALIB_SENSOR_DPF_FILTERSETTING_TAG_ID, CALIB_SENSOR_DPF_TAG_ID);
 
-  const XMLNode* pchild = plement->FirstChild();
+  const XmlStreamNode* pchild = plement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -6904,7 +7078,7 @@ bool CalibDb::parseEntryFilter
 
 bool CalibDb::parseEntryNew3DnrYnr
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -6923,7 +7097,7 @@ bool CalibDb::parseEntryNew3DnrYnr
 
   	XML_CHECK_START(CALIB_SENSOR_NEW_DSP_3DNR_SETTING_YNR_SETTING_TAG_ID, CALIB_SENSOR_NEW_DSP_3DNR_SETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -6988,7 +7162,7 @@ bool CalibDb::parseEntryNew3DnrYnr
 
 bool CalibDb::parseEntryNew3DnrUVnr
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -7006,7 +7180,7 @@ bool CalibDb::parseEntryNew3DnrUVnr
 
   	XML_CHECK_START(CALIB_SENSOR_NEW_DSP_3DNR_SETTING_UVNR_SETTING_TAG_ID, CALIB_SENSOR_NEW_DSP_3DNR_SETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -7054,7 +7228,7 @@ bool CalibDb::parseEntryNew3DnrUVnr
 
 bool CalibDb::parseEntryNew3DnrSharp
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -7073,7 +7247,7 @@ bool CalibDb::parseEntryNew3DnrSharp
 
   	XML_CHECK_START(CALIB_SENSOR_NEW_DSP_3DNR_SETTING_SHARP_SETTING_TAG_ID, CALIB_SENSOR_NEW_DSP_3DNR_SETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -7121,7 +7295,7 @@ bool CalibDb::parseEntryNew3DnrSharp
 
 bool CalibDb::parseEntryNew3DNR
 (
-    const XMLElement* plement,
+    const XmlStreamNode* plement,
     void* param
 )
 {
@@ -7150,7 +7324,7 @@ bool CalibDb::parseEntryNew3DNR
 
   XML_CHECK_START(CALIB_SENSOR_NEW_DSP_3DNR_SETTING_TAG_ID, CALIB_SENSOR_DPF_TAG_ID);
 
-  const XMLNode* pchild = plement->FirstChild();
+  const XmlStreamNode* pchild = plement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -7237,7 +7411,7 @@ bool CalibDb::parseEntryNew3DNR
 
 bool CalibDb::parseEntry3DnrLevel
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -7259,7 +7433,7 @@ bool CalibDb::parseEntry3DnrLevel
 
   	XML_CHECK_START(CALIB_SENSOR_DSP_3DNR_SETTING_LEVEL_SETTING_TAG_ID, CALIB_SENSOR_DSP_3DNR_SETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -7366,7 +7540,7 @@ bool CalibDb::parseEntry3DnrLevel
 
 bool CalibDb::parseEntry3DnrLuma
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -7387,7 +7561,7 @@ bool CalibDb::parseEntry3DnrLuma
 
   	XML_CHECK_START(CALIB_SENSOR_DSP_3DNR_SETTING_LUMA_SETTING_TAG_ID, CALIB_SENSOR_DSP_3DNR_SETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -7471,7 +7645,7 @@ bool CalibDb::parseEntry3DnrLuma
 
 bool CalibDb::parseEntry3DnrChrm
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -7492,7 +7666,7 @@ bool CalibDb::parseEntry3DnrChrm
 
   	XML_CHECK_START(CALIB_SENSOR_DSP_3DNR_SETTING_CHRM_SETTING_TAG_ID, CALIB_SENSOR_DSP_3DNR_SETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -7577,7 +7751,7 @@ bool CalibDb::parseEntry3DnrChrm
 
 bool CalibDb::parseEntry3DnrSharp
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -7600,7 +7774,7 @@ bool CalibDb::parseEntry3DnrSharp
 
   	XML_CHECK_START(CALIB_SENSOR_DSP_3DNR_SETTING_SHP_SETTING_TAG_ID, CALIB_SENSOR_DSP_3DNR_SETTING_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -7708,7 +7882,7 @@ bool CalibDb::parseEntry3DnrSharp
 
 bool CalibDb::parseEntry3DNR
 (
-    const XMLElement* plement,
+    const XmlStreamNode* plement,
     void* param
 )
 {
@@ -7738,7 +7912,7 @@ bool CalibDb::parseEntry3DNR
 
   XML_CHECK_START(CALIB_SENSOR_DSP_3DNR_SETTING_TAG_ID, CALIB_SENSOR_DPF_TAG_ID);
 
-  const XMLNode* pchild = plement->FirstChild();
+  const XmlStreamNode* pchild = plement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -7845,7 +8019,7 @@ bool CalibDb::parseEntry3DNR
 
 bool CalibDb::parseEntryDemosaicLPConfig
 (
-    const XMLElement* plement,
+    const XmlStreamNode* plement,
     void* param
 )
 {
@@ -7904,7 +8078,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
 
     XML_CHECK_START(CALIB_SENSOR_DPF_DEMOSAIC_LP_CONF_TAG_ID, CALIB_SENSOR_DPF_FILTERSETTING_TAG_ID);
 
-	const XMLNode* pchild = plement->FirstChild();
+	const XmlStreamNode* pchild = plement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -8478,7 +8652,7 @@ bool CalibDb::parseEntryDemosaicLPConfig
  *****************************************************************************/
 bool CalibDb::parseEntryDpf
 (
-    const XMLElement*  pelement,
+    const XmlStreamNode*  pelement,
     void*                param
 ) {
   (void)param;
@@ -8494,7 +8668,7 @@ bool CalibDb::parseEntryDpf
 
   XML_CHECK_START(CALIB_SENSOR_DPF_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -8643,7 +8817,7 @@ bool CalibDb::parseEntryDpf
  *****************************************************************************/
 bool CalibDb::parseEntryDpcc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -8657,7 +8831,7 @@ bool CalibDb::parseEntryDpcc
 
   XML_CHECK_START(CALIB_SENSOR_DPCC_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -8711,7 +8885,7 @@ bool CalibDb::parseEntryDpcc
  *****************************************************************************/
 bool CalibDb::parseEntryDpccRegisters
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -8722,12 +8896,12 @@ bool CalibDb::parseEntryDpccRegisters
 
   CamDpccProfile_t* pDpcc_profile = (CamDpccProfile_t*)param;
 
-  char*     reg_name;
+  std::string s_regname;
   uint32_t    reg_value = 0U;
 
   XML_CHECK_START(CALIB_SENSOR_DPCC_REGISTER_TAG_ID, CALIB_SENSOR_DPCC_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -8738,7 +8912,7 @@ bool CalibDb::parseEntryDpccRegisters
 #endif
 
     if (XML_CHECK_TAGID_COMPARE(CALIB_SENSOR_DPCC_REGISTER_NAME_TAG_ID)){
-      reg_name = Toupper(tag.Value());
+      s_regname = Toupper(tag.Value());
     } else if (XML_CHECK_TAGID_COMPARE(CALIB_SENSOR_DPCC_REGISTER_VALUE_TAG_ID)){
       bool ok;
 
@@ -8761,7 +8935,6 @@ bool CalibDb::parseEntryDpccRegisters
   }
   XML_CHECK_END();
 
-  std::string s_regname(reg_name);
 
   if (s_regname == CALIB_SENSOR_DPCC_REGISTER_ISP_DPCC_MODE) {
     pDpcc_profile->isp_dpcc_mode = reg_value;
@@ -8832,7 +9005,7 @@ bool CalibDb::parseEntryDpccRegisters
  *****************************************************************************/
 bool CalibDb::parseEntryGoc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -8849,7 +9022,7 @@ bool CalibDb::parseEntryGoc
 
   XML_CHECK_START(CALIB_SENSOR_GOC_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -8899,7 +9072,7 @@ bool CalibDb::parseEntryGoc
 
 bool CalibDb::parseEntryWdrMaxGain
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -8921,7 +9094,7 @@ bool CalibDb::parseEntryWdrMaxGain
 
 	XML_CHECK_START(CALIB_SENSOR_WDR_MAXGAIN_FILTER_TAG_ID, CALIB_SENSOR_WDR_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -8995,7 +9168,7 @@ bool CalibDb::parseEntryWdrMaxGain
  *****************************************************************************/
 bool CalibDb::parseEntryWdr
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -9010,7 +9183,7 @@ bool CalibDb::parseEntryWdr
 
   XML_CHECK_START(CALIB_SENSOR_WDR_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -9140,7 +9313,7 @@ bool CalibDb::parseEntryWdr
 
 bool CalibDb::parseEntryRKsharpen
 (
-  const XMLElement *pelement,
+  const XmlStreamNode *pelement,
   void *param
 )
 {
@@ -9155,7 +9328,7 @@ bool CalibDb::parseEntryRKsharpen
 
     XML_CHECK_START(CALIB_SENSOR_IESHARPEN_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-    const XMLNode *pchild = pelement->FirstChild();
+    const XmlStreamNode *pchild = pelement->FirstChild();
     while(pchild)
     {
         XmlTag tag = XmlTag(pchild->ToElement());
@@ -9479,7 +9652,7 @@ bool CalibDb::parseEntryRKsharpen
 
 bool CalibDb::parseEntrySystemAfps
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -9495,7 +9668,7 @@ bool CalibDb::parseEntrySystemAfps
 
 	XML_CHECK_START(CALIB_SYSTEM_AFPS_TAG_ID, CALIB_SYSTEM_TAG_ID);
 
-	const XMLNode* pchild = pelement->FirstChild();
+	const XmlStreamNode* pchild = pelement->FirstChild();
 	while (pchild) {
 		XmlTag tag = XmlTag(pchild->ToElement());
 		std::string tagname(pchild->ToElement()->Name());
@@ -9537,7 +9710,7 @@ bool CalibDb::parseEntrySystemAfps
  *****************************************************************************/
 bool CalibDb::parseEntrySystem
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
   (void)param;
@@ -9551,7 +9724,7 @@ bool CalibDb::parseEntrySystem
 
   XML_CHECK_START(CALIB_SYSTEM_TAG_ID, CALIB_FILESTART_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     const char* value = tag.Value();
@@ -9595,7 +9768,7 @@ bool CalibDb::parseEntrySystem
  *****************************************************************************/
 bool CalibDb::parseEntryCproc
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 ) {
 #ifdef DEBUG_LOG
@@ -9608,7 +9781,7 @@ bool CalibDb::parseEntryCproc
 
   XML_CHECK_START(CALIB_SENSOR_CPROC_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -9668,7 +9841,7 @@ bool CalibDb::parseEntryCproc
  *****************************************************************************/
 bool CalibDb::parseEntryOTP
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     void*                param
 )
 {
@@ -9681,7 +9854,7 @@ bool CalibDb::parseEntryOTP
 
   XML_CHECK_START(CALIB_SENSOR_OTP_TAG_ID, CALIB_SENSOR_TAG_ID);
 
-  const XMLNode* pchild = pelement->FirstChild();
+  const XmlStreamNode* pchild = pelement->FirstChild();
   while (pchild) {
     XmlTag tag = XmlTag(pchild->ToElement());
     std::string tagname(pchild->ToElement()->Name());
@@ -15,6 +15,7 @@
  *****************************************************************************/
 
 #include "calibtags.h"
+#include <string.h>
 #include <ebase/dct_assert.h>
 #include <base/xcam_log.h>
 
@@ -29,6 +29,9 @@
 
 using namespace tinyxml2;
 
+class XmlStreamNode;
+class XmlStreamReader;
+
 struct sensor_calib_info {
   CamCalibDbMetaData_t meta_data;
   CamResolution_t resolution;
@@ -81,23 +84,18 @@ class CalibDb {
 
  private:
 
-  typedef bool (CalibDb::*parseCellContent)(const XMLElement*, void* param);
+  typedef bool (CalibDb::*parseCellContent)(const XmlStreamNode*, void* param);
 
-  bool parseCellNoElement(
-    const XMLElement*   pelement,
-    int                 noElements,
-    int					*RealNo
-  ) ;
-  // parse helper
-  bool parseEntryCell(const XMLElement*, int, parseCellContent, void* param = NULL);
+// parse helper
+  bool parseEntryCell(const XmlStreamNode*, int, parseCellContent, void* param = NULL, int* cells = NULL);
   bool parseEntryCellForCheck(
-	const XMLElement*   pelement,
 	int                 noElements,
+	int                 cell_size,
 	uint32_t			cur_id,
 	uint32_t	 parent_id	);
   bool parseEntryCell
 (
-    const XMLElement*   pelement,
+    const XmlStreamNode*   pelement,
     int                 noElements,
     parseCellContent    func,
     void*                param,
@@ -105,125 +103,125 @@ class CalibDb {
     uint32_t	 parent_id			
 );
 
+  // parse the root element in document order
+  bool parseEntryFile(const XmlStreamNode*);
+
   // parse Header
-  bool parseEntryHeader(const XMLElement*, void* param = NULL);
-  bool parseEntryResolution(const XMLElement*, void* param = NULL);
+  bool parseEntryHeader(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryResolution(const XmlStreamNode*, void* param = NULL);
 
-  bool parseEntryFramerates(const XMLElement*, void* param = NULL);
+  bool parseEntryFramerates(const XmlStreamNode*, void* param = NULL);
 
   // parse Sensor
-  bool parseEntrySensor(const XMLElement*, void* param = NULL);
+  bool parseEntrySensor(const XmlStreamNode*, void* param = NULL);
 
   // parse Sensor-AWB
-  bool parseEntryAwb_V10_IIR( const XMLElement*, void *param = NULL );
-  bool parseEntryAwb_V11_IIR( const XMLElement*, void *param = NULL );
-  bool parseEntryAwb(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V11_Para(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V10_Para(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V11_Globals(const XMLElement*, void* param = NULL);  
-  bool parseEntryAwb_V10_Globals(const XMLElement*, void* param = NULL);
+  bool parseEntryAwb_V10_IIR( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAwb_V11_IIR( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAwb(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V11_Para(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V10_Para(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V11_Globals(const XmlStreamNode*, void* param = NULL);  
+  bool parseEntryAwb_V10_Globals(const XmlStreamNode*, void* param = NULL);
   
-  bool parseEntryAwb_V10_IlluminationGMM(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V10_IlluminationSat(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V11_IlluminationSat(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V10_IlluminationVig(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V11_IlluminationVig(const XMLElement*, void* param = NULL);
+  bool parseEntryAwb_V10_IlluminationGMM(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V10_IlluminationSat(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V11_IlluminationSat(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V10_IlluminationVig(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V11_IlluminationVig(const XmlStreamNode*, void* param = NULL);
   
-  bool parseEntryAwb_V11_Illumination(const XMLElement*, void* param = NULL);
+  bool parseEntryAwb_V11_Illumination(const XmlStreamNode*, void* param = NULL);
   
-  bool parseEntryAwb_V10_Illumination(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V11_IlluminationAlsc(const XMLElement*, void* param = NULL);
+  bool parseEntryAwb_V10_Illumination(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V11_IlluminationAlsc(const XmlStreamNode*, void* param = NULL);
   
-  bool parseEntryAwb_V10_IlluminationAlsc(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_V11_IlluminationAcc(const XMLElement*, void* param = NULL);
+  bool parseEntryAwb_V10_IlluminationAlsc(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_V11_IlluminationAcc(const XmlStreamNode*, void* param = NULL);
   
-  bool parseEntryAwb_V10_IlluminationAcc(const XMLElement*, void* param = NULL);
-  bool parseEntryAwb_Flash_Para(const XMLElement*, void* param = NULL);
-  bool parseEntryAfWin( const XMLElement*, void *param = NULL, uint32_t parent_id = 0);
-  bool parseEntryContrastAf( const XMLElement*, void *param = NULL );
-  bool parseEntryLaserAf( const XMLElement*, void *param = NULL );
-  bool parseEntryPdaf( const XMLElement*, void *param = NULL );
-  bool parseEntryAf( const XMLElement*, void *param = NULL );
+  bool parseEntryAwb_V10_IlluminationAcc(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAwb_Flash_Para(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAfWin( const XmlStreamNode*, void *param = NULL, uint32_t parent_id = 0);
+  bool parseEntryContrastAf( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryLaserAf( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryPdaf( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAf( const XmlStreamNode*, void *param = NULL );
   // parse Sensor-AEC
-  bool parseEntryAecDON( const XMLElement*, void *param = NULL );
-  bool parseEntryAecFPSSetConfig( const XMLElement*, void *param = NULL );
-  bool parseEntryAecHist2Hal( const XMLElement*, void *param = NULL );
-  bool parseEntryAecNLSC( const XMLElement*, void *param = NULL );
-  bool parseEntryAecIntervalAdjustStrategy( const XMLElement*, void *param = NULL );
-  bool parseEntryAecBackLightWeightMethod( const XMLElement*, void *param = NULL );
-  bool parseEntryAecBackLightDarkROIMethod( const XMLElement*, void *param = NULL );
-  bool parseEntryAecBacklight( const XMLElement*, void *param = NULL );
-  bool parseEntryAecLockAE( const XMLElement*, void *param = NULL );
-  bool parseEntryAecHdrCtrlLframe( const XMLElement*, void *param = NULL );
-  bool parseEntryAecHdrCtrlSframe( const XMLElement*, void *param = NULL );
-  bool parseEntryAecHdrCtrl( const XMLElement*, void *param = NULL );
-  bool parseEntryAecFlashCtrl( const XMLElement*, void *param = NULL );
-  bool parseEntryAec(const XMLElement*, void* param = NULL);
-  bool parseEntryAecEcm(const XMLElement*, void* param = NULL);
-  bool parseEntryAecEcmPriorityScheme(const XMLElement*, void* param = NULL);
-  bool parseAECDySetpoint(const XMLElement*, void* param = NULL);
-  bool parseAECExpSeparate(const XMLElement*, void* param = NULL);
+  bool parseEntryAecDON( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecFPSSetConfig( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecHist2Hal( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecNLSC( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecIntervalAdjustStrategy( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecBackLightWeightMethod( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecBackLightDarkROIMethod( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecBacklight( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecLockAE( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecHdrCtrlLframe( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecHdrCtrlSframe( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecHdrCtrl( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAecFlashCtrl( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryAec(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAecEcm(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryAecEcmPriorityScheme(const XmlStreamNode*, void* param = NULL);
+  bool parseAECDySetpoint(const XmlStreamNode*, void* param = NULL);
+  bool parseAECExpSeparate(const XmlStreamNode*, void* param = NULL);
 
   // parse Sensor-LSC
-  bool parseEntryLsc(const XMLElement*, void* param = NULL);
+  bool parseEntryLsc(const XmlStreamNode*, void* param = NULL);
 
   // parse Sensor-CC
-  bool parseEntryCc(const XMLElement*, void* param = NULL);
+  bool parseEntryCc(const XmlStreamNode*, void* param = NULL);
 
   // parse Sensor-BLS
-  bool parseEntryBls(const XMLElement*, void* param = NULL);
+  bool parseEntryBls(const XmlStreamNode*, void* param = NULL);
 
   // parse Sensor-CAC
-  bool parseEntryCac(const XMLElement*, void* param = NULL);
+  bool parseEntryCac(const XmlStreamNode*, void* param = NULL);
 
-  bool parseEntryFilter(const XMLElement* plement, void* param = NULL);
-  bool parseEntryFilterDemosiacTH(const XMLElement* plement, void* param = NULL);
-  bool parseEntryFilterSharpLevel(const XMLElement* plement, void* param = NULL);
-  bool parseEntryFilterDenoiseLevel(const XMLElement* plement, void* param = NULL);
-  bool parseEntryFilterRegConfig(const XMLElement* plement, void* param = NULL);
+  bool parseEntryFilter(const XmlStreamNode* plement, void* param = NULL);
+  bool parseEntryFilterDemosiacTH(const XmlStreamNode* plement, void* param = NULL);
+  bool parseEntryFilterSharpLevel(const XmlStreamNode* plement, void* param = NULL);
+  bool parseEntryFilterDenoiseLevel(const XmlStreamNode* plement, void* param = NULL);
+  bool parseEntryFilterRegConfig(const XmlStreamNode* plement, void* param = NULL);
 
   // parse Sensor-3dnr
-  bool parseEntry3DnrLevel(const XMLElement* plement, void* param = NULL) ;
-  bool parseEntry3DnrLuma(const XMLElement* plement, void* param = NULL) ;
-  bool parseEntry3DnrChrm(const XMLElement* plement, void* param = NULL) ;
-  bool parseEntry3DnrSharp(const XMLElement* plement, void* param = NULL) ;
-  bool parseEntry3DNR(const XMLElement* , void* param = NULL);
+  bool parseEntry3DnrLevel(const XmlStreamNode* plement, void* param = NULL) ;
+  bool parseEntry3DnrLuma(const XmlStreamNode* plement, void* param = NULL) ;
+  bool parseEntry3DnrChrm(const XmlStreamNode* plement, void* param = NULL) ;
+  bool parseEntry3DnrSharp(const XmlStreamNode* plement, void* param = NULL) ;
+  bool parseEntry3DNR(const XmlStreamNode* , void* param = NULL);
   
   //parse new 3dnr
   
-  bool parseEntryNew3DnrYnr(const XMLElement* , void* param = NULL);
-  bool parseEntryNew3DnrUVnr(const XMLElement* , void* param = NULL);
-  bool parseEntryNew3DnrSharp(const XMLElement* , void* param = NULL);
-  bool parseEntryNew3DNR(const XMLElement* plement, void* param = NULL) ;
+  bool parseEntryNew3DnrYnr(const XmlStreamNode* , void* param = NULL);
+  bool parseEntryNew3DnrUVnr(const XmlStreamNode* , void* param = NULL);
+  bool parseEntryNew3DnrSharp(const XmlStreamNode* , void* param = NULL);
+  bool parseEntryNew3DNR(const XmlStreamNode* plement, void* param = NULL) ;
 
-  bool parseEntryDemosaicLPConfig(const XMLElement* plement, void* param = NULL); 
+  bool parseEntryDemosaicLPConfig(const XmlStreamNode* plement, void* param = NULL); 
   
   // parse Sensor-DPF
-  bool parseEntryDpf(const XMLElement*, void* param = NULL);
+  bool parseEntryDpf(const XmlStreamNode*, void* param = NULL);
 
   // parse Sensor-DPCC
-  bool parseEntryDpcc(const XMLElement*, void* param = NULL);
-  bool parseEntryDpccRegisters(const XMLElement*, void* param = NULL);
+  bool parseEntryDpcc(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryDpccRegisters(const XmlStreamNode*, void* param = NULL);
   // parse Sensor-GOC
-  bool parseEntryGoc(const XMLElement*, void* param = NULL);
+  bool parseEntryGoc(const XmlStreamNode*, void* param = NULL);
   // parse Sensor-WDR
-  bool parseEntryWdrMaxGain(const XMLElement*, void* param = NULL);
-  bool parseEntryWdr(const XMLElement*, void* param = NULL);
+  bool parseEntryWdrMaxGain(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryWdr(const XmlStreamNode*, void* param = NULL);
   // parse System
-  bool parseEntrySystem(const XMLElement*, void* param = NULL);
-  bool parseEntrySystemAfps( const XMLElement*, void *param = NULL );
+  bool parseEntrySystem(const XmlStreamNode*, void* param = NULL);
+  bool parseEntrySystemAfps( const XmlStreamNode*, void *param = NULL );
   // parse cproc
-  bool parseEntryCproc(const XMLElement*, void* param = NULL);
-  bool parseEntryRKsharpen( const XMLElement*, void *param = NULL );
-  bool parseEntryOTP(const XMLElement*, void* param = NULL); 
-
-  void characterDataHandler(void* userData, const char* s, int len);
-
-  void startElementHandler(void* userData, const char* name, const char** atts);
+  bool parseEntryCproc(const XmlStreamNode*, void* param = NULL);
+  bool parseEntryRKsharpen( const XmlStreamNode*, void *param = NULL );
+  bool parseEntryOTP(const XmlStreamNode*, void* param = NULL); 
 
  private:
 
   CamCalibDbHandle_t  m_CalibDbHandle;
+  const XmlStreamReader* m_Reader;   /**< of the running parse */
   struct sensor_calib_info m_CalibInfo;
 };
 
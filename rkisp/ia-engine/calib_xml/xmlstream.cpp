@@ -0,0 +1,500 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd. All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file        xmlstream.cpp
+ *
+ *****************************************************************************/
+
+#include "xmlstream.h"
+#include <string.h>
+#include <base/xcam_log.h>
+
+/* input bytes parsed at once, bounds the number of queued events */
+#define XML_STREAM_CHUNK_SIZE   4096
+
+
+/******************************************************************************
+ * XmlStreamNode::XmlStreamNode
+ *****************************************************************************/
+XmlStreamNode::XmlStreamNode()
+    : m_Reader( NULL )
+    , m_Depth( 0 )
+    , m_Open( false )
+    , m_Children( 0 )
+    , m_Visited( 0 )
+{
+}
+
+
+
+/******************************************************************************
+ * XmlStreamNode::FirstChild
+ *****************************************************************************/
+const XmlStreamNode* XmlStreamNode::FirstChild() const
+{
+    XmlStreamNode* self = const_cast<XmlStreamNode*>( this );
+
+    if ( m_Visited )
+    {
+        LOGE( "%s(%d): children of <%s> visited twice\n", __FUNCTION__, __LINE__, Name() );
+        return ( NULL );
+    }
+
+    while ( m_Open && !m_Children )
+    {
+        if ( !m_Reader->Advance() )
+        {
+            return ( NULL );
+        }
+    }
+
+    if ( !m_Children )
+    {
+        return ( NULL );
+    }
+
+    self->m_Visited = 1;
+    return ( &m_Reader->m_Nodes[m_Depth + 1] );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamNode::NextSibling
+ *****************************************************************************/
+const XmlStreamNode* XmlStreamNode::NextSibling() const
+{
+    if ( m_Depth == 0 )
+    {
+        return ( NULL );
+    }
+
+    XmlStreamNode* parent = &m_Reader->m_Nodes[m_Depth - 1];
+
+    // skip what is left of this node
+    while ( m_Open )
+    {
+        if ( !m_Reader->Advance() )
+        {
+            return ( NULL );
+        }
+    }
+
+    while ( parent->m_Open && parent->m_Children == parent->m_Visited )
+    {
+        if ( !m_Reader->Advance() )
+        {
+            return ( NULL );
+        }
+    }
+
+    if ( parent->m_Children == parent->m_Visited )
+    {
+        return ( NULL );
+    }
+
+    parent->m_Visited++;
+    return ( this );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamNode::Attribute
+ *****************************************************************************/
+const char* XmlStreamNode::Attribute( const char* name ) const
+{
+    const char* attr = m_Attrs.c_str();
+    const char* end = attr + m_Attrs.size();
+
+    while ( attr < end )
+    {
+        const char* value = attr + strlen( attr ) + 1;
+        if ( !strcmp( attr, name ) )
+        {
+            return ( value );
+        }
+        attr = value + strlen( value ) + 1;
+    }
+
+    return ( NULL );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamNode::GetText
+ *****************************************************************************/
+const char* XmlStreamNode::GetText() const
+{
+    while ( m_Open && !m_Children )
+    {
+        if ( !m_Reader->Advance() )
+        {
+            break;
+        }
+    }
+
+    // white space only text is dropped by tinyxml2 as well
+    size_t pos = m_Text.find_first_not_of( " \t\n\r\v\f" );
+    if ( pos == std::string::npos )
+    {
+        return ( NULL );
+    }
+
+    // callers trim the text in place
+    return ( &const_cast<XmlStreamNode*>( this )->m_Text[0] );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::XmlStreamReader
+ *****************************************************************************/
+XmlStreamReader::XmlStreamReader()
+    : m_Parser( NULL )
+    , m_File( NULL )
+    , m_Buffer( NULL )
+    , m_BufferLen( 0 )
+    , m_Final( false )
+    , m_Error( false )
+    , m_EventCount( 0 )
+    , m_EventHead( 0 )
+    , m_ParseHasChild( false )
+    , m_Depth( 0 )
+{
+    for ( int i = 0; i < XML_STREAM_MAX_DEPTH; i++ )
+    {
+        m_Nodes[i].m_Reader = this;
+        m_Nodes[i].m_Depth = i;
+    }
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::~XmlStreamReader
+ *****************************************************************************/
+XmlStreamReader::~XmlStreamReader()
+{
+    Close();
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::OpenFile
+ *****************************************************************************/
+const XmlStreamNode* XmlStreamReader::OpenFile( const char* path )
+{
+    Close();
+
+    m_File = fopen( path, "rb" );
+    if ( !m_File )
+    {
+        LOGE( "%s(%d): can't open %s\n", __FUNCTION__, __LINE__, path );
+        return ( NULL );
+    }
+
+    return ( Open() );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::OpenBuffer
+ *****************************************************************************/
+const XmlStreamNode* XmlStreamReader::OpenBuffer( const char* buffer, size_t len )
+{
+    Close();
+
+    m_Buffer = buffer;
+    m_BufferLen = len;
+
+    return ( Open() );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::Open
+ *****************************************************************************/
+const XmlStreamNode* XmlStreamReader::Open()
+{
+    m_Parser = XML_ParserCreate( NULL );
+    if ( !m_Parser )
+    {
+        Close();
+        return ( NULL );
+    }
+
+    XML_SetUserData( m_Parser, this );
+    XML_SetElementHandler( m_Parser, StartHandler, EndHandler );
+    XML_SetCharacterDataHandler( m_Parser, CharacterHandler );
+
+    while ( m_Depth == 0 )
+    {
+        if ( !Advance() )
+        {
+            return ( NULL );
+        }
+    }
+
+    return ( &m_Nodes[0] );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::Close
+ *****************************************************************************/
+void XmlStreamReader::Close()
+{
+    if ( m_Parser )
+    {
+        XML_ParserFree( m_Parser );
+        m_Parser = NULL;
+    }
+
+    if ( m_File )
+    {
+        fclose( m_File );
+        m_File = NULL;
+    }
+
+    m_Buffer = NULL;
+    m_BufferLen = 0;
+    m_Final = false;
+    m_Error = false;
+    m_EventCount = 0;
+    m_EventHead = 0;
+    m_ParseHasChild = false;
+    m_Depth = 0;
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::Parse
+ *
+ * Parses the next chunk of the input into m_Events, false at the end of the
+ * document or on error.
+ *****************************************************************************/
+bool XmlStreamReader::Parse()
+{
+    enum XML_Status status;
+
+    if ( m_Final || m_Error || !m_Parser )
+    {
+        return ( false );
+    }
+
+    m_EventCount = 0;
+    m_EventHead = 0;
+
+    if ( m_File )
+    {
+        void* buf = XML_GetBuffer( m_Parser, XML_STREAM_CHUNK_SIZE );
+        if ( !buf )
+        {
+            m_Error = true;
+            return ( false );
+        }
+
+        size_t len = fread( buf, 1, XML_STREAM_CHUNK_SIZE, m_File );
+        if ( ferror( m_File ) )
+        {
+            LOGE( "%s(%d): read error\n", __FUNCTION__, __LINE__ );
+            m_Error = true;
+            return ( false );
+        }
+
+        m_Final = ( len < XML_STREAM_CHUNK_SIZE );
+        status = XML_ParseBuffer( m_Parser, (int)len, m_Final );
+    }
+    else
+    {
+        size_t len = ( m_BufferLen < XML_STREAM_CHUNK_SIZE ) ? m_BufferLen : XML_STREAM_CHUNK_SIZE;
+
+        m_Final = ( len == m_BufferLen );
+        status = XML_Parse( m_Parser, m_Buffer, (int)len, m_Final );
+        m_Buffer += len;
+        m_BufferLen -= len;
+    }
+
+    if ( status != XML_STATUS_OK )
+    {
+        LOGE( "%s(%d): %s at line %lu\n", __FUNCTION__, __LINE__,
+              XML_ErrorString( XML_GetErrorCode( m_Parser ) ),
+              (unsigned long)XML_GetCurrentLineNumber( m_Parser ) );
+        m_Error = true;
+    }
+
+    return ( !m_Error );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::Advance
+ *
+ * Applies the next start or end tag to the visited nodes, collecting the
+ * text in between. False at the end of the document or on error.
+ *****************************************************************************/
+bool XmlStreamReader::Advance()
+{
+    for ( ;; )
+    {
+        while ( m_EventHead == m_EventCount )
+        {
+            if ( !Parse() )
+            {
+                return ( false );
+            }
+        }
+
+        Event* event = &m_Events[m_EventHead++];
+
+        if ( event->type == EVENT_TEXT )
+        {
+            if ( m_Depth > 0 && !m_Nodes[m_Depth - 1].m_Children )
+            {
+                m_Nodes[m_Depth - 1].m_Text.append( event->name );
+            }
+            continue;
+        }
+
+        if ( event->type == EVENT_START )
+        {
+            if ( m_Depth >= XML_STREAM_MAX_DEPTH )
+            {
+                LOGE( "%s(%d): <%s> nested too deep\n", __FUNCTION__, __LINE__, event->name.c_str() );
+                m_Error = true;
+                return ( false );
+            }
+
+            if ( m_Depth > 0 )
+            {
+                m_Nodes[m_Depth - 1].m_Children++;
+            }
+
+            XmlStreamNode* node = &m_Nodes[m_Depth++];
+            node->m_Name.swap( event->name );
+            node->m_Attrs.swap( event->attrs );
+            node->m_Text.clear();
+            node->m_Open = true;
+            node->m_Children = 0;
+            node->m_Visited = 0;
+        }
+        else
+        {
+            m_Nodes[--m_Depth].m_Open = false;
+        }
+
+        return ( true );
+    }
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::Push
+ *****************************************************************************/
+XmlStreamReader::Event* XmlStreamReader::Push( EventType_e type )
+{
+    if ( m_EventCount == m_Events.size() )
+    {
+        m_Events.resize( m_EventCount + 16 );
+    }
+
+    Event* event = &m_Events[m_EventCount++];
+    event->type = type;
+    event->name.clear();
+    event->attrs.clear();
+
+    return ( event );
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::StartHandler
+ *****************************************************************************/
+void XMLCALL XmlStreamReader::StartHandler
+(
+    void*               userData,
+    const XML_Char*     name,
+    const XML_Char**    atts
+)
+{
+    XmlStreamReader* reader = (XmlStreamReader*)userData;
+    Event* event = reader->Push( EVENT_START );
+
+    event->name.assign( name );
+    for ( int i = 0; atts[i]; i += 2 )
+    {
+        event->attrs.append( atts[i] ).push_back( '\0' );
+        event->attrs.append( atts[i + 1] ).push_back( '\0' );
+    }
+
+    reader->m_ParseHasChild = false;
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::EndHandler
+ *****************************************************************************/
+void XMLCALL XmlStreamReader::EndHandler
+(
+    void*               userData,
+    const XML_Char*     name
+)
+{
+    (void)name;
+    XmlStreamReader* reader = (XmlStreamReader*)userData;
+
+    reader->Push( EVENT_END );
+    // the parent now has a child, its later text is of no interest
+    reader->m_ParseHasChild = true;
+}
+
+
+
+/******************************************************************************
+ * XmlStreamReader::CharacterHandler
+ *****************************************************************************/
+void XMLCALL XmlStreamReader::CharacterHandler
+(
+    void*               userData,
+    const XML_Char*     s,
+    int                 len
+)
+{
+    XmlStreamReader* reader = (XmlStreamReader*)userData;
+
+    if ( reader->m_ParseHasChild )
+    {
+        return;
+    }
+
+    Event* event = NULL;
+    if ( reader->m_EventCount && reader->m_Events[reader->m_EventCount - 1].type == EVENT_TEXT )
+    {
+        event = &reader->m_Events[reader->m_EventCount - 1];
+    }
+    else
+    {
+        event = reader->Push( EVENT_TEXT );
+    }
+
+    event->name.append( s, len );
+}
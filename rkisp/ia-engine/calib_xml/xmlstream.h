@@ -0,0 +1,137 @@
+/******************************************************************************
+ *
+ * Copyright 2019, Fuzhou Rockchip Electronics Co.Ltd. All rights reserved.
+ * No part of this work may be reproduced, modified, distributed, transmitted,
+ * transcribed, or translated into any language or computer format, in any form
+ * or by any means without written permission of:
+ * Fuzhou Rockchip Electronics Co.Ltd .
+ *
+ *
+ *****************************************************************************/
+/**
+ * @file xmlstream.h
+ *
+ * Forward only xml reader on top of expat. The document is parsed in small
+ * chunks while the nodes are visited, no tree is built. Only the ancestors
+ * of the current node are held, one node per depth.
+ *
+ *****************************************************************************/
+#ifndef __XMLSTREAM_H__
+#define __XMLSTREAM_H__
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <expat.h>
+
+#define XML_STREAM_MAX_DEPTH    16
+
+class XmlStreamReader;
+
+/******************************************************************************
+ * class XmlStreamNode
+ *
+ * Same accessors as the tinyxml2 element they replace. Children must be
+ * visited in document order: FirstChild once, then NextSibling on the last
+ * returned child, which skips whatever is left of it. A node returned by
+ * NextSibling reuses the storage of its previous sibling.
+ *****************************************************************************/
+class XmlStreamNode
+{
+public:
+    XmlStreamNode();
+
+    const XmlStreamNode* FirstChild() const;
+    const XmlStreamNode* NextSibling() const;
+    const XmlStreamNode* ToElement() const {
+        return ( this );
+    }
+
+    const char* Name() const {
+        return ( m_Name.c_str() );
+    }
+    const char* Attribute( const char* name ) const;
+
+    /* text in front of the first child, NULL if there is only white space */
+    const char* GetText() const;
+
+private:
+    friend class XmlStreamReader;
+
+    XmlStreamReader*    m_Reader;
+    int                 m_Depth;
+    std::string         m_Name;
+    std::string         m_Attrs;        /**< name\0value\0 pairs */
+    std::string         m_Text;
+    bool                m_Open;         /**< end tag not reached yet */
+    int                 m_Children;     /**< children started so far */
+    int                 m_Visited;      /**< children handed out so far */
+};
+
+
+/******************************************************************************
+ * class XmlStreamReader
+ *****************************************************************************/
+class XmlStreamReader
+{
+public:
+    XmlStreamReader();
+    ~XmlStreamReader();
+
+    /* root element of the document, NULL on error */
+    const XmlStreamNode* OpenFile( const char* path );
+    const XmlStreamNode* OpenBuffer( const char* buffer, size_t len );
+    void Close();
+
+    /* io or syntax error so far, the visit may have ended early */
+    bool Error() const {
+        return ( m_Error );
+    }
+
+private:
+    friend class XmlStreamNode;
+
+    enum EventType_e
+    {
+        EVENT_START = 0,
+        EVENT_TEXT,
+        EVENT_END
+    };
+
+    struct Event {
+        EventType_e type;
+        std::string name;               /**< text of EVENT_TEXT */
+        std::string attrs;
+    };
+
+    const XmlStreamNode* Open();
+    bool Parse();
+    bool Advance();
+    Event* Push( EventType_e type );
+
+    static void XMLCALL StartHandler( void* userData, const XML_Char* name, const XML_Char** atts );
+    static void XMLCALL EndHandler( void* userData, const XML_Char* name );
+    static void XMLCALL CharacterHandler( void* userData, const XML_Char* s, int len );
+
+    XmlStreamReader( const XmlStreamReader& );
+    XmlStreamReader& operator=( const XmlStreamReader& );
+
+private:
+    XML_Parser          m_Parser;
+    FILE*               m_File;
+    const char*         m_Buffer;
+    size_t              m_BufferLen;
+    bool                m_Final;
+    bool                m_Error;
+
+    /* events of the last parsed chunk, records are reused */
+    std::vector<Event>  m_Events;
+    size_t              m_EventCount;
+    size_t              m_EventHead;
+    bool                m_ParseHasChild;    /**< innermost element while parsing */
+
+    XmlStreamNode       m_Nodes[XML_STREAM_MAX_DEPTH];
+    int                 m_Depth;            /**< open elements handed to the visit */
+};
+
+#endif /* __XMLSTREAM_H__ */
@@ -17,6 +17,8 @@
 #include "xmltags.h"
 #include <string>
 #include <iostream>
+#include <stdlib.h>
+#include <string.h>
 
 /******************************************************************************
  * class XmlTag
@@ -25,7 +27,7 @@
 /******************************************************************************
  * XmlTag::XmlTag
  *****************************************************************************/
-XmlTag::XmlTag( const XMLElement* e )
+XmlTag::XmlTag( const XmlStreamNode* e )
     : m_Element( e )
 {
 }
@@ -37,8 +39,7 @@ XmlTag::XmlTag( const XMLElement* e )
  *****************************************************************************/
 int XmlTag::Size()
 {
-    const XMLAttribute* pattr = m_Element->FindAttribute( CALIB_ATTRIBUTE_SIZE );
-    const char* c_string = pattr->Value();
+    const char* c_string = m_Element->Attribute( CALIB_ATTRIBUTE_SIZE );
 
     int col;
     int row;
@@ -111,8 +112,7 @@ unsigned int XmlTag::ValueToUInt( bool *ok )
  *****************************************************************************/
 XmlTag::TagType_e XmlTag::Type()
 {
-    const XMLAttribute *pattr = m_Element->FindAttribute( CALIB_ATTRIBUTE_TYPE );
-    std::string s_value(pattr->Value());
+    std::string s_value(m_Element->Attribute( CALIB_ATTRIBUTE_TYPE ));
 
     if ( s_value == CALIB_ATTRIBUTE_TYPE_CHAR )
     {
@@ -148,8 +148,7 @@ bool XmlTag::isType
     const XmlTag::TagType_e type
 )
 {
-    const XMLAttribute* pattr = m_Element->FindAttribute( CALIB_ATTRIBUTE_TYPE );
-    std::string s_value(pattr->Value());
+    std::string s_value(m_Element->Attribute( CALIB_ATTRIBUTE_TYPE ));
     
     if ( s_value == CALIB_ATTRIBUTE_TYPE_CHAR )
     {
@@ -184,7 +183,7 @@ bool XmlTag::isType
 /******************************************************************************
  * XmlCellTag::XmlCellTag
  *****************************************************************************/
-XmlCellTag::XmlCellTag( const XMLElement *e )
+XmlCellTag::XmlCellTag( const XmlStreamNode *e )
     : XmlTag( e )
 {
 }
@@ -198,10 +197,10 @@ int XmlCellTag::Index()
 {
     int value = 0;
 
-    const XMLAttribute *pattr = m_Element->FindAttribute( CALIB_ATTRIBUTE_INDEX );
-    if ( !pattr )
+    const char* c_string = m_Element->Attribute( CALIB_ATTRIBUTE_INDEX );
+    if ( c_string )
     {
-        pattr->QueryIntValue(&value);
+        value = atoi( c_string );
     }
 
     return ( value );
@@ -15,9 +15,8 @@
  #ifndef __XMLTAGS_H__
  #define __XMLTAGS_H__
 
- #include <tinyxml2.h>
+ #include "xmlstream.h"
 
-using namespace tinyxml2;
 /******************************************************************************
  * class XmlTag
  *****************************************************************************/
@@ -34,7 +33,7 @@ public:
         TAG_TYPE_MAX
     };
 
-    XmlTag( const XMLElement *e );
+    XmlTag( const XmlStreamNode *e );
     
     int Size();
     const char* Value();
@@ -44,7 +43,7 @@ public:
     bool isType( const TagType_e type );
 
 protected:
-    const XMLElement* m_Element;
+    const XmlStreamNode* m_Element;
 };
 
 
@@ -54,7 +53,7 @@ protected:
 class XmlCellTag: public XmlTag
 {
 public:
-    XmlCellTag( const XMLElement *e );
+    XmlCellTag( const XmlStreamNode *e );
 
     int Index();
 };
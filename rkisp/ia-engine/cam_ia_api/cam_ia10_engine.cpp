@@ -13,6 +13,11 @@
 #include <cam_types.h>
 #include <map>
 #include <string>
+#include <stddef.h>
+#include <stdlib.h>
+#ifdef ANDROID_OS
+#include <cutils/properties.h>
+#endif
 
 static std::map<string, CalibDb*> g_CalibDbHandlesMap;
 static uint8_t g_aec_weights[81] = {0};
@@ -36,6 +41,106 @@ void CamIa10_set_aec_weights(const unsigned char* pWeight, unsigned int cnt)
    g_update_aec_weights = true;
 }
 
+/*
+ * "0" resolves every static ISP module on every call, "verify" resolves
+ * them anyway and checks the cached results against them.
+ */
+static int man_isp_cache_mode()
+{
+    char value[16] = {0};
+#ifdef ANDROID_OS
+    property_get("persist.vendor.rkisp.ispcache", value, "1");
+#else
+    const char *env = getenv("persist_camera_engine_isp_cache");
+    if (env)
+        strncpy(value, env, sizeof(value) - 1);
+#endif
+    if (!strcmp(value, "verify"))
+        return 2;
+    if (value[0] && !atoi(value))
+        return 0;
+    return 1;
+}
+
+/* in the order of CamIA10Engine::ManIspCacheModule */
+static const struct {
+    const char* name;
+    int enabled_id;
+    size_t cfg_offset;
+    size_t cfg_size;
+} g_man_isp_cache_modules[] = {
+    { "DPCC", HAL_ISP_BPC_ID, offsetof(struct HAL_ISP_cfg_s, dpcc_cfg),
+      sizeof(struct HAL_ISP_dpcc_cfg_s) },
+    { "BLS", HAL_ISP_BLS_ID, offsetof(struct HAL_ISP_cfg_s, bls_cfg),
+      sizeof(struct HAL_ISP_bls_cfg_s) },
+    { "FLT", HAL_ISP_FLT_ID, offsetof(struct HAL_ISP_cfg_s, flt_cfg),
+      sizeof(struct HAL_ISP_flt_cfg_s) },
+    { "CPROC", HAL_ISP_CPROC_ID, offsetof(struct HAL_ISP_cfg_s, cproc_cfg),
+      sizeof(struct HAL_ISP_cproc_cfg_s) },
+    { "WDR", HAL_ISP_WDR_ID, offsetof(struct HAL_ISP_cfg_s, wdr_cfg),
+      sizeof(struct HAL_ISP_wdr_cfg_s) },
+    { "GOC", HAL_ISP_GOC_ID, offsetof(struct HAL_ISP_cfg_s, goc_cfg),
+      sizeof(struct HAL_ISP_goc_cfg_s) },
+    { "demosaiclp", HAL_ISP_DEMOSAICLP_ID, offsetof(struct HAL_ISP_cfg_s, demosaicLP_cfg),
+      sizeof(struct HAL_ISP_demosaiclp_cfg_s) },
+    { "rkIEsharp", HAL_ISP_RKIESHARP_ID, offsetof(struct HAL_ISP_cfg_s, rkIEsharp_cfg),
+      sizeof(struct HAL_ISP_RKIEsharp_cfg_s) },
+};
+
+static const size_t g_man_isp_cache_result_size[] = {
+    sizeof(CamerIcDpccConfig_t),
+    sizeof(CamerIcIspBlsConfig_t),
+    sizeof(CamerIcIspFltConfig_t),
+    sizeof(CamerIcCprocConfig_t),
+    sizeof(CameraIcWdrConfig_t),
+    sizeof(CamerIcIspGocConfig_t),
+    sizeof(CamerIcRKDemosaicLP_t),
+    sizeof(CamerIcRKIeSharpConfig_t),
+};
+
+/* FNV-1a taken a word at a time */
+static uint32_t man_isp_cache_hash(const void* data, size_t size)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t hash = 2166136261u;
+    uint32_t word;
+    size_t i = 0;
+
+    for (; i + sizeof(word) <= size; i += sizeof(word)) {
+        memcpy(&word, p + i, sizeof(word));
+        hash ^= word;
+        hash *= 16777619u;
+    }
+    for (; i < size; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* overwrites the bits set in mask with value, keeps the others */
+static void man_isp_cache_apply
+(
+    const uint8_t* mask,
+    const uint8_t* value,
+    void* out,
+    size_t size
+) {
+    uint8_t* dst = (uint8_t*)out;
+    uint64_t d, m, v;
+    size_t i = 0;
+
+    for (; i + sizeof(d) <= size; i += sizeof(d)) {
+        memcpy(&d, dst + i, sizeof(d));
+        memcpy(&m, mask + i, sizeof(m));
+        memcpy(&v, value + i, sizeof(v));
+        d = (d & ~m) | v;
+        memcpy(dst + i, &d, sizeof(d));
+    }
+    for (; i < size; i++)
+        dst[i] = (dst[i] & ~mask[i]) | value[i];
+}
+
 CamIA10Engine::CamIA10Engine():
     aecContext(NULL),
     aecDesc(NULL),
@@ -116,6 +221,9 @@ RESULT CamIA10Engine::init() {
     }
     mLock3AForStillCap = 0;
     mAeAlgoConvRst = false;
+    mManIspCacheMode = (enum ManIspCacheMode)man_isp_cache_mode();
+    mManIspCacheMismatches = 0;
+    clearManIspCache();
 
     return 0;
 }
@@ -157,6 +265,7 @@ RESULT CamIA10Engine::deinit() {
     mStatisticsUpdated = BOOL_FALSE;
     mInitDynamic = false;
     mFrameId = 0;
+    clearManIspCache();
 
     return 0;
 }
@@ -353,10 +462,7 @@ RESULT HalAwbXtalk2CamerIcXtalk
     LOGV( "%s: (enter)\n", __FUNCTION__);
 
     if ((pAwbXTalkMatrix != NULL) && (pXTalkMatrix != NULL)) {
-        int32_t i;
-        for (i = 0UL; i < 9; i++) {
-            pXTalkMatrix->Coeff[i] = UtlFloatToFix_S0407(pAwbXTalkMatrix->fCoeff[i]);
-        }
+        UtlFloatToFixArray_S0407(pAwbXTalkMatrix->fCoeff, pXTalkMatrix->Coeff, 9);
     } else {
         result = RET_NULL_POINTER;
     }
@@ -2909,6 +3015,7 @@ RESULT CamIA10Engine::clearStatic(){
     }
     g_CalibDbHandlesMap.clear();
     hCamCalibDb = NULL;
+    clearManIspCache();
     return ret;
 }
 
@@ -3096,16 +3203,214 @@ RESULT CamIA10Engine::runManIspForFlash(struct CamIA10_Results* result) {
     return ret;
 }
 
+void CamIA10Engine::clearManIspCache() {
+    memset(mManIspCache, 0, sizeof(mManIspCache));
+    memset(mManIspCacheNext, 0, sizeof(mManIspCacheNext));
+}
+
+RESULT CamIA10Engine::runManIspModule
+(
+ enum ManIspCacheModule module,
+ struct HAL_ISP_cfg_s* manCfg,
+ int width,
+ int height,
+ void* out
+ ) {
+    switch (module) {
+    case MAN_ISP_CACHE_BPC:
+        return cam_ia10_isp_dpcc_config
+            (
+             manCfg->enabled[HAL_ISP_BPC_ID],
+             manCfg->dpcc_cfg,
+             hCamCalibDb,
+             width,
+             height,
+             (CamerIcDpccConfig_t*)out
+            );
+    case MAN_ISP_CACHE_BLS:
+        return cam_ia10_isp_bls_config
+            (
+             manCfg->enabled[HAL_ISP_BLS_ID],
+             hCamCalibDb,
+             width,
+             height,
+             manCfg->bls_cfg,
+             (CamerIcIspBlsConfig_t*)out
+            );
+    case MAN_ISP_CACHE_FLT:
+        return cam_ia10_isp_flt_config
+            (
+             hCamCalibDb,
+             manCfg->enabled[HAL_ISP_FLT_ID],
+             manCfg->flt_cfg,
+             width,
+             height,
+             (CamerIcIspFltConfig_t*)out
+            );
+    case MAN_ISP_CACHE_CPROC:
+        return cam_ia10_isp_cproc_config
+            (
+             hCamCalibDb,
+             manCfg->enabled[HAL_ISP_CPROC_ID],
+             manCfg->cproc_cfg,
+             (CamerIcCprocConfig_t*)out
+            );
+    case MAN_ISP_CACHE_WDR:
+        return cam_ia10_isp_wdr_config
+            (
+             hCamCalibDb,
+             manCfg->enabled[HAL_ISP_WDR_ID],
+             manCfg->wdr_cfg,
+             (CameraIcWdrConfig_t*)out
+            );
+    case MAN_ISP_CACHE_GOC:
+        return cam_ia10_isp_goc_config
+            (
+             hCamCalibDb,
+             manCfg->enabled[HAL_ISP_GOC_ID],
+             manCfg->goc_cfg,
+             (CamerIcIspGocConfig_t*)out,
+             mWdrEnabledState,
+             mIspVer
+            );
+    case MAN_ISP_CACHE_DEMOSAICLP:
+        return cam_ia10_isp_demosaicLp_config
+            (
+             hCamCalibDb,
+             manCfg->enabled[HAL_ISP_DEMOSAICLP_ID],
+             manCfg->demosaicLP_cfg,
+             width,
+             height,
+             (CamerIcRKDemosaicLP_t*)out
+            );
+    case MAN_ISP_CACHE_RKIESHARP:
+        return cam_ia10_isp_rkIEsharp_config
+            (
+             hCamCalibDb,
+             manCfg->enabled[HAL_ISP_RKIESHARP_ID],
+             manCfg->rkIEsharp_cfg,
+             width,
+             height,
+             (CamerIcRKIeSharpConfig_t*)out
+            );
+    default:
+        return RET_INVALID_PARM;
+    }
+}
+
+/*
+ * Resolves a static module from the cache when the mode, the manual config,
+ * the sensor mode and the calibration generation match an earlier call.
+ * On a miss the module is resolved on an all zero and an all one result,
+ * the bits that come out the same in both are the ones it writes.
+ */
+RESULT CamIA10Engine::runManIspCached
+(
+ enum ManIspCacheModule module,
+ struct HAL_ISP_cfg_s* manCfg,
+ int width,
+ int height,
+ const uint32_t* generation,
+ void* out
+ ) {
+    const size_t size = g_man_isp_cache_result_size[module];
+    const size_t cfg_size = g_man_isp_cache_modules[module].cfg_size;
+    const void* cfg = *(void* const*)((const char*)manCfg +
+                                      g_man_isp_cache_modules[module].cfg_offset);
+    enum HAL_ISP_ACTIVE_MODE mode = manCfg->enabled[g_man_isp_cache_modules[module].enabled_id];
+    bool_t wdr_enabled = (module == MAN_ISP_CACHE_GOC) ? mWdrEnabledState : BOOL_FALSE;
+    uint32_t cfg_hash = cfg ? man_isp_cache_hash(cfg, cfg_size) : 0;
+    struct ManIspCacheEntry* entry = NULL;
+    union ManIspCacheResult zeros, ones;
+    RESULT ret;
+
+    if (!generation)
+        return runManIspModule(module, manCfg, width, height, out);
+
+    for (int i = 0; i < 2; i++) {
+        struct ManIspCacheEntry* e = &mManIspCache[module][i];
+        if (e->valid && e->hCamCalibDb == hCamCalibDb &&
+            e->generation == *generation &&
+            e->width == width && e->height == height &&
+            e->isp_ver == mIspVer && e->wdr_enabled == wdr_enabled &&
+            e->mode == mode && e->has_cfg == (cfg != NULL) &&
+            e->cfg_hash == cfg_hash &&
+            (!cfg || !memcmp(&e->cfg, cfg, cfg_size))) {
+            entry = e;
+            break;
+        }
+    }
+
+    if (entry && mManIspCacheMode == MAN_ISP_CACHE_VERIFY) {
+        union ManIspCacheResult check;
+
+        memcpy(&check, out, size);
+        ret = runManIspModule(module, manCfg, width, height, &check);
+        man_isp_cache_apply(entry->mask, entry->value, out, size);
+        if (ret != entry->ret || memcmp(&check, out, size)) {
+            LOGE("%s: cached %s config differs from the resolved one !",
+                 __FUNCTION__, g_man_isp_cache_modules[module].name);
+            mManIspCacheMismatches++;
+            memcpy(out, &check, size);
+            entry->valid = false;
+        }
+        return ret;
+    }
+
+    if (entry) {
+        man_isp_cache_apply(entry->mask, entry->value, out, size);
+        return entry->ret;
+    }
+
+    memset(&zeros, 0x00, size);
+    memset(&ones, 0xff, size);
+    ret = runManIspModule(module, manCfg, width, height, &zeros);
+    if (ret != runManIspModule(module, manCfg, width, height, &ones))
+        return runManIspModule(module, manCfg, width, height, out);
+
+    entry = &mManIspCache[module][mManIspCacheNext[module]];
+    mManIspCacheNext[module] ^= 1;
+    entry->valid = true;
+    entry->hCamCalibDb = hCamCalibDb;
+    entry->generation = *generation;
+    entry->width = width;
+    entry->height = height;
+    entry->isp_ver = mIspVer;
+    entry->wdr_enabled = wdr_enabled;
+    entry->mode = mode;
+    entry->has_cfg = (cfg != NULL);
+    entry->cfg_hash = cfg_hash;
+    if (cfg)
+        memcpy(&entry->cfg, cfg, cfg_size);
+    entry->ret = ret;
+    for (size_t i = 0; i < size; i++) {
+        uint8_t a = ((const uint8_t*)&zeros)[i];
+        uint8_t b = ((const uint8_t*)&ones)[i];
+        entry->mask[i] = ~(a ^ b);
+        entry->value[i] = a & entry->mask[i];
+    }
+    man_isp_cache_apply(entry->mask, entry->value, out, size);
+
+    return ret;
+}
+
 RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Results* result) {
     RESULT ret = RET_SUCCESS;
     int width = dCfg.sensor_mode.isp_input_width;
     int height = dCfg.sensor_mode.isp_input_height;
 
+    uint32_t generation = 0;
+    const uint32_t* cacheGeneration = NULL;
+
     if (!mInitDynamic) {
         width = mStats.sensor_mode.isp_input_width;
         height = mStats.sensor_mode.isp_input_height;
     }
 
+    if (mManIspCacheMode != MAN_ISP_CACHE_OFF && hCamCalibDb &&
+        CamCalibDbGetGeneration(hCamCalibDb, &generation) == RET_SUCCESS)
+        cacheGeneration = &generation;
+
     //may override other awb related modules, so need place it first.
     if (manCfg->updated_mask & HAL_ISP_AWB_MEAS_MASK) {
         CamerIcAwbMeasConfig_t awb_meas_result = {BOOL_FALSE, 0, 0, 0};
@@ -3140,15 +3445,8 @@ RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Res
     }
 
     if (manCfg->updated_mask & HAL_ISP_BPC_MASK) {
-        ret =  cam_ia10_isp_dpcc_config
-            (
-             manCfg->enabled[HAL_ISP_BPC_ID],
-             manCfg->dpcc_cfg,
-             hCamCalibDb,
-             width,
-             height,
-             &(result->dpcc)
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_BPC, manCfg, width, height,
+                              cacheGeneration, &(result->dpcc));
 
         if (ret != RET_SUCCESS)
             LOGE("%s:config DPCC failed !", __FUNCTION__);
@@ -3156,15 +3454,8 @@ RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Res
     }
 
     if (manCfg->updated_mask & HAL_ISP_BLS_MASK) {
-        ret = cam_ia10_isp_bls_config
-            (
-             manCfg->enabled[HAL_ISP_BLS_ID],
-             hCamCalibDb,
-             width,
-             height,
-             manCfg->bls_cfg,
-             &(result->bls)
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_BLS, manCfg, width, height,
+                              cacheGeneration, &(result->bls));
 
         if (ret != RET_SUCCESS)
             LOGE("%s:config BLS failed !", __FUNCTION__);
@@ -3238,15 +3529,8 @@ RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Res
     }
 
     if (manCfg->updated_mask & HAL_ISP_FLT_MASK) {
-        ret = cam_ia10_isp_flt_config
-            (
-             hCamCalibDb,
-             manCfg->enabled[HAL_ISP_FLT_ID],
-             manCfg->flt_cfg,
-             width,
-             height,
-             &(result->flt)
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_FLT, manCfg, width, height,
+                              cacheGeneration, &(result->flt));
 
         if (ret != RET_SUCCESS)
             LOGE("%s:config FLT failed !", __FUNCTION__);
@@ -3285,13 +3569,8 @@ RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Res
 
 
     if (manCfg->updated_mask & HAL_ISP_CPROC_MASK) {
-        ret = cam_ia10_isp_cproc_config
-            (
-             hCamCalibDb,
-             manCfg->enabled[HAL_ISP_CPROC_ID],
-             manCfg->cproc_cfg,
-             &(result->cproc)
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_CPROC, manCfg, width, height,
+                              cacheGeneration, &(result->cproc));
 
         if (ret != RET_SUCCESS)
             LOGE("%s:config CPROC failed !", __FUNCTION__);
@@ -3346,13 +3625,8 @@ RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Res
 
     /*TODOS*/
     if (manCfg->updated_mask & HAL_ISP_WDR_MASK) {
-        ret = cam_ia10_isp_wdr_config
-            (
-             hCamCalibDb,
-             manCfg->enabled[HAL_ISP_WDR_ID],
-             manCfg->wdr_cfg,
-             &(result->wdr)
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_WDR, manCfg, width, height,
+                              cacheGeneration, &(result->wdr));
 
         if (ret != RET_SUCCESS)
             LOGE("%s:config WDR failed !", __FUNCTION__);
@@ -3372,15 +3646,8 @@ RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Res
 
 
     if (manCfg->updated_mask & HAL_ISP_GOC_MASK) {
-        ret = cam_ia10_isp_goc_config
-            (
-             hCamCalibDb,
-             manCfg->enabled[HAL_ISP_GOC_ID],
-             manCfg->goc_cfg,
-             &(result->goc),
-             mWdrEnabledState,
-             mIspVer
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_GOC, manCfg, width, height,
+                              cacheGeneration, &(result->goc));
 
         if (ret != RET_SUCCESS)
             LOGE("%s:config GOC failed !", __FUNCTION__);
@@ -3425,30 +3692,16 @@ RESULT CamIA10Engine::runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Res
     }
 
     if (manCfg->updated_mask & HAL_ISP_DEMOSAICLP_MASK) {
-        ret = cam_ia10_isp_demosaicLp_config
-            (
-             hCamCalibDb,
-             manCfg->enabled[HAL_ISP_DEMOSAICLP_ID],
-             manCfg->demosaicLP_cfg,
-             width,
-             height,
-             &(result->rkDemosaicLP)
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_DEMOSAICLP, manCfg, width, height,
+                              cacheGeneration, &(result->rkDemosaicLP));
         if (ret != RET_SUCCESS)
             LOGE("%s:config demosaiclp failed !", __FUNCTION__);
         result->active |= CAMIA10_DEMOSAICLP_MASK;
     }
 
     if (manCfg->updated_mask & HAL_ISP_RK_IESHARP_MASK) {
-        ret = cam_ia10_isp_rkIEsharp_config
-            (
-             hCamCalibDb,
-             manCfg->enabled[HAL_ISP_RKIESHARP_ID],
-             manCfg->rkIEsharp_cfg,
-             width,
-             height,
-             &(result->rkIEsharp)
-            );
+        ret = runManIspCached(MAN_ISP_CACHE_RKIESHARP, manCfg, width, height,
+                              cacheGeneration, &(result->rkIEsharp));
         if (ret != RET_SUCCESS)
             LOGE("%s:config demosaiclp failed !", __FUNCTION__);
         result->active |= CAMIA10_RKIESHARP_MASK;
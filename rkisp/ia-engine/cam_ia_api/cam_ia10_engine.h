@@ -57,6 +57,8 @@ class CamIA10Engine: public CamIA10EngineItf {
   virtual RESULT clearStatic();
   /* manual ISP configs*/
   virtual RESULT runManISP(struct HAL_ISP_cfg_s* manCfg, struct CamIA10_Results* result);
+  /* cached static ISP configs found stale so far, counted in verify mode */
+  uint32_t getManIspCacheMismatches() const { return mManIspCacheMismatches; }
   virtual void mapSensorExpToHal(
       int sensorGain,
       int sensorInttime,
@@ -143,6 +145,76 @@ class CamIA10Engine: public CamIA10EngineItf {
 
   bool_t  mWdrEnabledState;
   enum LIGHT_MODE mLightMode;
+
+  /*
+   * Static ISP modules resolved by runManISP. Their results depend only on
+   * the active mode, the manual config, the sensor mode and the calibration
+   * database, so the last two outcomes of each are kept keyed by those.
+   * A config function may write only part of its result, the bits it
+   * writes are recorded in mask and the rest are left as they were.
+   */
+  enum ManIspCacheModule {
+    MAN_ISP_CACHE_BPC,
+    MAN_ISP_CACHE_BLS,
+    MAN_ISP_CACHE_FLT,
+    MAN_ISP_CACHE_CPROC,
+    MAN_ISP_CACHE_WDR,
+    MAN_ISP_CACHE_GOC,
+    MAN_ISP_CACHE_DEMOSAICLP,
+    MAN_ISP_CACHE_RKIESHARP,
+    MAN_ISP_CACHE_MAX
+  };
+
+  enum ManIspCacheMode {
+    MAN_ISP_CACHE_OFF,
+    MAN_ISP_CACHE_ON,
+    /* resolve every module anyway and report cached results that differ */
+    MAN_ISP_CACHE_VERIFY
+  };
+
+  union ManIspCacheCfg {
+    struct HAL_ISP_dpcc_cfg_s dpcc;
+    struct HAL_ISP_bls_cfg_s bls;
+    struct HAL_ISP_flt_cfg_s flt;
+    struct HAL_ISP_cproc_cfg_s cproc;
+    struct HAL_ISP_wdr_cfg_s wdr;
+    struct HAL_ISP_goc_cfg_s goc;
+    struct HAL_ISP_demosaiclp_cfg_s demosaicLP;
+    struct HAL_ISP_RKIEsharp_cfg_s rkIEsharp;
+  };
+
+  union ManIspCacheResult {
+    CamerIcDpccConfig_t dpcc;
+    CamerIcIspBlsConfig_t bls;
+    CamerIcIspFltConfig_t flt;
+    CamerIcCprocConfig_t cproc;
+    CameraIcWdrConfig_t wdr;
+    CamerIcIspGocConfig_t goc;
+    CamerIcRKDemosaicLP_t rkDemosaicLP;
+    CamerIcRKIeSharpConfig_t rkIEsharp;
+  };
+
+  struct ManIspCacheEntry {
+    bool valid;
+    CamCalibDbHandle_t hCamCalibDb;
+    uint32_t generation;
+    int width;
+    int height;
+    int isp_ver;
+    bool_t wdr_enabled;
+    enum HAL_ISP_ACTIVE_MODE mode;
+    bool has_cfg;
+    uint32_t cfg_hash;
+    union ManIspCacheCfg cfg;
+    RESULT ret;
+    uint8_t mask[sizeof(union ManIspCacheResult)];
+    uint8_t value[sizeof(union ManIspCacheResult)];
+  };
+
+  struct ManIspCacheEntry mManIspCache[MAN_ISP_CACHE_MAX][2];
+  int mManIspCacheNext[MAN_ISP_CACHE_MAX];
+  enum ManIspCacheMode mManIspCacheMode;
+  uint32_t mManIspCacheMismatches;
  private:
   RESULT initAEC();
   RESULT initAWB();
@@ -153,6 +225,14 @@ class CamIA10Engine: public CamIA10EngineItf {
   RESULT runManIspForPreIsp(struct CamIA10_Results* result);
   RESULT runManIspForOTP(struct CamIA10_Results* result);
   RESULT runManIspForFlash(struct CamIA10_Results* result);
+  RESULT runManIspModule(enum ManIspCacheModule module,
+                         struct HAL_ISP_cfg_s* manCfg,
+                         int width, int height, void* out);
+  RESULT runManIspCached(enum ManIspCacheModule module,
+                         struct HAL_ISP_cfg_s* manCfg,
+                         int width, int height, const uint32_t* generation,
+                         void* out);
+  void clearManIspCache();
   const char* mSensorEntityName;
   int mIspVer;
   int mXMLIspOutputType;
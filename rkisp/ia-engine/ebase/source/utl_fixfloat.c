@@ -19,6 +19,15 @@
 #include <ebase/builtins.h>
 #include <ebase/dct_assert.h>
 #include <utl_fixfloat.h>
+#include <math.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define UTL_FIX_ARRAY_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define UTL_FIX_ARRAY_SSE2
+#endif
 
 // The general strategie of FrameFun is to use float during all calculations. Just right
 // before writing to registers and directly after reading registers conversion to/from
@@ -1546,3 +1555,503 @@ float UtlFixToFloat_S0110(uint32_t ulFix) {
   return fFloat;
 }
 
+
+// Batch conversion of whole tables. Every element is converted exactly as
+// the matching UtlFloatToFix_* routine does, but without branches, so the
+// loops vectorize: the value is clamped to the range of the format, the
+// magnitude is scaled and rounded and the two's complement is formed with
+// a sign mask. Values outside the range (and NaN) are clamped instead of
+// triggering the range check assert. Scaling by a power of two is exact,
+// so a fused multiply-add yields the same result as the scalar routines.
+// testApp/fixfloat_test compares both bit for bit over all formats.
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixClamped \n
+ *  \RETURNVALUE fixed point value in uint32_t container \n
+ *  \PARAMETERS  float value, range, precision and mask of the format \n
+ *  \DESCRIPTION Branchless conversion of a single value, used by the \n
+ *               scalar builds and for the remainder of a vector loop. \n
+ */
+/*****************************************************************************/
+static uint32_t UtlFloatToFixClamped
+(
+    float     fFloat,
+    float     fMin,
+    float     fMax,
+    float     fPrecision,
+    uint32_t  ulMask
+) {
+  uint32_t ulFix = 0;
+  uint32_t ulNeg = 0;
+
+  // NaN fails the first comparison and ends up at the lower limit
+  fFloat = (fFloat >= fMin) ? fFloat : fMin;
+  fFloat = (fFloat <= fMax) ? fFloat : fMax;
+
+  // all ones for negative values
+  ulNeg = 0U - (uint32_t)(fFloat < 0.0f);
+
+  // round the magnitude, then two's complement if negative
+  ulFix = (uint32_t)(fabsf(fFloat) * fPrecision + 0.5f);
+  ulFix = (ulFix ^ ulNeg) - ulNeg;
+
+  return (ulFix & ulMask);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements, \n
+ *               range, precision and mask of the format \n
+ *  \DESCRIPTION Converts a table of float values, four at a time where \n
+ *               NEON or SSE2 is available. \n
+ */
+/*****************************************************************************/
+static void UtlFloatToFixArray
+(
+    const float*  pFloat,
+    uint32_t*     pFix,
+    uint32_t      ulCount,
+    float         fMin,
+    float         fMax,
+    float         fPrecision,
+    uint32_t      ulMask
+) {
+  uint32_t i = 0U;
+
+#if defined(UTL_FIX_ARRAY_NEON)
+  const float32x4_t vMin = vdupq_n_f32(fMin);
+  const float32x4_t vMax = vdupq_n_f32(fMax);
+  const float32x4_t vPrecision = vdupq_n_f32(fPrecision);
+  const float32x4_t vHalf = vdupq_n_f32(0.5f);
+  const float32x4_t vZero = vdupq_n_f32(0.0f);
+  const uint32x4_t vMask = vdupq_n_u32(ulMask);
+
+  for (; (i + 4U) <= ulCount; i += 4U) {
+    float32x4_t vFloat = vld1q_f32(pFloat + i);
+    uint32x4_t vNeg;
+    uint32x4_t vFix;
+
+    // select rather than vmaxq/vminq, those return NaN for NaN
+    vFloat = vbslq_f32(vcgeq_f32(vFloat, vMin), vFloat, vMin);
+    vFloat = vbslq_f32(vcleq_f32(vFloat, vMax), vFloat, vMax);
+    vNeg = vcltq_f32(vFloat, vZero);
+
+    vFloat = vaddq_f32(vmulq_f32(vabsq_f32(vFloat), vPrecision), vHalf);
+    vFix = vreinterpretq_u32_s32(vcvtq_s32_f32(vFloat));
+    vFix = vsubq_u32(veorq_u32(vFix, vNeg), vNeg);
+
+    vst1q_u32(pFix + i, vandq_u32(vFix, vMask));
+  }
+#elif defined(UTL_FIX_ARRAY_SSE2)
+  const __m128 vMin = _mm_set1_ps(fMin);
+  const __m128 vMax = _mm_set1_ps(fMax);
+  const __m128 vPrecision = _mm_set1_ps(fPrecision);
+  const __m128 vHalf = _mm_set1_ps(0.5f);
+  const __m128 vSign = _mm_set1_ps(-0.0f);
+  const __m128i vMask = _mm_set1_epi32((int32_t)ulMask);
+
+  for (; (i + 4U) <= ulCount; i += 4U) {
+    __m128 vFloat = _mm_loadu_ps(pFloat + i);
+    __m128i vNeg;
+    __m128i vFix;
+
+    // maxps returns its second operand for NaN
+    vFloat = _mm_max_ps(vFloat, vMin);
+    vFloat = _mm_min_ps(vFloat, vMax);
+    vNeg = _mm_castps_si128(_mm_cmplt_ps(vFloat, _mm_setzero_ps()));
+
+    vFloat = _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(vSign, vFloat), vPrecision), vHalf);
+    vFix = _mm_cvttps_epi32(vFloat);
+    vFix = _mm_sub_epi32(_mm_xor_si128(vFix, vNeg), vNeg);
+
+    _mm_storeu_si128((__m128i*)(pFix + i), _mm_and_si128(vFix, vMask));
+  }
+#endif
+
+  for (; i < ulCount; i++) {
+    pFix[i] = UtlFloatToFixClamped(pFloat[i], fMin, fMax, fPrecision, ulMask);
+  }
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U0402 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U0402, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U0402(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U0402, UTL_FIX_MAX_U0402,
+                     UTL_FIX_PRECISION_U0402, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U0107 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U0107, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U0107(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U0107, UTL_FIX_MAX_U0107,
+                     UTL_FIX_PRECISION_U0107, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U0208 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U0208, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U0208(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U0208, UTL_FIX_MAX_U0208,
+                     UTL_FIX_PRECISION_U0208, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U0408 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U0408, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U0408(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U0408, UTL_FIX_MAX_U0408,
+                     UTL_FIX_PRECISION_U0408, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U0800 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U0800, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U0800(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U0800, UTL_FIX_MAX_U0800,
+                     1.0f, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U1000 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U1000, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U1000(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U1000, UTL_FIX_MAX_U1000,
+                     1.0f, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U1200 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U1200, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U1200(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U1200, UTL_FIX_MAX_U1200,
+                     1.0f, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_U0010 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to unsigned fixed point \n
+ *               values like UtlFloatToFix_U0010, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_U0010(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_U0010, UTL_FIX_MAX_U0010,
+                     UTL_FIX_PRECISION_U0010, 0xffffffffU);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0207 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0207, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0207(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0207, UTL_FIX_MAX_S0207,
+                     UTL_FIX_PRECISION_S0207, UTL_FIX_MASK_S0207);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0307 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0307, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0307(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0307, UTL_FIX_MAX_S0307,
+                     UTL_FIX_PRECISION_S0307, UTL_FIX_MASK_S0307);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0407 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0407, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0407(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0407, UTL_FIX_MAX_S0407,
+                     UTL_FIX_PRECISION_S0407, UTL_FIX_MASK_S0407);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0504 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0504, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0504(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0504, UTL_FIX_MAX_S0504,
+                     UTL_FIX_PRECISION_S0504, UTL_FIX_MASK_S0504);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0808 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0808, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0808(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0808, UTL_FIX_MAX_S0808,
+                     UTL_FIX_PRECISION_S0808, UTL_FIX_MASK_S0808);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0800 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0800, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0800(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0800, UTL_FIX_MAX_S0800,
+                     1.0f, UTL_FIX_MASK_S0800);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0900 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0900, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0900(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0900, UTL_FIX_MAX_S0900,
+                     1.0f, UTL_FIX_MASK_S0900);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S1200 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S1200, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S1200(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S1200, UTL_FIX_MAX_S1200,
+                     1.0f, UTL_FIX_MASK_S1200);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0109 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0109, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0109(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0109, UTL_FIX_MAX_S0109,
+                     UTL_FIX_PRECISION_S0109, UTL_FIX_MASK_S0109);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0408 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0408, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0408(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0408, UTL_FIX_MAX_S0408,
+                     UTL_FIX_PRECISION_S0408, UTL_FIX_MASK_S0408);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0108 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0108, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0108(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0108, UTL_FIX_MAX_S0108,
+                     UTL_FIX_PRECISION_S0108, UTL_FIX_MASK_S0108);
+}
+
+/*****************************************************************************/
+/*!
+ *  \FUNCTION    UtlFloatToFixArray_S0110 \n
+ *  \RETURNVALUE none \n
+ *  \PARAMETERS  float table, fixed point table, number of elements \n
+ *  \DESCRIPTION Converts a table of float values to signed fixed point \n
+ *               values like UtlFloatToFix_S0110, clamped to the \n
+ *               range of the format. \n
+ */
+/*****************************************************************************/
+void UtlFloatToFixArray_S0110(const float* pFloat, uint32_t* pFix, uint32_t ulCount) {
+  DCT_ASSERT(pFloat != NULL || ulCount == 0U);
+  DCT_ASSERT(pFix != NULL || ulCount == 0U);
+
+  UtlFloatToFixArray(pFloat, pFix, ulCount,
+                     UTL_FIX_MIN_S0110, UTL_FIX_MAX_S0110,
+                     UTL_FIX_PRECISION_S0110, UTL_FIX_MASK_S0110);
+}
@@ -84,6 +84,30 @@ float UtlFixToFloat_S0108(uint32_t ulFix);
 
 uint32_t UtlFloatToFix_S0110(float fFloat);
 float UtlFixToFloat_S0110(uint32_t ulFix);
+
+/* Table versions of the conversions above. Values are clamped to the range
+ * of the format instead of asserting, in range values give the same result
+ * as the single value conversion. */
+void UtlFloatToFixArray_U0402(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_U0107(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_U0208(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_U0408(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_U0800(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_U1000(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_U1200(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_U0010(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0207(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0307(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0407(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0504(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0808(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0800(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0900(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S1200(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0109(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0408(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0108(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
+void UtlFloatToFixArray_S0110(const float* pFloat, uint32_t* pFix, uint32_t ulCount);
 #ifdef __cplusplus
 }
 #endif
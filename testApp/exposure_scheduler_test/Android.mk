@@ -0,0 +1,29 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES = exposure_scheduler_test.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX -DENABLE_ASSERT
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../xcore \
+	$(LOCAL_PATH)/../../xcore/base \
+	$(LOCAL_PATH)/../../modules/isp \
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+ifeq (1,$(strip $(shell expr $(PLATFORM_SDK_VERSION) \>= 26)))
+LOCAL_PROPRIETARY_MODULE := true
+endif
+endif
+
+LOCAL_SHARED_LIBRARIES += librkisp
+
+LOCAL_MODULE:= exposure_scheduler_test
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,207 @@
+/*
+ * Drives ExposureScheduler against FakeExposureSensor the way IspController
+ * does: the writes due in a SOF are issued first, then the AE result of the
+ * previous frame is planned several smooth steps ahead. Checks that the
+ * integration time, both gains and the frame length land on the frame they
+ * were planned for, for the default and for mixed sensor latencies.
+ *
+ *   exposure_scheduler_test
+ *
+ * Returns non-zero when a check fails.
+ */
+#include <stdio.h>
+#include <map>
+
+#include <xcam_std.h>
+#include <exposure_scheduler.h>
+
+using namespace XCam;
+
+#define TEST_FRAMES 64
+#define TEST_STEPS  3
+
+struct TestCase {
+    const char *name;
+    int32_t delay[ExposureComponentCount];  // time, again, dgain
+    int32_t plan_every;                     // frames between AE results
+    uint32_t mask;
+};
+
+struct Expected {
+    uint32_t mask;
+    int32_t value[ExposureComponentCount];
+    int32_t vts;
+};
+
+#define MASK_ALL (XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentTime) | \
+                  XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentAgain) | \
+                  XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentDgain))
+#define MASK_GAINS (XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentAgain) | \
+                    XCAM_EXPOSURE_COMPONENT_MASK (ExposureComponentDgain))
+
+static const TestCase test_cases[] = {
+    {"default 2/2/2",          {2, 2, 2}, 1, MASK_ALL},
+    {"default 2/2/2 sparse",   {2, 2, 2}, 4, MASK_ALL},
+    {"mixed 1/2/2",            {1, 2, 2}, 1, MASK_ALL},
+    {"mixed 3/1/0",            {3, 1, 0}, 1, MASK_ALL},
+    {"mixed 3/1/0 sparse",     {3, 1, 0}, 5, MASK_ALL},
+    {"none 0/0/0",             {0, 0, 0}, 1, MASK_ALL},
+    {"gains only 2/2/2",       {2, 2, 2}, 1, MASK_GAINS},
+    {"gains only 3/1/0",       {3, 1, 0}, 2, MASK_GAINS},
+};
+
+static const char *component_names[ExposureComponentCount] = {
+    "time", "again", "dgain",
+};
+
+// value of @comp planned at @frame for smooth step @step, unique per plan
+static int32_t
+plan_value (int comp, int32_t frame, int32_t step)
+{
+    return (comp + 1) * 100000 + frame * 10 + step;
+}
+
+static int
+check_latched (const char *what, bool found, int32_t frame, int32_t value, int32_t target, int32_t expected)
+{
+    if (found && value == expected && target == frame)
+        return 0;
+
+    printf ("  frame %d %s: got %d for frame %d, expected %d\n",
+            frame, what, found ? value : -1, found ? target : -1, expected);
+    return 1;
+}
+
+// values in effect for @frame against the plan, once all its writes are out
+static int
+check_frame (const FakeExposureSensor &sensor, int32_t frame, const Expected &e)
+{
+    int32_t value = 0, target = 0;
+    int failures = 0;
+
+    for (int i = 0; i < ExposureComponentCount; i++) {
+        if (!(e.mask & XCAM_EXPOSURE_COMPONENT_MASK (i)))
+            continue;
+        bool found = sensor.get_effective ((ExposureComponent)i, frame, value, target);
+        failures += check_latched (component_names[i], found, frame, value, target, e.value[i]);
+    }
+    bool found = sensor.get_effective_vts (frame, value, target);
+    failures += check_latched ("vts", found, frame, value, target, e.vts);
+    return failures;
+}
+
+static int
+run_case (const TestCase &test)
+{
+    SensorExposureDelay delay;
+    ExposureScheduleStats stats;
+    std::map<int32_t, Expected> expected;
+    int failures = 0;
+
+    for (int i = 0; i < ExposureComponentCount; i++)
+        delay.delay[i] = test.delay[i];
+
+    ExposureScheduler scheduler;
+    FakeExposureSensor sensor (delay);
+    scheduler.set_delay (delay);
+    int32_t max_delay = scheduler.get_max_delay ();
+
+    for (int32_t frame = 0; frame < TEST_FRAMES; frame++) {
+        ExposureWrite write;
+
+        if (scheduler.take_writes (frame, write))
+            sensor.write (write);
+
+        // the last write for a frame goes out max_delay SOFs before it, the
+        // sensor only keeps a few latched values, so check as the run goes
+        std::map<int32_t, Expected>::const_iterator done = expected.find (frame - max_delay);
+        if (done != expected.end ())
+            failures += check_frame (sensor, done->first, done->second);
+
+        if (frame % test.plan_every)
+            continue;
+
+        // a new plan replaces everything planned from its first target on
+        int32_t next_sof = frame + 1;
+        int32_t target = next_sof + max_delay;
+        expected.erase (expected.lower_bound (target), expected.end ());
+
+        for (int32_t step = 0; step < TEST_STEPS; step++, target++) {
+            Expected &e = expected[target];
+            e.mask = test.mask;
+            for (int i = 0; i < ExposureComponentCount; i++)
+                e.value[i] = plan_value (i, frame, step);
+            e.vts = plan_value (ExposureComponentCount, frame, step);
+            scheduler.schedule (next_sof, target, test.mask, e.value, e.vts);
+        }
+    }
+
+    scheduler.get_stats (stats);
+    if (stats.late) {
+        printf ("  %lld writes planned late\n", (long long)stats.late);
+        failures++;
+    }
+
+    printf ("%-24s %s\n", test.name, failures ? "FAILED" : "ok");
+    return failures;
+}
+
+// a plan too close to be met lands as early as the latency allows
+static int
+run_late_case ()
+{
+    SensorExposureDelay delay;
+    ExposureScheduleStats stats;
+    int32_t value[ExposureComponentCount];
+    int failures = 0;
+
+    delay.delay[ExposureComponentTime] = 3;
+    delay.delay[ExposureComponentAgain] = 1;
+    delay.delay[ExposureComponentDgain] = 0;
+
+    ExposureScheduler scheduler;
+    FakeExposureSensor sensor (delay);
+    scheduler.set_delay (delay);
+
+    for (int i = 0; i < ExposureComponentCount; i++)
+        value[i] = plan_value (i, 0, 0);
+    // frame 2 is too early for the time only, the gains still make it
+    scheduler.schedule (1, 2, MASK_ALL, value, plan_value (ExposureComponentCount, 0, 0));
+
+    for (int32_t frame = 0; frame < 8; frame++) {
+        ExposureWrite write;
+        if (scheduler.take_writes (frame, write))
+            sensor.write (write);
+    }
+
+    for (int i = 0; i < ExposureComponentCount; i++) {
+        int32_t frame = XCAM_MAX (2, 1 + delay.delay[i]), got = 0, target = 0;
+        bool found = sensor.get_effective ((ExposureComponent)i, frame, got, target);
+        if (!found || got != value[i] || target != 2 ||
+                sensor.get_effective ((ExposureComponent)i, frame - 1, got, target)) {
+            printf ("  %s did not land first on frame %d\n", component_names[i], frame);
+            failures++;
+        }
+    }
+
+    scheduler.get_stats (stats);
+    if (stats.late != 1) {
+        printf ("  %lld writes counted late, expected 1\n", (long long)stats.late);
+        failures++;
+    }
+
+    printf ("%-24s %s\n", "late 3/1/0", failures ? "FAILED" : "ok");
+    return failures;
+}
+
+int main ()
+{
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof (test_cases) / sizeof (test_cases[0]); i++)
+        failures += run_case (test_cases[i]);
+    failures += run_late_case ();
+
+    printf ("%s\n", failures ? "exposure scheduler test FAILED" : "exposure scheduler test passed");
+    return failures ? 1 : 0;
+}
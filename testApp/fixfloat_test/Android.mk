@@ -0,0 +1,28 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES = fixfloat_test.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -O2 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include \
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+ifeq (1,$(strip $(shell expr $(PLATFORM_SDK_VERSION) \>= 26)))
+LOCAL_PROPRIETARY_MODULE := true
+endif
+endif
+
+# the converters are linked into librkisp from libisp_ebase
+LOCAL_SHARED_LIBRARIES += librkisp
+
+LOCAL_MODULE:= fixfloat_test
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,287 @@
+/*
+ * Compares the table converters UtlFloatToFixArray_* bit for bit with the
+ * single value converters UtlFloatToFix_*, for every format:
+ *
+ *   fixfloat_test [-s stride] [-f format]
+ *
+ * The inputs are every stride-th float bit pattern, -s 1 sweeps all 2^32
+ * of them, plus every code of the format with its rounding boundaries,
+ * the limits, zeros, denormals, infinities and NaNs. The table converters
+ * clamp what is out of range, so the reference clamps to the limits of
+ * the format before calling UtlFloatToFix_*, NaN going to the minimum.
+ *
+ * Converting one value at a time runs the scalar path, whole blocks run
+ * the NEON or SSE2 loop where the library is built with one.
+ *
+ * Returns non-zero on a mismatch.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <getopt.h>
+
+#include <ebase/utl_fixfloat.h>
+
+#define SWEEP_BLOCK         4096
+#define SWEEP_STRIDE        251
+#define MAX_REPORTED        8
+
+struct fixfloat_format {
+    const char *name;
+    uint32_t (*to_fix) (float);
+    void (*to_fix_array) (const float *, uint32_t *, uint32_t);
+    // limits and precision as in utl_fixfloat.c
+    float min;
+    float max;
+    float precision;
+};
+
+#define FIXFLOAT_FORMAT(fmt, min, max, precision) \
+    {#fmt, UtlFloatToFix_##fmt, UtlFloatToFixArray_##fmt, min, max, precision}
+
+static const fixfloat_format formats[] = {
+    FIXFLOAT_FORMAT (U0402,     0.0f,    15.875f,    4.0f),
+    FIXFLOAT_FORMAT (U0107,     0.0f,     1.996f,  128.0f),
+    FIXFLOAT_FORMAT (U0208,     0.0f,     3.998f,  256.0f),
+    FIXFLOAT_FORMAT (U0408,     0.0f,    15.998f,  256.0f),
+    FIXFLOAT_FORMAT (U0800,     0.0f,   255.499f,    1.0f),
+    FIXFLOAT_FORMAT (U1000,     0.0f,  1023.499f,    1.0f),
+    FIXFLOAT_FORMAT (U1200,     0.0f,  4095.499f,    1.0f),
+    FIXFLOAT_FORMAT (U0010,     0.0f,     0.9995f, 1024.0f),
+    FIXFLOAT_FORMAT (S0207,    -2.0f,     1.996f,  128.0f),
+    FIXFLOAT_FORMAT (S0307,    -4.0f,     3.996f,  128.0f),
+    FIXFLOAT_FORMAT (S0407,    -8.0f,     7.996f,  128.0f),
+    FIXFLOAT_FORMAT (S0504,   -16.0f,    15.968f,   16.0f),
+    FIXFLOAT_FORMAT (S0808,  -128.0f,   127.998f,  256.0f),
+    FIXFLOAT_FORMAT (S0800,  -128.0f,   127.499f,    1.0f),
+    FIXFLOAT_FORMAT (S0900,  -256.0f,   255.499f,    1.0f),
+    FIXFLOAT_FORMAT (S1200, -2048.0f,  2047.499f,    1.0f),
+    FIXFLOAT_FORMAT (S0109,    -1.0f,     0.999f,  512.0f),
+    FIXFLOAT_FORMAT (S0408,    -8.0f,     7.998f,  256.0f),
+    FIXFLOAT_FORMAT (S0108,    -1.0f,     0.998f,  256.0f),
+    FIXFLOAT_FORMAT (S0110,    -1.0f,     0.9995f, 1024.0f),
+};
+
+struct fixfloat_sweep {
+    const fixfloat_format *format;
+    float input[SWEEP_BLOCK];
+    uint32_t block[SWEEP_BLOCK];
+    uint32_t shifted[SWEEP_BLOCK];
+    uint32_t count;
+    uint64_t checked;
+    uint64_t mismatches;
+};
+
+static float
+bits_to_float (uint32_t bits)
+{
+    float value;
+    memcpy (&value, &bits, sizeof (value));
+    return value;
+}
+
+static uint32_t
+float_to_bits (float value)
+{
+    uint32_t bits;
+    memcpy (&bits, &value, sizeof (bits));
+    return bits;
+}
+
+// the single value converters assert on values out of range
+static uint32_t
+reference (const fixfloat_format *format, float value)
+{
+    if (!(value >= format->min))
+        value = format->min;
+    else if (value > format->max)
+        value = format->max;
+    return format->to_fix (value);
+}
+
+static void
+report (fixfloat_sweep &sweep, const char *path, float value, uint32_t expected, uint32_t got)
+{
+    if (sweep.mismatches++ < MAX_REPORTED)
+        printf ("  %s %s: 0x%08x (%g) gives 0x%x, expected 0x%x\n",
+                sweep.format->name, path, float_to_bits (value), value, got, expected);
+}
+
+static void
+flush (fixfloat_sweep &sweep)
+{
+    const fixfloat_format *format = sweep.format;
+    uint32_t count = sweep.count;
+
+    if (!count)
+        return;
+
+    format->to_fix_array (sweep.input, sweep.block, count);
+    // unaligned, with a tail left for the scalar loop
+    format->to_fix_array (sweep.input + 1, sweep.shifted, count - 1);
+
+    for (uint32_t i = 0; i < count; i++) {
+        float value = sweep.input[i];
+        uint32_t expected = reference (format, value);
+        uint32_t single = 0;
+
+        format->to_fix_array (&value, &single, 1);
+        if (single != expected)
+            report (sweep, "scalar", value, expected, single);
+        if (sweep.block[i] != expected)
+            report (sweep, "block", value, expected, sweep.block[i]);
+        if (i && sweep.shifted[i - 1] != expected)
+            report (sweep, "unaligned", value, expected, sweep.shifted[i - 1]);
+    }
+
+    sweep.checked += count;
+    sweep.count = 0;
+}
+
+static void
+add (fixfloat_sweep &sweep, float value)
+{
+    sweep.input[sweep.count++] = value;
+    if (sweep.count == SWEEP_BLOCK)
+        flush (sweep);
+}
+
+// a value and the floats right next to it
+static void
+add_around (fixfloat_sweep &sweep, float value)
+{
+    add (sweep, nextafterf (value, -INFINITY));
+    add (sweep, value);
+    add (sweep, nextafterf (value, INFINITY));
+}
+
+static void
+sweep_bits (fixfloat_sweep &sweep, uint32_t stride)
+{
+    for (uint64_t bits = 0; bits <= UINT32_MAX; bits += stride)
+        add (sweep, bits_to_float ((uint32_t)bits));
+}
+
+// every code of the format, the half way points between them and the limits
+static void
+sweep_codes (fixfloat_sweep &sweep)
+{
+    const fixfloat_format *format = sweep.format;
+    int32_t lowest = (int32_t)floorf (format->min * format->precision) - 2;
+    int32_t highest = (int32_t)ceilf (format->max * format->precision) + 2;
+
+    for (int32_t code = lowest; code <= highest; code++) {
+        add_around (sweep, code / format->precision);
+        add_around (sweep, (code + 0.5f) / format->precision);
+    }
+
+    add_around (sweep, format->min);
+    add_around (sweep, format->max);
+}
+
+static void
+sweep_special (fixfloat_sweep &sweep)
+{
+    static const uint32_t special[] = {
+        0x00000000, 0x80000000,     // zeros
+        0x00000001, 0x80000001,     // smallest denormals
+        0x007fffff, 0x807fffff,     // largest denormals
+        0x7f7fffff, 0xff7fffff,     // FLT_MAX
+        0x7f800000, 0xff800000,     // infinities
+        0x7fc00000, 0xffc00000,     // quiet NaNs
+        0x7f800001, 0xff800001,     // signalling NaNs
+        0x7fffffff, 0xffffffff,
+    };
+
+    for (size_t i = 0; i < sizeof (special) / sizeof (special[0]); i++)
+        add (sweep, bits_to_float (special[i]));
+}
+
+static int
+run_format (const fixfloat_format *format, uint32_t stride)
+{
+    static fixfloat_sweep sweep;
+
+    sweep.format = format;
+    sweep.count = 0;
+    sweep.checked = 0;
+    sweep.mismatches = 0;
+
+    sweep_special (sweep);
+    sweep_codes (sweep);
+    sweep_bits (sweep, stride);
+    flush (sweep);
+
+    printf ("%-6s %12llu inputs  %s\n", format->name, (unsigned long long)sweep.checked,
+            sweep.mismatches ? "FAILED" : "ok");
+    if (sweep.mismatches > MAX_REPORTED)
+        printf ("  %llu mismatches\n", (unsigned long long)sweep.mismatches);
+    return sweep.mismatches ? 1 : 0;
+}
+
+static void usage (const char *name)
+{
+    printf ("Usage: %s [options]\n"
+            "  -s, --stride n   step between the float bit patterns swept, default %d,\n"
+            "                   1 sweeps all of them\n"
+            "  -f, --format f   only check format f, e.g. S0407\n",
+            name, SWEEP_STRIDE);
+}
+
+int main (int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"stride", required_argument, 0, 's'},
+        {"format", required_argument, 0, 'f'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    const char *only = NULL;
+    long stride = SWEEP_STRIDE;
+    int failures = 0, checked = 0, c;
+
+    while ((c = getopt_long (argc, argv, "s:f:h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 's':
+            stride = atol (optarg);
+            break;
+        case 'f':
+            only = optarg;
+            break;
+        default:
+            usage (argv[0]);
+            return c == 'h' ? 0 : 1;
+        }
+    }
+
+    if (stride < 1 || stride > UINT32_MAX) {
+        usage (argv[0]);
+        return 1;
+    }
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    printf ("vector path: NEON\n");
+#elif defined(__SSE2__)
+    printf ("vector path: SSE2\n");
+#else
+    printf ("vector path: none, blocks run the scalar loop\n");
+#endif
+
+    for (size_t i = 0; i < sizeof (formats) / sizeof (formats[0]); i++) {
+        if (only && strcmp (only, formats[i].name))
+            continue;
+        failures += run_format (&formats[i], (uint32_t)stride);
+        checked++;
+    }
+
+    if (!checked) {
+        printf ("unknown format %s\n", only);
+        return 1;
+    }
+
+    printf ("%s\n", failures ? "fixfloat test FAILED" : "fixfloat test passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,52 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES = \
+	gain_table_test.cpp \
+	adpf_gain_check.c \
+	awdr_gain_check.c
+
+LOCAL_CPPFLAGS += -std=c++11 -Wno-error
+LOCAL_CPPFLAGS += -DLINUX
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+# the module sources are built into the checks, with the flags of the modules
+LOCAL_CFLAGS += -std=c99 -Wno-error
+LOCAL_CFLAGS += -DLINUX -DMIPI_USE_CAMERIC -DHAL_MOCKUP -DCAM_ENGINE_DRAW_DOM_ONLY -D_FILE_OFFSET_BITS=64 -DHAS_STDINT_H
+LOCAL_CFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/adpf/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/adpf/include_priv \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/adpf/source \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/awdr/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/awdr/include_priv \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/aaa/awdr/source \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/calib_xml/include \
+	$(LOCAL_PATH)/../../xcore \
+
+ifeq ($(IS_NEED_COMPILE_TINYXML2), true)
+LOCAL_C_INCLUDES += \
+	$(LOCAL_PATH)/../../ext/tinyxml2
+else
+LOCAL_C_INCLUDES += \
+	external/tinyxml2
+endif
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+ifeq (1,$(strip $(shell expr $(PLATFORM_SDK_VERSION) \>= 26)))
+LOCAL_PROPRIETARY_MODULE := true
+endif
+endif
+
+# the calibration database and the logging are linked into librkisp
+LOCAL_SHARED_LIBRARIES += librkisp
+
+LOCAL_MODULE:= gain_table_test
+
+include $(BUILD_EXECUTABLE)
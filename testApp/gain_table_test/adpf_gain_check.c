@@ -0,0 +1,225 @@
+/*
+ * The ADPF half of gain_table_test. The gain table and its lookups are
+ * static in adpf.c, so adpf.c is built in here. The searches the table
+ * replaced are kept below as they were before it, as the reference.
+ */
+#include <stdio.h>
+
+#include "adpf.c"
+#include "gain_table_test.h"
+
+#define MAX_REPORTED        8
+
+static const char* const AdpfCurveName[ADPF_GAIN_CURVE_MAX] = {
+  "denoise level",
+  "sharpening level",
+  "demosaic th",
+  "dsp 3dnr",
+  "new dsp 3dnr",
+};
+
+/*
+ * The nearest node search of AdpfCalculateDenoiseLevel, -SharpeningLevel,
+ * -DemosaicThLevel, -3DNRResult and -New3DNRResult. The last one tested
+ * n <= nMax after reading the node, which only reads one past the curve
+ * and gives the same node.
+ */
+static uint16_t OldAdpfGainCurveNode
+(
+    const float*    pSensorGain,
+    const uint16_t  ArraySize,
+    const float     fSensorGain
+) {
+  uint16_t n    = 0U;
+  uint16_t nMax = 0U;
+  float Dgain = fSensorGain;
+
+  nMax = (ArraySize - 1U);
+  /* lower range check */
+  if (Dgain < pSensorGain[0]) {
+    Dgain = pSensorGain[0];
+  }
+
+  /* upper range check */
+  if (Dgain > pSensorGain[nMax]) {
+    Dgain = pSensorGain[nMax];
+  }
+
+  /* find x area */
+  n = 0;
+  while ((n <= nMax) && (Dgain >=  pSensorGain[n])) {
+    ++n;
+  }
+  --n;
+
+  /**
+   * If n was larger than nMax, which means fSensorGain lies exactly on the
+  * last interval border, we count fSensorGain to the last interval and
+   * have to decrease n one more time */
+  if (n == nMax) {
+    --n;
+  }
+  float sub1 = ABS(pSensorGain[n] - Dgain);
+  float sub2 = ABS(pSensorGain[n + 1] - Dgain);
+  n = sub1 < sub2 ? n : n + 1;
+
+  return (n);
+}
+
+/* AdpfRKLpCalMatrix, interpolating each curve on its own */
+static RESULT OldAdpfRKLpCalMatrix
+(
+    const float             fSensorGain,
+	CamDemosaicLpProfile_t *pRKDLpConf,
+	RKDemosiacLpResult_t   *prkDLpResult
+)
+{
+	uint8_t counts = 6;
+	RESULT result = RET_SUCCESS;
+
+
+	if (pRKDLpConf == NULL) {
+		LOGV("%s: pRKDLpConf == NULL \n", __func__);
+		return (RET_INVALID_PARM);
+	}
+
+	if(fSensorGain < 1.0f)
+	{
+		LOGV( "%s: AECgain(%f) is invalid\n", __func__,fSensorGain );
+		 return ( RET_INVALID_PARM );
+	}
+
+	if (prkDLpResult == NULL) {
+		LOGV("%s: prkDLpResult == NULL \n", __func__);
+		return (RET_INVALID_PARM);
+	}
+
+	prkDLpResult->thgrad_divided[0] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thgrad_divided[1] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thgrad_divided[2] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thgrad_divided[3] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thgrad_divided[4] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thH_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thcsc_divided[0] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thcsc_divided[1] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thcsc_divided[2] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thcsc_divided[3] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thcsc_divided[4] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thCSC_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thdiff_divided[0] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thdiff_divided[1] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thdiff_divided[2] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thdiff_divided[3] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thdiff_divided[4] = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->diff_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thvar_divided[0] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided0), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thvar_divided[1] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided1), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thvar_divided[2] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided2), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thvar_divided[3] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided3), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thvar_divided[4] = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->varTh_divided4), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->th_grad = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->th_grad), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->th_diff = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->th_diff), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->th_csc = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->th_csc), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->th_var = (uint16_t)AdpfRKLpInterpolate((pRKDLpConf->th_var), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thgrad_r_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thgrad_r_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thdiff_r_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thdiff_r_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thvar_r_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thvar_r_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thgrad_b_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thgrad_b_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thdiff_b_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thdiff_b_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->thvar_b_fct = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->thvar_b_fct), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->similarity_th = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->similarity_th), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->flat_level_sel= (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->flat_level_sel), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->pattern_level_sel = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->pattern_level_sel), (pRKDLpConf->gainsArray), counts, fSensorGain);
+	prkDLpResult->edge_level_sel = (uint8_t)AdpfRKLpInterpolate((pRKDLpConf->edge_level_sel), (pRKDLpConf->gainsArray), counts, fSensorGain);
+
+	return ( result );
+}
+
+static void AdpfReport
+(
+    GainTableCheck_t*   pCheck,
+    const char*         what,
+    const float         fSensorGain,
+    const int           expected,
+    const int           got
+) {
+  if (pCheck->mismatches++ < MAX_REPORTED) {
+    printf("  %s: %s at gain %.9g gives %d, expected %d\n",
+           pCheck->file, what, fSensorGain, got, expected);
+  }
+}
+
+void AdpfGainTableCheck
+(
+    GainTableCheck_t*           pCheck,
+    CamFilterProfile_t*         pFilterProfile,
+    CamDsp3DNRSettingProfile_t* p3DNRProfile,
+    CamNewDsp3DNRProfile_t*     pNew3DNRProfile,
+    const float*                pGain,
+    const uint32_t              NoGains
+) {
+  static AdpfContext_t AdpfCtx;
+  AdpfGainTable_t* pTable = &AdpfCtx.GainTable[0];
+  CamDemosaicLpProfile_t* pLpConf = &pFilterProfile->DemosaicLpConf;
+  bool_t check[ADPF_GAIN_CURVE_MAX];
+  uint32_t i;
+  int curve;
+
+  MEMSET(&AdpfCtx, 0, sizeof(AdpfCtx));
+  AdpfGainTableBuild(pTable, pFilterProfile, p3DNRProfile, pNew3DNRProfile);
+  AdpfCtx.pGainTable = pTable;
+
+  for (curve = 0; curve < ADPF_GAIN_CURVE_MAX; curve++) {
+    /* the old search reads past curves of less than two nodes */
+    check[curve] = (pTable->pCurveGain[curve] != NULL) && (pTable->CurveSize[curve] >= 2U);
+    if (check[curve]) {
+      if (pTable->CurveValid[curve]) {
+        pCheck->tabled++;
+      } else {
+        pCheck->searched++;
+      }
+    }
+  }
+  if (pTable->LpValid) {
+    pCheck->tabled++;
+  } else {
+    pCheck->searched++;
+  }
+
+  /* all curves per gain, as a frame looks them up */
+  for (i = 0U; i < NoGains; i++) {
+    RKDemosiacLpResult_t expected, got;
+    RESULT expectedResult, gotResult;
+
+    for (curve = 0; curve < ADPF_GAIN_CURVE_MAX; curve++) {
+      uint16_t expectedNode, gotNode;
+
+      if (!check[curve]) {
+        continue;
+      }
+
+      expectedNode = OldAdpfGainCurveNode(pTable->pCurveGain[curve], pTable->CurveSize[curve], pGain[i]);
+      gotNode = AdpfGainCurveNode(&AdpfCtx, (AdpfGainCurve_t)curve,
+                                  pTable->pCurveGain[curve], pTable->CurveSize[curve], pGain[i]);
+      if (gotNode != expectedNode) {
+        AdpfReport(pCheck, AdpfCurveName[curve], pGain[i], expectedNode, gotNode);
+      }
+      pCheck->checked++;
+    }
+
+    MEMSET(&expected, 0, sizeof(expected));
+    MEMSET(&got, 0, sizeof(got));
+    expectedResult = OldAdpfRKLpCalMatrix(pGain[i], pLpConf, &expected);
+    gotResult = AdpfRKLpCalMatrix(&AdpfCtx, pGain[i], pLpConf, &got);
+    if (gotResult != expectedResult) {
+      AdpfReport(pCheck, "demosaic lp result", pGain[i], expectedResult, gotResult);
+    } else if (memcmp(&got, &expected, sizeof(got))) {
+      const uint8_t* pExpected = (const uint8_t*)&expected;
+      const uint8_t* pGot = (const uint8_t*)&got;
+      char what[32];
+      size_t k;
+
+      for (k = 0; pExpected[k] == pGot[k]; k++);
+      snprintf(what, sizeof(what), "demosaic lp byte %u", (unsigned)k);
+      AdpfReport(pCheck, what, pGain[i], pExpected[k], pGot[k]);
+    }
+    pCheck->checked++;
+  }
+}
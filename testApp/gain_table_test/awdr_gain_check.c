@@ -0,0 +1,140 @@
+/*
+ * The AWDR half of gain_table_test. The gain table and its lookup are
+ * static in awdr.c, so awdr.c is built in here. The search the table
+ * replaced is kept below as it was before it, as the reference.
+ */
+#include <stdio.h>
+
+#include "awdr.c"
+#include "gain_table_test.h"
+
+#define MAX_REPORTED        8
+
+/*
+ * AwdrCalculateWdrMaxGainLevel as it was, less the logs. It tested n <= nMax after
+ * reading the node, which only reads one past the curve and gives the
+ * same level.
+ */
+static RESULT OldAwdrCalculateWdrMaxGainLevel
+(
+    CamCalibWdrMaxGainLevelCurve_t* pWdrMaxGainLevelCurve,
+    const float             fSensorGain,
+    uint8_t*       MaxGainLevelRegValue
+) {
+  if (pWdrMaxGainLevelCurve == NULL) {
+    return (RET_NULL_POINTER);
+  }
+
+  if (fSensorGain < 1.0f) {
+    return (RET_INVALID_PARM);
+  }
+
+  if (pWdrMaxGainLevelCurve->nSize < 1) {
+    return (RET_INVALID_PARM);
+  }
+
+  uint16_t n    = 0U;
+  uint16_t nMax = 0U;
+  float Dgain = fSensorGain;
+  float MaxGainResult = 1.0;
+  nMax = (pWdrMaxGainLevelCurve->nSize - 1U);
+
+  /* lower range check */
+  if (Dgain < pWdrMaxGainLevelCurve->pfSensorGain_level[0]) {
+    Dgain = pWdrMaxGainLevelCurve->pfSensorGain_level[0];
+  }
+
+  /* upper range check */
+  if (Dgain > pWdrMaxGainLevelCurve->pfSensorGain_level[nMax]) {
+    Dgain = pWdrMaxGainLevelCurve->pfSensorGain_level[nMax];
+  }
+
+  /* find x area */
+  n = 0;
+  while ((n <= nMax) && (Dgain >=  pWdrMaxGainLevelCurve->pfSensorGain_level[n])) {
+    ++n;
+  }
+  --n;
+
+  /**
+   * If n was larger than nMax, which means fSensorGain lies exactly on the
+  * last interval border, we count fSensorGain to the last interval and
+   * have to decrease n one more time */
+  if (n == nMax) {
+    --n;
+  }
+
+  MaxGainResult = pWdrMaxGainLevelCurve->pfMaxGain_level[n + 1];
+
+  if (Dgain == pWdrMaxGainLevelCurve->pfSensorGain_level[0])
+    MaxGainResult = pWdrMaxGainLevelCurve->pfMaxGain_level[0];
+
+  if (MaxGainResult < 1.0)
+    MaxGainResult = 1.0;
+
+  if (MaxGainResult > 15.0)
+    MaxGainResult = 15.0;
+
+  *MaxGainLevelRegValue = (((uint8_t)MaxGainResult) << 4);
+
+  return (RET_SUCCESS);
+}
+
+static void AwdrReport
+(
+    GainTableCheck_t*   pCheck,
+    const char*         what,
+    const float         fSensorGain,
+    const int           expected,
+    const int           got
+) {
+  if (pCheck->mismatches++ < MAX_REPORTED) {
+    printf("  %s: %s at gain %.9g gives %d, expected %d\n",
+           pCheck->file, what, fSensorGain, got, expected);
+  }
+}
+
+void AwdrGainTableCheck
+(
+    GainTableCheck_t*               pCheck,
+    CamCalibWdrMaxGainLevelCurve_t* pCurve,
+    const float*                    pGain,
+    const uint32_t                  NoGains
+) {
+  static AwdrContext_t AwdrCtx;
+  uint32_t i;
+
+  /* the old search reads past curves of less than two nodes */
+  if ((pCurve->pfSensorGain_level == NULL) || (pCurve->pfMaxGain_level == NULL)
+      || (pCurve->nSize < 2U)) {
+    return;
+  }
+
+  MEMSET(&AwdrCtx, 0, sizeof(AwdrCtx));
+  AwdrGainTableBuild(&AwdrCtx.GainTable, pCurve);
+  if (AwdrCtx.GainTable.Valid) {
+    pCheck->tabled++;
+  } else {
+    pCheck->searched++;
+  }
+
+  for (i = 0U; i < NoGains; i++) {
+    uint8_t expected = 0U, got = 0U;
+    RESULT expectedResult, gotResult;
+
+    /* both reject gains below 1.0 with an error log, the gains are
+     * ascending and the last of them is enough */
+    if ((pGain[i] < 1.0f) && ((i + 1U) < NoGains) && (pGain[i + 1U] < 1.0f)) {
+      continue;
+    }
+
+    expectedResult = OldAwdrCalculateWdrMaxGainLevel(pCurve, pGain[i], &expected);
+    gotResult = AwdrCalculateWdrMaxGainLevel(&AwdrCtx, pCurve, pGain[i], &got);
+    if (gotResult != expectedResult) {
+      AwdrReport(pCheck, "wdr max gain level result", pGain[i], expectedResult, gotResult);
+    } else if (got != expected) {
+      AwdrReport(pCheck, "wdr max gain level", pGain[i], expected, got);
+    }
+    pCheck->checked++;
+  }
+}
@@ -0,0 +1,248 @@
+/*
+ * Compares the ADPF and AWDR gain tables bit for bit with the linear
+ * searches they replaced, over the curves of the calibration files:
+ *
+ *   gain_table_test [iqfile ...]
+ *
+ * With no file every *.xml under ./iqfiles is run. For every resolution,
+ * each filter profile is checked with the dsp 3dnr and new dsp 3dnr
+ * profiles of the same index, as a light mode is, and the wdr max gain
+ * curve on its own. The gains are every node of the curves with the
+ * floats right next to it, the midpoints between the nodes of each curve
+ * and of all of them, and the ends out of range on both sides.
+ *
+ * The level curves compare the node found, the demosaic lp curves the
+ * whole RKDemosiacLpResult_t and the wdr curve the register value and
+ * the return code, a gain below 1.0 included.
+ *
+ * Returns non-zero on a mismatch.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <calib_xml/calibdb.h>
+
+#include "gain_table_test.h"
+
+#define IQFILES_DIR         "iqfiles"
+#define MAX_RESOLUTIONS     32
+#define MAX_REPORTED        8
+
+struct gain_curve {
+    const float *gain;
+    uint32_t size;
+};
+
+// a gain and the floats right next to it
+static void
+add_around (std::vector<float> &gains, float gain)
+{
+    gains.push_back (nextafterf (gain, -INFINITY));
+    gains.push_back (gain);
+    gains.push_back (nextafterf (gain, INFINITY));
+}
+
+static std::vector<float>
+sweep (const std::vector<gain_curve> &curves)
+{
+    std::vector<float> nodes, gains;
+
+    for (size_t c = 0; c < curves.size (); c++) {
+        const gain_curve &curve = curves[c];
+
+        if (!curve.gain)
+            continue;
+        for (uint32_t i = 0; i < curve.size; i++) {
+            if (!isfinite (curve.gain[i]))
+                continue;
+            nodes.push_back (curve.gain[i]);
+            add_around (gains, curve.gain[i]);
+            // where a level curve turns from one node to the next
+            if (i + 1 < curve.size && isfinite (curve.gain[i + 1]))
+                add_around (gains, (curve.gain[i] + curve.gain[i + 1]) / 2.0f);
+        }
+    }
+
+    std::sort (nodes.begin (), nodes.end ());
+    nodes.erase (std::unique (nodes.begin (), nodes.end ()), nodes.end ());
+    for (size_t i = 1; i < nodes.size (); i++)
+        add_around (gains, (nodes[i - 1] + nodes[i]) / 2.0f);
+
+    // the ends, the engine rejects gains below 1.0 before the lookups
+    static const float ends[] = {-INFINITY, -1.0f, 0.0f, 0.5f, 1.0f, FLT_MAX, INFINITY};
+    for (size_t i = 0; i < sizeof (ends) / sizeof (ends[0]); i++)
+        add_around (gains, ends[i]);
+    if (!nodes.empty ()) {
+        add_around (gains, nodes.front () / 2.0f);
+        add_around (gains, nodes.front () - 1.0f);
+        add_around (gains, nodes.back () + 1.0f);
+        add_around (gains, nodes.back () * 2.0f);
+    }
+
+    // NaN fails every comparison, the old searches run off the curve
+    gains.erase (std::remove_if (gains.begin (), gains.end (),
+                                 [] (float gain) { return isnan (gain); }), gains.end ());
+    std::sort (gains.begin (), gains.end ());
+    gains.erase (std::unique (gains.begin (), gains.end ()), gains.end ());
+    return gains;
+}
+
+static void
+check_dpf (GainTableCheck_t &check, CamCalibDbHandle_t hCalib, CamDpfProfile_t *pDpfProfile)
+{
+    int32_t no_filter = 0, no_3dnr = 0, no_new_3dnr = 0;
+
+    if (CamCalibDbGetNoOfFilterProfile (hCalib, pDpfProfile, &no_filter) != RET_SUCCESS)
+        no_filter = 0;
+    if (CamCalibDbGetNoOfDsp3DNRSetting (hCalib, pDpfProfile, &no_3dnr) != RET_SUCCESS)
+        no_3dnr = 0;
+    if (CamCalibDbGetNoOfNewDsp3DNRSetting (hCalib, pDpfProfile, &no_new_3dnr) != RET_SUCCESS)
+        no_new_3dnr = 0;
+
+    for (int32_t i = 0; i < no_filter; i++) {
+        CamFilterProfile_t *pFilter = NULL;
+        CamDsp3DNRSettingProfile_t *p3dnr = NULL;
+        CamNewDsp3DNRProfile_t *pNew3dnr = NULL;
+        // the engine builds the table from zeroed profiles where none is set
+        CamDsp3DNRSettingProfile_t no3dnr;
+        CamNewDsp3DNRProfile_t noNew3dnr;
+        std::vector<gain_curve> curves;
+
+        memset (&no3dnr, 0, sizeof (no3dnr));
+        memset (&noNew3dnr, 0, sizeof (noNew3dnr));
+
+        if (CamCalibDbGetFilterProfileByIdx (hCalib, pDpfProfile, i, &pFilter) != RET_SUCCESS || !pFilter)
+            continue;
+        if (i >= no_3dnr || CamCalibDbGetDsp3DNRByIdx (hCalib, pDpfProfile, i, &p3dnr) != RET_SUCCESS || !p3dnr)
+            p3dnr = &no3dnr;
+        if (i >= no_new_3dnr || CamCalibDbGetNewDsp3DNRByIdx (hCalib, pDpfProfile, i, &pNew3dnr) != RET_SUCCESS || !pNew3dnr)
+            pNew3dnr = &noNew3dnr;
+
+        curves.push_back ({pFilter->DenoiseLevelCurve.pSensorGain, pFilter->DenoiseLevelCurve.ArraySize});
+        curves.push_back ({pFilter->SharpeningLevelCurve.pSensorGain, pFilter->SharpeningLevelCurve.ArraySize});
+        curves.push_back ({pFilter->DemosaicThCurve.pSensorGain, pFilter->DemosaicThCurve.ArraySize});
+        curves.push_back ({p3dnr->pgain_Level, p3dnr->ArraySize});
+        curves.push_back ({pNew3dnr->pgain_Level, pNew3dnr->ArraySize});
+        curves.push_back ({pFilter->DemosaicLpConf.gainsArray, pFilter->DemosaicLpConf.gainsArray_ArraySize});
+
+        std::vector<float> gains = sweep (curves);
+        AdpfGainTableCheck (&check, pFilter, p3dnr, pNew3dnr, gains.data (), gains.size ());
+    }
+}
+
+static int
+run_file (const char *file, uint32_t &tabled)
+{
+    GainTableCheck_t check;
+    CalibDb db;
+    CamCalibDbHandle_t hCalib;
+    CamCalibWdrGlobal_t *pWdrGlobal = NULL;
+    int32_t no_res = 0;
+
+    memset (&check, 0, sizeof (check));
+    check.file = file;
+
+    if (!db.CreateCalibDb (file) || !(hCalib = db.GetCalibDbHandle ())) {
+        printf ("%-50s can't load the calibration database  FAILED\n", file);
+        return 1;
+    }
+
+    /*
+     * CamCalibDbGetResolutionNameByIdx takes the id of the resolution, a
+     * bit mask starting at 0x1, not its position
+     */
+    if (CamCalibDbGetNoOfResolutions (hCalib, &no_res) != RET_SUCCESS)
+        no_res = 0;
+    for (int32_t i = 0; i < no_res && i < MAX_RESOLUTIONS; i++) {
+        CamResolutionName_t name;
+        CamDpfProfile_t *pDpfProfile = NULL;
+
+        memset (name, 0, sizeof (name));
+        if (CamCalibDbGetResolutionNameByIdx (hCalib, 1u << i, &name) != RET_SUCCESS)
+            continue;
+        if (CamCalibDbGetDpfProfileByResolution (hCalib, name, &pDpfProfile) != RET_SUCCESS || !pDpfProfile)
+            continue;
+        check_dpf (check, hCalib, pDpfProfile);
+    }
+
+    if (CamCalibDbGetWdrGlobal (hCalib, &pWdrGlobal) == RET_SUCCESS && pWdrGlobal) {
+        CamCalibWdrMaxGainLevelCurve_t *pCurve = &pWdrGlobal->wdr_MaxGain_Level_curve;
+        std::vector<gain_curve> curves;
+
+        curves.push_back ({pCurve->pfSensorGain_level, pCurve->nSize});
+        std::vector<float> gains = sweep (curves);
+        AwdrGainTableCheck (&check, pCurve, gains.data (), gains.size ());
+    }
+
+    printf ("%-50s %7u lookups %3u curves tabled %3u searched  %s\n", file, check.checked,
+            check.tabled, check.searched, check.mismatches ? "FAILED" : "ok");
+    if (check.mismatches > MAX_REPORTED)
+        printf ("  %u mismatches\n", check.mismatches);
+    tabled += check.tabled;
+    return check.mismatches ? 1 : 0;
+}
+
+static void usage (const char *name)
+{
+    printf ("Usage: %s [options] [iqfile ...]\n"
+            "  with no iqfile every *.xml under ./%s is run\n"
+            "  -h, --help   this text\n",
+            name, IQFILES_DIR);
+}
+
+int main (int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    std::vector<std::string> files;
+    uint32_t tabled = 0;
+    int failures = 0, c;
+
+    while ((c = getopt_long (argc, argv, "h", long_options, NULL)) != -1) {
+        usage (argv[0]);
+        return c == 'h' ? 0 : 1;
+    }
+
+    for (int i = optind; i < argc; i++)
+        files.push_back (argv[i]);
+
+    if (files.empty ()) {
+        DIR *dir = opendir (IQFILES_DIR);
+        struct dirent *entry;
+
+        if (!dir) {
+            printf ("can't open %s, run from the top of the tree or name the iqfiles\n", IQFILES_DIR);
+            return 1;
+        }
+        while ((entry = readdir (dir)) != NULL) {
+            size_t len = strlen (entry->d_name);
+            if (len > 4 && !strcmp (entry->d_name + len - 4, ".xml"))
+                files.push_back (std::string (IQFILES_DIR "/") + entry->d_name);
+        }
+        closedir (dir);
+        std::sort (files.begin (), files.end ());
+    }
+
+    for (size_t i = 0; i < files.size (); i++)
+        failures += run_file (files[i].c_str (), tabled);
+
+    // with no curve in a table only the search was compared with itself
+    if (!tabled) {
+        printf ("no curve went into a gain table, nothing was checked\n");
+        failures++;
+    }
+
+    printf ("%s\n", failures ? "gain table test FAILED" : "gain table test passed");
+    return failures ? 1 : 0;
+}
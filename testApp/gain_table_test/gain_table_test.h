@@ -0,0 +1,54 @@
+/*
+ * The checks of gain_table_test, in C next to the module sources they
+ * build in.
+ */
+#ifndef __GAIN_TABLE_TEST_H__
+#define __GAIN_TABLE_TEST_H__
+
+#include <stdint.h>
+
+#include <common/cam_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct GainTableCheck_s {
+  const char* file;         /**< reported with the mismatches */
+  uint32_t    checked;      /**< lookups compared */
+  uint32_t    tabled;       /**< curves looked up through a gain table */
+  uint32_t    searched;     /**< curves the table left to the search */
+  uint32_t    mismatches;
+} GainTableCheck_t;
+
+/*
+ * Builds the ADPF gain table of one light mode and compares every level
+ * curve and the demosaic lp curves with the old searches at each gain.
+ */
+void AdpfGainTableCheck
+(
+    GainTableCheck_t*           pCheck,
+    CamFilterProfile_t*         pFilterProfile,
+    CamDsp3DNRSettingProfile_t* p3DNRProfile,
+    CamNewDsp3DNRProfile_t*     pNew3DNRProfile,
+    const float*                pGain,
+    const uint32_t              NoGains
+);
+
+/*
+ * Builds the AWDR gain table and compares the max gain level with the
+ * old search at each gain.
+ */
+void AwdrGainTableCheck
+(
+    GainTableCheck_t*               pCheck,
+    CamCalibWdrMaxGainLevelCurve_t* pCurve,
+    const float*                    pGain,
+    const uint32_t                  NoGains
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
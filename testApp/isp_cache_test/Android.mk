@@ -0,0 +1,44 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES = isp_cache_test.cpp
+
+LOCAL_CPPFLAGS += -std=c++11 -Wno-error
+LOCAL_CPPFLAGS += -D_GLIBCXX_USE_C99=1 -DLINUX -DENABLE_ASSERT
+LOCAL_CPPFLAGS += $(PRJ_CPPFLAGS)
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(LOCAL_PATH)/../../rkisp/ia-engine \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/cam_ia_api \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include/linux \
+	$(LOCAL_PATH)/../../rkisp/ia-engine/include/linux/media \
+	$(LOCAL_PATH)/../../rkisp/isp-engine \
+	$(LOCAL_PATH)/../../xcore \
+	$(LOCAL_PATH)/../../xcore/ia \
+	$(LOCAL_PATH)/../../plugins/3a/rkiq \
+
+ifeq ($(IS_NEED_COMPILE_TINYXML2), true)
+LOCAL_C_INCLUDES += \
+	$(LOCAL_PATH)/../../ext/tinyxml2
+else
+LOCAL_C_INCLUDES += \
+	external/tinyxml2
+endif
+
+ifeq ($(IS_ANDROID_OS),true)
+LOCAL_32_BIT_ONLY := true
+LOCAL_SHARED_LIBRARIES += libutils libcutils liblog
+ifeq (1,$(strip $(shell expr $(PLATFORM_SDK_VERSION) \>= 26)))
+LOCAL_PROPRIETARY_MODULE := true
+endif
+endif
+
+# CamIA10Engine and the calibration database are linked into librkisp
+LOCAL_SHARED_LIBRARIES += librkisp
+
+LOCAL_MODULE:= isp_cache_test
+
+include $(BUILD_EXECUTABLE)
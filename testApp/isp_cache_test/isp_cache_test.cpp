@@ -0,0 +1,416 @@
+/*
+ * Checks the static ISP module cache of CamIA10Engine against the way the
+ * tuning tool edits the calibration database:
+ *
+ *   isp_cache_test [iqfile ...]
+ *
+ * With no file every *.xml under ./iqfiles is run. Three engines share the
+ * database of each file, one caching the static modules, one in verify mode
+ * and one with the cache off as the reference. GOC and FLT are resolved for
+ * both light modes and every filter level of the file, then the GOC and
+ * filter profiles are changed in place through the pointers the database
+ * hands out, as RKiqCompositor::tuning_tool_set_goc/_flt do.
+ *
+ * Until CamCalibDbTouch is called the caching engine keeps serving what it
+ * resolved before, this is checked too so the test can tell a stale result
+ * from a good one. After the touch all three engines must agree bit for
+ * bit and verify mode must not report anything.
+ *
+ * Returns non-zero on a mismatch.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "cam_ia10_engine.h"
+
+#define IQFILES_DIR         "iqfiles"
+#define EDIT_ROUNDS         2
+#define MAX_REPORTED        8
+
+enum {
+    ENGINE_CACHED,
+    ENGINE_VERIFY,
+    ENGINE_REFERENCE,
+    ENGINE_MAX
+};
+
+static const char *engine_modes[ENGINE_MAX] = {"1", "verify", "0"};
+
+struct cache_config {
+    uint32_t mask;
+    enum HAL_ISP_ACTIVE_MODE mode;
+    struct HAL_ISP_goc_cfg_s goc;
+    struct HAL_ISP_flt_cfg_s flt;
+};
+
+struct cache_run {
+    const char *file;
+    CamIA10Engine *engines[ENGINE_MAX];
+    CamCalibDbHandle_t hCalib;
+    CamDpfProfile_t *pDpfProfile;
+    std::vector<cache_config> configs;
+    uint32_t checked;
+    uint32_t stale;
+    uint32_t mismatches;
+};
+
+static void
+add_goc (cache_run &run, enum LIGHT_MODE light_mode)
+{
+    cache_config config;
+
+    memset (&config, 0, sizeof (config));
+    config.mask = HAL_ISP_GOC_MASK;
+    config.mode = HAL_ISP_ACTIVE_DEFAULT;
+    config.goc.light_mode = light_mode;
+    run.configs.push_back (config);
+}
+
+static void
+add_flt (cache_run &run, enum HAL_ISP_ACTIVE_MODE mode, uint8_t level, enum LIGHT_MODE light_mode)
+{
+    cache_config config;
+
+    memset (&config, 0, sizeof (config));
+    config.mask = HAL_ISP_FLT_MASK;
+    config.mode = mode;
+    config.flt.denoise_level = level;
+    config.flt.sharp_level = level;
+    config.flt.light_mode = light_mode;
+    run.configs.push_back (config);
+}
+
+// GOC of both light modes, FLT by default and at every level of the file
+static void
+build_configs (cache_run &run)
+{
+    enum LIGHT_MODE light_modes[] = {LIGHT_MODE_DAY, LIGHT_MODE_NIGHT};
+    std::vector<uint8_t> levels;
+    int32_t no_filter = 0;
+
+    if (run.pDpfProfile &&
+            CamCalibDbGetNoOfFilterProfile (run.hCalib, run.pDpfProfile, &no_filter) != RET_SUCCESS)
+        no_filter = 0;
+    for (int32_t i = 0; i < no_filter; i++) {
+        CamFilterProfile_t *pFilterProfile = NULL;
+        if (CamCalibDbGetFilterProfileByIdx (run.hCalib, run.pDpfProfile, i, &pFilterProfile) != RET_SUCCESS ||
+                !pFilterProfile)
+            continue;
+        CamFilterLevelRegConf_t &conf = pFilterProfile->FiltLevelRegConf;
+        for (int j = 0; j < conf.ArraySize; j++)
+            if (std::find (levels.begin (), levels.end (), conf.p_FiltLevel[j]) == levels.end ())
+                levels.push_back (conf.p_FiltLevel[j]);
+    }
+    if (levels.empty ())
+        levels.push_back (2);
+
+    add_flt (run, HAL_ISP_ACTIVE_DEFAULT, 0, LIGHT_MODE_DAY);
+    for (size_t i = 0; i < sizeof (light_modes) / sizeof (light_modes[0]); i++) {
+        add_goc (run, light_modes[i]);
+        for (size_t j = 0; j < levels.size (); j++)
+            add_flt (run, HAL_ISP_ACTIVE_SETTING, levels[j], light_modes[i]);
+    }
+}
+
+static RESULT
+resolve (CamIA10Engine *engine, const cache_config &config, struct CamIA10_Results &result)
+{
+    struct HAL_ISP_cfg_s manCfg;
+    struct HAL_ISP_goc_cfg_s goc = config.goc;
+    struct HAL_ISP_flt_cfg_s flt = config.flt;
+
+    memset (&manCfg, 0, sizeof (manCfg));
+    memset (&result, 0, sizeof (result));
+    manCfg.updated_mask = config.mask;
+    if (config.mask & HAL_ISP_GOC_MASK) {
+        manCfg.enabled[HAL_ISP_GOC_ID] = config.mode;
+        manCfg.goc_cfg = &goc;
+    } else {
+        manCfg.enabled[HAL_ISP_FLT_ID] = config.mode;
+        manCfg.flt_cfg = &flt;
+    }
+    return engine->runManISP (&manCfg, &result);
+}
+
+static bool
+same_result (const cache_config &config, const struct CamIA10_Results &a, const struct CamIA10_Results &b)
+{
+    if (config.mask & HAL_ISP_GOC_MASK)
+        return !memcmp (&a.goc, &b.goc, sizeof (a.goc));
+    return !memcmp (&a.flt, &b.flt, sizeof (a.flt));
+}
+
+static const char *
+config_name (const cache_config &config, char *name, size_t size)
+{
+    if (config.mask & HAL_ISP_GOC_MASK)
+        snprintf (name, size, "GOC default, light mode %d", config.goc.light_mode);
+    else if (config.mode == HAL_ISP_ACTIVE_DEFAULT)
+        snprintf (name, size, "FLT default");
+    else
+        snprintf (name, size, "FLT level %d, light mode %d", config.flt.denoise_level, config.flt.light_mode);
+    return name;
+}
+
+static void
+report (cache_run &run, const char *what, const cache_config &config)
+{
+    char name[64];
+
+    if (run.mismatches++ < MAX_REPORTED)
+        printf ("  %s: %s %s\n", run.file, config_name (config, name, sizeof (name)), what);
+}
+
+/*
+ * Resolves @config on the three engines. The verify and reference engines
+ * always resolve, the cached engine is stale when it differs from them and
+ * @touched tells whether that is allowed. True when it was stale.
+ */
+static bool
+check (cache_run &run, const cache_config &config, bool touched)
+{
+    static struct CamIA10_Results results[ENGINE_MAX];
+    RESULT ret[ENGINE_MAX];
+    bool stale = false;
+
+    for (int e = 0; e < ENGINE_MAX; e++)
+        ret[e] = resolve (run.engines[e], config, results[e]);
+
+    if (ret[ENGINE_VERIFY] != ret[ENGINE_REFERENCE] ||
+            !same_result (config, results[ENGINE_VERIFY], results[ENGINE_REFERENCE]))
+        report (run, "differs in verify mode", config);
+
+    if (ret[ENGINE_CACHED] != ret[ENGINE_REFERENCE] ||
+            !same_result (config, results[ENGINE_CACHED], results[ENGINE_REFERENCE])) {
+        if (touched)
+            report (run, "is stale after CamCalibDbTouch", config);
+        else
+            run.stale++;
+        stale = true;
+    }
+    run.checked++;
+    return stale;
+}
+
+// what tuning_tool_set_goc writes, a new curve and segmentation mode
+static void
+edit_goc (cache_run &run, int edit)
+{
+    int32_t no_goc = 0;
+
+    if (CamCalibDbGetNoOfGocProfile (run.hCalib, &no_goc) != RET_SUCCESS)
+        return;
+    for (int32_t i = 0; i < no_goc; i++) {
+        CamCalibGocProfile_t *pGocProfile = NULL;
+        if (CamCalibDbGetGocProfileByIdx (run.hCalib, i, &pGocProfile) != RET_SUCCESS || !pGocProfile)
+            continue;
+        pGocProfile->def_cfg_mode = (pGocProfile->def_cfg_mode == HAL_ISP_GAMMA_SEG_MODE_LOGARITHMIC) ?
+                                    HAL_ISP_GAMMA_SEG_MODE_EQUIDISTANT : HAL_ISP_GAMMA_SEG_MODE_LOGARITHMIC;
+        for (int j = 0; j < 34; j++)
+            pGocProfile->GammaY[j] = std::min (4095, j * 120 + edit % 64 + 1);
+    }
+}
+
+// what tuning_tool_set_flt writes, the filter registers of every level
+static void
+edit_flt (cache_run &run, int edit)
+{
+    int32_t no_filter = 0;
+
+    if (!run.pDpfProfile ||
+            CamCalibDbGetNoOfFilterProfile (run.hCalib, run.pDpfProfile, &no_filter) != RET_SUCCESS)
+        return;
+    for (int32_t i = 0; i < no_filter; i++) {
+        CamFilterProfile_t *pFilterProfile = NULL;
+        if (CamCalibDbGetFilterProfileByIdx (run.hCalib, run.pDpfProfile, i, &pFilterProfile) != RET_SUCCESS ||
+                !pFilterProfile)
+            continue;
+        CamFilterLevelRegConf_t &conf = pFilterProfile->FiltLevelRegConf;
+        conf.FiltLevelRegConfEnable = 1;
+        for (int j = 0; j < conf.ArraySize; j++) {
+            conf.p_grn_stage1[j] = (conf.p_grn_stage1[j] + 1) & 0x7;
+            conf.p_chr_h_mode[j] = (conf.p_chr_h_mode[j] + 1) & 0x3;
+            conf.p_chr_v_mode[j] = (conf.p_chr_v_mode[j] + 1) & 0x3;
+            conf.p_thresh_bl0[j] += edit % 8 + 1;
+            conf.p_thresh_bl1[j] += edit % 8 + 1;
+            conf.p_thresh_sh0[j] += edit % 8 + 1;
+            conf.p_thresh_sh1[j] += edit % 8 + 1;
+            conf.p_fac_sh0[j] += 1;
+            conf.p_fac_sh1[j] += 1;
+            conf.p_fac_mid[j] += 1;
+            conf.p_fac_bl0[j] += 1;
+            conf.p_fac_bl1[j] += 1;
+        }
+    }
+}
+
+static bool
+setup (cache_run &run)
+{
+    int32_t no_res = 0;
+    int width = 0, height = 0;
+
+    for (int e = 0; e < ENGINE_MAX; e++) {
+        // the cache mode is read when the engine is built
+        setenv ("persist_camera_engine_isp_cache", engine_modes[e], 1);
+        run.engines[e] = new CamIA10Engine ();
+        // same file, so all of them get the same database
+        if (run.engines[e]->initStatic ((char*)run.file, "isp_cache_test", 0) != RET_SUCCESS) {
+            printf ("  %s: initStatic failed\n", run.file);
+            return false;
+        }
+    }
+    unsetenv ("persist_camera_engine_isp_cache");
+
+    run.engines[ENGINE_REFERENCE]->getCalibdbHandle (&run.hCalib);
+    if (!run.hCalib) {
+        printf ("  %s: no calibration database\n", run.file);
+        return false;
+    }
+
+    /*
+     * the first resolution of the file, FLT looks its DPF profile up by it.
+     * CamCalibDbGetResolutionNameByIdx takes the id of the resolution, a
+     * bit mask starting at 0x1, not its position
+     */
+    if (CamCalibDbGetNoOfResolutions (run.hCalib, &no_res) == RET_SUCCESS && no_res > 0) {
+        CamResolutionName_t name;
+        CamResolution_t *pResolution = NULL;
+        memset (name, 0, sizeof (name));
+        if (CamCalibDbGetResolutionNameByIdx (run.hCalib, 0x1, &name) == RET_SUCCESS &&
+                CamCalibDbGetResolutionByName (run.hCalib, name, &pResolution) == RET_SUCCESS &&
+                pResolution) {
+            width = pResolution->width;
+            height = pResolution->height;
+            if (CamCalibDbGetDpfProfileByResolution (run.hCalib, name, &run.pDpfProfile) != RET_SUCCESS)
+                run.pDpfProfile = NULL;
+        }
+    }
+    for (int e = 0; e < ENGINE_MAX; e++) {
+        run.engines[e]->mStats.sensor_mode.isp_input_width = width;
+        run.engines[e]->mStats.sensor_mode.isp_input_height = height;
+    }
+
+    build_configs (run);
+    return true;
+}
+
+static int
+run_file (const char *file, uint32_t &stale)
+{
+    cache_run run;
+    int edits = 0;
+
+    run.file = file;
+    memset (run.engines, 0, sizeof (run.engines));
+    run.hCalib = NULL;
+    run.pDpfProfile = NULL;
+    run.checked = 0;
+    run.stale = 0;
+    run.mismatches = 0;
+
+    if (setup (run)) {
+        /*
+         * One config at a time, the engine keeps only the last two results
+         * of a module and the others would push it out before it is checked.
+         */
+        for (int round = 0; round < EDIT_ROUNDS; round++) {
+            for (size_t i = 0; i < run.configs.size (); i++) {
+                const cache_config &config = run.configs[i];
+                uint32_t flagged;
+
+                check (run, config, true);
+                edit_goc (run, edits);
+                edit_flt (run, edits);
+                edits++;
+
+                // not touched yet, only the cached engine may be behind
+                flagged = run.engines[ENGINE_VERIFY]->getManIspCacheMismatches ();
+                if (check (run, config, false) &&
+                        run.engines[ENGINE_VERIFY]->getManIspCacheMismatches () == flagged)
+                    report (run, "is stale but verify mode flagged nothing", config);
+
+                flagged = run.engines[ENGINE_VERIFY]->getManIspCacheMismatches ();
+                CamCalibDbTouch (run.hCalib);
+                check (run, config, true);
+                if (run.engines[ENGINE_VERIFY]->getManIspCacheMismatches () != flagged)
+                    report (run, "is flagged by verify mode after CamCalibDbTouch", config);
+            }
+        }
+    } else {
+        run.mismatches++;
+    }
+
+    for (int e = 0; e < ENGINE_MAX; e++)
+        delete run.engines[e];
+
+    printf ("%-50s %4u checks %4u stale before touch  %s\n", file, run.checked, run.stale,
+            run.mismatches ? "FAILED" : "ok");
+    if (run.mismatches > MAX_REPORTED)
+        printf ("  %u mismatches\n", run.mismatches);
+    stale += run.stale;
+    return run.mismatches ? 1 : 0;
+}
+
+static void usage (const char *name)
+{
+    printf ("Usage: %s [options] [iqfile ...]\n"
+            "  with no iqfile every *.xml under ./%s is run\n"
+            "  -h, --help   this text\n",
+            name, IQFILES_DIR);
+}
+
+int main (int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    std::vector<std::string> files;
+    uint32_t stale = 0;
+    int failures = 0, c;
+
+    while ((c = getopt_long (argc, argv, "h", long_options, NULL)) != -1) {
+        usage (argv[0]);
+        return c == 'h' ? 0 : 1;
+    }
+
+    for (int i = optind; i < argc; i++)
+        files.push_back (argv[i]);
+
+    if (files.empty ()) {
+        DIR *dir = opendir (IQFILES_DIR);
+        struct dirent *entry;
+
+        if (!dir) {
+            printf ("can't open %s, run from the top of the tree or name the iqfiles\n", IQFILES_DIR);
+            return 1;
+        }
+        while ((entry = readdir (dir)) != NULL) {
+            size_t len = strlen (entry->d_name);
+            if (len > 4 && !strcmp (entry->d_name + len - 4, ".xml"))
+                files.push_back (std::string (IQFILES_DIR "/") + entry->d_name);
+        }
+        closedir (dir);
+        std::sort (files.begin (), files.end ());
+    }
+
+    for (size_t i = 0; i < files.size (); i++)
+        failures += run_file (files[i].c_str (), stale);
+
+    // an edit nothing notices would pass without checking the touch at all
+    if (!stale) {
+        printf ("no cached result went stale, the edits are not seen by the engine\n");
+        failures++;
+    }
+
+    printf ("%s\n", failures ? "isp cache test FAILED" : "isp cache test passed");
+    return failures ? 1 : 0;
+}
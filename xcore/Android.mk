@@ -5,6 +5,7 @@ include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES +=\
 	xcam_log.cpp \
+	xcam_log_ring.cpp \
 
 LOCAL_CFLAGS += -Wno-error=unused-function -Wno-array-bounds
 LOCAL_CFLAGS += -DLINUX  -D_FILE_OFFSET_BITS=64 -DHAS_STDINT_H -DENABLE_ASSERTa
@@ -53,11 +54,14 @@ LOCAL_SRC_FILES +=\
 	dynamic_analyzer_loader.cpp \
 	fake_poll_thread.cpp \
 	file_handle.cpp \
+	frame_sequencer.cpp \
+	frame_tracer.cpp \
 	handler_interface.cpp \
 	image_file_handle.cpp \
 	image_handler.cpp \
 	image_processor.cpp \
 	image_projector.cpp \
+	object_pool.cpp \
 	once_map_video_buffer_priv.cpp \
 	pipe_manager.cpp \
 	poll_thread.cpp \
@@ -73,6 +77,7 @@ LOCAL_SRC_FILES +=\
 	v4l2_device.cpp \
 	video_buffer.cpp \
 	worker.cpp \
+	work_scheduler.cpp \
 	x3a_analyzer.cpp \
 	x3a_analyzer_manager.cpp \
 	x3a_analyzer_simple.cpp \
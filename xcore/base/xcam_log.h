@@ -45,10 +45,20 @@ typedef enum {
     XCORE_LOG_MODULE_MAX,
 } xcore_log_modules_t;
 
+typedef enum {
+    XCORE_LOG_FILE_MODE_SYNC,         // open/write/close the file on every line, default
+    XCORE_LOG_FILE_MODE_ASYNC,        // per-thread ring, flushed by a writer thread
+    XCORE_LOG_FILE_MODE_ASYNC_BINARY, // as async, formatting deferred to the writer
+} xcore_log_file_mode_t;
+
 #ifdef  __cplusplus
 extern "C" {
 #endif
 void xcam_set_log (const char* file_name);
+/* must be called before xcam_set_log, or the log file is reopened */
+void xcam_set_log_file_mode (int mode);
+/* block until all queued records are written to the log file */
+void xcam_flush_log ();
 void xcam_print_log (int module, int level, const char* format, ...);
 int xcam_get_log_level();
 #ifdef  __cplusplus
@@ -19,18 +19,29 @@
  */
 
 #include "buffer_pool.h"
+#include <time.h>
 
 namespace XCam {
 
+static int64_t
+buffer_pool_now_us ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 BufferProxy::BufferProxy (const VideoBufferInfo &info, const SmartPtr<BufferData> &data)
     : VideoBuffer (info)
     , _data (data)
+    , _acquire_time (0)
 {
     XCAM_ASSERT (data.ptr ());
 }
 
 BufferProxy::BufferProxy (const SmartPtr<BufferData> &data)
     : _data (data)
+    , _acquire_time (0)
 {
     XCAM_ASSERT (data.ptr ());
 }
@@ -38,11 +49,18 @@ BufferProxy::BufferProxy (const SmartPtr<BufferData> &data)
 BufferProxy::~BufferProxy ()
 {
     if (_pool.ptr ()) {
-        _pool->release (_data);
+        _pool->release (_data, _acquire_time);
     }
     _data.release ();
 }
 
+void
+BufferProxy::set_buf_pool (const SmartPtr<BufferPool> &pool)
+{
+    _pool = pool;
+    _acquire_time = pool.ptr () ? buffer_pool_now_us () : 0;
+}
+
 uint8_t *
 BufferProxy::map ()
 {
@@ -68,7 +86,15 @@ BufferPool::BufferPool ()
     : _allocated_num (0)
     , _max_count (0)
     , _started (false)
+    , _elastic_max (0)
+    , _idle_timeout (0)
+    , _idle_window_start (0)
+    , _free_low_water (0)
+    , _in_use (0)
+    , _hold_time_sum (0)
+    , _hold_count (0)
 {
+    xcam_mem_clear (_stats);
 }
 
 BufferPool::~BufferPool ()
@@ -96,13 +122,30 @@ BufferPool::update_video_info_unsafe (const VideoBufferInfo &info)
     _buffer_info = info;
 }
 
+bool
+BufferPool::set_ring_capacity (uint32_t capacity)
+{
+    SmartLock lock (_mutex);
+
+    XCAM_FAIL_RETURN (
+        ERROR, !_started && !_allocated_num, false,
+        "BufferPool ring capacity must be set before reserve");
+    _buf_list.set_ring_capacity (capacity);
+    return true;
+}
+
 bool
 BufferPool::reserve (uint32_t max_count)
 {
     uint32_t i = 0;
+    uint32_t capacity = _buf_list.get_ring_capacity ();
 
     XCAM_ASSERT (max_count);
 
+    XCAM_FAIL_RETURN (
+        ERROR, !capacity || max_count <= capacity, false,
+        "BufferPool reserve count(%d) exceeds ring capacity(%d)", max_count, capacity);
+
     SmartLock lock (_mutex);
 
     for (i = _allocated_num; i < max_count; ++i) {
@@ -110,6 +153,7 @@ BufferPool::reserve (uint32_t max_count)
         if (!new_data.ptr ())
             break;
         _buf_list.push (new_data);
+        ++_stats.alloc_count;
     }
 
     XCAM_FAIL_RETURN (
@@ -125,16 +169,85 @@ BufferPool::reserve (uint32_t max_count)
     _allocated_num = _max_count;
     _started = true;
 
+    _idle_window_start = buffer_pool_now_us ();
+    _free_low_water = _buf_list.size ();
+
     return true;
 }
 
+bool
+BufferPool::set_elastic (uint32_t max_count, uint32_t idle_timeout_ms)
+{
+    uint32_t capacity = _buf_list.get_ring_capacity ();
+
+    XCAM_FAIL_RETURN (
+        ERROR, !capacity || max_count <= capacity, false,
+        "BufferPool elastic count(%d) exceeds ring capacity(%d)", max_count, capacity);
+
+    SmartLock lock (_mutex);
+    _elastic_max = max_count;
+    _idle_timeout = (int64_t)idle_timeout_ms * 1000;
+    _idle_window_start = buffer_pool_now_us ();
+    _free_low_water = _buf_list.size ();
+    return true;
+}
+
+SmartPtr<BufferData>
+BufferPool::grow_unsafe ()
+{
+    if (!_elastic_max || _allocated_num >= _elastic_max)
+        return NULL;
+
+    SmartPtr<BufferData> data = allocate_data (_buffer_info);
+    XCAM_FAIL_RETURN (
+        WARNING, data.ptr (), NULL,
+        "BufferPool grow failed with %d data allocated", _allocated_num);
+
+    ++_allocated_num;
+    ++_stats.alloc_count;
+    XCAM_LOG_DEBUG ("BufferPool grew to %d data", _allocated_num);
+    return data;
+}
+
+void
+BufferPool::trim_unsafe (int64_t now)
+{
+    if (!_elastic_max || _idle_timeout <= 0 || now - _idle_window_start < _idle_timeout)
+        return;
+
+    // data never taken during the whole window was idle
+    uint32_t spare = _allocated_num > _max_count ? _allocated_num - _max_count : 0;
+    uint32_t trim_num = XCAM_MIN (_free_low_water, spare);
+    for (uint32_t i = 0; i < trim_num; ++i) {
+        SmartPtr<BufferData> data = _buf_list.try_pop ();
+        if (!data.ptr ())
+            break;
+        --_allocated_num;
+        ++_stats.trim_count;
+    }
+    if (trim_num)
+        XCAM_LOG_DEBUG ("BufferPool trimmed to %d data", _allocated_num);
+
+    _idle_window_start = now;
+    _free_low_water = _buf_list.size ();
+}
+
+void
+BufferPool::trim ()
+{
+    SmartLock lock (_mutex);
+    trim_unsafe (buffer_pool_now_us ());
+}
+
 bool
 BufferPool::add_data_unsafe (const SmartPtr<BufferData> &data)
 {
     if (!data.ptr ())
         return false;
 
-    _buf_list.push (data);
+    XCAM_FAIL_RETURN (
+        ERROR, _buf_list.push (data), false,
+        "BufferPool add data failed, ring is full(%d)", _buf_list.get_ring_capacity ());
     ++_allocated_num;
 
     XCAM_ASSERT (_allocated_num <= _max_count || !_max_count);
@@ -142,7 +255,7 @@ BufferPool::add_data_unsafe (const SmartPtr<BufferData> &data)
 }
 
 SmartPtr<VideoBuffer>
-BufferPool::get_buffer (const SmartPtr<BufferPool> &self)
+BufferPool::get_buffer (const SmartPtr<BufferPool> &self, int32_t timeout)
 {
     SmartPtr<BufferProxy> ret_buf;
     SmartPtr<BufferData> data;
@@ -160,11 +273,31 @@ BufferPool::get_buffer (const SmartPtr<BufferPool> &self)
         NULL,
         "BufferPool get_buffer failed since parameter<self> not this");
 
-    data = _buf_list.pop ();
+    data = _buf_list.try_pop ();
     if (!data.ptr ()) {
-        XCAM_LOG_DEBUG ("BufferPool failed to get buffer");
-        return NULL;
+        SmartLock lock (_mutex);
+        data = grow_unsafe ();
+        if (!data.ptr ())
+            ++_stats.starvations;
     }
+    if (!data.ptr ())
+        data = _buf_list.pop (timeout);
+
+    {
+        SmartLock lock (_mutex);
+        if (!data.ptr ()) {
+            if (_started)
+                ++_stats.timeouts;
+            XCAM_LOG_DEBUG ("BufferPool failed to get buffer");
+            return NULL;
+        }
+        ++_in_use;
+        if (_in_use > _stats.high_water)
+            _stats.high_water = _in_use;
+        _free_low_water = XCAM_MIN (_free_low_water, _buf_list.size ());
+        trim_unsafe (buffer_pool_now_us ());
+    }
+
     ret_buf = create_buffer_from_data (data);
     ret_buf->set_buf_pool (self);
 
@@ -185,17 +318,43 @@ BufferPool::stop ()
         _started = false;
     }
     _buf_list.pause_pop ();
+
+    BufferPoolStats stats;
+    get_stats (stats);
+    XCAM_LOG_DEBUG (
+        "BufferPool stopped, allocated:%d high water:%d starvations:%d timeouts:%d "
+        "allocs:%lld trims:%lld hold avg:%lldus",
+        stats.allocated, stats.high_water, stats.starvations, stats.timeouts,
+        (long long)stats.alloc_count, (long long)stats.trim_count, (long long)stats.hold_time_avg);
 }
 
 void
-BufferPool::release (SmartPtr<BufferData> &data)
+BufferPool::get_stats (BufferPoolStats &stats)
 {
-    {
-        SmartLock lock (_mutex);
-        if (!_started)
-            return;
+    SmartLock lock (_mutex);
+    stats = _stats;
+    stats.allocated = _allocated_num;
+    stats.in_use = _in_use;
+    stats.hold_time_avg = _hold_count ? _hold_time_sum / _hold_count : 0;
+}
+
+void
+BufferPool::release (SmartPtr<BufferData> &data, int64_t acquire_time)
+{
+    int64_t now = buffer_pool_now_us ();
+
+    SmartLock lock (_mutex);
+    if (_in_use)
+        --_in_use;
+    if (acquire_time) {
+        _hold_time_sum += now - acquire_time;
+        ++_hold_count;
     }
+    if (!_started)
+        return;
+
     _buf_list.push (data);
+    trim_unsafe (now);
 }
 
 bool
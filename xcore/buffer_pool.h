@@ -22,13 +22,24 @@
 #define XCAM_BUFFER_POOL_H
 
 #include <xcam_std.h>
-#include <safe_list.h>
+#include <safe_queue.h>
 #include <video_buffer.h>
 
 namespace XCam {
 
 class BufferPool;
 
+struct BufferPoolStats {
+    uint32_t allocated;       // buffer data owned by the pool
+    uint32_t in_use;          // buffers handed out
+    uint32_t high_water;      // max buffers handed out at the same time
+    uint32_t starvations;     // get_buffer found the free list empty
+    uint32_t timeouts;        // get_buffer gave up waiting
+    uint64_t alloc_count;     // allocate_data calls
+    uint64_t trim_count;      // buffer data freed by idle trimming
+    uint64_t hold_time_avg;   // us, between get_buffer and release
+};
+
 class BufferData {
 protected:
     explicit BufferData () {}
@@ -54,9 +65,7 @@ public:
     explicit BufferProxy (const SmartPtr<BufferData> &data);
     virtual ~BufferProxy ();
 
-    void set_buf_pool (const SmartPtr<BufferPool> &pool) {
-        _pool = pool;
-    }
+    void set_buf_pool (const SmartPtr<BufferPool> &pool);
 
     // derived from VideoBuffer
     virtual uint8_t *map ();
@@ -74,6 +83,7 @@ private:
 private:
     SmartPtr<BufferData>       _data;
     SmartPtr<BufferPool>       _pool;
+    int64_t                    _acquire_time;
 };
 
 class BufferPool
@@ -86,12 +96,28 @@ public:
     virtual ~BufferPool ();
 
     bool set_video_info (const VideoBufferInfo &info);
+    /*
+     * keep the free data in a ring of @capacity instead of a list, before
+     * reserve; reserve and set_elastic fail for counts above @capacity
+     */
+    bool set_ring_capacity (uint32_t capacity);
     bool reserve (uint32_t max_count = 4);
-    SmartPtr<VideoBuffer> get_buffer (const SmartPtr<BufferPool> &self);
+    /*
+     * elastic mode, the pool allocates more data on demand up to @max_count
+     * and frees data beyond the reserved count which stayed unused for
+     * @idle_timeout_ms. @max_count 0 disables it.
+     */
+    bool set_elastic (uint32_t max_count, uint32_t idle_timeout_ms = 3000);
+    // @timeout in us, -1 waits until a buffer is released, 0 never waits
+    SmartPtr<VideoBuffer> get_buffer (const SmartPtr<BufferPool> &self, int32_t timeout = -1);
     SmartPtr<VideoBuffer> get_buffer ();
+    // frees idle data in elastic mode, also done on get_buffer/release
+    void trim ();
 
     void stop ();
 
+    void get_stats (BufferPoolStats &stats);
+
     const VideoBufferInfo & get_video_info () const {
         return _buffer_info;
     }
@@ -114,16 +140,28 @@ protected:
     void update_video_info_unsafe (const VideoBufferInfo &info);
 
 private:
-    void release (SmartPtr<BufferData> &data);
+    void release (SmartPtr<BufferData> &data, int64_t acquire_time);
+    SmartPtr<BufferData> grow_unsafe ();
+    void trim_unsafe (int64_t now);
     XCAM_DEAD_COPY (BufferPool);
 
 private:
     Mutex                    _mutex;
     VideoBufferInfo          _buffer_info;
-    SafeList<BufferData>     _buf_list;
+    SafeQueue<BufferData>    _buf_list;
     uint32_t                 _allocated_num;
     uint32_t                 _max_count;
     bool                     _started;
+
+    uint32_t                 _elastic_max;
+    int64_t                  _idle_timeout;
+    int64_t                  _idle_window_start;
+    uint32_t                 _free_low_water;
+
+    uint32_t                 _in_use;
+    BufferPoolStats          _stats;
+    uint64_t                 _hold_time_sum;
+    uint64_t                 _hold_count;
 };
 
 };
@@ -339,6 +339,9 @@ DeviceManager::stop ()
 
     XCAM_LOG_INFO ("Device manager poll thread stopped");
 
+    /* stopping the analyzer releases the stats it holds, zero-copy stats
+     * must be handed back before the stats device unmaps their buffers
+     */
     if (_3a_analyzer.ptr()) {
         _3a_analyzer->stop ();
         /* _3a_analyzer->deinit (); */
@@ -524,7 +527,7 @@ void
 DeviceManager::post_message (XCamMessageType type, int64_t timestamp, const char *msg)
 {
     SmartPtr<XCamMessage> new_msg = new XCamMessage (type, timestamp, msg);
-    _msg_queue.push (new_msg);
+    _msg_queue.push (std::move (new_msg));
 }
 
 XCamReturn
@@ -29,6 +29,8 @@
 #include <x3a_image_process_center.h>
 #include <image_processor.h>
 #include <poll_thread.h>
+#include <safe_list.h>
+#include <object_pool.h>
 #include <stats_callback_interface.h>
 
 namespace XCam {
@@ -42,7 +44,10 @@ enum XCamMessageType {
     XCAM_MESSAGE_3A_RESULTS_ERROR,
 };
 
-struct XCamMessage {
+struct XCamMessage
+    : public RefObj
+    , public PooledObject<XCamMessage>
+{
     int64_t          timestamp;
     XCamMessageType  msg_id;
     char            *msg;
@@ -152,7 +157,7 @@ protected:
     SmartPtr<X3aAnalyzer>            _3a_analyzer;
     SmartPtr<X3aImageProcessCenter>  _3a_process_center;
 
-    /* msg queue */
+    /* msg queue, a list so posting never blocks nor drops a message */
     SafeList<XCamMessage>            _msg_queue;
     SmartPtr<MessageThread>          _msg_thread;
 
@@ -62,6 +62,10 @@ FakePollThread::start()
         XCAM_RETURN_ERROR_FILE,
         "FakePollThread failed to open file:%s", XCAM_STR (_raw_path));
 
+    // frames come from poll_buffer_loop, which only the per-device
+    // capture thread runs, the single epoll loop reads the device
+    set_single_loop (false);
+
     return PollThread::start ();
 }
 
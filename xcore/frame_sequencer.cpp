@@ -0,0 +1,227 @@
+/*
+ * frame_sequencer.cpp - pair SOF, stats and capture events by frame sequence
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "frame_sequencer.h"
+#include <errno.h>
+#include <time.h>
+
+namespace XCam {
+
+static int64_t
+frame_sequencer_now_us ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+FrameSequencer::FrameSequencer (uint32_t required)
+    : _stopped (false)
+    , _required (required)
+    , _late_us (XCAM_FRAME_SEQUENCER_LATE_US)
+{
+    xcam_mem_clear (_stats);
+    reset ();
+}
+
+void
+FrameSequencer::set_required (uint32_t required)
+{
+    SmartLock locker (_mutex);
+    XCAM_ASSERT (required);
+    _required = required;
+}
+
+void
+FrameSequencer::set_late_threshold (int64_t late_us)
+{
+    SmartLock locker (_mutex);
+    _late_us = late_us;
+}
+
+FrameTuple *
+FrameSequencer::get_slot_unsafe (int32_t sequence, bool claim)
+{
+    if (sequence < 0)
+        return NULL;
+
+    FrameTuple *slot = &_slots[sequence & (XCAM_FRAME_SEQUENCER_DEPTH - 1)];
+    if (slot->sequence == sequence)
+        return slot;
+    if (!claim || slot->sequence > sequence)
+        return NULL;
+
+    if (slot->sequence >= 0 && (slot->arrived & _required) != _required) {
+        XCAM_LOG_DEBUG (
+            "frame sequencer drops incomplete frame %d (arrived 0x%x)",
+            slot->sequence, slot->arrived);
+        ++_stats.mismatches;
+    }
+    xcam_mem_clear (*slot);
+    slot->sequence = sequence;
+    return slot;
+}
+
+void
+FrameSequencer::notify (FrameSource source, int32_t sequence, int64_t timestamp)
+{
+    XCAM_ASSERT (source >= FrameSourceSof && source < FrameSourceCount);
+    uint32_t mask = XCAM_FRAME_SOURCE_MASK (source);
+    int64_t now = frame_sequencer_now_us ();
+
+    SmartLock locker (_mutex);
+    if (_stopped)
+        return;
+
+    if (sequence <= _latest[source]) {
+        XCAM_LOG_WARNING (
+            "frame sequencer source %d out of order, frame %d after %d",
+            source, sequence, _latest[source]);
+        ++_stats.mismatches;
+    } else
+        _latest[source] = sequence;
+
+    FrameTuple *slot = get_slot_unsafe (sequence, true);
+    if (!slot) {
+        XCAM_LOG_WARNING ("frame sequencer source %d frame %d arrived too late", source, sequence);
+        ++_stats.late;
+        return;
+    }
+    if (slot->arrived & mask)
+        return;
+
+    slot->arrived |= mask;
+    slot->timestamp[source] = timestamp;
+    slot->arrival[source] = now;
+
+    // spilled into the next frame for longer than the threshold
+    FrameTuple *next = get_slot_unsafe (sequence + 1, false);
+    if (source != FrameSourceSof && next && (next->arrived & XCAM_FRAME_SOURCE_MASK (FrameSourceSof)) &&
+            now - next->arrival[FrameSourceSof] > _late_us) {
+        XCAM_LOG_DEBUG (
+            "frame sequencer source %d frame %d late %lldus after next SOF",
+            source, sequence, (long long)(now - next->arrival[FrameSourceSof]));
+        ++_stats.late;
+    }
+
+    if ((slot->arrived & _required) == _required && (mask & _required))
+        ++_stats.matched;
+
+    // a new frame may also supersede tuples that lost a source
+    _complete_cond.broadcast ();
+}
+
+bool
+FrameSequencer::is_done_unsafe (int32_t sequence, FrameTuple &tuple)
+{
+    FrameTuple *slot = get_slot_unsafe (sequence, false);
+    uint32_t arrived = slot ? slot->arrived : 0;
+    uint32_t missing = _required & ~arrived;
+
+    for (int i = 0; i < FrameSourceCount; ++i) {
+        if ((missing & XCAM_FRAME_SOURCE_MASK (i)) && _latest[i] <= sequence)
+            return false;
+    }
+
+    if (slot)
+        tuple = *slot;
+    else {
+        xcam_mem_clear (tuple);
+        tuple.sequence = sequence;
+    }
+
+    if (missing) {
+        XCAM_LOG_DEBUG (
+            "frame sequencer frame %d superseded, missing sources 0x%x", sequence, missing);
+        ++_stats.mismatches;
+    }
+    return true;
+}
+
+XCamReturn
+FrameSequencer::wait_complete (int32_t sequence, int32_t timeout_us, FrameTuple &tuple)
+{
+    struct timespec deadline;
+
+    if (timeout_us >= 0) {
+        clock_gettime (CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_us / 1000000;
+        deadline.tv_nsec += (timeout_us % 1000000) * 1000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    SmartLock locker (_mutex);
+    while (!_stopped) {
+        if (is_done_unsafe (sequence, tuple))
+            return XCAM_RETURN_NO_ERROR;
+
+        if (timeout_us < 0)
+            _complete_cond.wait (_mutex);
+        else if (_complete_cond.timedwait_until (_mutex, deadline) == ETIMEDOUT) {
+            if (!_stopped && is_done_unsafe (sequence, tuple))
+                return XCAM_RETURN_NO_ERROR;
+            ++_stats.timeouts;
+            return XCAM_RETURN_ERROR_TIMEOUT;
+        }
+    }
+
+    return XCAM_RETURN_BYPASS;
+}
+
+int32_t
+FrameSequencer::get_latest (FrameSource source)
+{
+    XCAM_ASSERT (source >= FrameSourceSof && source < FrameSourceCount);
+    SmartLock locker (_mutex);
+    return _latest[source];
+}
+
+void
+FrameSequencer::stop ()
+{
+    SmartLock locker (_mutex);
+    _stopped = true;
+    _complete_cond.broadcast ();
+}
+
+void
+FrameSequencer::reset ()
+{
+    SmartLock locker (_mutex);
+    for (int i = 0; i < XCAM_FRAME_SEQUENCER_DEPTH; ++i) {
+        xcam_mem_clear (_slots[i]);
+        _slots[i].sequence = -1;
+    }
+    for (int i = 0; i < FrameSourceCount; ++i)
+        _latest[i] = -1;
+    _stopped = false;
+    _complete_cond.broadcast ();
+}
+
+void
+FrameSequencer::get_stats (FrameSequencerStats &stats)
+{
+    SmartLock locker (_mutex);
+    stats = _stats;
+}
+
+}
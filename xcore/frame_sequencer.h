@@ -0,0 +1,105 @@
+/*
+ * frame_sequencer.h - pair SOF, stats and capture events by frame sequence
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_FRAME_SEQUENCER_H
+#define XCAM_FRAME_SEQUENCER_H
+
+#include <xcam_std.h>
+#include <xcam_mutex.h>
+
+// frames tracked at once, must be power of 2
+#define XCAM_FRAME_SEQUENCER_DEPTH 16
+// arrivals later than this after the next SOF are counted late
+#define XCAM_FRAME_SEQUENCER_LATE_US (10 * 1000)
+
+namespace XCam {
+
+enum FrameSource {
+    FrameSourceSof = 0,
+    FrameSourceStats,
+    FrameSourceCapture,
+    FrameSourceCount,
+};
+
+#define XCAM_FRAME_SOURCE_MASK(source) (1 << (source))
+
+struct FrameTuple {
+    int32_t     sequence;
+    uint32_t    arrived;                        // XCAM_FRAME_SOURCE_MASK of arrived sources
+    int64_t     timestamp[FrameSourceCount];    // as given by the source
+    int64_t     arrival[FrameSourceCount];      // CLOCK_MONOTONIC, us
+};
+
+struct FrameSequencerStats {
+    uint64_t    matched;     // tuples completed
+    uint64_t    mismatches;  // out of order arrivals and tuples left incomplete
+    uint64_t    late;        // arrivals later than the late threshold
+    uint64_t    timeouts;    // waits that hit their deadline
+};
+
+/*
+ * Collects the events of one frame, keyed by the hardware sequence
+ * number, and wakes waiters as soon as every required source arrived
+ * or a newer frame made the missing ones pointless. Deadlines are on
+ * CLOCK_MONOTONIC.
+ */
+class FrameSequencer {
+public:
+    explicit FrameSequencer (
+        uint32_t required = XCAM_FRAME_SOURCE_MASK (FrameSourceSof) | XCAM_FRAME_SOURCE_MASK (FrameSourceStats));
+
+    void set_required (uint32_t required);
+    void set_late_threshold (int64_t late_us);
+
+    void notify (FrameSource source, int32_t sequence, int64_t timestamp);
+    /*
+     * wait for the tuple of @sequence, @timeout_us -1 waits forever
+     * returns XCAM_RETURN_NO_ERROR once complete or superseded by a newer
+     * frame (check @tuple.arrived), XCAM_RETURN_ERROR_TIMEOUT at the deadline
+     * and XCAM_RETURN_BYPASS after stop
+     */
+    XCamReturn wait_complete (int32_t sequence, int32_t timeout_us, FrameTuple &tuple);
+    int32_t get_latest (FrameSource source);
+
+    // wake up all waiters, notify and wait are rejected until reset
+    void stop ();
+    void reset ();
+
+    void get_stats (FrameSequencerStats &stats);
+
+private:
+    FrameTuple *get_slot_unsafe (int32_t sequence, bool claim);
+    bool is_done_unsafe (int32_t sequence, FrameTuple &tuple);
+
+    XCAM_DEAD_COPY (FrameSequencer);
+
+private:
+    Mutex                   _mutex;
+    Cond                    _complete_cond;
+    bool                    _stopped;
+    uint32_t                _required;
+    int64_t                 _late_us;
+    FrameTuple              _slots[XCAM_FRAME_SEQUENCER_DEPTH];
+    int32_t                 _latest[FrameSourceCount];
+    FrameSequencerStats     _stats;
+};
+
+}
+
+#endif // XCAM_FRAME_SEQUENCER_H
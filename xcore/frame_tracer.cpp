@@ -0,0 +1,379 @@
+/*
+ * frame_tracer.cpp - per-frame latency tracer of the 3a control loop
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "frame_tracer.h"
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <algorithm>
+#include <map>
+#ifdef ANDROID_OS
+#include <cutils/properties.h>
+#endif
+
+#define FRAME_TRACE_MASK (XCAM_FRAME_TRACE_CAPACITY - 1)
+#define FRAME_TRACE_MAX_LAG 8
+
+namespace XCam {
+
+static const char *stage_names[FrameTraceStageMax] = {
+    "sof",
+    "stats_dequeued",
+    "analyze_begin",
+    "analyze_end",
+    "params_queued",
+    "params_applied",
+};
+
+// histogram bucket upper bounds in microseconds, last bucket is open
+static const int64_t hist_bounds_us[] = {
+    250, 500, 1000, 2000, 4000, 8000, 16000, 33000, 66000, 133000
+};
+#define HIST_BOUND_NUM (sizeof (hist_bounds_us) / sizeof (hist_bounds_us[0]))
+#define HIST_BUCKET_NUM (HIST_BOUND_NUM + 1)
+
+static const struct {
+    const char *name;
+    int32_t     from;
+    int32_t     to;
+} trace_intervals[] = {
+    {"sof->stats",        FrameTraceSof,           FrameTraceStatsDequeued},
+    {"stats->analyze",    FrameTraceStatsDequeued, FrameTraceAnalyzeBegin},
+    {"analyze",           FrameTraceAnalyzeBegin,  FrameTraceAnalyzeEnd},
+    {"analyze->queued",   FrameTraceAnalyzeEnd,    FrameTraceParamsQueued},
+    {"queued->applied",   FrameTraceParamsQueued,  FrameTraceParamsApplied},
+    {"stats->applied",    FrameTraceStatsDequeued, FrameTraceParamsApplied},
+    {"sof->applied",      FrameTraceSof,           FrameTraceParamsApplied},
+};
+
+struct FrameStamps {
+    int64_t ts[FrameTraceStageMax];
+    int32_t effect_frame_id;
+
+    FrameStamps () : effect_frame_id (-1) {
+        for (int i = 0; i < FrameTraceStageMax; i++)
+            ts[i] = -1;
+    }
+};
+
+static int64_t
+trace_now ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static uint32_t
+trace_tid ()
+{
+    static __thread uint32_t tid = 0;
+    if (!tid)
+        tid = (uint32_t) syscall (SYS_gettid);
+    return tid;
+}
+
+static void
+tracer_dump_at_exit ()
+{
+    FrameTracer *tracer = FrameTracer::instance ();
+    if (tracer->is_enabled () && tracer->get_output_prefix ()[0])
+        tracer->dump (tracer->get_output_prefix ());
+}
+
+FrameTracer *
+FrameTracer::instance ()
+{
+    static FrameTracer tracer;
+    return &tracer;
+}
+
+FrameTracer::FrameTracer ()
+    : _pos (0)
+    , _enabled (false)
+{
+    for (uint32_t i = 0; i < XCAM_FRAME_TRACE_CAPACITY; i++)
+        _slots[i].seq.store (0, std::memory_order_relaxed);
+    xcam_mem_clear (_output_prefix);
+
+#ifdef ANDROID_OS
+    property_get ("persist.vendor.rkisp.frametrace", _output_prefix, "");
+#else
+    const char *prefix = getenv ("persist_camera_engine_frame_trace");
+    if (prefix)
+        strncpy (_output_prefix, prefix, sizeof (_output_prefix) - 1);
+#endif
+    if (_output_prefix[0]) {
+        XCAM_LOG_INFO ("frame tracer enabled, output prefix:%s", _output_prefix);
+        _enabled.store (true);
+        atexit (tracer_dump_at_exit);
+    }
+}
+
+const char *
+FrameTracer::stage_name (int32_t stage)
+{
+    if (stage < 0 || stage >= FrameTraceStageMax)
+        return "unknown";
+    return stage_names[stage];
+}
+
+void
+FrameTracer::set_enabled (bool enable)
+{
+    _enabled.store (enable);
+}
+
+void
+FrameTracer::record (FrameTraceStage stage, int32_t frame_id, int32_t arg)
+{
+    int64_t ts = trace_now ();
+    uint32_t pos = _pos.fetch_add (1, std::memory_order_relaxed);
+    Slot &slot = _slots[pos & FRAME_TRACE_MASK];
+
+    // odd seq marks the slot busy, readers drop it until it turns even
+    slot.seq.store (pos * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    slot.event.ts = ts;
+    slot.event.stage = stage;
+    slot.event.frame_id = frame_id;
+    slot.event.arg = arg;
+    slot.event.tid = trace_tid ();
+    slot.seq.store (pos * 2 + 2, std::memory_order_release);
+}
+
+void
+FrameTracer::reset ()
+{
+    for (uint32_t i = 0; i < XCAM_FRAME_TRACE_CAPACITY; i++)
+        _slots[i].seq.store (0, std::memory_order_relaxed);
+}
+
+void
+FrameTracer::snapshot (std::vector<Event> &events)
+{
+    std::vector<std::pair<uint32_t, Event> > valid;
+
+    valid.reserve (XCAM_FRAME_TRACE_CAPACITY);
+    for (uint32_t i = 0; i < XCAM_FRAME_TRACE_CAPACITY; i++) {
+        Slot &slot = _slots[i];
+        uint32_t seq = slot.seq.load (std::memory_order_acquire);
+        if (seq == 0 || (seq & 1))
+            continue;
+        Event event = slot.event;
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if (slot.seq.load (std::memory_order_relaxed) != seq)
+            continue;
+        valid.push_back (std::make_pair (seq, event));
+    }
+
+    std::sort (valid.begin (), valid.end (),
+    [](const std::pair<uint32_t, Event> &a, const std::pair<uint32_t, Event> &b) {
+        return a.first < b.first;
+    });
+
+    events.clear ();
+    events.reserve (valid.size ());
+    for (size_t i = 0; i < valid.size (); i++)
+        events.push_back (valid[i].second);
+}
+
+static void
+collect_frames (const std::vector<FrameTracer::Event> &events, std::map<int32_t, FrameStamps> &frames)
+{
+    for (size_t i = 0; i < events.size (); i++) {
+        const FrameTracer::Event &ev = events[i];
+        if (ev.frame_id < 0 || ev.stage < 0 || ev.stage >= FrameTraceStageMax)
+            continue;
+        FrameStamps &stamps = frames[ev.frame_id];
+        // keep the first occurrence of each stage
+        if (stamps.ts[ev.stage] >= 0)
+            continue;
+        stamps.ts[ev.stage] = ev.ts;
+        if (ev.stage == FrameTraceParamsApplied)
+            stamps.effect_frame_id = ev.arg;
+    }
+}
+
+bool
+FrameTracer::dump_chrome_trace (const char *file_name)
+{
+    std::vector<Event> events;
+    std::map<int32_t, FrameStamps> frames;
+    FILE *fp = NULL;
+    bool first = true;
+
+    XCAM_ASSERT (file_name);
+    fp = fopen (file_name, "w");
+    XCAM_FAIL_RETURN (ERROR, fp, false, "frame tracer open %s failed", file_name);
+
+    snapshot (events);
+    collect_frames (events, frames);
+
+    fprintf (fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < events.size (); i++) {
+        const Event &ev = events[i];
+        fprintf (fp, "%s{\"name\":\"%s\",\"cat\":\"3a\",\"ph\":\"i\",\"s\":\"t\","
+                 "\"ts\":%.3f,\"pid\":%d,\"tid\":%u,\"args\":{\"frame\":%d,\"arg\":%d}}",
+                 first ? "" : ",\n", stage_name (ev.stage), ev.ts / 1000.0,
+                 getpid (), ev.tid, ev.frame_id, ev.arg);
+        first = false;
+    }
+
+    // one async span per frame covering its whole trip through the loop
+    for (std::map<int32_t, FrameStamps>::iterator iter = frames.begin ();
+            iter != frames.end (); ++iter) {
+        const FrameStamps &stamps = iter->second;
+        int64_t begin = -1, end = -1;
+        for (int i = 0; i < FrameTraceStageMax; i++) {
+            if (stamps.ts[i] < 0)
+                continue;
+            if (begin < 0 || stamps.ts[i] < begin)
+                begin = stamps.ts[i];
+            if (stamps.ts[i] > end)
+                end = stamps.ts[i];
+        }
+        if (begin < 0)
+            continue;
+        fprintf (fp, "%s{\"name\":\"frame %d\",\"cat\":\"frame\",\"ph\":\"b\",\"id\":%d,"
+                 "\"ts\":%.3f,\"pid\":%d,\"args\":{\"effect_frame\":%d}}",
+                 first ? "" : ",\n", iter->first, iter->first, begin / 1000.0,
+                 getpid (), stamps.effect_frame_id);
+        fprintf (fp, ",\n{\"name\":\"frame %d\",\"cat\":\"frame\",\"ph\":\"e\",\"id\":%d,"
+                 "\"ts\":%.3f,\"pid\":%d}",
+                 iter->first, iter->first, end / 1000.0, getpid ());
+        first = false;
+    }
+    fprintf (fp, "\n]}\n");
+    fclose (fp);
+
+    XCAM_LOG_INFO ("frame tracer dumped %d events of %d frames to %s",
+                   (int)events.size (), (int)frames.size (), file_name);
+    return true;
+}
+
+bool
+FrameTracer::dump_histograms (const char *file_name)
+{
+    std::vector<Event> events;
+    std::map<int32_t, FrameStamps> frames;
+    char line[512];
+    FILE *fp = NULL;
+
+    if (file_name) {
+        fp = fopen (file_name, "w");
+        XCAM_FAIL_RETURN (ERROR, fp, false, "frame tracer open %s failed", file_name);
+    }
+
+#define HIST_PRINT(...)                                  \
+    do {                                                 \
+        snprintf (line, sizeof (line), __VA_ARGS__);     \
+        if (fp)                                          \
+            fprintf (fp, "%s\n", line);                  \
+        else                                             \
+            XCAM_LOG_INFO ("%s", line);                  \
+    } while (0)
+
+    snapshot (events);
+    collect_frames (events, frames);
+
+    HIST_PRINT ("frame latency of %d frames (us), buckets are upper bounds", (int)frames.size ());
+    for (uint32_t n = 0; n < sizeof (trace_intervals) / sizeof (trace_intervals[0]); n++) {
+        std::vector<int64_t> values;
+        uint32_t buckets[HIST_BUCKET_NUM] = {0};
+        int64_t sum = 0;
+
+        for (std::map<int32_t, FrameStamps>::iterator iter = frames.begin ();
+                iter != frames.end (); ++iter) {
+            const FrameStamps &stamps = iter->second;
+            int64_t from = stamps.ts[trace_intervals[n].from];
+            int64_t to = stamps.ts[trace_intervals[n].to];
+            if (from < 0 || to < 0 || to < from)
+                continue;
+            int64_t us = (to - from) / 1000;
+            uint32_t b = 0;
+            while (b < HIST_BOUND_NUM && us > hist_bounds_us[b])
+                b++;
+            buckets[b]++;
+            values.push_back (us);
+            sum += us;
+        }
+
+        if (values.empty ()) {
+            HIST_PRINT ("%-16s no samples", trace_intervals[n].name);
+            continue;
+        }
+        std::sort (values.begin (), values.end ());
+        HIST_PRINT ("%-16s n:%d min:%lld avg:%lld p50:%lld p99:%lld max:%lld",
+                    trace_intervals[n].name, (int)values.size (),
+                    (long long)values.front (), (long long)(sum / (int64_t)values.size ()),
+                    (long long)values[values.size () / 2],
+                    (long long)values[(values.size () * 99) / 100],
+                    (long long)values.back ());
+        for (uint32_t b = 0; b < HIST_BUCKET_NUM; b++) {
+            if (!buckets[b])
+                continue;
+            if (b < HIST_BOUND_NUM)
+                HIST_PRINT ("    <=%-7lld %u", (long long)hist_bounds_us[b], buckets[b]);
+            else
+                HIST_PRINT ("    > %-7lld %u", (long long)hist_bounds_us[b - 1], buckets[b]);
+        }
+    }
+
+    // frames between the stats source and the frame its params take effect on,
+    // compare against the sensor exposure delay
+    uint32_t lags[FRAME_TRACE_MAX_LAG + 1] = {0};
+    uint32_t lag_num = 0;
+    for (std::map<int32_t, FrameStamps>::iterator iter = frames.begin ();
+            iter != frames.end (); ++iter) {
+        if (iter->second.effect_frame_id < 0)
+            continue;
+        int32_t lag = iter->second.effect_frame_id - iter->first;
+        lags[lag < 0 ? 0 : XCAM_MIN (lag, FRAME_TRACE_MAX_LAG)]++;
+        lag_num++;
+    }
+    HIST_PRINT ("params effect lag of %u frames (frames)", lag_num);
+    for (int i = 0; i <= FRAME_TRACE_MAX_LAG; i++) {
+        if (lags[i])
+            HIST_PRINT ("    %s%d %u", i == FRAME_TRACE_MAX_LAG ? ">=" : "", i, lags[i]);
+    }
+
+#undef HIST_PRINT
+
+    if (fp)
+        fclose (fp);
+    return true;
+}
+
+bool
+FrameTracer::dump (const char *prefix)
+{
+    char file_name[XCAM_MAX_STR_SIZE];
+    bool ret = true;
+
+    XCAM_FAIL_RETURN (ERROR, prefix && prefix[0], false, "frame tracer dump without prefix");
+
+    snprintf (file_name, sizeof (file_name), "%s.json", prefix);
+    ret = dump_chrome_trace (file_name) && ret;
+    snprintf (file_name, sizeof (file_name), "%s_hist.txt", prefix);
+    ret = dump_histograms (file_name) && ret;
+    return ret;
+}
+
+};
@@ -0,0 +1,111 @@
+/*
+ * frame_tracer.h - per-frame latency tracer of the 3a control loop
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_FRAME_TRACER_H
+#define XCAM_FRAME_TRACER_H
+
+#include <xcam_std.h>
+#include <atomic>
+#include <vector>
+
+// must be power of 2
+#define XCAM_FRAME_TRACE_CAPACITY 4096
+
+namespace XCam {
+
+enum FrameTraceStage {
+    FrameTraceSof = 0,        // SOF event handled by the controller
+    FrameTraceStatsDequeued,  // 3a stats dequeued from the isp stats device
+    FrameTraceAnalyzeBegin,   // stats picked up by the 3a analyzer
+    FrameTraceAnalyzeEnd,     // 3a results integrated by the analyzer
+    FrameTraceParamsQueued,   // isp params handed over to the controller
+    FrameTraceParamsApplied,  // isp params queued to the isp params device
+    FrameTraceStageMax,
+};
+
+/*
+ * Records per-stage timestamps of each frame into a fixed ring, old
+ * events are overwritten. Recording is lock-free and costs one atomic
+ * increment, dumps take a consistent snapshot while recording goes on.
+ *
+ * Enabled at startup when env persist_camera_engine_frame_trace (or
+ * property persist.vendor.rkisp.frametrace on android) holds an output
+ * path prefix, the trace is then dumped as <prefix>.json (chrome
+ * trace-event format) and <prefix>_hist.txt on deinit.
+ */
+class FrameTracer
+{
+public:
+    struct Event {
+        int64_t  ts;        // monotonic, nanoseconds
+        int32_t  stage;
+        int32_t  frame_id;
+        int32_t  arg;       // effecting frame id for FrameTraceParamsApplied
+        uint32_t tid;
+    };
+
+    static FrameTracer *instance ();
+
+    bool is_enabled () const {
+        return _enabled.load (std::memory_order_relaxed);
+    }
+    void set_enabled (bool enable);
+    const char *get_output_prefix () const {
+        return _output_prefix;
+    }
+
+    void record (FrameTraceStage stage, int32_t frame_id, int32_t arg = -1);
+    void reset ();
+
+    // returns events ordered by record time
+    void snapshot (std::vector<Event> &events);
+    bool dump_chrome_trace (const char *file_name);
+    // @file_name NULL prints to log
+    bool dump_histograms (const char *file_name);
+    // dump both files with @prefix
+    bool dump (const char *prefix);
+
+    static const char *stage_name (int32_t stage);
+
+private:
+    FrameTracer ();
+    XCAM_DEAD_COPY (FrameTracer);
+
+    struct Slot {
+        std::atomic<uint32_t>  seq;
+        Event                  event;
+    };
+
+private:
+    Slot                   _slots[XCAM_FRAME_TRACE_CAPACITY];
+    std::atomic<uint32_t>  _pos;
+    std::atomic<bool>      _enabled;
+    char                   _output_prefix[256];
+};
+
+};
+
+#define XCAM_FRAME_TRACE(stage, frame_id, ...)                            \
+    do {                                                                  \
+        XCam::FrameTracer *tracer = XCam::FrameTracer::instance ();       \
+        if (tracer->is_enabled ())                                        \
+            tracer->record (stage, frame_id, ##__VA_ARGS__);              \
+    } while (0)
+
+#endif //XCAM_FRAME_TRACER_H
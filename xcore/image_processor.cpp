@@ -137,9 +137,9 @@ bool X3aResultsProcessThread::loop ()
     if (!result.ptr ())
         return false;
 
-    result_list.push_back (result);
+    result_list.push_back (std::move (result));
     while ((result = _queue.pop (0)).ptr ()) {
-        result_list.push_back (result);
+        result_list.push_back (std::move (result));
     }
 
     XCamReturn ret = _processor->process_3a_results (result_list);
@@ -318,8 +318,8 @@ ImageProcessor::filter_valid_results (X3aResultList &input, X3aResultList &valid
     for (X3aResultList::iterator i_res = input.begin(); i_res != input.end(); ) {
         SmartPtr<X3aResult> &res = *i_res;
         if (can_process_result(res)) {
-            valid_results.push_back (res);
-            input.erase (i_res++);
+            // relink the node, no refcount traffic
+            valid_results.splice (valid_results.end (), input, i_res++);
         } else
             ++i_res;
     }
@@ -0,0 +1,156 @@
+/*
+ * object_pool.cpp - typed slab pool for per-frame objects
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "object_pool.h"
+#include <cxxabi.h>
+
+#define OBJECT_SLAB_ALIGN 16
+
+namespace XCam {
+
+static Mutex *
+registry_mutex ()
+{
+    static Mutex *mutex = new Mutex ();
+    return mutex;
+}
+
+static std::vector<ObjectSlab *> &
+registry ()
+{
+    static std::vector<ObjectSlab *> *slabs = new std::vector<ObjectSlab *> ();
+    return *slabs;
+}
+
+ObjectSlab::ObjectSlab (const char *name, size_t block_size)
+    : _name (NULL)
+    , _block_size (block_size)
+    , _blocks_per_slab (0)
+    , _free_list (NULL)
+    , _capacity (0)
+    , _live (0)
+    , _total (0)
+    , _slab_allocs (0)
+{
+    int status = 0;
+    char *demangled = abi::__cxa_demangle (name, NULL, NULL, &status);
+    if (demangled && status == 0)
+        _name = demangled;
+    else {
+        xcam_free (demangled);
+        _name = strndup (name, XCAM_MAX_STR_SIZE);
+    }
+
+    if (_block_size < sizeof (FreeBlock))
+        _block_size = sizeof (FreeBlock);
+    _block_size = XCAM_ALIGN_UP (_block_size, OBJECT_SLAB_ALIGN);
+    _blocks_per_slab = XCAM_MAX (XCAM_OBJECT_SLAB_MIN_BLOCKS, XCAM_OBJECT_SLAB_SIZE / _block_size);
+
+    SmartLock locker (*registry_mutex ());
+    registry ().push_back (this);
+}
+
+bool
+ObjectSlab::grow_unsafe ()
+{
+    char *slab = NULL;
+    if (posix_memalign ((void **)&slab, OBJECT_SLAB_ALIGN, _block_size * _blocks_per_slab) != 0 || !slab) {
+        XCAM_LOG_ERROR ("object pool(%s) grow failed", XCAM_STR (_name));
+        return false;
+    }
+
+    for (uint32_t i = _blocks_per_slab; i > 0; --i) {
+        FreeBlock *block = (FreeBlock *)(slab + (i - 1) * _block_size);
+        block->next = _free_list;
+        _free_list = block;
+    }
+    _capacity += _blocks_per_slab;
+    ++_slab_allocs;
+
+    XCAM_LOG_DEBUG (
+        "object pool(%s) grew to %d blocks of %d bytes",
+        XCAM_STR (_name), _capacity, (int)_block_size);
+    return true;
+}
+
+void *
+ObjectSlab::alloc ()
+{
+    SmartLock locker (_mutex);
+    if (!_free_list && !grow_unsafe ())
+        return NULL;
+
+    FreeBlock *block = _free_list;
+    _free_list = block->next;
+    ++_live;
+    ++_total;
+    return block;
+}
+
+void
+ObjectSlab::release (void *ptr)
+{
+    XCAM_ASSERT (ptr);
+    FreeBlock *block = (FreeBlock *)ptr;
+
+    SmartLock locker (_mutex);
+    XCAM_ASSERT (_live > 0);
+    block->next = _free_list;
+    _free_list = block;
+    --_live;
+}
+
+void
+ObjectSlab::get_stats (ObjectPoolStats &stats)
+{
+    SmartLock locker (_mutex);
+    stats.name = _name;
+    stats.block_size = _block_size;
+    stats.capacity = _capacity;
+    stats.live = _live;
+    stats.total = _total;
+    stats.slab_allocs = _slab_allocs;
+}
+
+void
+ObjectSlab::get_all_stats (std::vector<ObjectPoolStats> &stats)
+{
+    SmartLock locker (*registry_mutex ());
+    std::vector<ObjectSlab *> &slabs = registry ();
+
+    stats.resize (slabs.size ());
+    for (size_t i = 0; i < slabs.size (); ++i)
+        slabs[i]->get_stats (stats[i]);
+}
+
+void
+ObjectSlab::dump_all_stats ()
+{
+    std::vector<ObjectPoolStats> stats;
+    get_all_stats (stats);
+
+    for (size_t i = 0; i < stats.size (); ++i) {
+        XCAM_LOG_INFO (
+            "object pool(%s) block:%d live:%d capacity:%d total:%lld slab allocs:%d",
+            XCAM_STR (stats[i].name), stats[i].block_size, stats[i].live,
+            stats[i].capacity, (long long)stats[i].total, stats[i].slab_allocs);
+    }
+}
+
+};
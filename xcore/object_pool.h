@@ -0,0 +1,120 @@
+/*
+ * object_pool.h - typed slab pool for per-frame objects
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_OBJECT_POOL_H
+#define XCAM_OBJECT_POOL_H
+
+#include <xcam_std.h>
+#include <xcam_mutex.h>
+#include <new>
+#include <typeinfo>
+#include <vector>
+
+// slabs grow by this many bytes, at least XCAM_OBJECT_SLAB_MIN_BLOCKS blocks
+#define XCAM_OBJECT_SLAB_SIZE (64 * 1024)
+#define XCAM_OBJECT_SLAB_MIN_BLOCKS 4
+
+namespace XCam {
+
+struct ObjectPoolStats {
+    const char *name;
+    uint32_t    block_size;
+    uint32_t    capacity;     // blocks carved from slabs
+    uint32_t    live;         // blocks in use
+    uint64_t    total;        // allocations served since start
+    uint32_t    slab_allocs;  // heap allocations made by the pool
+};
+
+/*
+ * Fixed-size block allocator. Blocks are carved from slabs that are
+ * never handed back to the heap, so once the pool reached its high-water
+ * mark alloc/release only move blocks on a free list.
+ * Pools live for the whole process and are registered for get_all_stats.
+ */
+class ObjectSlab {
+public:
+    ObjectSlab (const char *name, size_t block_size);
+
+    void *alloc ();
+    void release (void *ptr);
+
+    size_t get_block_size () const {
+        return _block_size;
+    }
+    void get_stats (ObjectPoolStats &stats);
+
+    static void get_all_stats (std::vector<ObjectPoolStats> &stats);
+    static void dump_all_stats ();
+
+private:
+    bool grow_unsafe ();
+    XCAM_DEAD_COPY (ObjectSlab);
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    char               *_name;
+    size_t              _block_size;
+    uint32_t            _blocks_per_slab;
+    Mutex               _mutex;
+    FreeBlock          *_free_list;
+    uint32_t            _capacity;
+    uint32_t            _live;
+    uint64_t            _total;
+    uint32_t            _slab_allocs;
+};
+
+/*
+ * Inherit to allocate objects of Obj from its ObjectSlab, releasing the
+ * last SmartPtr reference puts the block back on the free list.
+ * Classes derived from Obj with a different size use the heap.
+ */
+template <typename Obj>
+class PooledObject {
+public:
+    static void *operator new (size_t size) {
+        if (size != sizeof (Obj))
+            return ::operator new (size);
+        void *ptr = get_object_slab ()->alloc ();
+        if (!ptr)
+            throw std::bad_alloc ();
+        return ptr;
+    }
+    static void operator delete (void *ptr, size_t size) {
+        if (!ptr)
+            return;
+        if (size != sizeof (Obj)) {
+            ::operator delete (ptr);
+            return;
+        }
+        get_object_slab ()->release (ptr);
+    }
+
+    static ObjectSlab *get_object_slab () {
+        // never deleted, objects may be released during static destruction
+        static ObjectSlab *slab = new ObjectSlab (typeid (Obj).name (), sizeof (Obj));
+        return slab;
+    }
+};
+
+};
+
+#endif //XCAM_OBJECT_POOL_H
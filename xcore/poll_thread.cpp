@@ -23,6 +23,12 @@
 #include <linux/rkisp.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#ifdef ANDROID_OS
+#include <cutils/properties.h>
+#endif
 
 namespace XCam {
 
@@ -107,15 +113,67 @@ private:
     PollThread   *_poll;
 };
 
+class EpollLoopThread
+    : public Thread
+{
+public:
+    EpollLoopThread (PollThread *poll)
+        : Thread ("epoll_loop")
+        , _poll (poll)
+    {}
+
+protected:
+    virtual bool started () {
+        // the stats pool is only needed when there are stats to poll
+        if (!_poll->_isp_stats_dev.ptr ())
+            return true;
+        XCamReturn ret = _poll->init_3a_stats_pool ();
+        if (ret != XCAM_RETURN_NO_ERROR)
+            return false;
+        return true;
+    }
+    virtual bool loop () {
+        XCamReturn ret = _poll->poll_epoll_loop ();
+
+        if (ret == XCAM_RETURN_NO_ERROR || ret == XCAM_RETURN_ERROR_TIMEOUT ||
+            ret == XCAM_RETURN_BYPASS)
+            return true;
+        return false;
+    }
+
+private:
+    PollThread   *_poll;
+};
+
 const int PollThread::default_subdev_event_timeout = 100; // ms
 const int PollThread::default_capture_event_timeout = 100; // ms
 const int PollThread::default_isp_event_timeout = 1000; // ms
 
+// back-off before a source which polled error is watched again, the
+// same delays the per-device threads sleep
+static const int epoll_rearm_delay[] = {
+    0,      // stop
+    1,      // sub-device event
+    1,      // isp stats
+    100,    // capture
+};
+
+static int64_t
+epoll_now_ms ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
 
 PollThread::PollThread ()
     : _poll_callback (NULL)
     , _stats_callback (NULL)
     , frameid (0)
+    , _single_loop (false)
+    , _epoll_fd (-1)
+    , _epoll_stop_fd (-1)
 {
     SmartPtr<EventPollThread> event_loop = new EventPollThread(this);
     XCAM_ASSERT (event_loop.ptr ());
@@ -129,6 +187,21 @@ PollThread::PollThread ()
     XCAM_ASSERT (capture_loop.ptr ());
     _capture_loop = capture_loop;
 
+    SmartPtr<EpollLoopThread> epoll_loop = new EpollLoopThread (this);
+    XCAM_ASSERT (epoll_loop.ptr ());
+    _epoll_loop = epoll_loop;
+
+    xcam_mem_clear (_epoll_rearm_time);
+    char single_loop[16] = {0};
+#ifdef ANDROID_OS
+    property_get ("persist.vendor.rkisp.singlepoll", single_loop, "0");
+#else
+    const char *env = getenv ("persist_camera_engine_single_poll");
+    if (env)
+        strncpy (single_loop, env, sizeof (single_loop) - 1);
+#endif
+    _single_loop = (atoi (single_loop) != 0);
+
     _3a_stats_poll_stop_fd[0] =  -1;
     _3a_stats_poll_stop_fd[1] =  -1;
     _event_poll_stop_fd[0] = -1;
@@ -186,6 +259,16 @@ PollThread::set_stats_callback (StatsCallback *callback)
     return true;
 }
 
+bool
+PollThread::set_single_loop (bool enable)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, _epoll_fd < 0, false,
+        "PollThread set single loop failed, need stop the poll thread first");
+    _single_loop = enable;
+    return true;
+}
+
 void PollThread::destroy_stop_fds () {
     if (_3a_stats_poll_stop_fd[1] != -1 || _3a_stats_poll_stop_fd[0] != -1) {
         close(_3a_stats_poll_stop_fd[0]);
@@ -278,8 +361,96 @@ exit_error:
     return ret;
 }
 
+void PollThread::destroy_epoll_fds () {
+    if (_epoll_stop_fd != -1) {
+        close (_epoll_stop_fd);
+        _epoll_stop_fd = -1;
+    }
+    if (_epoll_fd != -1) {
+        close (_epoll_fd);
+        _epoll_fd = -1;
+    }
+    xcam_mem_clear (_epoll_rearm_time);
+}
+
+bool PollThread::epoll_add_source (int source) {
+    struct epoll_event ev;
+    int fd = -1;
+
+    xcam_mem_clear (ev);
+    switch (source) {
+    case EpollStop:
+        fd = _epoll_stop_fd;
+        ev.events = EPOLLIN;
+        break;
+    case EpollEvent:
+        fd = _event_dev.ptr () ? _event_dev->get_fd () : -1;
+        ev.events = EPOLLPRI;
+        break;
+    case EpollStats:
+        fd = _isp_stats_dev.ptr () ? _isp_stats_dev->get_fd () : -1;
+        ev.events = EPOLLIN | EPOLLPRI;
+        break;
+    case EpollCapture:
+        fd = _capture_dev.ptr () ? _capture_dev->get_fd () : -1;
+        ev.events = EPOLLIN | EPOLLPRI;
+        break;
+    default:
+        return false;
+    }
+
+    if (fd < 0)
+        return true;
+
+    ev.data.u32 = source;
+    if (epoll_ctl (_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        XCAM_LOG_ERROR ("epoll add source %d (fd:%d) failed: %s", source, fd, strerror (errno));
+        return false;
+    }
+    _epoll_rearm_time[source] = 0;
+    return true;
+}
+
+XCamReturn PollThread::create_epoll_fds () {
+    destroy_epoll_fds ();
+
+    _epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+    if (_epoll_fd < 0) {
+        XCAM_LOG_ERROR ("Failed to create epoll fd: %s", strerror(errno));
+        return XCAM_RETURN_ERROR_UNKNOWN;
+    }
+
+    _epoll_stop_fd = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_epoll_stop_fd < 0) {
+        XCAM_LOG_ERROR ("Failed to create epoll stop eventfd: %s", strerror(errno));
+        destroy_epoll_fds ();
+        return XCAM_RETURN_ERROR_UNKNOWN;
+    }
+
+    for (int i = EpollStop; i < EpollSourceMax; i++) {
+        if (!epoll_add_source (i)) {
+            destroy_epoll_fds ();
+            return XCAM_RETURN_ERROR_UNKNOWN;
+        }
+    }
+
+    return XCAM_RETURN_NO_ERROR;
+}
+
 XCamReturn PollThread::start ()
 {
+    if (_single_loop) {
+        if (create_epoll_fds ()) {
+            XCAM_LOG_ERROR("create epoll fds failed !");
+            return XCAM_RETURN_ERROR_UNKNOWN;
+        }
+        if ((_event_dev.ptr () || _isp_stats_dev.ptr () || _capture_dev.ptr ()) &&
+                !_epoll_loop->start ()) {
+            return XCAM_RETURN_ERROR_THREAD;
+        }
+        return XCAM_RETURN_NO_ERROR;
+    }
+
     if (create_stop_fds ()) {
         XCAM_LOG_ERROR("create stop fds failed !");
         return XCAM_RETURN_ERROR_UNKNOWN;
@@ -302,6 +473,15 @@ XCamReturn PollThread::stop ()
 {
     XCAM_LOG_DEBUG ("PollThread stop");
 
+    if (_epoll_fd != -1) {
+        uint64_t val = 1;
+        if (write (_epoll_stop_fd, &val, sizeof (val)) != sizeof (val))
+            XCAM_LOG_WARNING ("epoll stop write not completed");
+        _epoll_loop->stop ();
+        destroy_epoll_fds ();
+        return XCAM_RETURN_NO_ERROR;
+    }
+
     if (_event_dev.ptr ()) {
         if (_event_poll_stop_fd[1] != -1) {
             char buf = 0xf;  // random value to write to flush fd.
@@ -402,9 +582,7 @@ PollThread::handle_3a_stats_event (struct v4l2_event &event)
 XCamReturn
 PollThread::poll_isp_stats_loop ()
 {
-    XCamReturn ret = XCAM_RETURN_NO_ERROR;
     int poll_ret = 0;
-    struct v4l2_event event;
 
     poll_ret = _isp_stats_dev->poll_event (PollThread::default_isp_event_timeout,
                                            _3a_stats_poll_stop_fd[0]);
@@ -427,18 +605,22 @@ PollThread::poll_isp_stats_loop ()
         return XCAM_RETURN_ERROR_TIMEOUT;
     }
 
-    event.type = V4L2_EVENT_RKISP_3A_STATS_READY;
-    ret = handle_events (event);
+    return handle_isp_stats ();
+}
 
-    return ret;
+XCamReturn
+PollThread::handle_isp_stats ()
+{
+    struct v4l2_event event;
 
+    xcam_mem_clear (event);
+    event.type = V4L2_EVENT_RKISP_3A_STATS_READY;
+    return handle_events (event);
 }
 
 XCamReturn
 PollThread::poll_subdev_event_loop ()
 {
-    XCamReturn ret = XCAM_RETURN_NO_ERROR;
-    struct v4l2_event event;
     int poll_ret = 0;
 
     poll_ret = _event_dev->poll_event (PollThread::default_subdev_event_timeout,
@@ -462,6 +644,15 @@ PollThread::poll_subdev_event_loop ()
         return XCAM_RETURN_ERROR_TIMEOUT;
     }
 
+    return handle_subdev_event ();
+}
+
+XCamReturn
+PollThread::handle_subdev_event ()
+{
+    XCamReturn ret = XCAM_RETURN_NO_ERROR;
+    struct v4l2_event event;
+
     xcam_mem_clear (event);
     ret = _event_dev->dequeue_event (event);
     if (ret != XCAM_RETURN_NO_ERROR) {
@@ -476,9 +667,7 @@ PollThread::poll_subdev_event_loop ()
 XCamReturn
 PollThread::poll_buffer_loop ()
 {
-    XCamReturn ret = XCAM_RETURN_NO_ERROR;
     int poll_ret = 0;
-    SmartPtr<V4l2Buffer> buf;
 
     poll_ret = _capture_dev->poll_event (PollThread::default_capture_event_timeout,
                                          _capture_poll_stop_fd[0]);
@@ -502,6 +691,15 @@ PollThread::poll_buffer_loop ()
         //return XCAM_RETURN_ERROR_TIMEOUT;
     }
 
+    return handle_capture_buffer ();
+}
+
+XCamReturn
+PollThread::handle_capture_buffer ()
+{
+    XCamReturn ret = XCAM_RETURN_NO_ERROR;
+    SmartPtr<V4l2Buffer> buf;
+
     ret = _capture_dev->dequeue_buffer (buf);
     if (ret != XCAM_RETURN_NO_ERROR) {
         XCAM_LOG_WARNING ("capture buffer failed");
@@ -518,4 +716,98 @@ PollThread::poll_buffer_loop ()
     return ret;
 }
 
+XCamReturn
+PollThread::handle_pending_subdev_events ()
+{
+    XCamReturn ret = XCAM_RETURN_NO_ERROR;
+
+    // subdev fd is blocking, only dequeue while an event is pending
+    while (_event_dev.ptr () && _event_dev->poll_event (0, -1) > 0) {
+        ret = handle_subdev_event ();
+        if (ret != XCAM_RETURN_NO_ERROR)
+            break;
+    }
+    return ret;
+}
+
+XCamReturn
+PollThread::poll_epoll_loop ()
+{
+    struct epoll_event events[EpollSourceMax];
+    bool ready[EpollSourceMax] = {false};
+    int timeout = PollThread::default_isp_event_timeout;
+    int64_t now = epoll_now_ms ();
+    int num = 0;
+
+    // watch again the sources which failed before, or shorten the wait
+    for (int i = EpollStop; i < EpollSourceMax; i++) {
+        if (!_epoll_rearm_time[i])
+            continue;
+        if (_epoll_rearm_time[i] <= now)
+            epoll_add_source (i);
+        else
+            timeout = XCAM_MIN (timeout, (int)(_epoll_rearm_time[i] - now));
+    }
+
+    num = epoll_wait (_epoll_fd, events, EpollSourceMax, timeout);
+    if (num < 0) {
+        if (errno == EINTR)
+            return XCAM_RETURN_NO_ERROR;
+        XCAM_LOG_ERROR ("epoll wait failed: %s, stop poll loop", strerror (errno));
+        return XCAM_RETURN_ERROR_UNKNOWN;
+    }
+
+    /* timeout */
+    if (num == 0) {
+        XCAM_LOG_DEBUG ("epoll timeout and continue");
+        return XCAM_RETURN_ERROR_TIMEOUT;
+    }
+
+    for (int i = 0; i < num; i++) {
+        uint32_t source = events[i].data.u32;
+        XCAM_ASSERT (source < EpollSourceMax);
+
+        if (source == EpollStop) {
+            XCAM_LOG_DEBUG ("epoll stop success !");
+            // stop success, return error to stop the poll thread
+            return XCAM_RETURN_ERROR_UNKNOWN;
+        }
+
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            int fd = source == EpollEvent ? _event_dev->get_fd () :
+                     (source == EpollStats ? _isp_stats_dev->get_fd () : _capture_dev->get_fd ());
+            XCAM_LOG_DEBUG ("epoll source %d got error but continue", source);
+            // level triggered error would spin, drop the source for a while
+            epoll_ctl (_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+            _epoll_rearm_time[source] = now + epoll_rearm_delay[source];
+            continue;
+        }
+        ready[source] = true;
+    }
+
+    /*
+     * SOF of a frame always arrives before its stats, dispatch sub-device
+     * events first and again right before the stats, the controller waits
+     * for the matching SOF while reading stats.
+     */
+    if (ready[EpollEvent] && handle_pending_subdev_events () != XCAM_RETURN_NO_ERROR)
+        XCAM_LOG_WARNING ("handle sub-device events failed on dev:%s",
+                          XCAM_STR(_event_dev->get_device_name()));
+
+    if (ready[EpollStats]) {
+        handle_pending_subdev_events ();
+        XCamReturn ret = handle_isp_stats ();
+        if (ret != XCAM_RETURN_NO_ERROR && ret != XCAM_RETURN_BYPASS)
+            XCAM_LOG_WARNING ("handle isp stats failed");
+    }
+
+    if (ready[EpollCapture]) {
+        XCAM_ASSERT (_poll_callback);
+        if (handle_capture_buffer () != XCAM_RETURN_NO_ERROR)
+            XCAM_LOG_WARNING ("handle capture buffer failed");
+    }
+
+    return XCAM_RETURN_NO_ERROR;
+}
+
 };
@@ -49,12 +49,14 @@ class V4l2SubDevice;
 class ISP3AStatsPollThread;
 class EventPollThread;
 class CapturePollThread;
+class EpollLoopThread;
 
 class PollThread
 {
     friend class ISP3AStatsPollThread;
     friend class EventPollThread;
     friend class CapturePollThread;
+    friend class EpollLoopThread;
     friend class FakePollThread;
 public:
     explicit PollThread ();
@@ -65,6 +67,15 @@ public:
     bool set_isp_stats_device (SmartPtr<V4l2Device> &dev);
     bool set_poll_callback (PollCallback *callback);
     bool set_stats_callback (StatsCallback *callback);
+    /*
+     * poll all devices on one epoll thread instead of one thread per
+     * device, must be set before start. Default is taken from env
+     * persist_camera_engine_single_poll or property
+     * persist.vendor.rkisp.singlepoll. The single loop dequeues capture
+     * buffers itself, subclasses overriding poll_buffer_loop must keep
+     * it disabled.
+     */
+    bool set_single_loop (bool enable);
 
     virtual XCamReturn start();
     virtual XCamReturn stop ();
@@ -73,6 +84,12 @@ protected:
     XCamReturn poll_isp_stats_loop ();
     XCamReturn poll_subdev_event_loop ();
     virtual XCamReturn poll_buffer_loop ();
+    XCamReturn poll_epoll_loop ();
+
+    XCamReturn handle_subdev_event ();
+    XCamReturn handle_pending_subdev_events ();
+    XCamReturn handle_isp_stats ();
+    XCamReturn handle_capture_buffer ();
 
     virtual XCamReturn handle_events (struct v4l2_event &event);
     XCamReturn handle_3a_stats_event (struct v4l2_event &event);
@@ -84,6 +101,9 @@ private:
     virtual XCamReturn notify_sof (int64_t time, int frameid);
     XCamReturn create_stop_fds ();
     void destroy_stop_fds ();
+    XCamReturn create_epoll_fds ();
+    void destroy_epoll_fds ();
+    bool epoll_add_source (int source);
 
 private:
     XCAM_DEAD_COPY (PollThread);
@@ -93,9 +113,18 @@ private:
     static const int default_capture_event_timeout;
     static const int default_isp_event_timeout;
 
+    enum EpollSource {
+        EpollStop = 0,
+        EpollEvent,
+        EpollStats,
+        EpollCapture,
+        EpollSourceMax,
+    };
+
     SmartPtr<ISP3AStatsPollThread>   _isp_loop;
     SmartPtr<EventPollThread>        _event_loop;
     SmartPtr<CapturePollThread>      _capture_loop;
+    SmartPtr<EpollLoopThread>        _epoll_loop;
 
     SmartPtr<V4l2SubDevice>          _event_dev;
     SmartPtr<V4l2Device>             _capture_dev;
@@ -109,6 +138,13 @@ private:
     int _3a_stats_poll_stop_fd[2];
     int _event_poll_stop_fd[2];
     int _capture_poll_stop_fd[2];
+
+    // single loop engine
+    bool _single_loop;
+    int _epoll_fd;
+    int _epoll_stop_fd;
+    // monotonic time in ms a failed source is added back, 0 if armed
+    int64_t _epoll_rearm_time[EpollSourceMax];
 };
 
 };
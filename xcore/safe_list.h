@@ -24,6 +24,7 @@
 #include <base/xcam_defs.h>
 #include <base/xcam_common.h>
 #include <errno.h>
+#include <utility>
 #include <list>
 #include <xcam_mutex.h>
 
@@ -47,7 +48,10 @@ public:
      *         >=0,  wait for @timeout microsseconds
     */
     inline ObjPtr pop (int32_t timeout = -1);
+    // non-blocking pop, return NULL if list is empty
+    inline ObjPtr try_pop ();
     inline bool push (const ObjPtr &obj);
+    inline bool push (ObjPtr &&obj);
     inline bool erase (const ObjPtr &obj);
     inline ObjPtr front ();
     uint32_t size () {
@@ -106,8 +110,22 @@ SafeList<OBj>::pop (int32_t timeout)
         return NULL;
     }
 
-    SafeList<OBj>::ObjPtr obj = *_obj_list.begin ();
-    _obj_list.erase (_obj_list.begin ());
+    SafeList<OBj>::ObjPtr obj = std::move (_obj_list.front ());
+    _obj_list.pop_front ();
+    return obj;
+}
+
+template<class OBj>
+typename SafeList<OBj>::ObjPtr
+SafeList<OBj>::try_pop ()
+{
+    SmartLock lock (_mutex);
+
+    if (_pop_paused || _obj_list.empty ())
+        return NULL;
+
+    SafeList<OBj>::ObjPtr obj = std::move (_obj_list.front ());
+    _obj_list.pop_front ();
     return obj;
 }
 
@@ -121,6 +139,16 @@ SafeList<OBj>::push (const SafeList<OBj>::ObjPtr &obj)
     return true;
 }
 
+template<class OBj>
+bool
+SafeList<OBj>::push (SafeList<OBj>::ObjPtr &&obj)
+{
+    SmartLock lock (_mutex);
+    _obj_list.push_back (std::move (obj));
+    _new_obj_cond.signal ();
+    return true;
+}
+
 template<class OBj>
 bool
 SafeList<OBj>::erase (const SafeList<OBj>::ObjPtr &obj)
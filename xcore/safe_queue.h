@@ -0,0 +1,104 @@
+/*
+ * safe_queue.h - inter-thread queue, SafeList or opt-in SafeRing
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_SAFE_QUEUE_H
+#define XCAM_SAFE_QUEUE_H
+
+#include <safe_list.h>
+#include <safe_ring.h>
+
+namespace XCam {
+
+/*
+ * A SafeList unless the owner opts into a SafeRing of a given capacity.
+ * The list takes every object pushed, the ring never allocates but push
+ * fails once @capacity objects are queued, so only queues whose depth is
+ * bounded by their owner should opt in.
+ */
+template<class OBj>
+class SafeQueue {
+public:
+    typedef SmartPtr<OBj> ObjPtr;
+
+    SafeQueue ()
+        : _ring (NULL)
+    {}
+    ~SafeQueue () {
+        delete _ring;
+    }
+
+    /*
+     * @capacity 0 goes back to the list. Only while the queue is empty
+     * and no other thread uses it, before it is started.
+     */
+    void set_ring_capacity (uint32_t capacity) {
+        XCAM_ASSERT (is_empty ());
+        delete _ring;
+        _ring = capacity ? new SafeRing<OBj> (capacity) : NULL;
+    }
+    // 0 for the list
+    uint32_t get_ring_capacity () const {
+        return _ring ? _ring->capacity () : 0;
+    }
+
+    ObjPtr pop (int32_t timeout = -1) {
+        return _ring ? _ring->pop (timeout) : _list.pop (timeout);
+    }
+    ObjPtr try_pop () {
+        return _ring ? _ring->try_pop () : _list.try_pop ();
+    }
+    bool push (const ObjPtr &obj) {
+        return _ring ? _ring->push (obj) : _list.push (obj);
+    }
+    bool push (ObjPtr &&obj) {
+        return _ring ? _ring->push (std::move (obj)) : _list.push (std::move (obj));
+    }
+    // the ring can't take an object out of the middle, false there
+    bool erase (const ObjPtr &obj) {
+        return _ring ? false : _list.erase (obj);
+    }
+    uint32_t size () {
+        return _ring ? _ring->size () : _list.size ();
+    }
+    bool is_empty () {
+        return _ring ? _ring->is_empty () : _list.is_empty ();
+    }
+    void wakeup () {
+        _ring ? _ring->wakeup () : _list.wakeup ();
+    }
+    void pause_pop () {
+        _ring ? _ring->pause_pop () : _list.pause_pop ();
+    }
+    void resume_pop () {
+        _ring ? _ring->resume_pop () : _list.resume_pop ();
+    }
+    void clear () {
+        _ring ? _ring->clear () : _list.clear ();
+    }
+
+private:
+    XCAM_DEAD_COPY (SafeQueue);
+
+private:
+    SafeList<OBj>     _list;
+    SafeRing<OBj>    *_ring;
+};
+
+};
+#endif //XCAM_SAFE_QUEUE_H
@@ -0,0 +1,292 @@
+/*
+ * safe_ring.h - bounded lock-free ring queue template
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_SAFE_RING_H
+#define XCAM_SAFE_RING_H
+
+#include <base/xcam_defs.h>
+#include <base/xcam_common.h>
+#include <errno.h>
+#include <utility>
+#include <atomic>
+#include <xcam_mutex.h>
+
+#define XCAM_SAFE_RING_DEFAULT_CAPACITY 32
+
+namespace XCam {
+
+enum SafeRingMode {
+    SafeRingSPSC = 0, // single producer, single consumer
+    SafeRingMPMC,     // multiple producers, multiple consumers
+};
+
+/*
+ * Bounded alternative to SafeList for hot inter-thread queues, a queue
+ * opts into it with a capacity through SafeQueue.
+ * Slots are preallocated, so push/pop never touch the heap and only
+ * take the mutex when a consumer has to sleep on an empty ring.
+ *
+ * SafeRingSPSC: push only from one thread; pop and clear only from one thread.
+ * SafeRingMPMC: any thread may push, pop or clear.
+ */
+template<class OBj, SafeRingMode mode = SafeRingMPMC>
+class SafeRing {
+public:
+    typedef SmartPtr<OBj> ObjPtr;
+
+    explicit SafeRing (uint32_t capacity = XCAM_SAFE_RING_DEFAULT_CAPACITY);
+    ~SafeRing ();
+
+    /*
+     * timeout, -1,  wait until wakeup
+     *         >=0,  wait for @timeout microsseconds
+    */
+    inline ObjPtr pop (int32_t timeout = -1);
+    // return false if ring is full, @obj is left untouched then
+    inline bool push (const ObjPtr &obj);
+    inline bool push (ObjPtr &&obj);
+    // non-blocking pop, return NULL if ring is empty
+    inline ObjPtr try_pop ();
+
+    uint32_t capacity () const {
+        return _capacity;
+    }
+    uint32_t size () const {
+        uint32_t tail = _tail.load (std::memory_order_acquire);
+        uint32_t head = _head.load (std::memory_order_acquire);
+        return (tail - head) > _capacity ? 0 : (tail - head);
+    }
+    bool is_empty () const {
+        return size () == 0;
+    }
+    void wakeup () {
+        SmartLock lock (_mutex);
+        _new_obj_cond.broadcast ();
+    }
+    void pause_pop () {
+        SmartLock lock (_mutex);
+        _pop_paused = true;
+        _new_obj_cond.broadcast ();
+    }
+    void resume_pop () {
+        SmartLock lock (_mutex);
+        _pop_paused = false;
+    }
+    inline void clear ();
+
+private:
+    struct Slot {
+        std::atomic<uint32_t>  seq;
+        ObjPtr                 obj;
+    };
+
+    // moves @obj into the ring on success
+    inline bool enqueue (ObjPtr &obj);
+    inline bool dequeue (ObjPtr &obj);
+
+    XCAM_DEAD_COPY (SafeRing);
+
+private:
+    Slot                     *_slots;
+    uint32_t                  _capacity;
+    uint32_t                  _mask;
+    std::atomic<uint32_t>     _head;
+    std::atomic<uint32_t>     _tail;
+    std::atomic<uint32_t>     _waiters;
+    Mutex                     _mutex;
+    XCam::Cond                _new_obj_cond;
+    volatile bool             _pop_paused;
+};
+
+template<class OBj, SafeRingMode mode>
+SafeRing<OBj, mode>::SafeRing (uint32_t capacity)
+    : _slots (NULL)
+    , _capacity (1)
+    , _mask (0)
+    , _head (0)
+    , _tail (0)
+    , _waiters (0)
+    , _pop_paused (false)
+{
+    XCAM_ASSERT (capacity);
+    while (_capacity < capacity)
+        _capacity <<= 1;
+    _mask = _capacity - 1;
+
+    _slots = new Slot[_capacity];
+    for (uint32_t i = 0; i < _capacity; ++i)
+        _slots[i].seq.store (i, std::memory_order_relaxed);
+}
+
+template<class OBj, SafeRingMode mode>
+SafeRing<OBj, mode>::~SafeRing ()
+{
+    delete [] _slots;
+}
+
+template<class OBj, SafeRingMode mode>
+bool
+SafeRing<OBj, mode>::enqueue (ObjPtr &obj)
+{
+    Slot *slot = NULL;
+    uint32_t pos = _tail.load (std::memory_order_relaxed);
+
+    if (mode == SafeRingSPSC) {
+        slot = &_slots[pos & _mask];
+        if (slot->seq.load (std::memory_order_acquire) != pos)
+            return false;
+        _tail.store (pos + 1, std::memory_order_relaxed);
+    } else {
+        for (;;) {
+            slot = &_slots[pos & _mask];
+            int32_t dif = (int32_t)(slot->seq.load (std::memory_order_acquire) - pos);
+            if (dif == 0) {
+                if (_tail.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = _tail.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    slot->obj = std::move (obj);
+    slot->seq.store (pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<class OBj, SafeRingMode mode>
+bool
+SafeRing<OBj, mode>::dequeue (ObjPtr &obj)
+{
+    Slot *slot = NULL;
+    uint32_t pos = _head.load (std::memory_order_relaxed);
+
+    if (mode == SafeRingSPSC) {
+        slot = &_slots[pos & _mask];
+        if (slot->seq.load (std::memory_order_acquire) != pos + 1)
+            return false;
+        _head.store (pos + 1, std::memory_order_relaxed);
+    } else {
+        for (;;) {
+            slot = &_slots[pos & _mask];
+            int32_t dif = (int32_t)(slot->seq.load (std::memory_order_acquire) - (pos + 1));
+            if (dif == 0) {
+                if (_head.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = _head.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    obj = std::move (slot->obj);
+    slot->seq.store (pos + _capacity, std::memory_order_release);
+    return true;
+}
+
+template<class OBj, SafeRingMode mode>
+bool
+SafeRing<OBj, mode>::push (const ObjPtr &obj)
+{
+    ObjPtr copy (obj);
+    return push (std::move (copy));
+}
+
+template<class OBj, SafeRingMode mode>
+bool
+SafeRing<OBj, mode>::push (ObjPtr &&obj)
+{
+    if (!enqueue (obj)) {
+        XCAM_LOG_DEBUG ("safe ring push failed, ring full(capacity:%d)", _capacity);
+        return false;
+    }
+
+    // only pay for the lock when a consumer sleeps on an empty ring.
+    // pairs with the fence in pop (): either the consumer sees the new
+    // slot on its recheck or we see it counted in _waiters
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (_waiters.load (std::memory_order_relaxed)) {
+        SmartLock lock (_mutex);
+        _new_obj_cond.signal ();
+    }
+    return true;
+}
+
+template<class OBj, SafeRingMode mode>
+typename SafeRing<OBj, mode>::ObjPtr
+SafeRing<OBj, mode>::try_pop ()
+{
+    ObjPtr obj;
+    if (_pop_paused)
+        return NULL;
+    dequeue (obj);
+    return obj;
+}
+
+template<class OBj, SafeRingMode mode>
+typename SafeRing<OBj, mode>::ObjPtr
+SafeRing<OBj, mode>::pop (int32_t timeout)
+{
+    ObjPtr obj;
+    int code = 0;
+
+    if (_pop_paused)
+        return NULL;
+    if (dequeue (obj) || timeout == 0)
+        return obj;
+
+    SmartLock lock (_mutex);
+    ++_waiters;
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    while (!_pop_paused && !dequeue (obj) && code == 0) {
+        if (timeout < 0)
+            code = _new_obj_cond.wait (_mutex);
+        else
+            code = _new_obj_cond.timedwait (_mutex, timeout);
+    }
+    --_waiters;
+
+    if (_pop_paused)
+        return NULL;
+
+    if (!obj.ptr ()) {
+        if (code == ETIMEDOUT) {
+            XCAM_LOG_DEBUG ("safe ring pop timeout");
+        } else {
+            XCAM_LOG_ERROR ("safe ring pop failed, code:%d", code);
+        }
+    }
+    return obj;
+}
+
+template<class OBj, SafeRingMode mode>
+void
+SafeRing<OBj, mode>::clear ()
+{
+    ObjPtr obj;
+    while (dequeue (obj))
+        obj.release ();
+}
+
+};
+#endif //XCAM_SAFE_RING_H
@@ -27,7 +27,26 @@
 
 namespace XCam {
 
+/*
+ * Build with XCAM_REFCOUNT_STATS defined to count every atomic refcount
+ * operation, read them with xcam_refcount_ops (). The counter is relaxed,
+ * it only orders against itself. apps/rkisp_smartptr_bench is built with
+ * it to count the operations of a frame, copying against moving or
+ * borrowing.
+ */
+#ifdef XCAM_REFCOUNT_STATS
+inline std::atomic<uint64_t> &xcam_refcount_ops ()
+{
+    static std::atomic<uint64_t> ops (0);
+    return ops;
+}
+#define XCAM_REFCOUNT_OP() XCam::xcam_refcount_ops ().fetch_add (1, std::memory_order_relaxed)
+#else
+#define XCAM_REFCOUNT_OP()
+#endif
+
 class RefCount;
+template <typename Obj> class BorrowedPtr;
 
 class RefObj {
     friend class RefCount;
@@ -36,9 +55,11 @@ public:
     virtual ~RefObj () {}
 
     void ref() const {
+        XCAM_REFCOUNT_OP ();
         ++_ref_count;
     }
     uint32_t unref() const {
+        XCAM_REFCOUNT_OP ();
         return --_ref_count;
     }
     virtual bool is_a_object () const {
@@ -81,6 +102,7 @@ template <typename Obj>
 class SmartPtr {
 private:
     template<typename ObjDerive> friend class SmartPtr;
+    template<typename ObjDerive> friend class BorrowedPtr;
 public:
     SmartPtr (Obj *obj = NULL)
         : _ptr (obj), _ref(NULL)
@@ -117,6 +139,33 @@ public:
         }
     }
 
+    // move, takes over the reference of @obj without touching the count
+    SmartPtr (SmartPtr<Obj> &&obj)
+        : _ptr(obj._ptr), _ref(obj._ref)
+    {
+        obj._ptr = NULL;
+        obj._ref = NULL;
+    }
+
+    template <typename ObjDerive>
+    SmartPtr (SmartPtr<ObjDerive> &&obj)
+        : _ptr(obj._ptr), _ref(obj._ref)
+    {
+        obj._ptr = NULL;
+        obj._ref = NULL;
+    }
+
+    // take a new reference on a borrowed object
+    template <typename ObjDerive>
+    SmartPtr (const BorrowedPtr<ObjDerive> &obj)
+        : _ptr(obj._ptr), _ref(obj._ref)
+    {
+        if (_ref) {
+            _ref->ref();
+            XCAM_ASSERT (_ptr);
+        }
+    }
+
     ~SmartPtr () {
         release();
     }
@@ -148,6 +197,27 @@ public:
         return *this;
     }
 
+    SmartPtr<Obj> & operator = (SmartPtr<Obj> &&obj) {
+        if (this != &obj) {
+            release ();
+            _ptr = obj._ptr;
+            _ref = obj._ref;
+            obj._ptr = NULL;
+            obj._ref = NULL;
+        }
+        return *this;
+    }
+
+    template <typename ObjDerive>
+    SmartPtr<Obj> & operator = (SmartPtr<ObjDerive> &&obj) {
+        release ();
+        _ptr = obj._ptr;
+        _ref = obj._ref;
+        obj._ptr = NULL;
+        obj._ref = NULL;
+        return *this;
+    }
+
     Obj *operator -> () const {
         return _ptr;
     }
@@ -187,6 +257,18 @@ public:
         return ret;
     }
 
+    // same as dynamic_cast_ptr without taking a reference
+    template <typename ObjDerive>
+    BorrowedPtr<ObjDerive> dynamic_cast_borrow () const {
+        BorrowedPtr<ObjDerive> ret;
+        if (!_ref)
+            return ret;
+        ret._ptr = dynamic_cast<ObjDerive*>(_ptr);
+        if (ret._ptr)
+            ret._ref = _ref;
+        return ret;
+    }
+
 private:
     template <typename ObjD>
     void set_pointer (ObjD *obj, RefObj *ref) {
@@ -216,5 +298,56 @@ private:
     mutable RefObj   *_ref;
 };
 
+/*
+ * Non-owning view of an object held by a SmartPtr, copying it costs no
+ * refcount operation. The owning SmartPtr must outlive it, convert it to
+ * a SmartPtr to keep the object.
+ */
+template <typename Obj>
+class BorrowedPtr {
+private:
+    template<typename ObjDerive> friend class SmartPtr;
+    template<typename ObjDerive> friend class BorrowedPtr;
+public:
+    BorrowedPtr ()
+        : _ptr (NULL), _ref (NULL)
+    {}
+
+    template <typename ObjDerive>
+    BorrowedPtr (const SmartPtr<ObjDerive> &obj)
+        : _ptr (obj._ptr), _ref (obj._ref)
+    {}
+
+    // a temporary owner would die before the borrow
+    template <typename ObjDerive>
+    BorrowedPtr (SmartPtr<ObjDerive> &&obj) = delete;
+
+    template <typename ObjDerive>
+    BorrowedPtr (const BorrowedPtr<ObjDerive> &obj)
+        : _ptr (obj._ptr), _ref (obj._ref)
+    {}
+
+    Obj *operator -> () const {
+        return _ptr;
+    }
+
+    Obj *ptr() const {
+        return _ptr;
+    }
+
+    template <typename ObjDerive>
+    BorrowedPtr<ObjDerive> dynamic_cast_ptr () const {
+        BorrowedPtr<ObjDerive> ret;
+        ret._ptr = dynamic_cast<ObjDerive*>(_ptr);
+        if (ret._ptr)
+            ret._ref = _ref;
+        return ret;
+    }
+
+private:
+    Obj              *_ptr;
+    RefObj           *_ref;
+};
+
 }; // end namespace
 #endif //XCAM_SMARTPTR_H
\ No newline at end of file
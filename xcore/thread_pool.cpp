@@ -138,6 +138,18 @@ ThreadPool::set_threads (uint32_t min, uint32_t max)
     return true;
 }
 
+bool
+ThreadPool::set_queue_ring_capacity (uint32_t capacity)
+{
+    SmartLock locker(_mutex);
+    XCAM_FAIL_RETURN (
+        ERROR, !_running, false,
+        "ThreadPool(%s) set queue ring failed, need stop the pool first", XCAM_STR(get_name ()));
+
+    _data_queue.set_ring_capacity (capacity);
+    return true;
+}
+
 bool
 ThreadPool::is_running ()
 {
@@ -239,13 +251,19 @@ ThreadPool::queue (const SmartPtr<UserData> &data)
             return XCAM_RETURN_ERROR_THREAD;
     }
 
-    if (!_data_queue.push (data))
+    if (!_data_queue.push (data)) {
+        XCAM_LOG_WARNING ("thread pool(%s) queue is full", XCAM_STR (get_name()));
         return XCAM_RETURN_ERROR_THREAD;
+    }
 
     do {
         SmartLock locker(_mutex);
         if (!_running) {
-            _data_queue.erase (data);
+            // a ring can't erase a single item, pool is stopped so drop all
+            if (_data_queue.get_ring_capacity ())
+                _data_queue.clear ();
+            else
+                _data_queue.erase (data);
             return XCAM_RETURN_ERROR_THREAD;
         }
 
@@ -22,7 +22,7 @@
 #define XCAM_THREAD_POOL_H
 
 #include <xcam_std.h>
-#include <safe_list.h>
+#include <safe_queue.h>
 #include <xcam_thread.h>
 
 namespace XCam {
@@ -50,6 +50,8 @@ public:
     explicit ThreadPool (const char *name);
     virtual ~ThreadPool ();
     bool set_threads (uint32_t min, uint32_t max);
+    // queue data in a ring of @capacity, queue fails once it is full
+    bool set_queue_ring_capacity (uint32_t capacity);
     const char *get_name () const {
         return _name;
     }
@@ -76,7 +78,7 @@ private:
     UserThreadList          _thread_list;
     Mutex                   _mutex;
 
-    SafeList<UserData>      _data_queue;
+    SafeQueue<UserData>     _data_queue;
 };
 
 }
@@ -23,6 +23,7 @@
 
 #include <xcam_std.h>
 #include <buffer_pool.h>
+#include <object_pool.h>
 #include <linux/videodev2.h>
 
 namespace XCam {
@@ -86,6 +87,7 @@ private:
 
 class V4l2BufferProxy
     : public BufferProxy
+    , public PooledObject<V4l2BufferProxy>
 {
 public:
     explicit V4l2BufferProxy (SmartPtr<V4l2Buffer> &buf, SmartPtr<V4l2Device> &device);
@@ -532,7 +532,7 @@ V4l2Device::start (bool need_queue_bufs)
 XCamReturn
 V4l2Device::stop ()
 {
-    XCAM_LOG_INFO ("device(%s) stop, already start: %d", XCAM_STR (_name), _active);
+    XCAM_LOG_INFO ("device(%s) stop, already start: %d", XCAM_STR (_name), _active.load ());
 
     while (poll_event (0, -1) > 0) {
         SmartPtr<V4l2Buffer> buf = get_buffer_by_index (0);
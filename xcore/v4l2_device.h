@@ -25,6 +25,7 @@
 #include <linux/videodev2.h>
 #include <list>
 #include <vector>
+#include <atomic>
 
 extern "C" {
     struct v4l2_event;
@@ -146,12 +147,13 @@ protected:
     uint32_t            _fps_n;
     uint32_t            _fps_d;
 
-    bool                _active;
+    std::atomic<bool>   _active;            // read by threads requeueing held buffers
 
     // buffer pool
     BufferPool          _buf_pool;
     uint32_t            _buf_count;
-    uint32_t            _queued_bufcnt;
+    // changed by the poll thread and by whoever requeues a buffer
+    std::atomic<uint32_t> _queued_bufcnt;
     XCamReturn buffer_new();
     XCamReturn buffer_del();
 };
@@ -52,7 +52,9 @@ struct VideoBufferInfo
     bool is_valid () const;
 };
 
-class VideoBuffer {
+class VideoBuffer
+    : public RefObj
+{
 public:
     explicit VideoBuffer (int64_t timestamp = InvalidTimestamp)
         : _timestamp (timestamp)
@@ -0,0 +1,313 @@
+/*
+ * work_scheduler.cpp - process-wide work-stealing scheduler
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "work_scheduler.h"
+#include <sched.h>
+#include <unistd.h>
+
+namespace XCam {
+
+// scheduler and queue index of the calling thread, if it is a scheduler thread
+static __thread WorkScheduler *tls_scheduler = NULL;
+static __thread uint32_t tls_queue_index = 0;
+
+static uint32_t
+online_cores ()
+{
+    long cores = sysconf (_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (uint32_t)cores : 1;
+}
+
+class SchedulerThread
+    : public Thread
+{
+public:
+    SchedulerThread (WorkScheduler *scheduler, uint32_t index, const char *name)
+        : Thread (name)
+        , _scheduler (scheduler)
+        , _index (index)
+    {}
+
+protected:
+    virtual bool started ();
+    virtual void stopped ();
+    virtual bool loop ();
+
+private:
+    WorkScheduler   *_scheduler;
+    uint32_t         _index;
+};
+
+bool
+SchedulerThread::started ()
+{
+    tls_scheduler = _scheduler;
+    tls_queue_index = _index;
+
+    if (_scheduler->_affinity) {
+        cpu_set_t cpu_set;
+        CPU_ZERO (&cpu_set);
+        CPU_SET (_index % online_cores (), &cpu_set);
+        if (sched_setaffinity (0, sizeof (cpu_set), &cpu_set) != 0) {
+            XCAM_LOG_WARNING (
+                "scheduler thread(%s) set affinity to core %d failed",
+                XCAM_STR (get_name ()), _index % online_cores ());
+        }
+    }
+    return true;
+}
+
+void
+SchedulerThread::stopped ()
+{
+    tls_scheduler = NULL;
+    XCAM_LOG_DEBUG ("scheduler thread(%s) stopped", XCAM_STR (get_name ()));
+}
+
+bool
+SchedulerThread::loop ()
+{
+    SmartPtr<WorkScheduler::Task> task;
+
+    if (!_scheduler->wait_task (_index, task))
+        return false;
+
+    XCamReturn err = task->run ();
+    task->done (err);
+    return true;
+}
+
+WorkScheduler::WorkScheduler (const char *name, uint32_t threads)
+    : _name (NULL)
+    , _thread_count (threads)
+    , _affinity (false)
+    , _running (false)
+    , _queues (NULL)
+    , _pending (0)
+    , _sleepers (0)
+    , _next_queue (0)
+    , _stolen_count (0)
+{
+    if (name)
+        _name = strndup (name, XCAM_MAX_STR_SIZE);
+
+    if (!_thread_count)
+        _thread_count = online_cores ();
+    if (_thread_count > XCAM_SCHEDULER_MAX_THREADS)
+        _thread_count = XCAM_SCHEDULER_MAX_THREADS;
+
+    _queues = new TaskQueue[_thread_count];
+}
+
+WorkScheduler::~WorkScheduler ()
+{
+    stop ();
+
+    delete [] _queues;
+    xcam_free (_name);
+}
+
+SmartPtr<WorkScheduler>
+WorkScheduler::instance ()
+{
+    static Mutex instance_mutex;
+    static SmartPtr<WorkScheduler> scheduler;
+
+    SmartLock locker (instance_mutex);
+    if (!scheduler.ptr ()) {
+        scheduler = new WorkScheduler ("xcam-sched");
+        XCAM_ASSERT (scheduler.ptr ());
+        if (!xcam_ret_is_ok (scheduler->start ())) {
+            XCAM_LOG_ERROR ("start process-wide work scheduler failed");
+            scheduler.release ();
+        }
+    }
+    return scheduler;
+}
+
+bool
+WorkScheduler::set_affinity (bool enable)
+{
+    SmartLock locker (_mutex);
+    XCAM_FAIL_RETURN (
+        ERROR, !_running, false,
+        "WorkScheduler(%s) set affinity failed, need stop the scheduler first", XCAM_STR (get_name ()));
+    _affinity = enable;
+    return true;
+}
+
+bool
+WorkScheduler::is_running ()
+{
+    SmartLock locker (_mutex);
+    return _running;
+}
+
+XCamReturn
+WorkScheduler::start ()
+{
+    {
+        SmartLock locker (_mutex);
+        if (_running)
+            return XCAM_RETURN_NO_ERROR;
+
+        _running = true;
+        for (uint32_t i = 0; i < _thread_count; ++i) {
+            char name[256];
+            snprintf (name, 255, "%s-%d", XCAM_STR (get_name ()), i);
+            SmartPtr<SchedulerThread> thread = new SchedulerThread (this, i, name);
+            XCAM_ASSERT (thread.ptr ());
+            if (!thread->start ()) {
+                XCAM_LOG_ERROR ("WorkScheduler(%s) start thread %d failed", XCAM_STR (get_name ()), i);
+                break;
+            }
+            _threads.push_back (thread);
+        }
+    }
+
+    if (_threads.size () != _thread_count) {
+        stop ();
+        return XCAM_RETURN_ERROR_THREAD;
+    }
+
+    XCAM_LOG_DEBUG ("WorkScheduler(%s) started with %d threads", XCAM_STR (get_name ()), _thread_count);
+    return XCAM_RETURN_NO_ERROR;
+}
+
+XCamReturn
+WorkScheduler::stop ()
+{
+    std::vector<SmartPtr<SchedulerThread> > threads;
+    {
+        SmartLock locker (_mutex);
+        if (!_running && _threads.empty ())
+            return XCAM_RETURN_NO_ERROR;
+
+        {
+            SmartLock idle_locker (_idle_mutex);
+            _running = false;
+            _idle_cond.broadcast ();
+        }
+        threads.swap (_threads);
+    }
+
+    for (size_t i = 0; i < threads.size (); ++i)
+        threads[i]->emit_stop ();
+    for (size_t i = 0; i < threads.size (); ++i)
+        threads[i]->stop ();
+
+    clear_tasks ();
+    return XCAM_RETURN_NO_ERROR;
+}
+
+void
+WorkScheduler::clear_tasks ()
+{
+    for (uint32_t i = 0; i < _thread_count; ++i) {
+        SmartLock locker (_queues[i].mutex);
+        for (uint32_t p = 0; p < PriorityCount; ++p)
+            _queues[i].tasks[p].clear ();
+    }
+    _pending.store (0);
+}
+
+XCamReturn
+WorkScheduler::queue (const SmartPtr<Task> &task, Priority priority)
+{
+    XCAM_ASSERT (task.ptr ());
+    XCAM_FAIL_RETURN (
+        ERROR, priority >= PriorityHigh && priority < PriorityCount, XCAM_RETURN_ERROR_PARAM,
+        "WorkScheduler(%s) queue task with wrong priority:%d", XCAM_STR (get_name ()), priority);
+
+    if (!_running)
+        return XCAM_RETURN_ERROR_THREAD;
+
+    uint32_t index = 0;
+    if (tls_scheduler == this)
+        index = tls_queue_index;
+    else
+        index = _next_queue.fetch_add (1, std::memory_order_relaxed) % _thread_count;
+
+    // count first so a taker never sees the counter underflow
+    _pending.fetch_add (1);
+    {
+        SmartLock locker (_queues[index].mutex);
+        _queues[index].tasks[priority].push_back (task);
+    }
+
+    // only pay for the lock when some thread sleeps
+    if (_sleepers.load ()) {
+        SmartLock locker (_idle_mutex);
+        _idle_cond.signal ();
+    }
+    return XCAM_RETURN_NO_ERROR;
+}
+
+bool
+WorkScheduler::take_task (uint32_t index, SmartPtr<Task> &task)
+{
+    if (!_pending.load (std::memory_order_acquire))
+        return false;
+
+    for (uint32_t p = 0; p < PriorityCount; ++p) {
+        // own queue first, newest task is the hottest in cache
+        {
+            TaskQueue &own = _queues[index];
+            SmartLock locker (own.mutex);
+            if (!own.tasks[p].empty ()) {
+                task = own.tasks[p].back ();
+                own.tasks[p].pop_back ();
+                _pending.fetch_sub (1);
+                return true;
+            }
+        }
+
+        // steal the oldest task of the others
+        for (uint32_t i = 1; i < _thread_count; ++i) {
+            TaskQueue &victim = _queues[(index + i) % _thread_count];
+            SmartLock locker (victim.mutex);
+            if (!victim.tasks[p].empty ()) {
+                task = victim.tasks[p].front ();
+                victim.tasks[p].pop_front ();
+                _pending.fetch_sub (1);
+                _stolen_count.fetch_add (1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+WorkScheduler::wait_task (uint32_t index, SmartPtr<Task> &task)
+{
+    while (_running) {
+        if (take_task (index, task))
+            return true;
+
+        SmartLock locker (_idle_mutex);
+        _sleepers.fetch_add (1);
+        while (_running && !_pending.load ())
+            _idle_cond.wait (_idle_mutex);
+        _sleepers.fetch_sub (1);
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * work_scheduler.h - process-wide work-stealing scheduler
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_WORK_SCHEDULER_H
+#define XCAM_WORK_SCHEDULER_H
+
+#include <xcam_std.h>
+#include <xcam_mutex.h>
+#include <thread_pool.h>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#define XCAM_SCHEDULER_MAX_THREADS 64
+
+namespace XCam {
+
+class SchedulerThread;
+
+/*
+ * Fixed set of threads, one per core by default, each owning a deque per
+ * priority. Tasks queued from a scheduler thread go to its own deque,
+ * others are spread round-robin. An idle thread first drains its own
+ * deque (newest first) and then steals the oldest task of the others,
+ * higher priorities always go first.
+ */
+class WorkScheduler
+    : public RefObj
+{
+    friend class SchedulerThread;
+
+public:
+    enum Priority {
+        PriorityHigh = 0,
+        PriorityNormal,
+        PriorityLow,
+        PriorityCount,
+    };
+
+    typedef ThreadPool::UserData Task;
+
+public:
+    // @threads 0 means the number of online cores
+    explicit WorkScheduler (const char *name, uint32_t threads = 0);
+    virtual ~WorkScheduler ();
+
+    // shared by the whole process, started on first call
+    static SmartPtr<WorkScheduler> instance ();
+
+    const char *get_name () const {
+        return _name;
+    }
+    uint32_t get_thread_count () const {
+        return _thread_count;
+    }
+    // pin thread i to core (i % cores), must be set before start
+    bool set_affinity (bool enable);
+    bool is_running ();
+
+    XCamReturn start ();
+    XCamReturn stop ();
+    XCamReturn queue (const SmartPtr<Task> &task, Priority priority = PriorityNormal);
+
+    uint64_t get_stolen_count () const {
+        return _stolen_count.load (std::memory_order_relaxed);
+    }
+
+private:
+    struct TaskQueue {
+        Mutex                          mutex;
+        std::deque<SmartPtr<Task> >    tasks[PriorityCount];
+    };
+
+    bool take_task (uint32_t index, SmartPtr<Task> &task);
+    bool wait_task (uint32_t index, SmartPtr<Task> &task);
+    void clear_tasks ();
+
+    XCAM_DEAD_COPY (WorkScheduler);
+
+private:
+    char                                   *_name;
+    uint32_t                                _thread_count;
+    bool                                    _affinity;
+    std::atomic<bool>                       _running;
+    Mutex                                   _mutex;
+    std::vector<SmartPtr<SchedulerThread> > _threads;
+    TaskQueue                              *_queues;
+
+    std::atomic<uint32_t>                   _pending;
+    std::atomic<uint32_t>                   _sleepers;
+    std::atomic<uint32_t>                   _next_queue;
+    std::atomic<uint64_t>                   _stolen_count;
+    Mutex                                   _idle_mutex;
+    XCam::Cond                              _idle_cond;
+};
+
+}
+
+#endif // XCAM_WORK_SCHEDULER_H
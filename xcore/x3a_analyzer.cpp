@@ -21,9 +21,99 @@
 #include "xcam_analyzer.h"
 #include "x3a_analyzer.h"
 #include "x3a_stats_pool.h"
+#include "work_scheduler.h"
+#include <time.h>
+
+// the analyzer thread runs one handler itself
+#define X3A_PARALLEL_WORKERS 2
 
 namespace XCam {
 
+static int64_t
+x3a_analyze_now_us ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static XCamReturn
+x3a_run_handler (AnalyzerHandler *handler, X3aResultList &results, int64_t &time_us)
+{
+    int64_t start = x3a_analyze_now_us ();
+    XCamReturn ret = handler->analyze (results);
+    time_us = x3a_analyze_now_us () - start;
+    return ret;
+}
+
+class X3aHandlerJoin {
+public:
+    explicit X3aHandlerJoin () : _pending (0) {}
+
+    void add () {
+        SmartLock locker (_mutex);
+        ++_pending;
+    }
+    void finish () {
+        SmartLock locker (_mutex);
+        XCAM_ASSERT (_pending > 0);
+        if (--_pending == 0)
+            _cond.broadcast ();
+    }
+    void wait () {
+        SmartLock locker (_mutex);
+        while (_pending > 0)
+            _cond.wait (_mutex);
+    }
+
+private:
+    XCAM_DEAD_COPY (X3aHandlerJoin);
+
+private:
+    Mutex        _mutex;
+    Cond         _cond;
+    uint32_t     _pending;
+};
+
+// runs one handler on a worker into its own result list
+class X3aHandlerTask
+    : public WorkScheduler::Task
+{
+public:
+    explicit X3aHandlerTask (AnalyzerHandler *handler, X3aHandlerJoin *join)
+        : _handler (handler)
+        , _join (join)
+        , _ret (XCAM_RETURN_NO_ERROR)
+        , _time_us (0)
+    {}
+
+    virtual XCamReturn run () {
+        _ret = x3a_run_handler (_handler, _results, _time_us);
+        return _ret;
+    }
+    // after done the analyzer thread may return, don't touch @_join later
+    virtual void done (XCamReturn) {
+        _join->finish ();
+    }
+
+    XCamReturn get_return () const {
+        return _ret;
+    }
+    int64_t get_time_us () const {
+        return _time_us;
+    }
+    X3aResultList &get_results () {
+        return _results;
+    }
+
+private:
+    AnalyzerHandler    *_handler;
+    X3aHandlerJoin     *_join;
+    XCamReturn          _ret;
+    int64_t             _time_us;
+    X3aResultList       _results;
+};
+
 X3aAnalyzer::X3aAnalyzer (const char *name)
     : XAnalyzer (name)
     , _brightness_level_param (0.0)
@@ -31,11 +121,81 @@ X3aAnalyzer::X3aAnalyzer (const char *name)
     , _awb_handler (NULL)
     , _af_handler (NULL)
     , _common_handler (NULL)
+    , _parallel_mode (X3aParallelNone)
+    , _timed_frames (0)
 {
+    xcam_mem_clear (_last_timing);
+    xcam_mem_clear (_timing_sum);
 }
 
 X3aAnalyzer::~X3aAnalyzer()
 {
+    if (_workers.ptr ())
+        _workers->stop ();
+
+    X3aAnalyzeTiming last, average;
+    get_analyze_timing (last, average);
+    if (_timed_frames)
+        XCAM_LOG_INFO (
+            "3a analyzer(%s) parallel mode %d, average over %lld frames ae:%lldus awb:%lldus af:%lldus common:%lldus total:%lldus",
+            XCAM_STR (get_name ()), _parallel_mode, (long long)_timed_frames,
+            (long long)average.ae_us, (long long)average.awb_us, (long long)average.af_us,
+            (long long)average.common_us, (long long)average.total_us);
+}
+
+bool
+X3aAnalyzer::set_parallel_mode (X3aParallelMode mode)
+{
+    XCAM_FAIL_RETURN (
+        ERROR, mode >= X3aParallelNone && mode <= X3aParallelAll, false,
+        "3a analyzer(%s) invalid parallel mode %d", XCAM_STR (get_name ()), mode);
+
+    if (mode != X3aParallelNone && !_workers.ptr ()) {
+        SmartPtr<WorkScheduler> workers = new WorkScheduler ("xcam-3a", X3A_PARALLEL_WORKERS);
+        XCAM_ASSERT (workers.ptr ());
+        XCAM_FAIL_RETURN (
+            ERROR, xcam_ret_is_ok (workers->start ()), false,
+            "3a analyzer(%s) start 3a workers failed", XCAM_STR (get_name ()));
+        _workers = workers;
+    }
+
+    _parallel_mode = mode;
+    XCAM_LOG_INFO ("3a analyzer(%s) parallel mode %d", XCAM_STR (get_name ()), mode);
+    return true;
+}
+
+void
+X3aAnalyzer::get_analyze_timing (X3aAnalyzeTiming &last, X3aAnalyzeTiming &average)
+{
+    SmartLock locker (_timing_mutex);
+    last = _last_timing;
+    xcam_mem_clear (average);
+    if (!_timed_frames)
+        return;
+
+    average.ae_us = _timing_sum.ae_us / (int64_t)_timed_frames;
+    average.awb_us = _timing_sum.awb_us / (int64_t)_timed_frames;
+    average.af_us = _timing_sum.af_us / (int64_t)_timed_frames;
+    average.common_us = _timing_sum.common_us / (int64_t)_timed_frames;
+    average.total_us = _timing_sum.total_us / (int64_t)_timed_frames;
+}
+
+void
+X3aAnalyzer::update_analyze_timing (const X3aAnalyzeTiming &timing)
+{
+    XCAM_LOG_DEBUG (
+        "3a analyze time ae:%lldus awb:%lldus af:%lldus common:%lldus total:%lldus",
+        (long long)timing.ae_us, (long long)timing.awb_us, (long long)timing.af_us,
+        (long long)timing.common_us, (long long)timing.total_us);
+
+    SmartLock locker (_timing_mutex);
+    _last_timing = timing;
+    _timing_sum.ae_us += timing.ae_us;
+    _timing_sum.awb_us += timing.awb_us;
+    _timing_sum.af_us += timing.af_us;
+    _timing_sum.common_us += timing.common_us;
+    _timing_sum.total_us += timing.total_us;
+    ++_timed_frames;
 }
 
 XCamReturn
@@ -99,12 +259,72 @@ X3aAnalyzer::push_3a_stats (const SmartPtr<X3aStats> &stats)
     return XAnalyzer::push_buffer (stats);
 }
 
+XCamReturn
+X3aAnalyzer::run_handlers_parallel (
+    X3aResultList &results, X3aAnalyzeTiming &timing, AnalyzerHandler *&failed)
+{
+    XCamReturn ret = XCAM_RETURN_NO_ERROR;
+    AnalyzerHandler *handlers[3] = {_ae_handler.ptr (), _awb_handler.ptr (), _af_handler.ptr ()};
+    int64_t *times[3] = {&timing.ae_us, &timing.awb_us, &timing.af_us};
+    SmartPtr<X3aHandlerTask> tasks[3];
+    X3aResultList local[3];
+    XCamReturn rets[3] = {XCAM_RETURN_NO_ERROR, XCAM_RETURN_NO_ERROR, XCAM_RETURN_NO_ERROR};
+    X3aHandlerJoin join;
+    uint32_t first = 0;
+
+    failed = NULL;
+    // AWB and AF consume the AE result of this frame
+    if (_parallel_mode == X3aParallelAwbAf) {
+        rets[0] = x3a_run_handler (handlers[0], local[0], *times[0]);
+        if (rets[0] != XCAM_RETURN_NO_ERROR) {
+            failed = handlers[0];
+            return rets[0];
+        }
+        first = 1;
+    }
+
+    // the analyzer thread takes the first handler, workers the rest
+    for (uint32_t i = first + 1; i < 3; ++i) {
+        tasks[i] = new X3aHandlerTask (handlers[i], &join);
+        join.add ();
+        if (!xcam_ret_is_ok (_workers->queue (tasks[i], WorkScheduler::PriorityHigh))) {
+            XCAM_LOG_WARNING ("3a analyzer(%s) queue handler %d failed, run it inline", XCAM_STR (get_name ()), i);
+            join.finish ();
+            tasks[i].release ();
+        }
+    }
+    rets[first] = x3a_run_handler (handlers[first], local[first], *times[first]);
+    for (uint32_t i = first + 1; i < 3; ++i) {
+        if (!tasks[i].ptr ())
+            rets[i] = x3a_run_handler (handlers[i], local[i], *times[i]);
+    }
+    join.wait ();
+
+    // merge in AE, AWB, AF order as the sequential path does
+    for (uint32_t i = 0; i < 3; ++i) {
+        if (tasks[i].ptr ()) {
+            rets[i] = tasks[i]->get_return ();
+            *times[i] = tasks[i]->get_time_us ();
+            local[i].swap (tasks[i]->get_results ());
+        }
+        if (rets[i] != XCAM_RETURN_NO_ERROR && !failed) {
+            failed = handlers[i];
+            ret = rets[i];
+        }
+        results.splice (results.end (), local[i]);
+    }
+    return ret;
+}
+
 XCamReturn
 X3aAnalyzer::analyze_3a_statistics (SmartPtr<X3aStats> &stats)
 {
     XCamReturn ret = XCAM_RETURN_NO_ERROR;
     X3aResultList results;
+    X3aAnalyzeTiming timing;
+    int64_t start = x3a_analyze_now_us ();
 
+    xcam_mem_clear (timing);
     ret = pre_3a_analyze (stats);
     if (ret != XCAM_RETURN_NO_ERROR) {
         notify_calculation_failed(
@@ -112,28 +332,42 @@ X3aAnalyzer::analyze_3a_statistics (SmartPtr<X3aStats> &stats)
         return ret;
     }
 
-    ret = _ae_handler->analyze (results);
-    if (ret != XCAM_RETURN_NO_ERROR) {
-        notify_calculation_failed(
-            _ae_handler.ptr(), stats->get_timestamp (), "ae calculation failed");
-        return ret;
-    }
-
-    ret = _awb_handler->analyze (results);
-    if (ret != XCAM_RETURN_NO_ERROR) {
-        notify_calculation_failed(
-            _awb_handler.ptr(), stats->get_timestamp (), "awb calculation failed");
-        return ret;
-    }
-
-    ret = _af_handler->analyze (results);
-    if (ret != XCAM_RETURN_NO_ERROR) {
-        notify_calculation_failed(
-            _af_handler.ptr(), stats->get_timestamp (), "af calculation failed");
-        return ret;
+    if (_parallel_mode != X3aParallelNone) {
+        AnalyzerHandler *failed = NULL;
+        ret = run_handlers_parallel (results, timing, failed);
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            const char *msg = "af calculation failed";
+            if (failed == _ae_handler.ptr ())
+                msg = "ae calculation failed";
+            else if (failed == _awb_handler.ptr ())
+                msg = "awb calculation failed";
+            notify_calculation_failed (failed, stats->get_timestamp (), msg);
+            return ret;
+        }
+    } else {
+        ret = x3a_run_handler (_ae_handler.ptr (), results, timing.ae_us);
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            notify_calculation_failed(
+                _ae_handler.ptr(), stats->get_timestamp (), "ae calculation failed");
+            return ret;
+        }
+
+        ret = x3a_run_handler (_awb_handler.ptr (), results, timing.awb_us);
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            notify_calculation_failed(
+                _awb_handler.ptr(), stats->get_timestamp (), "awb calculation failed");
+            return ret;
+        }
+
+        ret = x3a_run_handler (_af_handler.ptr (), results, timing.af_us);
+        if (ret != XCAM_RETURN_NO_ERROR) {
+            notify_calculation_failed(
+                _af_handler.ptr(), stats->get_timestamp (), "af calculation failed");
+            return ret;
+        }
     }
 
-    ret = _common_handler->analyze (results);
+    ret = x3a_run_handler (_common_handler.ptr (), results, timing.common_us);
     if (ret != XCAM_RETURN_NO_ERROR) {
         notify_calculation_failed(
             _common_handler.ptr(), stats->get_timestamp (), "3a other calculation failed");
@@ -146,6 +380,8 @@ X3aAnalyzer::analyze_3a_statistics (SmartPtr<X3aStats> &stats)
             NULL, stats->get_timestamp (), "3a collect results failed");
         return ret;
     }
+    timing.total_us = x3a_analyze_now_us () - start;
+    update_analyze_timing (timing);
 
     if (!results.empty ()) {
         set_results_timestamp(results, stats->get_timestamp ());
@@ -31,6 +31,22 @@ namespace XCam {
 class X3aStats;
 class AnalyzerThread;
 class VideoBuffer;
+class WorkScheduler;
+
+enum X3aParallelMode {
+    X3aParallelNone = 0,   // AE, AWB and AF in turn on the analyzer thread
+    X3aParallelAwbAf,      // AE first, then AWB and AF concurrently
+    X3aParallelAll,        // AE, AWB and AF concurrently
+};
+
+// time spent per handler in one analyze round, us
+struct X3aAnalyzeTiming {
+    int64_t     ae_us;
+    int64_t     awb_us;
+    int64_t     af_us;
+    int64_t     common_us;
+    int64_t     total_us;
+};
 
 class X3aAnalyzer
     : public XAnalyzer
@@ -105,6 +121,18 @@ public:
         return _common_handler;
     }
 
+    /*
+     * run the algorithm handlers of one frame on a small worker set and
+     * join before the common handler. Handlers run concurrently must not
+     * share state, so X3aParallelAll is only safe if AWB and AF don't
+     * consume the AE result of the same frame. Set before start.
+     */
+    bool set_parallel_mode (X3aParallelMode mode);
+    X3aParallelMode get_parallel_mode () const {
+        return _parallel_mode;
+    }
+    void get_analyze_timing (X3aAnalyzeTiming &last, X3aAnalyzeTiming &average);
+
     virtual XCamReturn configure ();
 protected:
     /* virtual function list */
@@ -129,6 +157,8 @@ protected:
 
 private:
     XCamReturn analyze_3a_statistics (SmartPtr<X3aStats> &stats);
+    XCamReturn run_handlers_parallel (X3aResultList &results, X3aAnalyzeTiming &timing, AnalyzerHandler *&failed);
+    void update_analyze_timing (const X3aAnalyzeTiming &timing);
 
     XCAM_DEAD_COPY (X3aAnalyzer);
 
@@ -140,6 +170,13 @@ private:
     SmartPtr<AwbHandler>     _awb_handler;
     SmartPtr<AfHandler>      _af_handler;
     SmartPtr<CommonHandler>  _common_handler;
+
+    X3aParallelMode          _parallel_mode;
+    SmartPtr<WorkScheduler>  _workers;
+    Mutex                    _timing_mutex;
+    X3aAnalyzeTiming         _last_timing;
+    X3aAnalyzeTiming         _timing_sum;
+    uint64_t                 _timed_frames;
 };
 
 }
@@ -29,6 +29,7 @@
 namespace XCam {
 
 class X3aResult
+    : public RefObj
 {
 protected:
     explicit X3aResult (
@@ -42,6 +43,7 @@ protected:
         , _ptr (NULL)
         , _processed (false)
         , _first_result(false)
+        , _frame_id (-1)
     {}
 
 public:
@@ -68,6 +70,13 @@ public:
     int64_t get_timestamp () const {
         return _timestamp;
     }
+    // id of the stats frame the result is calculated from
+    void set_frame_id (int32_t frame_id) {
+        _frame_id = frame_id;
+    }
+    int32_t get_frame_id () const {
+        return _frame_id;
+    }
     uint32_t get_type () const {
         return _type;
     }
@@ -97,6 +106,7 @@ protected:
     void                 *_ptr;
     bool                  _processed;
     bool                  _first_result;
+    int32_t               _frame_id;
 };
 
 typedef std::list<SmartPtr<X3aResult>>  X3aResultList;
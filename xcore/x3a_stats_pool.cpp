@@ -57,8 +57,8 @@ X3aStats::X3aStats (const SmartPtr<X3aStatsData> &data)
 XCam3AStats *
 X3aStats::get_stats ()
 {
-    SmartPtr<BufferData> data = get_buffer_data ();
-    SmartPtr<X3aStatsData> stats = data.dynamic_cast_ptr<X3aStatsData> ();
+    SmartPtr<BufferData> &data = get_buffer_data ();
+    BorrowedPtr<X3aStatsData> stats = data.dynamic_cast_borrow<X3aStatsData> ();
 
     XCAM_FAIL_RETURN(
         WARNING,
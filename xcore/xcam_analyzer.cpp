@@ -22,14 +22,58 @@
 
 #include "xcam_analyzer.h"
 #include "x3a_stats_pool.h"
+#ifdef ANDROID_OS
+#include <cutils/properties.h>
+#endif
 
 namespace XCam {
 
+#ifdef XCAM_REFCOUNT_STATS
+#define REFCOUNT_REPORT_FRAMES 300
+
+// process-wide atomic refcount operations per analyzed frame
+static void
+report_refcount_ops ()
+{
+    // analyzer threads of several handlers report here
+    static std::atomic<uint32_t> frames (0);
+    static std::atomic<uint64_t> last_ops (0);
+
+    if ((frames.fetch_add (1, std::memory_order_relaxed) + 1) % REFCOUNT_REPORT_FRAMES)
+        return;
+
+    uint64_t ops = xcam_refcount_ops ().load (std::memory_order_relaxed);
+    uint64_t last = last_ops.exchange (ops, std::memory_order_relaxed);
+    XCAM_LOG_INFO (
+        "refcount ops per frame:%.1f over %d frames",
+        (double)(ops - last) / REFCOUNT_REPORT_FRAMES, REFCOUNT_REPORT_FRAMES);
+}
+#endif
+
 AnalyzerThread::AnalyzerThread (XAnalyzer *analyzer)
     : Thread ("AnalyzerThread")
     , _analyzer (analyzer)
     , _paused (false)
-{}
+    , _policy (AnalyzerQueueFifo)
+    , _max_lag (0)
+    , _max_queued (0)
+    , _processed_count (0)
+    , _dropped_count (0)
+{
+    // "fifo" (default), "latest", or the max lag in frames
+    char policy[16] = {0};
+#ifdef ANDROID_OS
+    property_get ("persist.vendor.rkisp.3a_queue", policy, "fifo");
+#else
+    const char *env = getenv ("persist_camera_engine_3a_queue");
+    if (env)
+        strncpy (policy, env, sizeof (policy) - 1);
+#endif
+    if (!strcmp (policy, "latest"))
+        set_queue_policy (AnalyzerQueueLatestOnly);
+    else if (policy[0] >= '0' && policy[0] <= '9')
+        set_queue_policy (AnalyzerQueueBoundedLag, atoi (policy));
+}
 
 AnalyzerThread::~AnalyzerThread ()
 {
@@ -50,8 +94,56 @@ void AnalyzerThread::pause (bool pause)
 bool
 AnalyzerThread::push_stats (const SmartPtr<VideoBuffer> &buffer)
 {
-    _stats_queue.push (buffer);
-    return true;
+    uint32_t max_queued = _max_queued.load ();
+
+    // only this thread pushes, the analyzer popping meanwhile only helps
+    while (max_queued && _stats_queue.size () >= max_queued) {
+        SmartPtr<VideoBuffer> oldest = _stats_queue.try_pop ();
+        if (!oldest.ptr ())
+            break;
+        ++_dropped_count;
+    }
+    return _stats_queue.push (buffer);
+}
+
+void
+AnalyzerThread::set_queue_policy (AnalyzerQueuePolicy policy, uint32_t max_lag)
+{
+    _max_lag = max_lag;
+    _policy = policy;
+    XCAM_LOG_INFO ("analyzer thread queue policy:%d max lag:%d", policy, max_lag);
+}
+
+void
+AnalyzerThread::set_max_queued (uint32_t max_queued)
+{
+    _max_queued = max_queued;
+    XCAM_LOG_INFO ("analyzer thread max queued stats:%d", max_queued);
+}
+
+void
+AnalyzerThread::drop_stale_stats (SmartPtr<VideoBuffer> &stats)
+{
+    uint32_t max_lag = 0;
+
+    switch (_policy.load ()) {
+    case AnalyzerQueueLatestOnly:
+        break;
+    case AnalyzerQueueBoundedLag:
+        max_lag = _max_lag.load ();
+        break;
+    default:
+        return;
+    }
+
+    // replacing @stats releases the stale buffer back to its pool at once
+    while (_stats_queue.size () > max_lag) {
+        SmartPtr<VideoBuffer> newer = _stats_queue.try_pop ();
+        if (!newer.ptr ())
+            break;
+        stats = std::move (newer);
+        ++_dropped_count;
+    }
 }
 
 bool
@@ -71,25 +163,35 @@ AnalyzerThread::started ()
     return true;
 }
 
+void
+AnalyzerThread::stopped ()
+{
+    _stats_queue.clear ();
+    XCAM_LOG_DEBUG (
+        "analyzer(%s) processed %lld stats, dropped %lld",
+        XCAM_STR (_analyzer->get_name ()),
+        (long long)get_processed_count (), (long long)get_dropped_count ());
+}
+
 bool
 AnalyzerThread::loop ()
 {
     const static int32_t timeout = -1;
-    SmartPtr<VideoBuffer> latest_stats;
     SmartPtr<VideoBuffer> stats = _stats_queue.pop (timeout);
     if (!stats.ptr()) {
         XCAM_LOG_DEBUG ("analyzer thread got empty stats, stop thread");
         return false;
     }
-    //while ((latest_stats = _stats_queue.pop (0)).ptr ()) {
-    //    stats = latest_stats;
-    //    XCAM_LOG_WARNING ("lost 3a stats since 3a analyzer too slow");
-    //}
+    drop_stale_stats (stats);
 
     SmartLock locker(_mutex);
     if (_paused)
         return true;
     XCamReturn ret = _analyzer->analyze (stats);
+    ++_processed_count;
+#ifdef XCAM_REFCOUNT_STATS
+    report_refcount_ops ();
+#endif
     if (ret == XCAM_RETURN_NO_ERROR || ret == XCAM_RETURN_BYPASS)
         return true;
 
@@ -244,7 +346,9 @@ XAnalyzer::stop ()
     if (!_sync) {
         _analyzer_thread->triger_stop ();
         _analyzer_thread->stop ();
+        _analyzer_thread->clear_stats ();
     }
+    release_stats ();
 
     _started = false;
     XCAM_LOG_INFO ("Analyzer(%s) stopped.", XCAM_STR(get_name()));
@@ -258,6 +362,25 @@ XAnalyzer::pause (bool pause)
     return XCAM_RETURN_NO_ERROR;
 }
 
+void
+XAnalyzer::set_queue_policy (AnalyzerQueuePolicy policy, uint32_t max_lag)
+{
+    _analyzer_thread->set_queue_policy (policy, max_lag);
+}
+
+void
+XAnalyzer::set_max_queued_stats (uint32_t max_queued)
+{
+    _analyzer_thread->set_max_queued (max_queued);
+}
+
+void
+XAnalyzer::get_stats_counts (uint64_t &processed, uint64_t &dropped) const
+{
+    processed = _analyzer_thread->get_processed_count ();
+    dropped = _analyzer_thread->get_dropped_count ();
+}
+
 XCamReturn
 XAnalyzer::push_buffer (const SmartPtr<VideoBuffer> &buffer)
 {
@@ -26,13 +26,27 @@
 #include <handler_interface.h>
 #include <xcam_thread.h>
 #include <video_buffer.h>
-#include <safe_list.h>
+#include <safe_queue.h>
 #include <v4l2_device.h>
+#include <atomic>
 
 namespace XCam {
 
 class XAnalyzer;
 
+/*
+ * How queued stats are consumed when analysis is slower than the frame rate.
+ * AnalyzerQueueFifo: analyze every stats buffer in order.
+ * AnalyzerQueueLatestOnly: analyze the newest, drop the older ones.
+ * AnalyzerQueueBoundedLag: drop the oldest so at most max_lag stats wait
+ *   behind the one being analyzed.
+ */
+enum AnalyzerQueuePolicy {
+    AnalyzerQueueFifo = 0,
+    AnalyzerQueueLatestOnly,
+    AnalyzerQueueBoundedLag,
+};
+
 class AnalyzerThread
     : public Thread
 {
@@ -44,20 +58,42 @@ public:
         _stats_queue.pause_pop ();
     }
     bool push_stats (const SmartPtr<VideoBuffer> &buffer);
+    void clear_stats () {
+        _stats_queue.clear ();
+    }
+    // bounded ring instead of the list, push_stats fails once it is full
+    void set_stats_ring_capacity (uint32_t capacity) {
+        _stats_queue.set_ring_capacity (capacity);
+    }
     void pause (bool pause);
 
+    void set_queue_policy (AnalyzerQueuePolicy policy, uint32_t max_lag = 0);
+    void set_max_queued (uint32_t max_queued);
+    uint64_t get_processed_count () const {
+        return _processed_count.load (std::memory_order_relaxed);
+    }
+    uint64_t get_dropped_count () const {
+        return _dropped_count.load (std::memory_order_relaxed);
+    }
+
 protected:
     virtual bool started ();
-    virtual void stopped () {
-        _stats_queue.clear ();
-    }
+    virtual void stopped ();
     virtual bool loop ();
 
+private:
+    void drop_stale_stats (SmartPtr<VideoBuffer> &stats);
+
 private:
     XAnalyzer              *_analyzer;
-    SafeList<VideoBuffer>   _stats_queue;
+    SafeQueue<VideoBuffer>  _stats_queue;
     XCam::Mutex     _mutex;
     bool _paused;
+    std::atomic<int>        _policy;
+    std::atomic<uint32_t>   _max_lag;
+    std::atomic<uint32_t>   _max_queued;
+    std::atomic<uint64_t>   _processed_count;
+    std::atomic<uint64_t>   _dropped_count;
 };
 
 class AnalyzerCallback {
@@ -94,6 +130,15 @@ public:
     XCamReturn stop ();
     XCamReturn pause (bool pause);
     XCamReturn push_buffer (const SmartPtr<VideoBuffer> &buffer);
+    // only for async mode, @max_lag is used by AnalyzerQueueBoundedLag
+    void set_queue_policy (AnalyzerQueuePolicy policy, uint32_t max_lag = 0);
+    /*
+     * only for async mode, push_buffer drops the oldest queued stats so at
+     * most @max_queued wait, whatever the policy. 0, the default, doesn't
+     * bound the queue. For stats holding buffers of a device.
+     */
+    void set_max_queued_stats (uint32_t max_queued);
+    void get_stats_counts (uint64_t &processed, uint64_t &dropped) const;
 
     uint32_t get_width () const {
         return _width;
@@ -144,6 +189,9 @@ protected:
     virtual XCamReturn release_handlers () = 0;
     virtual XCamReturn internal_init (uint32_t width, uint32_t height, double framerate) = 0;
     virtual XCamReturn internal_deinit () = 0;
+    // after stop, drop the stats kept from the last analysis, they may
+    // point into buffers of the stats device
+    virtual void release_stats () {}
 
     // in analyzer thread
     //virtual XCamReturn configure () = 0;
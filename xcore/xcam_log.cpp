@@ -20,6 +20,7 @@
 
 #include <base/xcam_log.h>
 #include <base/xcam_defs.h>
+#include "xcam_log_ring.h"
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/ioctl.h>
@@ -36,6 +37,7 @@
 #endif
 
 static char log_file_name[XCAM_MAX_STR_SIZE] = {0};
+static int log_file_mode = XCORE_LOG_FILE_MODE_SYNC;
 /* use a 32 bit value to represent all modules bug level, and
  * each module represents by 4 bits, and the module bit maps is
  * as follow:
@@ -108,10 +110,16 @@ int xcam_get_log_level() {
 }
 
 void xcam_print_log (int module, int level, const char* format, ...) {
-    char buffer[XCAM_MAX_STR_SIZE] = {0};
+    char buffer[XCAM_MAX_STR_SIZE];
 
-    if (strlen (log_file_name) > 0) {
+    if (log_file_name[0] != '\0') {
         va_list va_list;
+        if (xcam_log_ring_is_running ()) {
+            va_start (va_list, format);
+            xcam_log_ring_vprint (format, va_list);
+            va_end (va_list);
+            return ;
+        }
         va_start (va_list, format);
         vsnprintf (buffer, XCAM_MAX_STR_SIZE, format, va_list);
         va_end (va_list);
@@ -161,9 +169,31 @@ void xcam_print_log (int module, int level, const char* format, ...) {
 #endif
 }
 
+static void xcam_reopen_log () {
+    xcam_log_ring_stop ();
+    if (log_file_mode != XCORE_LOG_FILE_MODE_SYNC &&
+            !xcam_log_ring_start (log_file_name,
+                                  log_file_mode == XCORE_LOG_FILE_MODE_ASYNC_BINARY))
+        printf("error! async log start failed, fall back to sync log !\n");
+}
+
 void xcam_set_log (const char* file_name) {
     if (NULL != file_name) {
         memset (log_file_name, 0, XCAM_MAX_STR_SIZE);
-        strncpy (log_file_name, file_name, XCAM_MAX_STR_SIZE);
+        strncpy (log_file_name, file_name, XCAM_MAX_STR_SIZE - 1);
+        xcam_reopen_log ();
     }
 }
+
+void xcam_set_log_file_mode (int mode) {
+    if (mode < XCORE_LOG_FILE_MODE_SYNC || mode > XCORE_LOG_FILE_MODE_ASYNC_BINARY)
+        return;
+
+    log_file_mode = mode;
+    if (log_file_name[0] != '\0')
+        xcam_reopen_log ();
+}
+
+void xcam_flush_log () {
+    xcam_log_ring_flush ();
+}
@@ -0,0 +1,773 @@
+/*
+ * xcam_log_ring.cpp - asynchronous ring buffer backend of xcam log
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "xcam_log_ring.h"
+#include <base/xcam_defs.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/time.h>
+#include <atomic>
+#include <new>
+
+// per thread ring size in bytes, must be power of 2
+#define XCAM_LOG_RING_SIZE (64 * 1024)
+#define XCAM_LOG_RING_MASK (XCAM_LOG_RING_SIZE - 1)
+// records are 16 bytes aligned so a wrap always leaves room for a pad header
+#define XCAM_LOG_RECORD_ALIGN 16
+#define XCAM_LOG_BINARY_MAX 1024
+#define XCAM_LOG_STR_ARG_MAX 256
+#define XCAM_LOG_LINE_MAX XCAM_MAX_STR_SIZE
+#define XCAM_LOG_WRITE_BATCH (64 * 1024)
+#define XCAM_LOG_FLUSH_INTERVAL_MS 20
+
+enum LogRecordType {
+    LOG_RECORD_PAD = 0,
+    LOG_RECORD_TEXT,
+    LOG_RECORD_BINARY,
+};
+
+struct LogRecordHeader {
+    uint32_t size;      // whole record size including header, aligned
+    uint16_t type;
+    uint16_t len;       // payload bytes
+    uint64_t seq;
+};
+
+struct LogRing {
+    std::atomic<uint64_t>  head;     // advanced by writer thread
+    std::atomic<uint64_t>  tail;     // advanced by owner thread
+    std::atomic<uint32_t>  dropped;
+    std::atomic<bool>      in_use;
+    LogRing               *next;
+    uint8_t                data[XCAM_LOG_RING_SIZE];
+};
+
+static std::atomic<LogRing *>  g_rings (NULL);
+static std::atomic<uint64_t>   g_log_seq (0);
+static std::atomic<bool>       g_running (false);
+static std::atomic<bool>       g_binary (false);
+
+static pthread_once_t          g_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t           g_ring_key;
+
+static pthread_mutex_t         g_writer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t          g_writer_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t               g_writer_thread;
+static bool                    g_writer_stop = false;
+static uint32_t                g_flush_request = 0;
+static uint32_t                g_flush_done = 0;
+static FILE                   *g_file = NULL;
+static bool                    g_atexit_registered = false;
+
+static char                    g_write_batch[XCAM_LOG_WRITE_BATCH];
+static uint32_t                g_write_len = 0;
+
+static void
+ring_release (void *data)
+{
+    LogRing *ring = (LogRing *)data;
+    if (ring)
+        ring->in_use.store (false, std::memory_order_release);
+}
+
+static void
+ring_key_create ()
+{
+    pthread_key_create (&g_ring_key, ring_release);
+}
+
+static LogRing *
+get_thread_ring ()
+{
+    LogRing *ring = NULL;
+
+    pthread_once (&g_key_once, ring_key_create);
+    ring = (LogRing *)pthread_getspecific (g_ring_key);
+    if (ring)
+        return ring;
+
+    // reuse a drained ring left by an exited thread
+    for (ring = g_rings.load (std::memory_order_acquire); ring; ring = ring->next) {
+        bool expected = false;
+        if (ring->in_use.load (std::memory_order_relaxed))
+            continue;
+        if (ring->head.load (std::memory_order_acquire) != ring->tail.load (std::memory_order_relaxed))
+            continue;
+        if (ring->in_use.compare_exchange_strong (expected, true))
+            break;
+    }
+
+    if (!ring) {
+        ring = (LogRing *)malloc (sizeof (LogRing));
+        if (!ring)
+            return NULL;
+        new (&ring->head) std::atomic<uint64_t> (0);
+        new (&ring->tail) std::atomic<uint64_t> (0);
+        new (&ring->dropped) std::atomic<uint32_t> (0);
+        new (&ring->in_use) std::atomic<bool> (true);
+        ring->next = g_rings.load (std::memory_order_relaxed);
+        while (!g_rings.compare_exchange_weak (ring->next, ring))
+            ;
+    }
+
+    pthread_setspecific (g_ring_key, ring);
+    return ring;
+}
+
+static bool
+ring_write (LogRing *ring, LogRecordType type, const void *payload, uint32_t len)
+{
+    uint32_t size = XCAM_ALIGN_UP (sizeof (LogRecordHeader) + len, XCAM_LOG_RECORD_ALIGN);
+    uint64_t tail = ring->tail.load (std::memory_order_relaxed);
+    uint64_t head = ring->head.load (std::memory_order_acquire);
+    uint32_t offset = tail & XCAM_LOG_RING_MASK;
+    uint32_t contiguous = XCAM_LOG_RING_SIZE - offset;
+    uint32_t need = (contiguous < size) ? contiguous + size : size;
+    LogRecordHeader *hdr = NULL;
+
+    if (need > XCAM_LOG_RING_SIZE - (uint32_t)(tail - head)) {
+        ring->dropped.fetch_add (1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (contiguous < size) {
+        hdr = (LogRecordHeader *)(ring->data + offset);
+        hdr->size = contiguous;
+        hdr->type = LOG_RECORD_PAD;
+        hdr->len = 0;
+        tail += contiguous;
+        offset = 0;
+    }
+
+    hdr = (LogRecordHeader *)(ring->data + offset);
+    hdr->size = size;
+    hdr->type = type;
+    hdr->len = len;
+    hdr->seq = g_log_seq.fetch_add (1, std::memory_order_relaxed);
+    memcpy (hdr + 1, payload, len);
+
+    ring->tail.store (tail + size, std::memory_order_release);
+
+    // wake the writer early on bursts, never block the logging thread
+    if (tail + size - head > XCAM_LOG_RING_SIZE / 2 &&
+            pthread_mutex_trylock (&g_writer_mutex) == 0) {
+        pthread_cond_signal (&g_writer_cond);
+        pthread_mutex_unlock (&g_writer_mutex);
+    }
+    return true;
+}
+
+/*
+ * printf conversion spec parser, shared by the binary encoder on the
+ * logging thread and the decoder on the writer thread so both agree on
+ * the argument layout.
+ */
+enum LogArgLength {
+    LOG_LEN_NONE = 0,
+    LOG_LEN_HH,
+    LOG_LEN_H,
+    LOG_LEN_L,
+    LOG_LEN_LL,
+    LOG_LEN_Z,
+    LOG_LEN_J,
+    LOG_LEN_T,
+    LOG_LEN_BIG_L,
+};
+
+struct LogSpec {
+    const char *start;
+    uint32_t    len;
+    bool        width_star;
+    bool        prec_star;
+    int         length;
+    char        conv;
+};
+
+static const char *
+parse_spec (const char *p, LogSpec &spec)
+{
+    XCAM_ASSERT (*p == '%');
+    spec.start = p++;
+    spec.width_star = false;
+    spec.prec_star = false;
+    spec.length = LOG_LEN_NONE;
+
+    while (*p && strchr ("-+ #0'", *p))
+        ++p;
+    if (*p == '*') {
+        spec.width_star = true;
+        ++p;
+    } else {
+        while (*p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (*p == '.') {
+        ++p;
+        if (*p == '*') {
+            spec.prec_star = true;
+            ++p;
+        } else {
+            while (*p >= '0' && *p <= '9')
+                ++p;
+        }
+    }
+
+    switch (*p) {
+    case 'h':
+        spec.length = (p[1] == 'h') ? LOG_LEN_HH : LOG_LEN_H;
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        spec.length = (p[1] == 'l') ? LOG_LEN_LL : LOG_LEN_L;
+        p += (p[1] == 'l') ? 2 : 1;
+        break;
+    case 'z':
+        spec.length = LOG_LEN_Z;
+        ++p;
+        break;
+    case 'j':
+        spec.length = LOG_LEN_J;
+        ++p;
+        break;
+    case 't':
+        spec.length = LOG_LEN_T;
+        ++p;
+        break;
+    case 'L':
+        spec.length = LOG_LEN_BIG_L;
+        ++p;
+        break;
+    default:
+        break;
+    }
+
+    if (!*p || !strchr ("diouxXcsfFeEgGaAp%", *p))
+        return NULL;
+    // wide chars/strings are not supported in binary mode
+    if ((*p == 's' || *p == 'c') && spec.length != LOG_LEN_NONE)
+        return NULL;
+
+    spec.conv = *p++;
+    spec.len = p - spec.start;
+    return p;
+}
+
+class LogArgWriter {
+public:
+    LogArgWriter (uint8_t *buf, uint32_t cap) : _buf (buf), _cap (cap), _len (0) {}
+    bool put (const void *data, uint32_t len) {
+        if (_len + len > _cap)
+            return false;
+        memcpy (_buf + _len, data, len);
+        _len += len;
+        return true;
+    }
+    uint32_t length () const {
+        return _len;
+    }
+private:
+    uint8_t  *_buf;
+    uint32_t  _cap;
+    uint32_t  _len;
+};
+
+class LogArgReader {
+public:
+    LogArgReader (const uint8_t *buf, uint32_t len) : _buf (buf), _len (len), _pos (0) {}
+    bool get (void *data, uint32_t len) {
+        if (_pos + len > _len)
+            return false;
+        memcpy (data, _buf + _pos, len);
+        _pos += len;
+        return true;
+    }
+    const char *get_str () {
+        uint16_t len = 0;
+        const char *str = NULL;
+        if (!get (&len, sizeof (len)) || _pos + len > _len)
+            return NULL;
+        str = (const char *)(_buf + _pos);
+        _pos += len;
+        return str;
+    }
+private:
+    const uint8_t *_buf;
+    uint32_t       _len;
+    uint32_t       _pos;
+};
+
+#define LOG_ARG_PUT(writer, args, type)                 \
+    do {                                                \
+        type value = va_arg (args, type);               \
+        if (!(writer).put (&value, sizeof (value)))     \
+            return false;                               \
+    } while (0)
+
+// length with the terminating 0, then the bytes, read back by get_str ()
+static bool
+put_str (LogArgWriter &writer, const char *str, uint32_t max)
+{
+    uint16_t len = strnlen (str, max - 1);
+    uint16_t stored = len + 1;
+    return writer.put (&stored, sizeof (stored)) && writer.put (str, len) && writer.put ("", 1);
+}
+
+static bool
+encode_binary (LogArgWriter &writer, const char *format, va_list args)
+{
+    LogSpec spec;
+
+    // the format may live in a library unloaded before the writer gets to
+    // the record, so it is copied like the string arguments; formats too
+    // long for a record fall back to text
+    if (!put_str (writer, format, XCAM_LOG_BINARY_MAX))
+        return false;
+
+    for (const char *p = format; *p; ) {
+        if (*p != '%') {
+            ++p;
+            continue;
+        }
+        p = parse_spec (p, spec);
+        if (!p)
+            return false;
+        if (spec.width_star)
+            LOG_ARG_PUT (writer, args, int);
+        if (spec.prec_star)
+            LOG_ARG_PUT (writer, args, int);
+
+        switch (spec.conv) {
+        case '%':
+            break;
+        case 'd':
+        case 'i':
+        case 'c':
+            switch (spec.length) {
+            case LOG_LEN_L:
+                LOG_ARG_PUT (writer, args, long);
+                break;
+            case LOG_LEN_LL:
+                LOG_ARG_PUT (writer, args, long long);
+                break;
+            case LOG_LEN_Z:
+                LOG_ARG_PUT (writer, args, ssize_t);
+                break;
+            case LOG_LEN_J:
+                LOG_ARG_PUT (writer, args, intmax_t);
+                break;
+            case LOG_LEN_T:
+                LOG_ARG_PUT (writer, args, ptrdiff_t);
+                break;
+            default:
+                LOG_ARG_PUT (writer, args, int);
+                break;
+            }
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            switch (spec.length) {
+            case LOG_LEN_L:
+                LOG_ARG_PUT (writer, args, unsigned long);
+                break;
+            case LOG_LEN_LL:
+                LOG_ARG_PUT (writer, args, unsigned long long);
+                break;
+            case LOG_LEN_Z:
+                LOG_ARG_PUT (writer, args, size_t);
+                break;
+            case LOG_LEN_J:
+                LOG_ARG_PUT (writer, args, uintmax_t);
+                break;
+            case LOG_LEN_T:
+                LOG_ARG_PUT (writer, args, ptrdiff_t);
+                break;
+            default:
+                LOG_ARG_PUT (writer, args, unsigned int);
+                break;
+            }
+            break;
+        case 'p':
+            LOG_ARG_PUT (writer, args, void *);
+            break;
+        case 's': {
+            // strings may not outlive the call, copy them
+            const char *str = va_arg (args, const char *);
+            if (!str)
+                str = "(null)";
+            if (!put_str (writer, str, XCAM_LOG_STR_ARG_MAX))
+                return false;
+            break;
+        }
+        default:
+            if (spec.length == LOG_LEN_BIG_L)
+                LOG_ARG_PUT (writer, args, long double);
+            else
+                LOG_ARG_PUT (writer, args, double);
+            break;
+        }
+    }
+    return true;
+}
+
+#define LOG_ARG_FORMAT(reader, type, out, size, fmt)                    \
+    do {                                                                \
+        type value;                                                     \
+        if (!(reader).get (&value, sizeof (value)))                     \
+            return -1;                                                  \
+        ret = snprintf (out, size, fmt, value);                         \
+    } while (0)
+
+// format one spec, with '*' already replaced by stored values
+static int
+decode_spec (LogArgReader &reader, const LogSpec &spec, char *out, size_t size)
+{
+    char fmt[64];
+    uint32_t fmt_len = 0;
+    int stars[2];
+    int star_count = 0, star_idx = 0;
+    int ret = 0;
+
+    if (spec.width_star && !reader.get (&stars[star_count++], sizeof (int)))
+        return -1;
+    if (spec.prec_star && !reader.get (&stars[star_count++], sizeof (int)))
+        return -1;
+
+    for (uint32_t i = 0; i < spec.len && fmt_len < sizeof (fmt) - 16; ++i) {
+        if (spec.start[i] == '*' && star_idx < star_count)
+            fmt_len += snprintf (fmt + fmt_len, sizeof (fmt) - fmt_len, "%d", stars[star_idx++]);
+        else
+            fmt[fmt_len++] = spec.start[i];
+    }
+    fmt[fmt_len] = '\0';
+
+    switch (spec.conv) {
+    case '%':
+        ret = snprintf (out, size, "%%");
+        break;
+    case 'd':
+    case 'i':
+    case 'c':
+        switch (spec.length) {
+        case LOG_LEN_L:
+            LOG_ARG_FORMAT (reader, long, out, size, fmt);
+            break;
+        case LOG_LEN_LL:
+            LOG_ARG_FORMAT (reader, long long, out, size, fmt);
+            break;
+        case LOG_LEN_Z:
+            LOG_ARG_FORMAT (reader, ssize_t, out, size, fmt);
+            break;
+        case LOG_LEN_J:
+            LOG_ARG_FORMAT (reader, intmax_t, out, size, fmt);
+            break;
+        case LOG_LEN_T:
+            LOG_ARG_FORMAT (reader, ptrdiff_t, out, size, fmt);
+            break;
+        default:
+            LOG_ARG_FORMAT (reader, int, out, size, fmt);
+            break;
+        }
+        break;
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        switch (spec.length) {
+        case LOG_LEN_L:
+            LOG_ARG_FORMAT (reader, unsigned long, out, size, fmt);
+            break;
+        case LOG_LEN_LL:
+            LOG_ARG_FORMAT (reader, unsigned long long, out, size, fmt);
+            break;
+        case LOG_LEN_Z:
+            LOG_ARG_FORMAT (reader, size_t, out, size, fmt);
+            break;
+        case LOG_LEN_J:
+            LOG_ARG_FORMAT (reader, uintmax_t, out, size, fmt);
+            break;
+        case LOG_LEN_T:
+            LOG_ARG_FORMAT (reader, ptrdiff_t, out, size, fmt);
+            break;
+        default:
+            LOG_ARG_FORMAT (reader, unsigned int, out, size, fmt);
+            break;
+        }
+        break;
+    case 'p':
+        LOG_ARG_FORMAT (reader, void *, out, size, fmt);
+        break;
+    case 's': {
+        const char *str = reader.get_str ();
+        if (!str)
+            return -1;
+        ret = snprintf (out, size, fmt, str);
+        break;
+    }
+    default:
+        if (spec.length == LOG_LEN_BIG_L)
+            LOG_ARG_FORMAT (reader, long double, out, size, fmt);
+        else
+            LOG_ARG_FORMAT (reader, double, out, size, fmt);
+        break;
+    }
+    return ret;
+}
+
+static uint32_t
+decode_binary (const uint8_t *payload, uint32_t len, char *out, uint32_t size)
+{
+    LogArgReader reader (payload, len);
+    const char *format = NULL;
+    uint32_t pos = 0;
+    LogSpec spec;
+
+    format = reader.get_str ();
+    if (!format)
+        return 0;
+
+    for (const char *p = format; *p && pos + 1 < size; ) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        const char *next = parse_spec (p, spec);
+        int ret = next ? decode_spec (reader, spec, out + pos, size - pos) : -1;
+        if (ret < 0)
+            break;
+        pos += XCAM_MIN ((uint32_t)ret, size - pos - 1);
+        p = next;
+    }
+    return pos;
+}
+
+bool
+xcam_log_ring_vprint (const char *format, va_list args)
+{
+    LogRing *ring = get_thread_ring ();
+    if (!ring)
+        return false;
+
+    if (g_binary.load (std::memory_order_relaxed)) {
+        uint8_t payload[XCAM_LOG_BINARY_MAX];
+        LogArgWriter writer (payload, sizeof (payload));
+        va_list copy;
+        bool ok = false;
+
+        va_copy (copy, args);
+        ok = encode_binary (writer, format, copy);
+        va_end (copy);
+        if (ok)
+            return ring_write (ring, LOG_RECORD_BINARY, payload, writer.length ());
+        // unsupported conversion or too many args, fall back to text
+    }
+
+    char buffer[XCAM_LOG_LINE_MAX];
+    int len = vsnprintf (buffer, sizeof (buffer), format, args);
+    if (len < 0)
+        return false;
+    if (len >= (int)sizeof (buffer))
+        len = sizeof (buffer) - 1;
+    return ring_write (ring, LOG_RECORD_TEXT, buffer, len);
+}
+
+static void
+batch_flush ()
+{
+    if (g_write_len && g_file)
+        fwrite (g_write_batch, 1, g_write_len, g_file);
+    g_write_len = 0;
+}
+
+static const LogRecordHeader *
+ring_peek (LogRing *ring)
+{
+    uint64_t head = ring->head.load (std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load (std::memory_order_acquire);
+
+    while (head != tail) {
+        const LogRecordHeader *hdr =
+            (const LogRecordHeader *)(ring->data + (head & XCAM_LOG_RING_MASK));
+        if (hdr->type != LOG_RECORD_PAD)
+            return hdr;
+        head += hdr->size;
+        ring->head.store (head, std::memory_order_release);
+    }
+    return NULL;
+}
+
+static void
+drain_rings ()
+{
+    for (;;) {
+        LogRing *oldest_ring = NULL;
+        const LogRecordHeader *oldest = NULL;
+
+        // merge all thread rings by global sequence number
+        for (LogRing *ring = g_rings.load (std::memory_order_acquire); ring; ring = ring->next) {
+            uint32_t dropped = ring->dropped.exchange (0, std::memory_order_relaxed);
+            if (dropped) {
+                if (g_write_len + 128 > XCAM_LOG_WRITE_BATCH)
+                    batch_flush ();
+                g_write_len += snprintf (
+                    g_write_batch + g_write_len, XCAM_LOG_WRITE_BATCH - g_write_len,
+                    "XCAM WARNING xcam_log_ring: %u log records dropped, ring full\n", dropped);
+            }
+
+            const LogRecordHeader *hdr = ring_peek (ring);
+            if (hdr && (!oldest || hdr->seq < oldest->seq)) {
+                oldest = hdr;
+                oldest_ring = ring;
+            }
+        }
+        if (!oldest)
+            break;
+
+        if (g_write_len + XCAM_LOG_LINE_MAX > XCAM_LOG_WRITE_BATCH)
+            batch_flush ();
+
+        if (oldest->type == LOG_RECORD_TEXT) {
+            memcpy (g_write_batch + g_write_len, oldest + 1, oldest->len);
+            g_write_len += oldest->len;
+        } else {
+            g_write_len += decode_binary (
+                               (const uint8_t *)(oldest + 1), oldest->len,
+                               g_write_batch + g_write_len, XCAM_LOG_LINE_MAX);
+        }
+
+        oldest_ring->head.fetch_add (oldest->size, std::memory_order_release);
+    }
+    batch_flush ();
+}
+
+static void *
+log_writer_loop (void *)
+{
+    bool stop = false;
+
+    while (!stop) {
+        uint32_t flush_request = 0;
+        struct timeval now;
+        struct timespec abstime;
+
+        gettimeofday (&now, NULL);
+        now.tv_usec += XCAM_LOG_FLUSH_INTERVAL_MS * 1000;
+        abstime.tv_sec = now.tv_sec + now.tv_usec / 1000000;
+        abstime.tv_nsec = (now.tv_usec % 1000000) * 1000;
+
+        pthread_mutex_lock (&g_writer_mutex);
+        if (!g_writer_stop && g_flush_request == g_flush_done)
+            pthread_cond_timedwait (&g_writer_cond, &g_writer_mutex, &abstime);
+        stop = g_writer_stop;
+        flush_request = g_flush_request;
+        pthread_mutex_unlock (&g_writer_mutex);
+
+        drain_rings ();
+        if (g_file)
+            fflush (g_file);
+
+        pthread_mutex_lock (&g_writer_mutex);
+        g_flush_done = flush_request;
+        pthread_cond_broadcast (&g_writer_cond);
+        pthread_mutex_unlock (&g_writer_mutex);
+    }
+    return NULL;
+}
+
+static void
+log_ring_atexit ()
+{
+    xcam_log_ring_stop ();
+}
+
+bool
+xcam_log_ring_is_running ()
+{
+    return g_running.load (std::memory_order_acquire);
+}
+
+bool
+xcam_log_ring_start (const char *file_name, bool binary)
+{
+    if (!file_name || !file_name[0])
+        return false;
+
+    xcam_log_ring_stop ();
+
+    g_file = fopen (file_name, "ab+");
+    if (!g_file) {
+        printf ("error! can't open log file %s: %s\n", file_name, strerror (errno));
+        return false;
+    }
+
+    g_binary.store (binary);
+    g_writer_stop = false;
+    if (pthread_create (&g_writer_thread, NULL, log_writer_loop, NULL) != 0) {
+        printf ("error! can't create log writer thread\n");
+        fclose (g_file);
+        g_file = NULL;
+        return false;
+    }
+
+    if (!g_atexit_registered) {
+        atexit (log_ring_atexit);
+        g_atexit_registered = true;
+    }
+    g_running.store (true, std::memory_order_release);
+    return true;
+}
+
+void
+xcam_log_ring_stop ()
+{
+    if (!g_running.exchange (false))
+        return;
+
+    pthread_mutex_lock (&g_writer_mutex);
+    g_writer_stop = true;
+    pthread_cond_broadcast (&g_writer_cond);
+    pthread_mutex_unlock (&g_writer_mutex);
+    pthread_join (g_writer_thread, NULL);
+
+    // pick up records queued while the writer was exiting
+    drain_rings ();
+    fclose (g_file);
+    g_file = NULL;
+}
+
+void
+xcam_log_ring_flush ()
+{
+    if (!xcam_log_ring_is_running ())
+        return;
+
+    pthread_mutex_lock (&g_writer_mutex);
+    uint32_t request = ++g_flush_request;
+    pthread_cond_broadcast (&g_writer_cond);
+    while (!g_writer_stop && (int32_t)(g_flush_done - request) < 0)
+        pthread_cond_wait (&g_writer_cond, &g_writer_mutex);
+    pthread_mutex_unlock (&g_writer_mutex);
+}
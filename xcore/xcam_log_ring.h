@@ -0,0 +1,40 @@
+/*
+ * xcam_log_ring.h - asynchronous ring buffer backend of xcam log
+ *
+ *  Copyright (c) 2019, Fuzhou Rockchip Electronics Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef XCAM_LOG_RING_H
+#define XCAM_LOG_RING_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+
+/*
+ * Internal interface between xcam_log.cpp and the async file backend.
+ * Each logging thread owns a lock-free SPSC byte ring, a single writer
+ * thread drains all rings in sequence order and keeps the file open.
+ */
+
+bool xcam_log_ring_start (const char *file_name, bool binary);
+void xcam_log_ring_stop ();
+void xcam_log_ring_flush ();
+bool xcam_log_ring_is_running ();
+
+// returns false if the record was dropped
+bool xcam_log_ring_vprint (const char *format, va_list args);
+
+#endif //XCAM_LOG_RING_H
@@ -24,6 +24,7 @@
 #include <xcam_std.h>
 #include <pthread.h>
 #include <sys/time.h>
+#include <time.h>
 
 namespace XCam {
 
@@ -68,8 +69,13 @@ private:
     XCAM_DEAD_COPY (Cond);
 
 public:
+    // timeouts run on CLOCK_MONOTONIC, wall clock steps do not stretch them
     Cond () {
-        pthread_cond_init (&_cond, NULL);
+        pthread_condattr_t attr;
+        pthread_condattr_init (&attr);
+        pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+        pthread_cond_init (&_cond, &attr);
+        pthread_condattr_destroy (&attr);
     }
     ~Cond () {
         pthread_cond_destroy (&_cond);
@@ -79,17 +85,22 @@ public:
         return pthread_cond_wait (&_cond, &mutex._mutex);
     }
     int timedwait (Mutex &mutex, uint32_t time_in_us) {
-        struct timeval now;
         struct timespec abstime;
 
-        gettimeofday (&now, NULL);
-        now.tv_usec += time_in_us;
-        xcam_mem_clear (abstime);
-        abstime.tv_sec += now.tv_sec + now.tv_usec / 1000000;
-        abstime.tv_nsec = (now.tv_usec % 1000000) * 1000;
+        clock_gettime (CLOCK_MONOTONIC, &abstime);
+        abstime.tv_sec += time_in_us / 1000000;
+        abstime.tv_nsec += (time_in_us % 1000000) * 1000;
+        if (abstime.tv_nsec >= 1000000000) {
+            abstime.tv_sec += 1;
+            abstime.tv_nsec -= 1000000000;
+        }
 
         return pthread_cond_timedwait (&_cond, &mutex._mutex, &abstime);
     }
+    // @deadline is an absolute CLOCK_MONOTONIC time
+    int timedwait_until (Mutex &mutex, const struct timespec &deadline) {
+        return pthread_cond_timedwait (&_cond, &mutex._mutex, &deadline);
+    }
 
     int signal() {
         return pthread_cond_signal (&_cond);